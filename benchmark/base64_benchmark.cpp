@@ -0,0 +1,132 @@
+#include "galay-utils/encoding/base64.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t inputSize;
+    double nsPerOp;
+    double gbPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t inputSize, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double gbPerSec = static_cast<double>(inputSize) / nsPerOp;
+    return Result{std::move(name), inputSize, nsPerOp, gbPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(24) << result.name
+              << std::right << std::setw(12) << result.inputSize
+              << std::setw(14) << std::fixed << std::setprecision(2) << result.nsPerOp
+              << std::setw(10) << std::fixed << std::setprecision(3) << result.gbPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+} // namespace
+
+int main() {
+    using galay::utils::Base64Decoder;
+    using galay::utils::Base64Util;
+    namespace detail = galay::utils::detail;
+
+    constexpr std::size_t bytesPerCase = 64 * 1024 * 1024;
+
+    std::vector<std::uint8_t> input(1024 * 1024);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<std::uint8_t>(i * 131 + 17);
+    }
+
+    std::cout << "Base64 benchmark\n";
+    std::cout << "Build with -O3 -DNDEBUG. Bytes per case=" << bytesPerCase
+              << ", backend=" << static_cast<int>(Base64Util::backend())
+              << " (0=Scalar 1=SSSE3 2=AVX2 3=NEON)\n";
+    std::cout << std::left << std::setw(24) << "Scenario"
+              << std::right << std::setw(12) << "bytes"
+              << std::setw(14) << "ns/op"
+              << std::setw(10) << "GB/s" << '\n';
+
+    for (std::size_t size : {std::size_t{48}, std::size_t{768}, std::size_t{16 * 1024}, input.size()}) {
+        const std::size_t iterations = std::max<std::size_t>(1, bytesPerCase / size);
+        const std::span<const std::uint8_t> bytes(input.data(), size);
+        const std::string text = Base64Util::Base64Encode(input.data(), size);
+        std::string encoded(text.size(), '\0');
+        std::vector<std::uint8_t> decoded(size);
+
+        printResult(measure("encode scalar", size, iterations, [&]() {
+            detail::base64EncodeScalar(bytes.data(), size / 3, encoded.data(), false);
+            return static_cast<std::uint64_t>(encoded[size / 2]);
+        }));
+        printResult(measure("Base64EncodeInto", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(Base64Util::Base64EncodeInto(bytes, encoded).length);
+        }));
+        printResult(measure("Base64Encode string", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(Base64Util::Base64Encode(input.data(), size).size());
+        }));
+        printResult(measure("decode scalar", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(detail::base64DecodeScalar(text.data(), size / 3, decoded.data()));
+        }));
+        printResult(measure("Base64DecodeInto", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(Base64Util::Base64DecodeInto(text, decoded).length);
+        }));
+        printResult(measure("Base64Decode string", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(Base64Util::Base64Decode(text).size());
+        }));
+    }
+
+    // MIME 正文：76 列 CRLF 换行，64KB 分片送入流式解码器
+    const std::string mime = [&]() {
+        const std::string lf = Base64Util::Base64EncodeMime(
+            std::string(reinterpret_cast<const char*>(input.data()), input.size()));
+        std::string crlf;
+        crlf.reserve(lf.size() + lf.size() / 76);
+        for (char c : lf) {
+            if (c == '\n') {
+                crlf.push_back('\r');
+            }
+            crlf.push_back(c);
+        }
+        return crlf;
+    }();
+    std::vector<std::uint8_t> body(Base64Decoder::maxOutputLength(mime.size()));
+    const std::size_t mimeIterations = std::max<std::size_t>(1, bytesPerCase / input.size());
+    printResult(measure("Base64Decoder MIME", input.size(), mimeIterations, [&]() {
+        Base64Decoder decoder;
+        std::size_t written = 0;
+        for (std::size_t offset = 0; offset < mime.size(); offset += 64 * 1024) {
+            written += decoder.update(std::string_view(mime).substr(offset, 64 * 1024),
+                                      std::span<std::uint8_t>(body).subspan(written)).length;
+        }
+        written += decoder.finish(std::span<std::uint8_t>(body).subspan(written)).length;
+        return static_cast<std::uint64_t>(written);
+    }));
+    printResult(measure("Base64Decode linebreaks", input.size(), mimeIterations, [&]() {
+        return static_cast<std::uint64_t>(Base64Util::Base64Decode(mime, true).size());
+    }));
+
+    return static_cast<int>(g_sink == static_cast<std::uint64_t>(-1));
+}
@@ -0,0 +1,146 @@
+#include "galay-utils/cache/lru_cache.hpp"
+#include "galay-utils/core/clock.hpp"
+#include "galay-utils/tool/circuit_breaker.hpp"
+#include "galay-utils/tool/rate_limiter.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    double nsPerOp;
+    double mopsPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double seconds = static_cast<double>(elapsedNs) / 1'000'000'000.0;
+    const double mopsPerSec = (static_cast<double>(iterations) / seconds) / 1'000'000.0;
+    return Result{std::move(name), nsPerOp, mopsPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(36) << result.name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2)
+              << result.nsPerOp
+              << std::setw(14) << std::fixed << std::setprecision(2)
+              << result.mopsPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+template<typename Clock>
+Result measureNow(std::string name, std::size_t iterations) {
+    return measure(std::move(name), iterations, [](std::size_t) {
+        return static_cast<std::uint64_t>(Clock::now().time_since_epoch().count());
+    });
+}
+
+template<typename Clock>
+Result measureTokenBucket(std::string name, std::size_t iterations) {
+    // 速率足够高，令牌始终充足，每次调用都完整走一遍读时钟 + 补充 + CAS 扣减
+    galay::utils::BasicTokenBucketLimiter<Clock> limiter(1e12, 1'000'000);
+    return measure(std::move(name), iterations, [&limiter](std::size_t) {
+        return static_cast<std::uint64_t>(limiter.tryAcquire());
+    });
+}
+
+// 窗口为 0 时每次请求都能复用槽位；缓存类时钟在同一刷新周期内读数不变会被判为窗口内请求，故只比较精确时钟
+template<typename Clock>
+Result measureSlidingWindow(std::string name, std::size_t iterations) {
+    galay::utils::BasicSlidingWindowLimiter<Clock> limiter(64, std::chrono::milliseconds(0));
+    return measure(std::move(name), iterations, [&limiter](std::size_t) {
+        return static_cast<std::uint64_t>(limiter.tryAcquire());
+    });
+}
+
+template<typename Clock>
+Result measureBreakerFailure(std::string name, std::size_t iterations) {
+    // 失败路径每次都记录时间戳
+    galay::utils::CircuitBreakerConfig config;
+    config.failureThreshold = static_cast<std::size_t>(-1);
+    galay::utils::BasicCircuitBreaker<Clock> breaker(config);
+    return measure(std::move(name), iterations, [&breaker](std::size_t) {
+        breaker.onFailure();
+        return static_cast<std::uint64_t>(breaker.allowRequest());
+    });
+}
+
+template<typename Clock>
+Result measureTtlCache(std::string name, std::size_t iterations) {
+    using Cache = galay::utils::LruCache<int, int, std::hash<int>, std::equal_to<int>, Clock>;
+    constexpr int kKeys = 1024;
+    Cache cache(kKeys, std::chrono::seconds(60));
+    for (int key = 0; key < kKeys; ++key) {
+        cache.put(key, key);
+    }
+    return measure(std::move(name), iterations, [&cache](std::size_t i) {
+        const int* value = cache.peek(static_cast<int>(i & (kKeys - 1)));
+        return value == nullptr ? 0u : static_cast<std::uint64_t>(*value);
+    });
+}
+
+} // namespace
+
+int main() {
+    constexpr std::size_t kIterations = 20'000'000;
+
+    galay::utils::TscClock::calibrate();
+    galay::utils::CachedClock::start();
+
+    std::cout << "TscClock hardware=" << galay::utils::TscClock::hardware()
+              << " ticksPerSecond=" << std::fixed << std::setprecision(0)
+              << galay::utils::TscClock::ticksPerSecond()
+              << " CoarseClock resolution="
+              << galay::utils::CoarseClock::resolution().count() << "ns"
+              << " CachedClock interval="
+              << galay::utils::CachedClock::interval().count() << "us\n";
+    std::cout << std::left << std::setw(36) << "case"
+              << std::right << std::setw(12) << "ns/op"
+              << std::setw(14) << "Mops/s" << '\n';
+
+    printResult(measureNow<std::chrono::system_clock>("system_clock::now", kIterations));
+    printResult(measureNow<std::chrono::steady_clock>("steady_clock::now", kIterations));
+    printResult(measureNow<galay::utils::TscClock>("TscClock::now", kIterations));
+    printResult(measureNow<galay::utils::CoarseClock>("CoarseClock::now", kIterations));
+    printResult(measureNow<galay::utils::CachedClock>("CachedClock::now", kIterations));
+
+    printResult(measureTokenBucket<std::chrono::steady_clock>("TokenBucket steady_clock", kIterations));
+    printResult(measureTokenBucket<galay::utils::TscClock>("TokenBucket TscClock", kIterations));
+    printResult(measureTokenBucket<galay::utils::CoarseClock>("TokenBucket CoarseClock", kIterations));
+    printResult(measureTokenBucket<galay::utils::CachedClock>("TokenBucket CachedClock", kIterations));
+
+    printResult(measureSlidingWindow<std::chrono::steady_clock>("SlidingWindow steady_clock", kIterations));
+    printResult(measureSlidingWindow<galay::utils::TscClock>("SlidingWindow TscClock", kIterations));
+
+    printResult(measureBreakerFailure<std::chrono::steady_clock>("Breaker onFailure steady_clock", kIterations));
+    printResult(measureBreakerFailure<galay::utils::TscClock>("Breaker onFailure TscClock", kIterations));
+    printResult(measureBreakerFailure<galay::utils::CachedClock>("Breaker onFailure CachedClock", kIterations));
+
+    printResult(measureTtlCache<std::chrono::steady_clock>("LruCache TTL peek steady_clock", kIterations));
+    printResult(measureTtlCache<galay::utils::TscClock>("LruCache TTL peek TscClock", kIterations));
+    printResult(measureTtlCache<galay::utils::CoarseClock>("LruCache TTL peek CoarseClock", kIterations));
+    printResult(measureTtlCache<galay::utils::CachedClock>("LruCache TTL peek CachedClock", kIterations));
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "galay-utils/encoding/base32.hpp"
+#include "galay-utils/encoding/hex.hpp"
+#include "galay-utils/encoding/z85.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t inputSize;
+    double nsPerOp;
+    double gbPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t inputSize, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double gbPerSec = static_cast<double>(inputSize) / nsPerOp;
+    return Result{std::move(name), inputSize, nsPerOp, gbPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(24) << result.name
+              << std::right << std::setw(12) << result.inputSize
+              << std::setw(14) << std::fixed << std::setprecision(2) << result.nsPerOp
+              << std::setw(10) << std::fixed << std::setprecision(3) << result.gbPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+// 逐字符追加的旧式十六进制编码，作为改造前的对照
+std::string legacyHex(const std::uint8_t* data, std::size_t length) {
+    static const char hexChars[] = "0123456789abcdef";
+    std::string result;
+    result.reserve(length * 2);
+    for (std::size_t i = 0; i < length; ++i) {
+        result.push_back(hexChars[data[i] >> 4]);
+        result.push_back(hexChars[data[i] & 0x0F]);
+    }
+    return result;
+}
+
+} // namespace
+
+int main() {
+    using galay::utils::Base32Codec;
+    using galay::utils::HexCodec;
+    using galay::utils::Z85Codec;
+    namespace detail = galay::utils::detail;
+
+    constexpr std::size_t bytesPerCase = 64 * 1024 * 1024;
+
+    std::vector<std::uint8_t> input(1024 * 1024);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<std::uint8_t>(i * 131 + 17);
+    }
+
+    std::cout << "Codec benchmark (hex / Base32 / Z85)\n";
+    std::cout << "Build with -O3 -DNDEBUG. Bytes per case=" << bytesPerCase
+              << ", backend=" << static_cast<int>(HexCodec::backend())
+              << " (0=Scalar 1=SSSE3 2=AVX2 3=NEON)\n";
+    std::cout << std::left << std::setw(24) << "Scenario"
+              << std::right << std::setw(12) << "bytes"
+              << std::setw(14) << "ns/op"
+              << std::setw(10) << "GB/s" << '\n';
+
+    // 16B / 32B 对应 MD5 / SHA-256 摘要与 trace ID
+    for (std::size_t size : {std::size_t{16}, std::size_t{32}, std::size_t{4 * 1024}, input.size()}) {
+        const std::size_t iterations = std::max<std::size_t>(1, bytesPerCase / size);
+        const std::span<const std::uint8_t> bytes(input.data(), size);
+        const std::string text = HexCodec::encode(bytes);
+        std::string encoded(text.size(), '\0');
+        std::vector<std::uint8_t> decoded(size);
+
+        printResult(measure("hex legacy push_back", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(legacyHex(bytes.data(), size)[size]);
+        }));
+        printResult(measure("hex encode scalar", size, iterations, [&]() {
+            detail::hexEncodeScalar(bytes.data(), size, encoded.data(), false);
+            return static_cast<std::uint64_t>(encoded[size]);
+        }));
+        printResult(measure("hex encodeInto", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(HexCodec::encodeInto(bytes, encoded).length);
+        }));
+        printResult(measure("hex encode string", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(HexCodec::encode(bytes)[size]);
+        }));
+        printResult(measure("hex decode scalar", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(detail::hexDecodeScalar(text.data(), size, decoded.data()));
+        }));
+        printResult(measure("hex decodeInto", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(HexCodec::decodeInto(text, decoded).length);
+        }));
+    }
+
+    for (std::size_t size : {std::size_t{20}, std::size_t{4 * 1024}, input.size()}) {
+        const std::size_t iterations = std::max<std::size_t>(1, bytesPerCase / size);
+        const std::span<const std::uint8_t> bytes(input.data(), size);
+        const std::string base32 = Base32Codec::encode(bytes);
+        const std::string z85 = Z85Codec::encode(bytes);
+        std::string encoded(base32.size(), '\0');
+        std::vector<std::uint8_t> decoded(size);
+
+        printResult(measure("base32 encodeInto", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(Base32Codec::encodeInto(bytes, encoded).length);
+        }));
+        printResult(measure("base32 decodeInto", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(Base32Codec::decodeInto(base32, decoded).length);
+        }));
+        printResult(measure("z85 encodeInto", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(Z85Codec::encodeInto(bytes, encoded).length);
+        }));
+        printResult(measure("z85 decodeInto", size, iterations, [&]() {
+            return static_cast<std::uint64_t>(Z85Codec::decodeInto(z85, decoded).length);
+        }));
+    }
+
+    return static_cast<int>(g_sink == static_cast<std::uint64_t>(-1));
+}
@@ -0,0 +1,265 @@
+#include "galay-utils/config/config_watcher.hpp"
+#include "galay-utils/config/parser_manager.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t inputSize;
+    double msPerOp;
+    double mbPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t inputSize, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double msPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations) / 1'000'000.0;
+    const double mbPerSec = static_cast<double>(inputSize) / (msPerOp * 1000.0);
+    return Result{std::move(name), inputSize, msPerOp, mbPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(32) << result.name
+              << std::right << std::setw(12) << result.inputSize
+              << std::setw(12) << std::fixed << std::setprecision(2) << result.msPerOp
+              << std::setw(10) << std::fixed << std::setprecision(1) << result.mbPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+void printReads(const Result& result) {
+    std::cout << std::left << std::setw(32) << result.name
+              << std::right << std::setw(12) << "-"
+              << std::setw(12) << std::fixed << std::setprecision(2) << result.msPerOp * 1'000'000.0
+              << " ns/op" << "  checksum=" << result.checksum << '\n';
+}
+
+// 生成器产出的典型配置：分节 + 数字 / 布尔 / 带引号字符串，少量值含转义
+std::string makeConf(std::size_t sections, std::size_t keysPerSection) {
+    std::string text;
+    text.reserve(sections * keysPerSection * 40);
+    for (std::size_t s = 0; s < sections; ++s) {
+        text += "[upstream_" + std::to_string(s) + "]\n";
+        text += "# generated\n";
+        for (std::size_t k = 0; k < keysPerSection; ++k) {
+            text += "key_" + std::to_string(k) + " = ";
+            switch (k % 4) {
+                case 0: text += std::to_string(s * 1000 + k); break;
+                case 1: text += "true"; break;
+                case 2: text += "\"host-" + std::to_string(k) + ".internal\""; break;
+                default: text += "\"line\\twith\\nescapes\""; break;
+            }
+            text += '\n';
+        }
+    }
+    return text;
+}
+
+std::string makeEnv(std::size_t keys) {
+    std::string text;
+    text.reserve(keys * 32);
+    for (std::size_t k = 0; k < keys; ++k) {
+        text += (k % 3 == 0) ? "export " : "";
+        text += "SERVICE_KEY_" + std::to_string(k) + "=\"value-" + std::to_string(k) + "\"\n";
+    }
+    return text;
+}
+
+std::string makeToml(std::size_t sections, std::size_t keysPerSection) {
+    std::string text;
+    text.reserve(sections * keysPerSection * 40);
+    for (std::size_t s = 0; s < sections; ++s) {
+        text += "[upstream_" + std::to_string(s) + "]\n";
+        for (std::size_t k = 0; k < keysPerSection; ++k) {
+            text += "key_" + std::to_string(k) + " = ";
+            switch (k % 4) {
+                case 0: text += std::to_string(s * 1000 + k); break;
+                case 1: text += "true"; break;
+                case 2: text += "\"host-" + std::to_string(k) + ".internal\" # comment"; break;
+                default: text += "[1, 2, 3]"; break;
+            }
+            text += '\n';
+        }
+    }
+    return text;
+}
+
+// 改造前的 ConfigParser 做法：istringstream + getline，每行 trim / substr 产生多个临时字符串
+std::unordered_map<std::string, std::string> legacyParseConf(const std::string& content) {
+    using galay::utils::parser_detail::trim;
+    using galay::utils::parser_detail::unquote;
+    std::unordered_map<std::string, std::string> values;
+    std::string current_section;
+    std::istringstream input(content);
+    std::string line;
+    while (std::getline(input, line)) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';') {
+            continue;
+        }
+        if (line[0] == '[' && line.back() == ']') {
+            current_section = trim(line.substr(1, line.length() - 2));
+            continue;
+        }
+        auto equal_pos = line.find('=');
+        if (equal_pos == std::string::npos) {
+            break;
+        }
+        std::string key = trim(line.substr(0, equal_pos));
+        std::string value = unquote(trim(line.substr(equal_pos + 1)));
+        values[current_section.empty() ? key : current_section + "." + key] = value;
+    }
+    return values;
+}
+
+std::string legacyReadFile(const std::string& path) {
+    std::ifstream file(path);
+    std::ostringstream output;
+    output << file.rdbuf();
+    return output.str();
+}
+
+} // namespace
+
+int main() {
+    using namespace galay::utils;
+
+    std::cout << std::left << std::setw(32) << "case"
+              << std::right << std::setw(12) << "bytes"
+              << std::setw(12) << "ms/parse"
+              << std::setw(10) << "MB/s" << '\n';
+
+    const std::string conf = makeConf(2'000, 100);
+    const std::string env = makeEnv(200'000);
+    const std::string toml = makeToml(200, 100);
+
+    printResult(measure("legacy getline parse 200k keys", conf.size(), 10, [&conf](std::size_t) {
+        auto values = legacyParseConf(conf);
+        return static_cast<std::uint64_t>(std::stoi(values["upstream_1999.key_96"]));
+    }));
+    printResult(measure("ConfigParser 200k keys", conf.size(), 10, [&conf](std::size_t) {
+        ConfigParser parser;
+        parser.parseString(conf);
+        return static_cast<std::uint64_t>(parser.getValueAs<int>("upstream_1999.key_96", 0));
+    }));
+
+    const std::string confPath = "/tmp/galay_config_benchmark.conf";
+    {
+        std::ofstream out(confPath, std::ios::binary);
+        out << conf;
+    }
+    printResult(measure("legacy ifstream + getline 200k", conf.size(), 10, [&confPath](std::size_t) {
+        auto values = legacyParseConf(legacyReadFile(confPath));
+        return static_cast<std::uint64_t>(std::stoi(values["upstream_1999.key_96"]));
+    }));
+    printResult(measure("ConfigParser::parseFile 200k", conf.size(), 10, [&confPath](std::size_t) {
+        ConfigParser parser;
+        parser.parseFile(confPath);
+        return static_cast<std::uint64_t>(parser.getValueAs<int>("upstream_1999.key_96", 0));
+    }));
+    std::remove(confPath.c_str());
+
+    printResult(measure("EnvParser 200k keys", env.size(), 10, [&env](std::size_t) {
+        EnvParser parser;
+        parser.parseString(env);
+        return static_cast<std::uint64_t>(parser.getValue("SERVICE_KEY_199999").value_or("").size());
+    }));
+
+    printResult(measure("TomlParser 20k keys", toml.size(), 5, [&toml](std::size_t) {
+        TomlParser parser;
+        parser.parseString(toml);
+        return static_cast<std::uint64_t>(parser.getValueAs<int>("upstream_199.key_96", 0));
+    }));
+
+    printResult(measure("TomlDocument 20k keys", toml.size(), 5, [&toml](std::size_t) {
+        TomlDocument doc;
+        doc.parseString(toml);
+        return static_cast<std::uint64_t>(doc.at("upstream_199.key_96").valueOr<int64_t>(0));
+    }));
+    {
+        TomlDocument doc;
+        doc.parseString(toml);
+        constexpr std::size_t kReads = 5'000'000;
+        printReads(measure("TomlDocument at(path)", 0, kReads, [&doc](std::size_t) {
+            return static_cast<std::uint64_t>(doc.at("upstream_42.key_0").valueOr<int64_t>(0));
+        }));
+        const TomlView section = doc["upstream_42"];
+        const InternedString key = doc.findKey("key_0");
+        printReads(measure("TomlView[InternedString]", 0, kReads, [&section, &key](std::size_t) {
+            return static_cast<std::uint64_t>(section[key].valueOr<int64_t>(0));
+        }));
+    }
+
+    // 热路径读取：同一批特性开关反复读取
+    {
+        ConfigParser parser;
+        parser.parseString(conf);
+        constexpr std::size_t kReads = 5'000'000;
+        printReads(measure("getValueAs<bool> by name", 0, kReads, [&parser](std::size_t) {
+            return static_cast<std::uint64_t>(parser.getValueAs<bool>("upstream_42.key_1", false));
+        }));
+        printReads(measure("getValueAs<int> by name", 0, kReads, [&parser](std::size_t) {
+            return static_cast<std::uint64_t>(parser.getValueAs<int>("upstream_42.key_0", 0));
+        }));
+
+        printResult(measure("TypedConfig load 200k keys", conf.size(), 5, [&parser](std::size_t) {
+            TypedConfig config(parser);
+            return static_cast<std::uint64_t>(config.size());
+        }));
+        TypedConfig config(parser);
+        const auto flag = config.key<bool>("upstream_42.key_1");
+        const auto limit = config.key<int>("upstream_42.key_0");
+        printReads(measure("TypedConfig get(ConfigKey<bool>)", 0, kReads, [&config, &flag](std::size_t) {
+            return static_cast<std::uint64_t>(config.get(flag));
+        }));
+        printReads(measure("TypedConfig get(ConfigKey<int>)", 0, kReads, [&config, &limit](std::size_t) {
+            return static_cast<std::uint64_t>(config.get(limit));
+        }));
+    }
+
+    // 热更新读取路径：快照原子加载 vs 版本号缓存的 ConfigReader
+    {
+        const std::string watchPath = "/tmp/galay_config_benchmark_watch.conf";
+        {
+            std::ofstream out(watchPath, std::ios::binary);
+            out << makeConf(20, 100);
+        }
+        ConfigWatcher watcher(watchPath);
+        watcher.start();
+        const auto flag = watcher.key<bool>("upstream_7.key_1");
+        auto reader = watcher.reader();
+        constexpr std::size_t kReads = 5'000'000;
+        printReads(measure("ConfigWatcher snapshot()->get", 0, kReads, [&watcher, &flag](std::size_t) {
+            return static_cast<std::uint64_t>(watcher.snapshot()->values.get(flag));
+        }));
+        printReads(measure("ConfigReader get(ConfigKey)", 0, kReads, [&reader, &flag](std::size_t) {
+            return static_cast<std::uint64_t>(reader.get(flag));
+        }));
+        watcher.stop();
+        std::remove(watchPath.c_str());
+    }
+
+    return 0;
+}
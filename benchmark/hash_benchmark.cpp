@@ -0,0 +1,108 @@
+#include "galay-utils/crypto/murmur_hash3.hpp"
+#include "galay-utils/crypto/xxhash3.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t inputSize;
+    double nsPerOp;
+    double gbPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t inputSize, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double gbPerSec = static_cast<double>(inputSize) / nsPerOp;
+    return Result{std::move(name), inputSize, nsPerOp, gbPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(24) << result.name
+              << std::right << std::setw(12) << result.inputSize
+              << std::setw(14) << std::fixed << std::setprecision(2) << result.nsPerOp
+              << std::setw(10) << std::fixed << std::setprecision(3) << result.gbPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+const char* backendName(galay::utils::XXH3Backend backend) {
+    switch (backend) {
+        case galay::utils::XXH3Backend::Scalar: return "scalar";
+        case galay::utils::XXH3Backend::Avx2: return "avx2";
+        case galay::utils::XXH3Backend::Neon: return "neon";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+int main() {
+    using galay::utils::MurmurHash3Util;
+    using galay::utils::XXH3;
+
+    constexpr std::size_t bytesPerCase = 256 * 1024 * 1024;
+    const std::vector<std::size_t> sizes = {8, 16, 32, 64, 128, 256, 1024, 4096, 65536, 1048576};
+
+    std::vector<std::uint8_t> input(sizes.back() + 64);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<std::uint8_t>(i * 131 + 17);
+    }
+
+    std::cout << "Hash benchmark\n";
+    std::cout << "Build with -O3 -DNDEBUG. Bytes per case=" << bytesPerCase
+              << ", xxh3 backend=" << backendName(XXH3::backend()) << '\n';
+    std::cout << std::left << std::setw(24) << "Scenario"
+              << std::right << std::setw(12) << "bytes"
+              << std::setw(14) << "ns/op"
+              << std::setw(10) << "GB/s" << '\n';
+
+    for (std::size_t size : sizes) {
+        const std::size_t iterations = std::max<std::size_t>(16, std::min<std::size_t>(bytesPerCase / size, 20000000));
+        // 每次错开 1 字节，避免编译器把同一输入的结果提到循环外
+        printResult(measure("murmur3 Hash32", size, iterations, [&](std::size_t i) {
+            return MurmurHash3Util::Hash32(input.data() + (i & 63), size);
+        }));
+        printResult(measure("murmur3 Hash128Raw", size, iterations, [&](std::size_t i) {
+            return MurmurHash3Util::Hash128Raw(input.data() + (i & 63), size)[0];
+        }));
+        printResult(measure("xxh3 hash64", size, iterations, [&](std::size_t i) {
+            return XXH3::hash64(input.data() + (i & 63), size);
+        }));
+        printResult(measure("xxh3 hash128", size, iterations, [&](std::size_t i) {
+            return XXH3::hash128(input.data() + (i & 63), size).low;
+        }));
+    }
+
+    // 流式 4KB 分片
+    const std::size_t chunk = 4096;
+    printResult(measure("xxh3 stream 4KB chunks", sizes.back(), 256, [&](std::size_t) {
+        XXH3::State state;
+        for (std::size_t offset = 0; offset < sizes.back(); offset += chunk) {
+            state.update(input.data() + offset, chunk);
+        }
+        return state.digest64();
+    }));
+
+    return static_cast<int>(g_sink == static_cast<std::uint64_t>(-1));
+}
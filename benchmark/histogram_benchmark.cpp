@@ -0,0 +1,262 @@
+#include "galay-utils/core/clock.hpp"
+#include "galay-utils/core/histogram.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    double nsPerOp;
+    double mopsPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double seconds = static_cast<double>(elapsedNs) / 1'000'000'000.0;
+    const double mopsPerSec = (static_cast<double>(iterations) / seconds) / 1'000'000.0;
+    return Result{std::move(name), nsPerOp, mopsPerSec, checksum};
+}
+
+// 多线程版本：每个线程执行 iterations 次，ns/op 以总操作数折算墙钟时间
+template<typename Fn>
+Result measureThreads(std::string name, std::size_t threads, std::size_t iterations, Fn&& fn) {
+    std::atomic<bool> go{false};
+    std::atomic<std::uint64_t> checksum{0};
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            std::uint64_t local = 0;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                local += fn(t, i);
+            }
+            checksum.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const std::size_t total = threads * iterations;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(total);
+    const double seconds = static_cast<double>(elapsedNs) / 1'000'000'000.0;
+    const double mopsPerSec = (static_cast<double>(total) / seconds) / 1'000'000.0;
+    return Result{std::move(name), nsPerOp, mopsPerSec, checksum.load()};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(40) << result.name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2)
+              << result.nsPerOp
+              << std::setw(14) << std::fixed << std::setprecision(2)
+              << result.mopsPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+void printLatency(const std::string& name, const galay::utils::HistogramSummary& summary) {
+    std::cout << std::left << std::setw(40) << name
+              << std::right << " n=" << summary.count
+              << " mean=" << std::fixed << std::setprecision(1) << summary.mean
+              << " p50=" << summary.p50
+              << " p99=" << summary.p99
+              << " p999=" << summary.p999
+              << " max=" << summary.max << " (ns)\n";
+}
+
+// 模拟请求耗时：大多数在几百纳秒，少量长尾
+std::uint64_t sampleValue(std::size_t i) {
+    const std::uint64_t mixed = static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ull;
+    const std::uint64_t base = 200 + ((mixed >> 40) & 1023);
+    return (mixed >> 60) == 0 ? base * 64 : base;
+}
+
+// 改造前的常见做法：收集到 vector，结束后排序取百分位
+struct LockedVector {
+    std::mutex mutex;
+    std::vector<std::uint64_t> samples;
+
+    void record(std::uint64_t value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        samples.push_back(value);
+    }
+};
+
+// 共享桶数组 + fetch_add：单一实例，无线程分片
+struct SharedAtomicHistogram {
+    galay::utils::detail::HistogramLayout layout{galay::utils::Histogram::kDefaultHighestTrackableValue,
+                                                 galay::utils::Histogram::kDefaultPrecisionBits};
+    std::unique_ptr<std::atomic<std::uint64_t>[]> buckets =
+        std::make_unique<std::atomic<std::uint64_t>[]>(layout.bucketCount());
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> sum{0};
+
+    void record(std::uint64_t value) {
+        buckets[layout.indexOf(value)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+    }
+};
+
+Result measureSortPercentiles(std::size_t samples) {
+    std::vector<std::uint64_t> values(samples);
+    for (std::size_t i = 0; i < samples; ++i) {
+        values[i] = sampleValue(i);
+    }
+    return measure("vector sort + p50/p99/p999 (5M)", 1, [&values](std::size_t) {
+        std::vector<std::uint64_t> copy = values;
+        std::sort(copy.begin(), copy.end());
+        return copy[copy.size() / 2] + copy[copy.size() * 99 / 100] + copy[copy.size() * 999 / 1000];
+    });
+}
+
+Result measureSnapshotPercentiles(std::size_t samples) {
+    galay::utils::Histogram histogram;
+    for (std::size_t i = 0; i < samples; ++i) {
+        histogram.record(sampleValue(i));
+    }
+    return measure("Histogram snapshot + summary (5M)", 1, [&histogram](std::size_t) {
+        const auto summary = histogram.summary();
+        return summary.p50 + summary.p99 + summary.p999;
+    });
+}
+
+} // namespace
+
+int main() {
+    constexpr std::size_t kIterations = 20'000'000;
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kThreadIterations = 5'000'000;
+
+    galay::utils::TscClock::calibrate();
+
+    std::cout << std::left << std::setw(40) << "case"
+              << std::right << std::setw(12) << "ns/op"
+              << std::setw(14) << "Mops/s" << '\n';
+
+    {
+        std::vector<std::uint64_t> samples;
+        samples.reserve(kIterations);
+        printResult(measure("vector push_back (reserved)", kIterations, [&samples](std::size_t i) {
+            samples.push_back(sampleValue(i));
+            return std::uint64_t{1};
+        }));
+    }
+    {
+        LockedVector locked;
+        locked.samples.reserve(kIterations);
+        printResult(measure("mutex + vector push_back", kIterations, [&locked](std::size_t i) {
+            locked.record(sampleValue(i));
+            return std::uint64_t{1};
+        }));
+    }
+    {
+        SharedAtomicHistogram shared;
+        printResult(measure("shared buckets fetch_add", kIterations, [&shared](std::size_t i) {
+            shared.record(sampleValue(i));
+            return std::uint64_t{1};
+        }));
+    }
+    {
+        galay::utils::Histogram histogram;
+        printResult(measure("Histogram::record", kIterations, [&histogram](std::size_t i) {
+            histogram.record(sampleValue(i));
+            return std::uint64_t{1};
+        }));
+    }
+
+    {
+        LockedVector locked;
+        locked.samples.reserve(kThreads * kThreadIterations);
+        printResult(measureThreads("4 threads mutex + vector", kThreads, kThreadIterations,
+                                   [&locked](std::size_t, std::size_t i) {
+            locked.record(sampleValue(i));
+            return std::uint64_t{1};
+        }));
+    }
+    {
+        SharedAtomicHistogram shared;
+        printResult(measureThreads("4 threads shared buckets fetch_add", kThreads, kThreadIterations,
+                                   [&shared](std::size_t, std::size_t i) {
+            shared.record(sampleValue(i));
+            return std::uint64_t{1};
+        }));
+    }
+    {
+        galay::utils::Histogram histogram;
+        printResult(measureThreads("4 threads Histogram::record", kThreads, kThreadIterations,
+                                   [&histogram](std::size_t, std::size_t i) {
+            histogram.record(sampleValue(i));
+            return std::uint64_t{1};
+        }));
+    }
+
+    {
+        galay::utils::Histogram histogram;
+        printResult(measure("ScopedTimer<steady_clock>", kIterations, [&histogram](std::size_t i) {
+            galay::utils::ScopedTimer<std::chrono::steady_clock> timer(histogram);
+            return static_cast<std::uint64_t>(i & 1);
+        }));
+    }
+    {
+        galay::utils::Histogram histogram;
+        printResult(measure("ScopedTimer<TscClock>", kIterations, [&histogram](std::size_t i) {
+            galay::utils::ScopedTimer<galay::utils::TscClock> timer(histogram);
+            return static_cast<std::uint64_t>(i & 1);
+        }));
+    }
+
+    printResult(measureSortPercentiles(kIterations / 4));
+    printResult(measureSnapshotPercentiles(kIterations / 4));
+
+    // 统一的延迟分布输出：逐次计时一个 unordered_map 查找
+    {
+        std::unordered_map<std::uint64_t, std::uint64_t> map;
+        for (std::uint64_t key = 0; key < (1u << 20); ++key) {
+            map.emplace(key * 0x9E3779B97F4A7C15ull, key);
+        }
+        galay::utils::Histogram latency;
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i < 1'000'000; ++i) {
+            galay::utils::ScopedTimer<galay::utils::TscClock> timer(latency);
+            const auto it = map.find(static_cast<std::uint64_t>(sampleValue(i) & ((1u << 20) - 1)) * 0x9E3779B97F4A7C15ull);
+            checksum += it == map.end() ? 0 : it->second;
+        }
+        g_sink = checksum;
+        printLatency("unordered_map find (1M keys) latency", latency.summary());
+    }
+
+    return 0;
+}
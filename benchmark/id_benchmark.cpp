@@ -0,0 +1,117 @@
+#include "galay-utils/core/id.hpp"
+#include "galay-utils/core/random.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t inputSize;
+    double nsPerOp;
+    double gbPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t inputSize, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double gbPerSec = static_cast<double>(inputSize) / nsPerOp;
+    return Result{std::move(name), inputSize, nsPerOp, gbPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(28) << result.name
+              << std::right << std::setw(12) << result.inputSize
+              << std::setw(14) << std::fixed << std::setprecision(2) << result.nsPerOp
+              << std::setw(10) << std::fixed << std::setprecision(3) << result.gbPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+} // namespace
+
+int main() {
+    using galay::utils::IdGenerator;
+    using galay::utils::RandomGenerator;
+    using galay::utils::SnowflakeGenerator;
+    using galay::utils::Ulid;
+    using galay::utils::Uuid;
+
+    constexpr std::size_t iterations = 5000000;
+
+    std::cout << "ID benchmark\n";
+    std::cout << "Build with -O3 -DNDEBUG. Iterations per case=" << iterations << '\n';
+    std::cout << std::left << std::setw(28) << "Scenario"
+              << std::right << std::setw(12) << "bytes"
+              << std::setw(14) << "ns/op"
+              << std::setw(10) << "GB/s" << '\n';
+
+    RandomGenerator random(12345);
+    printResult(measure("RandomGenerator::uuid v4", 36, iterations, [&]() {
+        return static_cast<std::uint64_t>(random.uuid()[0]);
+    }));
+    printResult(measure("uuidV7 binary", 16, iterations, [&]() {
+        return static_cast<std::uint64_t>(IdGenerator::uuidV7().bytes[15]);
+    }));
+    std::array<char, Uuid::kStringLength> uuidText{};
+    printResult(measure("uuidV7 formatTo", 36, iterations, [&]() {
+        IdGenerator::uuidV7().formatTo(uuidText);
+        return static_cast<std::uint64_t>(uuidText[35]);
+    }));
+    printResult(measure("uuidV7 toString", 36, iterations, [&]() {
+        return static_cast<std::uint64_t>(IdGenerator::uuidV7().toString()[35]);
+    }));
+    printResult(measure("ulid binary", 16, iterations, [&]() {
+        return static_cast<std::uint64_t>(IdGenerator::ulid().bytes[15]);
+    }));
+    std::array<char, Ulid::kStringLength> ulidText{};
+    printResult(measure("ulid formatTo", 26, iterations, [&]() {
+        IdGenerator::ulid().formatTo(ulidText);
+        return static_cast<std::uint64_t>(ulidText[25]);
+    }));
+    SnowflakeGenerator snowflake(1);
+    printResult(measure("snowflake next", 8, iterations, [&]() {
+        return snowflake.next();
+    }));
+
+    // 写入局部性：按生成顺序插入时，相邻 ID 已有序的比例（B-tree 右侧追加的近似）
+    constexpr std::size_t sampleSize = 100000;
+    std::vector<std::string> v4;
+    std::vector<Uuid> v7;
+    v4.reserve(sampleSize);
+    v7.reserve(sampleSize);
+    for (std::size_t i = 0; i < sampleSize; ++i) {
+        v4.push_back(random.uuid());
+        v7.push_back(IdGenerator::uuidV7());
+    }
+    std::size_t v4Sorted = 0;
+    std::size_t v7Sorted = 0;
+    for (std::size_t i = 1; i < sampleSize; ++i) {
+        v4Sorted += v4[i] > v4[i - 1];
+        v7Sorted += v7[i] > v7[i - 1];
+    }
+    std::cout << "append-ordered ratio: uuid v4=" << std::fixed << std::setprecision(3)
+              << static_cast<double>(v4Sorted) / (sampleSize - 1)
+              << " uuid v7=" << static_cast<double>(v7Sorted) / (sampleSize - 1) << '\n';
+
+    return static_cast<int>(g_sink == static_cast<std::uint64_t>(-1));
+}
@@ -0,0 +1,187 @@
+#include "galay-utils/core/interner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t inputSize;
+    double nsPerOp;
+    double gbPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t inputSize, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double gbPerSec = static_cast<double>(inputSize) / nsPerOp;
+    return Result{std::move(name), inputSize, nsPerOp, gbPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(32) << result.name
+              << std::right << std::setw(12) << result.inputSize
+              << std::setw(14) << std::fixed << std::setprecision(2) << result.nsPerOp
+              << std::setw(10) << std::fixed << std::setprecision(3) << result.gbPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+// 多线程并发查找同一批已存在的键，返回每次查找的平均 ns
+template<typename Fn>
+double measureConcurrent(std::size_t threads, std::size_t iterationsPerThread, Fn&& fn) {
+    std::atomic<bool> go{false};
+    std::atomic<std::uint64_t> checksum{0};
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            std::uint64_t local = 0;
+            for (std::size_t i = 0; i < iterationsPerThread; ++i) {
+                local += fn(i * threads + t);
+            }
+            checksum.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    g_sink = checksum.load();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count())
+         / static_cast<double>(iterationsPerThread);
+}
+
+} // namespace
+
+int main() {
+    using galay::utils::InternedString;
+    using galay::utils::InternedStringHash;
+    using galay::utils::StringInterner;
+    using galay::utils::Symbol;
+    using galay::utils::SymbolHash;
+
+    constexpr std::size_t keyCount = 100000;
+    constexpr std::size_t iterations = 5000000;
+
+    std::vector<std::string> keys;
+    keys.reserve(keyCount);
+    for (std::size_t i = 0; i < keyCount; ++i) {
+        keys.push_back("/api/v1/service-" + std::to_string(i % 97) + "/resource/" + std::to_string(i));
+    }
+    std::size_t totalBytes = 0;
+    for (const auto& key : keys) {
+        totalBytes += key.size();
+    }
+    const std::size_t avgKey = totalBytes / keyCount;
+
+    std::cout << "StringInterner benchmark\n";
+    std::cout << "Build with -O3 -DNDEBUG. Keys=" << keyCount << ", average key bytes=" << avgKey << '\n';
+    std::cout << std::left << std::setw(32) << "Scenario"
+              << std::right << std::setw(12) << "bytes"
+              << std::setw(14) << "ns/op"
+              << std::setw(10) << "GB/s" << '\n';
+
+    // 首次驻留（含写锁、arena 分配与扩容）
+    StringInterner interner(16);
+    printResult(measure("intern (insert)", avgKey, keyCount, [&](std::size_t i) {
+        return static_cast<std::uint64_t>(interner.intern(keys[i]).symbol().id());
+    }));
+
+    // 已存在键：无锁查找 vs 字符串键 unordered_map
+    std::unordered_map<std::string, std::uint32_t> stringMap;
+    for (std::size_t i = 0; i < keyCount; ++i) {
+        stringMap.emplace(keys[i], static_cast<std::uint32_t>(i));
+    }
+    std::mutex mapMutex;
+    printResult(measure("unordered_map<string> find", avgKey, iterations, [&](std::size_t i) {
+        return static_cast<std::uint64_t>(stringMap.find(keys[i % keyCount])->second);
+    }));
+    printResult(measure("mutex + unordered_map find", avgKey, iterations, [&](std::size_t i) {
+        std::lock_guard<std::mutex> lock(mapMutex);
+        return static_cast<std::uint64_t>(stringMap.find(keys[i % keyCount])->second);
+    }));
+    printResult(measure("intern (existing)", avgKey, iterations, [&](std::size_t i) {
+        return static_cast<std::uint64_t>(interner.intern(keys[i % keyCount]).symbol().id());
+    }));
+    std::vector<std::uint64_t> hashes;
+    hashes.reserve(keyCount);
+    for (const auto& key : keys) {
+        hashes.push_back(StringInterner::hashOf(key));
+    }
+    printResult(measure("find (precomputed hash)", avgKey, iterations, [&](std::size_t i) {
+        return static_cast<std::uint64_t>(interner.find(keys[i % keyCount], hashes[i % keyCount]).symbol().id());
+    }));
+    printResult(measure("resolve(Symbol)", avgKey, iterations, [&](std::size_t i) {
+        return static_cast<std::uint64_t>(interner.view(Symbol(static_cast<std::uint32_t>(i % keyCount + 1))).size());
+    }));
+
+    // 容器以符号为键：哈希与比较都不再触碰字符串内容
+    std::unordered_map<Symbol, std::uint32_t, SymbolHash> symbolMap;
+    std::unordered_map<InternedString, std::uint32_t, InternedStringHash> handleMap;
+    std::vector<InternedString> handles;
+    for (std::size_t i = 0; i < keyCount; ++i) {
+        const InternedString handle = interner.intern(keys[i]);
+        handles.push_back(handle);
+        symbolMap.emplace(handle.symbol(), static_cast<std::uint32_t>(i));
+        handleMap.emplace(handle, static_cast<std::uint32_t>(i));
+    }
+    printResult(measure("unordered_map<Symbol> find", 4, iterations, [&](std::size_t i) {
+        return static_cast<std::uint64_t>(symbolMap.find(handles[i % keyCount].symbol())->second);
+    }));
+    printResult(measure("unordered_map<Interned> find", 8, iterations, [&](std::size_t i) {
+        return static_cast<std::uint64_t>(handleMap.find(handles[i % keyCount])->second);
+    }));
+
+    // 并发读：已存在键的无锁查找 vs 全局 mutex 保护的 unordered_map
+    const std::size_t threadCount = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+    const std::size_t perThread = iterations / threadCount;
+    const double mutexNs = measureConcurrent(threadCount, perThread, [&](std::size_t i) {
+        std::lock_guard<std::mutex> lock(mapMutex);
+        return static_cast<std::uint64_t>(stringMap.find(keys[i % keyCount])->second);
+    });
+    const double internNs = measureConcurrent(threadCount, perThread, [&](std::size_t i) {
+        return static_cast<std::uint64_t>(interner.intern(keys[i % keyCount]).symbol().id());
+    });
+    std::cout << "concurrent lookups, threads=" << threadCount
+              << ": mutex map " << std::fixed << std::setprecision(2) << mutexNs << " ns/op per thread"
+              << ", interner " << internNs << " ns/op per thread\n";
+
+    // 内存：重复字符串拷贝 vs 驻留后只保存 4 字节 Symbol
+    constexpr std::size_t duplicates = 8;
+    std::size_t copiedBytes = 0;
+    for (const auto& key : keys) {
+        copiedBytes += duplicates * (sizeof(std::string) + (key.size() > 15 ? key.size() + 1 : 0));
+    }
+    const std::size_t internedBytes = interner.arenaBytes() + duplicates * keyCount * sizeof(Symbol);
+    std::cout << "memory for " << duplicates << " copies of each key: std::string " << copiedBytes
+              << " bytes, interned " << internedBytes << " bytes (arena + symbols)\n";
+
+    return static_cast<int>(g_sink == static_cast<std::uint64_t>(-1));
+}
@@ -0,0 +1,166 @@
+#include "galay-utils/core/metrics.hpp"
+#include "galay-utils/tool/component_metrics.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    double nsPerOp;
+    double mopsPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double seconds = static_cast<double>(elapsedNs) / 1'000'000'000.0;
+    const double mopsPerSec = (static_cast<double>(iterations) / seconds) / 1'000'000.0;
+    return Result{std::move(name), nsPerOp, mopsPerSec, checksum};
+}
+
+// 多线程版本：每个线程执行 iterations 次，ns/op 以总操作数折算墙钟时间
+template<typename Fn>
+Result measureThreads(std::string name, std::size_t threads, std::size_t iterations, Fn&& fn) {
+    std::atomic<bool> go{false};
+    std::atomic<std::uint64_t> checksum{0};
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            std::uint64_t local = 0;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                local += fn(i);
+            }
+            checksum.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const std::size_t total = threads * iterations;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(total);
+    const double seconds = static_cast<double>(elapsedNs) / 1'000'000'000.0;
+    const double mopsPerSec = (static_cast<double>(total) / seconds) / 1'000'000.0;
+    return Result{std::move(name), nsPerOp, mopsPerSec, checksum.load()};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(40) << result.name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2)
+              << result.nsPerOp
+              << std::setw(14) << std::fixed << std::setprecision(2)
+              << result.mopsPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+} // namespace
+
+int main() {
+    constexpr std::size_t kIterations = 50'000'000;
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kThreadIterations = 10'000'000;
+
+    std::cout << "stripes=" << galay::utils::detail::metricStripeCount()
+              << " hardware_concurrency=" << std::thread::hardware_concurrency() << '\n';
+    std::cout << std::left << std::setw(40) << "case"
+              << std::right << std::setw(12) << "ns/op"
+              << std::setw(14) << "Mops/s" << '\n';
+
+    // 改造前的常见做法：单个共享原子计数器
+    {
+        alignas(64) std::atomic<std::uint64_t> shared{0};
+        printResult(measure("shared atomic fetch_add", kIterations, [&shared](std::size_t) {
+            shared.fetch_add(1, std::memory_order_relaxed);
+            return std::uint64_t{1};
+        }));
+        shared.store(0);
+        printResult(measureThreads("4 threads shared atomic fetch_add", kThreads, kThreadIterations,
+                                   [&shared](std::size_t) {
+            shared.fetch_add(1, std::memory_order_relaxed);
+            return std::uint64_t{1};
+        }));
+    }
+    {
+        galay::utils::Counter counter;
+        printResult(measure("Counter::inc", kIterations, [&counter](std::size_t) {
+            counter.inc();
+            return std::uint64_t{1};
+        }));
+        counter.reset();
+        printResult(measureThreads("4 threads Counter::inc", kThreads, kThreadIterations,
+                                   [&counter](std::size_t) {
+            counter.inc();
+            return std::uint64_t{1};
+        }));
+        g_sink = counter.value();
+    }
+    {
+        galay::utils::Gauge gauge;
+        printResult(measure("Gauge::set", kIterations, [&gauge](std::size_t i) {
+            gauge.set(static_cast<std::int64_t>(i));
+            return std::uint64_t{1};
+        }));
+    }
+
+    // 导出开销：64 个计数器、8 个直方图、一组组件采集回调
+    {
+        galay::utils::MetricsRegistry registry("galay_");
+        for (int i = 0; i < 64; ++i) {
+            registry.counter("requests_total", "Handled requests", {{"route", "/r" + std::to_string(i)}}).inc(i);
+        }
+        for (int i = 0; i < 8; ++i) {
+            auto& histogram = registry.histogram("latency_ns", "Latency", {{"route", "/r" + std::to_string(i)}});
+            for (std::uint64_t v = 0; v < 10000; ++v) {
+                histogram.record(v * 37);
+            }
+        }
+        galay::utils::TokenBucketLimiter limiter(1000, 10);
+        galay::utils::CircuitBreaker breaker;
+        galay::utils::LruCache<int, int, std::hash<int>, std::equal_to<int>, std::chrono::steady_clock, true> cache(128);
+        auto r1 = galay::utils::registerMetrics(registry, "api", limiter);
+        auto r2 = galay::utils::registerMetrics(registry, "backend", breaker);
+        auto r3 = galay::utils::registerMetrics(registry, "sessions", cache);
+
+        printResult(measure("registry snapshot", 2'000, [&registry](std::size_t) {
+            return static_cast<std::uint64_t>(registry.snapshot().families().size());
+        }));
+        const auto snapshot = registry.snapshot();
+        printResult(measure("snapshot toPrometheus", 2'000, [&snapshot](std::size_t) {
+            return static_cast<std::uint64_t>(snapshot.toPrometheus().size());
+        }));
+        printResult(measure("snapshot toJson", 2'000, [&snapshot](std::size_t) {
+            return static_cast<std::uint64_t>(snapshot.toJson().size());
+        }));
+    }
+
+    return 0;
+}
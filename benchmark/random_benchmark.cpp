@@ -0,0 +1,162 @@
+#include "galay-utils/core/random.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t inputSize;
+    double nsPerOp;
+    double gbPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t inputSize, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double gbPerSec = static_cast<double>(inputSize) / nsPerOp;
+    return Result{std::move(name), inputSize, nsPerOp, gbPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(28) << result.name
+              << std::right << std::setw(12) << result.inputSize
+              << std::setw(14) << std::fixed << std::setprecision(2) << result.nsPerOp
+              << std::setw(10) << std::fixed << std::setprecision(3) << result.gbPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+// 改造前 RandomGenerator 的做法：mt19937_64 + 每字节一次 uniform_int_distribution
+struct LegacyGenerator {
+    std::mt19937_64 engine{12345};
+
+    void randomBytes(std::uint8_t* buffer, std::size_t length) {
+        std::uniform_int_distribution<int> dist(0, 255);
+        for (std::size_t i = 0; i < length; ++i) {
+            buffer[i] = static_cast<std::uint8_t>(dist(engine));
+        }
+    }
+
+    std::string randomHex(std::size_t length) {
+        static const char hexChars[] = "0123456789abcdef";
+        std::uniform_int_distribution<int> dist(0, 15);
+        std::string result(length, '\0');
+        for (std::size_t i = 0; i < length; ++i) {
+            result[i] = hexChars[dist(engine)];
+        }
+        return result;
+    }
+};
+
+// 改造前 Randomizer 的做法：全局单例 + mutex
+struct LegacySingleton {
+    std::mutex mutex;
+    LegacyGenerator generator;
+
+    int randomInt(int min, int max) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::uniform_int_distribution<int> dist(min, max);
+        return dist(generator.engine);
+    }
+};
+
+} // namespace
+
+int main() {
+    using galay::utils::RandomGenerator;
+    using galay::utils::Randomizer;
+    using galay::utils::WyRandGenerator;
+
+    constexpr std::size_t bytesPerCase = 64 * 1024 * 1024;
+    constexpr std::size_t drawIterations = 20000000;
+
+    std::cout << "Random benchmark\n";
+    std::cout << "Build with -O3 -DNDEBUG. Bytes per case=" << bytesPerCase << '\n';
+    std::cout << std::left << std::setw(28) << "Scenario"
+              << std::right << std::setw(12) << "bytes"
+              << std::setw(14) << "ns/op"
+              << std::setw(10) << "GB/s" << '\n';
+
+    LegacyGenerator legacy;
+    RandomGenerator xoshiro(12345);
+    WyRandGenerator wyrand(12345);
+
+    std::vector<std::uint8_t> buffer(64 * 1024);
+    for (std::size_t size : {std::size_t{16}, std::size_t{1024}, buffer.size()}) {
+        const std::size_t iterations = std::max<std::size_t>(1, bytesPerCase / size / (size < 64 ? 4 : 1));
+        printResult(measure("legacy randomBytes", size, std::max<std::size_t>(1, iterations / 8), [&]() {
+            legacy.randomBytes(buffer.data(), size);
+            return static_cast<std::uint64_t>(buffer[0]);
+        }));
+        printResult(measure("xoshiro256** fill", size, iterations, [&]() {
+            xoshiro.fill(std::span<std::uint8_t>(buffer.data(), size));
+            return static_cast<std::uint64_t>(buffer[0]);
+        }));
+        printResult(measure("wyrand fill", size, iterations, [&]() {
+            wyrand.fill(std::span<std::uint8_t>(buffer.data(), size));
+            return static_cast<std::uint64_t>(buffer[0]);
+        }));
+    }
+
+    const std::size_t hexIterations = 2000000;
+    printResult(measure("legacy randomHex(32)", 32, hexIterations, [&]() {
+        return static_cast<std::uint64_t>(legacy.randomHex(32)[0]);
+    }));
+    printResult(measure("randomHex(32)", 32, hexIterations, [&]() {
+        return static_cast<std::uint64_t>(xoshiro.randomHex(32)[0]);
+    }));
+    printResult(measure("uuid()", 16, hexIterations, [&]() {
+        return static_cast<std::uint64_t>(xoshiro.uuid()[14]);
+    }));
+
+    // 有界整数：标准分布 vs Lemire 近似无除法算法，上界取非 2 的幂以触发拒绝路径
+    std::uniform_int_distribution<std::uint64_t> stdDist(0, 999999);
+    printResult(measure("std::uniform_int(1e6)", 8, drawIterations, [&]() {
+        return stdDist(legacy.engine);
+    }));
+    printResult(measure("lemire uniform(1e6)", 8, drawIterations, [&]() {
+        return xoshiro.uniform(1000000);
+    }));
+    printResult(measure("raw mt19937_64", 8, drawIterations, [&]() {
+        return legacy.engine();
+    }));
+    printResult(measure("raw xoshiro256**", 8, drawIterations, [&]() {
+        return xoshiro.next();
+    }));
+    printResult(measure("raw wyrand", 8, drawIterations, [&]() {
+        return wyrand.next();
+    }));
+
+    // 单例：全局 mutex vs thread_local
+    LegacySingleton singleton;
+    printResult(measure("mutex singleton randomInt", 4, drawIterations, [&]() {
+        return static_cast<std::uint64_t>(singleton.randomInt(1, 1000));
+    }));
+    printResult(measure("thread_local randomInt", 4, drawIterations, [&]() {
+        return static_cast<std::uint64_t>(Randomizer::instance().randomInt(1, 1000));
+    }));
+
+    return static_cast<int>(g_sink == static_cast<std::uint64_t>(-1));
+}
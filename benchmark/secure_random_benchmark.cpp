@@ -0,0 +1,121 @@
+#include "galay-utils/crypto/salt.hpp"
+#include "galay-utils/crypto/secure_random.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t inputSize;
+    double nsPerOp;
+    double gbPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t inputSize, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double gbPerSec = static_cast<double>(inputSize) / nsPerOp;
+    return Result{std::move(name), inputSize, nsPerOp, gbPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(24) << result.name
+              << std::right << std::setw(12) << result.inputSize
+              << std::setw(14) << std::fixed << std::setprecision(2) << result.nsPerOp
+              << std::setw(10) << std::fixed << std::setprecision(3) << result.gbPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+// 改造前 generateSecureBytes 的做法：每次构造 random_device，逐字节取数
+void legacySecureBytes(std::uint8_t* buffer, std::size_t length) {
+    std::random_device rd;
+    for (std::size_t i = 0; i < length; ++i) {
+        buffer[i] = static_cast<std::uint8_t>(rd() & 0xFF);
+    }
+}
+
+// 改造前 generateBytes 的做法：每次构造 random_device 与 mt19937_64
+void legacyBytes(std::uint8_t* buffer, std::size_t length) {
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+    std::uniform_int_distribution<int> dis(0, 255);
+    for (std::size_t i = 0; i < length; ++i) {
+        buffer[i] = static_cast<std::uint8_t>(dis(gen));
+    }
+}
+
+} // namespace
+
+int main() {
+    using galay::utils::SaltGenerator;
+    using galay::utils::SecureRandom;
+    namespace detail = galay::utils::detail;
+
+    constexpr std::size_t bytesPerCase = 16 * 1024 * 1024;
+
+    std::cout << "SecureRandom benchmark\n";
+    std::cout << "Build with -O3 -DNDEBUG. Bytes per case=" << bytesPerCase << '\n';
+    std::cout << std::left << std::setw(24) << "Scenario"
+              << std::right << std::setw(12) << "bytes"
+              << std::setw(14) << "ns/op"
+              << std::setw(10) << "GB/s" << '\n';
+
+    std::vector<std::uint8_t> buffer(1024 * 1024);
+    for (std::size_t size : {std::size_t{16}, std::size_t{32}, std::size_t{4 * 1024}, buffer.size()}) {
+        const std::size_t iterations = std::max<std::size_t>(1, bytesPerCase / size / (size < 64 ? 8 : 1));
+        printResult(measure("legacy random_device", size, std::max<std::size_t>(1, iterations / 64), [&]() {
+            legacySecureBytes(buffer.data(), size);
+            return static_cast<std::uint64_t>(buffer[0]);
+        }));
+        printResult(measure("legacy mt19937_64", size, std::max<std::size_t>(1, iterations / 16), [&]() {
+            legacyBytes(buffer.data(), size);
+            return static_cast<std::uint64_t>(buffer[0]);
+        }));
+        printResult(measure("SecureRandom::fill", size, iterations, [&]() {
+            SecureRandom::fill(buffer.data(), size);
+            return static_cast<std::uint64_t>(buffer[0]);
+        }));
+    }
+
+    const std::size_t tokenIterations = 200000;
+    printResult(measure("SecureRandom::token", 32, tokenIterations, [&]() {
+        return static_cast<std::uint64_t>(SecureRandom::token().size());
+    }));
+    printResult(measure("SecureRandom::uuid", 16, tokenIterations, [&]() {
+        return static_cast<std::uint64_t>(SecureRandom::uuid()[14]);
+    }));
+    printResult(measure("generateSecureHex(32)", 32, tokenIterations, [&]() {
+        return static_cast<std::uint64_t>(SaltGenerator::generateSecureHex(32).size());
+    }));
+
+    // ChaCha20 密钥流原始吞吐（不含缓冲与擦除）
+    const std::uint32_t key[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    printResult(measure("chacha20 keystream", buffer.size(), bytesPerCase / buffer.size(), [&]() {
+        detail::chacha20Stream(key, buffer.data(), buffer.size() / 64);
+        return static_cast<std::uint64_t>(buffer[7]);
+    }));
+
+    return static_cast<int>(g_sink == static_cast<std::uint64_t>(-1));
+}
@@ -0,0 +1,194 @@
+#include "galay-utils/crypto/hmac.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t inputSize;
+    double nsPerOp;
+    double gbPerSec;
+    std::uint64_t checksum;
+};
+
+std::string backendName(galay::utils::SHA256Backend backend) {
+    switch (backend) {
+        case galay::utils::SHA256Backend::Scalar: return "scalar";
+        case galay::utils::SHA256Backend::ShaNi: return "sha-ni";
+        case galay::utils::SHA256Backend::ArmSha2: return "armv8-sha2";
+    }
+    return "unknown";
+}
+
+template<typename Fn>
+Result measure(std::string name, std::size_t inputSize, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double gbPerSec = static_cast<double>(inputSize) / nsPerOp;
+    return Result{std::move(name), inputSize, nsPerOp, gbPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(24) << result.name
+              << std::right << std::setw(12) << result.inputSize
+              << std::setw(14) << std::fixed << std::setprecision(2) << result.nsPerOp
+              << std::setw(10) << std::fixed << std::setprecision(3) << result.gbPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+std::uint64_t digestWord(const std::array<std::uint8_t, 32>& digest) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value = (value << 8) | digest[i];
+    }
+    return value;
+}
+
+} // namespace
+
+int main() {
+    using galay::utils::SHA256;
+    using galay::utils::SHA256Backend;
+
+    constexpr std::size_t bytesPerCase = 64 * 1024 * 1024;
+    const std::vector<std::size_t> sizes = {64, 256, 1024, 4096, 65536, 1048576, 16777216};
+
+    std::vector<std::uint8_t> input(sizes.back());
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<std::uint8_t>(i * 131 + 17);
+    }
+
+    std::vector<SHA256Backend> backends = {SHA256Backend::Scalar};
+    if (SHA256::bestBackend() != SHA256Backend::Scalar) {
+        backends.push_back(SHA256::bestBackend());
+    }
+
+    std::cout << "SHA256 benchmark\n";
+    std::cout << "Build with -O3 -DNDEBUG. Bytes per case=" << bytesPerCase
+              << ", best backend=" << backendName(SHA256::bestBackend()) << '\n';
+    std::cout << std::left << std::setw(24) << "Scenario"
+              << std::right << std::setw(12) << "bytes"
+              << std::setw(14) << "ns/op"
+              << std::setw(10) << "GB/s" << '\n';
+
+    for (SHA256Backend backend : backends) {
+        for (std::size_t size : sizes) {
+            const std::size_t iterations = std::max<std::size_t>(1, bytesPerCase / size);
+            printResult(measure("hash " + backendName(backend), size, iterations, [&]() {
+                SHA256::Context ctx;
+                SHA256::init(ctx, backend);
+                SHA256::update(ctx, input.data(), size);
+                return digestWord(SHA256::finalize(ctx));
+            }));
+        }
+    }
+
+    // 流式 4KB 分片输入 16MB
+    const std::size_t chunk = 4096;
+    printResult(measure("stream 4KB chunks", input.size(), 4, [&]() {
+        SHA256::Context ctx;
+        SHA256::init(ctx);
+        for (std::size_t offset = 0; offset < input.size(); offset += chunk) {
+            SHA256::update(ctx, input.data() + offset, chunk);
+        }
+        return digestWord(SHA256::finalize(ctx));
+    }));
+
+    const std::string key = "benchmark-secret-key";
+    for (std::size_t size : {std::size_t{64}, std::size_t{1024}, std::size_t{65536}}) {
+        const std::size_t iterations = std::max<std::size_t>(1, bytesPerCase / size / 4);
+        printResult(measure("hmacSha256", size, iterations, [&]() {
+            return digestWord(galay::utils::HMAC::hmacSha256(
+                reinterpret_cast<const std::uint8_t*>(key.data()), key.size(),
+                input.data(), size));
+        }));
+    }
+
+    // 短消息批量：单条循环 vs multi-buffer，HMAC 一次性接口 vs 预计算密钥 vs 批量校验
+    constexpr std::size_t batchCount = 1024;
+    SHA256::Context scalarIv;
+    SHA256::init(scalarIv, SHA256Backend::Scalar);
+    const galay::utils::HmacKey hmacKey(key);
+    for (std::size_t size : {std::size_t{64}, std::size_t{256}, std::size_t{1024}}) {
+        std::vector<std::string_view> messages;
+        for (std::size_t i = 0; i < batchCount; ++i) {
+            messages.emplace_back(reinterpret_cast<const char*>(input.data()) + i * 61, size);
+        }
+        std::vector<std::array<std::uint8_t, 32>> digests(batchCount);
+        std::vector<std::array<std::uint8_t, 32>> tags(batchCount);
+        hmacKey.signBatch(messages, tags);
+        std::unique_ptr<bool[]> verified(new bool[batchCount]);
+        const std::size_t iterations = std::max<std::size_t>(1, bytesPerCase / size / batchCount / 4);
+        const std::size_t batchBytes = size * batchCount;
+
+        printResult(measure("hash x1024 loop", batchBytes, iterations, [&]() {
+            std::uint64_t sum = 0;
+            for (const auto& message : messages) {
+                sum += digestWord(SHA256::hash(
+                    reinterpret_cast<const std::uint8_t*>(message.data()), message.size()));
+            }
+            return sum;
+        }));
+        printResult(measure("hashBatch x1024", batchBytes, iterations, [&]() {
+            SHA256::hashBatch(messages, digests);
+            return digestWord(digests.back());
+        }));
+        if (SHA256::isBatchAccelerated()) {
+            printResult(measure("hashBatch avx2 x1024", batchBytes, iterations, [&]() {
+                SHA256::hashBatch(scalarIv, messages, digests, galay::utils::SHA256BatchMode::MultiBuffer);
+                return digestWord(digests.back());
+            }));
+            printResult(measure("hash scalar x1024", batchBytes, iterations, [&]() {
+                std::uint64_t sum = 0;
+                for (const auto& message : messages) {
+                    SHA256::Context ctx = scalarIv;
+                    SHA256::update(ctx, reinterpret_cast<const std::uint8_t*>(message.data()), message.size());
+                    sum += digestWord(SHA256::finalize(ctx));
+                }
+                return sum;
+            }));
+        }
+        printResult(measure("hmacSha256 x1024", batchBytes, iterations, [&]() {
+            std::uint64_t sum = 0;
+            for (const auto& message : messages) {
+                sum += digestWord(galay::utils::HMAC::hmacSha256(
+                    reinterpret_cast<const std::uint8_t*>(key.data()), key.size(),
+                    reinterpret_cast<const std::uint8_t*>(message.data()), message.size()));
+            }
+            return sum;
+        }));
+        printResult(measure("HmacKey::sign x1024", batchBytes, iterations, [&]() {
+            std::uint64_t sum = 0;
+            for (const auto& message : messages) {
+                sum += digestWord(hmacKey.sign(message));
+            }
+            return sum;
+        }));
+        printResult(measure("verifyBatch x1024", batchBytes, iterations, [&]() {
+            return static_cast<std::uint64_t>(hmacKey.verifyBatch(
+                messages, tags, std::span<bool>(verified.get(), batchCount)));
+        }));
+    }
+
+    return static_cast<int>(g_sink == static_cast<std::uint64_t>(-1));
+}
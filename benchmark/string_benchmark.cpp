@@ -0,0 +1,365 @@
+#include "galay-utils/core/string.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t inputSize;
+    double nsPerOp;
+    double gbPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t inputSize, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double gbPerSec = static_cast<double>(inputSize) / nsPerOp;
+    return Result{std::move(name), inputSize, nsPerOp, gbPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(28) << result.name
+              << std::right << std::setw(12) << result.inputSize
+              << std::setw(14) << std::fixed << std::setprecision(2) << result.nsPerOp
+              << std::setw(10) << std::fixed << std::setprecision(3) << result.gbPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+// find_first_of 基线：标准库逐字节查表
+std::size_t countFieldsFindFirstOf(std::string_view line, std::string_view delimiters) {
+    std::size_t fields = 1;
+    std::size_t pos = line.find_first_of(delimiters);
+    while (pos != std::string_view::npos) {
+        ++fields;
+        pos = line.find_first_of(delimiters, pos + 1);
+    }
+    return fields;
+}
+
+// 改造前 parse<T> 的做法：trim 出新字符串后用 istringstream 解析
+template<typename T>
+T legacyParse(std::string_view str) {
+    std::istringstream iss{std::string(str)};
+    T value{};
+    iss >> value;
+    return value;
+}
+
+// 改造前 toString 的做法：ostringstream
+template<typename T>
+std::string legacyToString(const T& value) {
+    std::ostringstream oss;
+    oss << value;
+    return oss.str();
+}
+
+// 改造前 toLower / trim / isBlank 的做法：逐字节调用 locale 相关的 <cctype> 函数
+std::string legacyToLower(std::string_view str) {
+    std::string result(str);
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+std::string legacyTrim(std::string_view str) {
+    std::size_t start = 0;
+    std::size_t end = str.size();
+    while (start < end && std::isspace(static_cast<unsigned char>(str[start]))) ++start;
+    while (end > start && std::isspace(static_cast<unsigned char>(str[end - 1]))) --end;
+    return std::string(str.substr(start, end - start));
+}
+
+bool legacyIsBlank(std::string_view str) {
+    for (char c : str) {
+        if (!std::isspace(static_cast<unsigned char>(c))) return false;
+    }
+    return true;
+}
+
+// 改造前 count(str, substr) 的做法：循环调用 std::string_view::find
+std::size_t legacyCount(std::string_view str, std::string_view substr) {
+    std::size_t count = 0;
+    for (std::size_t pos = str.find(substr); pos != std::string_view::npos; pos = str.find(substr, pos + substr.size())) {
+        ++count;
+    }
+    return count;
+}
+
+// 改造前 replace 的做法：边查找边追加，输出按需增长
+std::string legacyReplace(std::string_view str, std::string_view from, std::string_view to) {
+    std::string result;
+    result.reserve(str.size());
+    std::size_t start = 0;
+    for (std::size_t pos = str.find(from); pos != std::string_view::npos; pos = str.find(from, start)) {
+        result.append(str.substr(start, pos - start));
+        result.append(to);
+        start = pos + from.size();
+    }
+    result.append(str.substr(start));
+    return result;
+}
+
+} // namespace
+
+int main() {
+    using galay::utils::AsciiCaseInsensitiveEqual;
+    using galay::utils::AsciiCaseInsensitiveHash;
+    using galay::utils::MultiReplacer;
+    using galay::utils::SplitByAnyOf;
+    using galay::utils::StringUtils;
+
+    constexpr std::size_t iterations = 2000000;
+
+    const std::string csvLine =
+        "2026-10-17T08:15:42.123Z,ingest-07,GET,/api/v1/orders,200,1532,0.0042,eu-west-1,true,trace-9f3c";
+    const std::string quotedLine =
+        "1024,\"Widget, large\",\"ACME, Inc.\",19.99,\"note with \"\"quotes\"\"\",2026-10-17,ok";
+    const std::string logLine =
+        "Oct 17 08:15:42 host sshd[2201]: Accepted publickey for deploy from 10.0.0.7 port 52144 ssh2: ED25519";
+    std::string longText;
+    for (int i = 0; i < 2000; ++i) {
+        longText += "field";
+        longText += std::to_string(i);
+        longText += (i % 3 == 0) ? '\t' : ' ';
+    }
+
+    std::cout << "StringUtils benchmark\n";
+    std::cout << "Build with -O3 -DNDEBUG. Iterations per case=" << iterations << '\n';
+    std::cout << std::left << std::setw(28) << "Scenario"
+              << std::right << std::setw(12) << "bytes"
+              << std::setw(14) << "ns/op"
+              << std::setw(10) << "GB/s" << '\n';
+
+    printResult(measure("csv split", csvLine.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::split(csvLine, ',').size());
+    }));
+    printResult(measure("csv splitView", csvLine.size(), iterations, [&]() {
+        std::uint64_t total = 0;
+        for (std::string_view field : StringUtils::splitView(csvLine, ',')) {
+            total += field.size();
+        }
+        return total;
+    }));
+    std::array<std::string_view, 16> slots{};
+    printResult(measure("csv splitInto", csvLine.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::splitInto(csvLine, ',', slots));
+    }));
+
+    printResult(measure("quoted splitRespectQuotes", quotedLine.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::splitRespectQuotes(quotedLine, ',').size());
+    }));
+    printResult(measure("quoted splitView", quotedLine.size(), iterations, [&]() {
+        std::uint64_t total = 0;
+        for (std::string_view field : StringUtils::splitViewRespectQuotes(quotedLine, ',')) {
+            total += field.size();
+        }
+        return total;
+    }));
+
+    printResult(measure("log split(\" \")", logLine.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::split(logLine, ' ').size());
+    }));
+    printResult(measure("log splitInto anyOf", logLine.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::splitInto(logLine, SplitByAnyOf(" :[]"), slots));
+    }));
+
+    const std::size_t longIterations = iterations / 100;
+    printResult(measure("long find_first_of", longText.size(), longIterations, [&]() {
+        return static_cast<std::uint64_t>(countFieldsFindFirstOf(longText, " \t"));
+    }));
+    printResult(measure("long splitViewAnyOf", longText.size(), longIterations, [&]() {
+        std::uint64_t fields = 0;
+        for ([[maybe_unused]] std::string_view field : StringUtils::splitViewAnyOf(longText, " \t")) {
+            ++fields;
+        }
+        return fields;
+    }));
+
+    // 数值解析与格式化
+    const std::string intText = "1234567";
+    const std::string u64Text = "18446744073709551000";
+    const std::string doubleText = "3.14159265358979";
+    printResult(measure("legacy parse<int>", intText.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(legacyParse<int>(intText));
+    }));
+    printResult(measure("tryParse<int>", intText.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::tryParse<int>(intText).value_or(0));
+    }));
+    printResult(measure("legacy parse<uint64_t>", u64Text.size(), iterations, [&]() {
+        return legacyParse<std::uint64_t>(u64Text);
+    }));
+    printResult(measure("tryParse<uint64_t>", u64Text.size(), iterations, [&]() {
+        return StringUtils::tryParse<std::uint64_t>(u64Text).value_or(0);
+    }));
+    printResult(measure("legacy parse<double>", doubleText.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(legacyParse<double>(doubleText) * 1000);
+    }));
+    printResult(measure("tryParse<double>", doubleText.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::tryParse<double>(doubleText).value_or(0) * 1000);
+    }));
+
+    std::uint64_t counter = 1234567;
+    printResult(measure("legacy toString(u64)", 8, iterations, [&]() {
+        return static_cast<std::uint64_t>(legacyToString(++counter).size());
+    }));
+    printResult(measure("toString(u64)", 8, iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::toString(++counter).size());
+    }));
+    std::array<char, 64> numberBuffer{};
+    printResult(measure("toChars(u64)", 8, iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::toChars(numberBuffer, ++counter));
+    }));
+    double sample = 0.125;
+    printResult(measure("legacy toString(double)", 8, iterations, [&]() {
+        sample += 1.0;
+        return static_cast<std::uint64_t>(legacyToString(sample).size());
+    }));
+    printResult(measure("toString(double)", 8, iterations, [&]() {
+        sample += 1.0;
+        return static_cast<std::uint64_t>(StringUtils::toString(sample).size());
+    }));
+
+    printResult(measure("format", 24, iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::format("%s:%d/%s", "host", 8080, "path").size());
+    }));
+    std::array<char, 64> formatBuffer{};
+    printResult(measure("formatInto", 24, iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::formatInto(formatBuffer, "%s:%d/%s", "host", 8080, "path"));
+    }));
+
+    // ASCII 内核：大小写转换、trim、分类与 UTF-8 校验
+    const std::string header = "Content-Type: Application/JSON; Charset=UTF-8";
+    printResult(measure("legacy toLower(header)", header.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(legacyToLower(header)[0]);
+    }));
+    printResult(measure("toLower(header)", header.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::toLower(header)[0]);
+    }));
+    std::string mutableText = longText;
+    printResult(measure("legacy toLower(long)", longText.size(), longIterations, [&]() {
+        return static_cast<std::uint64_t>(legacyToLower(longText).back());
+    }));
+    printResult(measure("toLowerInPlace(long)", longText.size(), longIterations, [&]() {
+        StringUtils::toLowerInPlace(mutableText);
+        return static_cast<std::uint64_t>(mutableText.back());
+    }));
+
+    const std::string paddedValue = "   \t  keep-alive, Upgrade  \r\n";
+    printResult(measure("legacy trim", paddedValue.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(legacyTrim(paddedValue).size());
+    }));
+    printResult(measure("trimView", paddedValue.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::trimView(paddedValue).size());
+    }));
+    const std::string blankText(longText.size(), ' ');
+    printResult(measure("legacy isBlank(long)", blankText.size(), longIterations, [&]() {
+        return static_cast<std::uint64_t>(legacyIsBlank(blankText));
+    }));
+    printResult(measure("isBlank(long)", blankText.size(), longIterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::isBlank(blankText));
+    }));
+
+    std::string utf8Text;
+    while (utf8Text.size() < longText.size()) {
+        utf8Text += "ASCII run of plain text, then \xE4\xB8\xAD\xE6\x96\x87 and \xF0\x9F\x98\x80 ";
+    }
+    // 起始偏移经 volatile 读取，防止编译器把纯函数提到循环外
+    volatile std::size_t utf8Offset = 0;
+    printResult(measure("isValidUtf8(ascii)", longText.size(), longIterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::isValidUtf8(std::string_view(longText).substr(utf8Offset)));
+    }));
+    printResult(measure("isValidUtf8(mixed)", utf8Text.size(), longIterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::isValidUtf8(std::string_view(utf8Text).substr(utf8Offset)));
+    }));
+
+    // 大小写不敏感的头部键：先 toLower 再比较 vs 直接使用折叠比较函数对象
+    const std::string headerKey = "X-Forwarded-For";
+    const std::string probeKey = "x-forwarded-for";
+    printResult(measure("toLower + std::hash", headerKey.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(std::hash<std::string>{}(legacyToLower(headerKey)));
+    }));
+    printResult(measure("AsciiCaseInsensitiveHash", headerKey.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(AsciiCaseInsensitiveHash{}(headerKey));
+    }));
+    printResult(measure("toLower + operator==", headerKey.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(legacyToLower(headerKey) == legacyToLower(probeKey));
+    }));
+    printResult(measure("AsciiCaseInsensitiveEqual", headerKey.size(), iterations, [&]() {
+        return static_cast<std::uint64_t>(AsciiCaseInsensitiveEqual{}(headerKey, probeKey));
+    }));
+
+    // 子串查找：std::string_view::find vs 首 / 末字节 SIMD 过滤
+    const std::string needle = "field1999";
+    printResult(measure("legacy count(substr)", longText.size(), longIterations, [&]() {
+        return static_cast<std::uint64_t>(legacyCount(longText, needle));
+    }));
+    printResult(measure("count(substr)", longText.size(), longIterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::count(longText, needle));
+    }));
+    printResult(measure("legacy contains(miss)", longText.size(), longIterations, [&]() {
+        return static_cast<std::uint64_t>(std::string_view(longText).find("field20000") != std::string_view::npos);
+    }));
+    printResult(measure("contains(miss)", longText.size(), longIterations, [&]() {
+        return static_cast<std::uint64_t>(StringUtils::contains(longText, "field20000"));
+    }));
+
+    // 模板渲染：逐个变量循环 replace vs 预编译 MultiReplacer 单趟替换
+    std::map<std::string, std::string> variables;
+    std::string templateText;
+    for (int i = 0; i < 32; ++i) {
+        variables["{{var" + std::to_string(i) + "}}"] = "value-" + std::to_string(i * 7919);
+    }
+    while (templateText.size() < 16 * 1024) {
+        for (int i = 0; i < 32; i += 3) {
+            templateText += "<p>Lorem ipsum dolor sit amet {{var" + std::to_string(i) + "}} consectetur.</p>\n";
+        }
+    }
+    const MultiReplacer renderer(variables);
+    const std::size_t renderIterations = 2000;
+    printResult(measure("legacy replace loop x32", templateText.size(), renderIterations, [&]() {
+        std::string text = templateText;
+        for (const auto& [from, to] : variables) {
+            text = legacyReplace(text, from, to);
+        }
+        return static_cast<std::uint64_t>(text.size());
+    }));
+    printResult(measure("replace loop x32", templateText.size(), renderIterations, [&]() {
+        std::string text = templateText;
+        for (const auto& [from, to] : variables) {
+            text = StringUtils::replace(text, from, to);
+        }
+        return static_cast<std::uint64_t>(text.size());
+    }));
+    std::string rendered;
+    printResult(measure("MultiReplacer applyTo", templateText.size(), renderIterations, [&]() {
+        renderer.applyTo(templateText, rendered);
+        return static_cast<std::uint64_t>(rendered.size());
+    }));
+
+    return static_cast<int>(g_sink == static_cast<std::uint64_t>(-1));
+}
@@ -0,0 +1,148 @@
+#include "galay-utils/core/time.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t inputSize;
+    double nsPerOp;
+    double gbPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t inputSize, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double gbPerSec = static_cast<double>(inputSize) / nsPerOp;
+    return Result{std::move(name), inputSize, nsPerOp, gbPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(32) << result.name
+              << std::right << std::setw(12) << result.inputSize
+              << std::setw(14) << std::fixed << std::setprecision(2) << result.nsPerOp
+              << std::setw(10) << std::fixed << std::setprecision(3) << result.gbPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+// 改造前 currentGMTTime() 的做法：time + gmtime_r + strftime + std::string
+std::string legacyGmtTime(std::time_t timestamp) {
+    std::tm tm{};
+    gmtime_r(&timestamp, &tm);
+    char buffer[256]{};
+    std::strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    return std::string(buffer);
+}
+
+// 常见的 ISO-8601 毫秒做法：gmtime_r + strftime 秒级部分 + snprintf 毫秒与时区
+std::size_t legacyIso8601(char* out, std::size_t size, std::int64_t micros) {
+    const std::time_t seconds = static_cast<std::time_t>(micros / 1000000);
+    std::tm tm{};
+    gmtime_r(&seconds, &tm);
+    const std::size_t written = std::strftime(out, size, "%Y-%m-%dT%H:%M:%S", &tm);
+    return written + static_cast<std::size_t>(
+        std::snprintf(out + written, size - written, ".%03dZ", static_cast<int>(micros / 1000 % 1000)));
+}
+
+} // namespace
+
+int main() {
+    using namespace std::chrono;
+    using galay::utils::Time;
+    using galay::utils::TimeFormatter;
+    using galay::utils::TimePrecision;
+
+    constexpr std::size_t iterations = 5000000;
+    const std::int64_t baseMicros = duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+
+    std::cout << "Time formatting benchmark\n";
+    std::cout << "Build with -O3 -DNDEBUG. Iterations per case=" << iterations << '\n';
+    std::cout << std::left << std::setw(32) << "Scenario"
+              << std::right << std::setw(12) << "bytes"
+              << std::setw(14) << "ns/op"
+              << std::setw(10) << "GB/s" << '\n';
+
+    std::array<char, 64> buffer{};
+    TimeFormatter& formatter = TimeFormatter::local();
+
+    // HTTP Date 头：每次调用取当前时间
+    printResult(measure("legacy currentGMTTime()", 29, iterations, [&](std::size_t) {
+        return static_cast<std::uint64_t>(legacyGmtTime(std::time(nullptr))[23]);
+    }));
+    printResult(measure("Time::currentGMTTime()", 29, iterations, [&](std::size_t) {
+        return static_cast<std::uint64_t>(Time::currentGMTTime()[23]);
+    }));
+    printResult(measure("formatRfc1123(now)", 29, iterations, [&](std::size_t) {
+        return static_cast<std::uint64_t>(formatter.formatRfc1123(buffer) + buffer[23]);
+    }));
+
+    // 固定输入：模拟每 1000 次请求跨一秒，隔离时钟读取开销
+    printResult(measure("legacy gmtime+strftime (1/1000s)", 29, iterations, [&](std::size_t i) {
+        return static_cast<std::uint64_t>(legacyGmtTime(static_cast<std::time_t>(baseMicros / 1000000 + i / 1000))[23]);
+    }));
+    printResult(measure("formatRfc1123 (1/1000s)", 29, iterations, [&](std::size_t i) {
+        const sys_seconds time(seconds(baseMicros / 1000000 + static_cast<std::int64_t>(i / 1000)));
+        return static_cast<std::uint64_t>(formatter.formatRfc1123(buffer, time) + buffer[23]);
+    }));
+    printResult(measure("formatRfc1123 (every second)", 29, iterations, [&](std::size_t i) {
+        const sys_seconds time(seconds(baseMicros / 1000000 + static_cast<std::int64_t>(i)));
+        return static_cast<std::uint64_t>(formatter.formatRfc1123(buffer, time) + buffer[23]);
+    }));
+
+    // 日志时间戳：毫秒 / 微秒精度，每次调用推进 1 微秒
+    printResult(measure("legacy ISO-8601 ms", 24, iterations, [&](std::size_t i) {
+        return static_cast<std::uint64_t>(legacyIso8601(buffer.data(), buffer.size(), baseMicros + static_cast<std::int64_t>(i)));
+    }));
+    printResult(measure("formatIso8601 ms", 24, iterations, [&](std::size_t i) {
+        const system_clock::time_point time(microseconds(baseMicros + static_cast<std::int64_t>(i)));
+        return static_cast<std::uint64_t>(formatter.formatIso8601(buffer, time));
+    }));
+    printResult(measure("formatIso8601 us", 27, iterations, [&](std::size_t i) {
+        const system_clock::time_point time(microseconds(baseMicros + static_cast<std::int64_t>(i)));
+        return static_cast<std::uint64_t>(formatter.formatIso8601(buffer, time, TimePrecision::Microseconds));
+    }));
+    printResult(measure("formatRfc3339 us +08:00", 32, iterations, [&](std::size_t i) {
+        const system_clock::time_point time(microseconds(baseMicros + static_cast<std::int64_t>(i)));
+        return static_cast<std::uint64_t>(formatter.formatRfc3339(buffer, time, hours(8), TimePrecision::Microseconds));
+    }));
+    printResult(measure("formatIso8601(now) ms", 24, iterations, [&](std::size_t) {
+        return static_cast<std::uint64_t>(formatter.formatIso8601(buffer));
+    }));
+
+    // 解析
+    const std::string httpDate = "Sun, 06 Nov 1994 08:49:37 GMT";
+    const std::string rfc3339 = "2026-10-17T08:15:42.123456+08:00";
+    printResult(measure("legacy strptime RFC 1123", httpDate.size(), iterations, [&](std::size_t) {
+        std::tm tm{};
+        strptime(httpDate.c_str(), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+        return static_cast<std::uint64_t>(timegm(&tm));
+    }));
+    printResult(measure("parseRfc1123", httpDate.size(), iterations, [&](std::size_t) {
+        return static_cast<std::uint64_t>(TimeFormatter::parseRfc1123(httpDate)->time_since_epoch().count());
+    }));
+    printResult(measure("parseRfc3339", rfc3339.size(), iterations, [&](std::size_t) {
+        return static_cast<std::uint64_t>(TimeFormatter::parseRfc3339(rfc3339)->time_since_epoch().count());
+    }));
+
+    return static_cast<int>(g_sink == static_cast<std::uint64_t>(-1));
+}
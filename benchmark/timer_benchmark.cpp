@@ -0,0 +1,273 @@
+#include "galay-utils/core/clock.hpp"
+#include "galay-utils/core/histogram.hpp"
+#include "galay-utils/tool/timer.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    double nsPerOp;
+    double mopsPerSec;
+    std::uint64_t checksum;
+};
+
+template<typename Fn>
+Result measure(std::string name, std::size_t iterations, Fn&& fn) {
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        checksum += fn(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    g_sink = checksum;
+    const auto elapsedNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const double nsPerOp = static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+    const double seconds = static_cast<double>(elapsedNs) / 1'000'000'000.0;
+    const double mopsPerSec = (static_cast<double>(iterations) / seconds) / 1'000'000.0;
+    return Result{std::move(name), nsPerOp, mopsPerSec, checksum};
+}
+
+void printResult(const Result& result) {
+    std::cout << std::left << std::setw(40) << result.name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2)
+              << result.nsPerOp
+              << std::setw(14) << std::fixed << std::setprecision(2)
+              << result.mopsPerSec
+              << "  checksum=" << result.checksum << '\n';
+}
+
+// 手动推进的时钟：benchmark 只衡量定时器结构本身，不含读时钟开销
+struct SimClock {
+    using rep = std::int64_t;
+    using period = std::milli;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<SimClock>;
+    static constexpr bool is_steady = true;
+    static inline time_point current{};
+    static time_point now() noexcept { return current; }
+};
+
+// 模拟请求超时：每个操作发起一个请求并登记超时；请求在 kInFlight 个操作后完成，
+// 其中 90% 在超时前完成并取消定时器，其余 10% 由定时器触发。每 kOpsPerTick 个操作时间前进 1ms。
+// 定时器句柄按请求序号取模复用，kSlots 覆盖一个超时周期内的全部请求，保证句柄复用前定时器已触发。
+constexpr std::size_t kInFlight = 65536;
+constexpr std::size_t kSlots = std::size_t{1} << 20;
+constexpr std::size_t kOpsPerTick = 32;
+constexpr std::int64_t kTimeoutTicks = 30000;
+
+bool completesInTime(std::size_t request) {
+    return request % 10 != 0;
+}
+
+// 改造前的常见做法：priority_queue + 取消标记（惰性删除）
+struct HeapTimers {
+    struct Item {
+        std::int64_t deadline;
+        std::uint32_t slot;
+        std::uint32_t generation;
+        bool operator>(const Item& other) const { return deadline > other.deadline; }
+    };
+
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+    std::vector<std::uint32_t> generations = std::vector<std::uint32_t>(kSlots, 0);
+    std::uint64_t fired = 0;
+
+    void schedule(std::size_t slot, std::int64_t deadline) {
+        heap.push(Item{deadline, static_cast<std::uint32_t>(slot), ++generations[slot]});
+    }
+
+    void cancel(std::size_t slot) {
+        ++generations[slot];
+    }
+
+    void advance(std::int64_t now) {
+        while (!heap.empty() && heap.top().deadline <= now) {
+            const Item item = heap.top();
+            heap.pop();
+            if (generations[item.slot] == item.generation) {
+                ++fired;
+            }
+        }
+    }
+};
+
+// 支持真实删除的有序容器
+struct MultimapTimers {
+    std::multimap<std::int64_t, std::size_t> timers;
+    std::vector<std::multimap<std::int64_t, std::size_t>::iterator> handles =
+        std::vector<std::multimap<std::int64_t, std::size_t>::iterator>(kSlots);
+    std::vector<bool> armed = std::vector<bool>(kSlots, false);
+    std::uint64_t fired = 0;
+
+    void schedule(std::size_t slot, std::int64_t deadline) {
+        handles[slot] = timers.emplace(deadline, slot);
+        armed[slot] = true;
+    }
+
+    void cancel(std::size_t slot) {
+        if (armed[slot]) {
+            timers.erase(handles[slot]);
+            armed[slot] = false;
+        }
+    }
+
+    void advance(std::int64_t now) {
+        auto it = timers.begin();
+        while (it != timers.end() && it->first <= now) {
+            armed[it->second] = false;
+            ++fired;
+            it = timers.erase(it);
+        }
+    }
+};
+
+struct WheelTimers {
+    struct Request : galay::utils::TimerNode {
+        Request() : TimerNode(&Request::onTimeout) {}
+        static void onTimeout(galay::utils::TimerNode& node) {
+            ++static_cast<Request&>(node).owner->fired;
+        }
+        WheelTimers* owner = nullptr;
+    };
+
+    galay::utils::BasicTimerWheel<SimClock> wheel{std::chrono::milliseconds(1), SimClock::time_point{}};
+    std::unique_ptr<Request[]> requests = std::make_unique<Request[]>(kSlots);
+    std::uint64_t fired = 0;
+
+    WheelTimers() {
+        for (std::size_t i = 0; i < kSlots; ++i) {
+            requests[i].owner = this;
+        }
+    }
+
+    void schedule(std::size_t slot, std::int64_t deadline) {
+        wheel.scheduleAt(requests[slot], SimClock::time_point(SimClock::duration(deadline)));
+    }
+
+    void cancel(std::size_t slot) {
+        requests[slot].cancel();
+    }
+
+    void advance(std::int64_t now) {
+        wheel.advance(SimClock::time_point(SimClock::duration(now)));
+    }
+};
+
+template<typename Timers>
+Result measureRequestTimeouts(std::string name, std::size_t iterations) {
+    auto timers = std::make_unique<Timers>();
+    std::int64_t now = 0;
+    for (std::size_t i = 0; i < kInFlight; ++i) {
+        timers->schedule(i, now + kTimeoutTicks);
+    }
+    auto result = measure(std::move(name), iterations, [&](std::size_t i) {
+        const std::size_t request = i + kInFlight;
+        // kInFlight 个操作之前发起的请求此刻完成
+        const std::size_t completed = request - kInFlight;
+        if (completesInTime(completed)) {
+            timers->cancel(completed & (kSlots - 1));
+        }
+        timers->schedule(request & (kSlots - 1), now + kTimeoutTicks);
+        if ((i & (kOpsPerTick - 1)) == kOpsPerTick - 1) {
+            timers->advance(++now);
+        }
+        return std::uint64_t{1};
+    });
+    result.checksum = timers->fired;
+    return result;
+}
+
+// 线程安全基线：mutex 保护的 multimap，句柄为迭代器
+Result measureLockedMultimapScheduleCancel(std::size_t iterations) {
+    std::mutex mutex;
+    std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> timers;
+    for (std::size_t i = 0; i < 1024; ++i) {
+        timers.emplace(std::chrono::steady_clock::now() + std::chrono::seconds(20), []() {});
+    }
+    return measure("mutex + std::multimap schedule+cancel", iterations, [&](std::size_t i) {
+        std::multimap<std::chrono::steady_clock::time_point, std::function<void()>>::iterator it;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            it = timers.emplace(std::chrono::steady_clock::now() + std::chrono::seconds(30), []() {});
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        timers.erase(it);
+        return std::uint64_t{1} + (i & 1);
+    });
+}
+
+Result measureServiceScheduleCancel(std::size_t iterations) {
+    galay::utils::TimerService service(std::chrono::milliseconds(1));
+    // 保持一批更早到期的定时器，新定时器不会提前驱动线程的唤醒时间（与线上常驻大量超时的场景一致）
+    for (std::size_t i = 0; i < 1024; ++i) {
+        service.schedule(std::chrono::seconds(20), []() {});
+    }
+    return measure("TimerService schedule+cancel", iterations, [&service](std::size_t i) {
+        const auto id = service.schedule(std::chrono::seconds(30), []() {});
+        return static_cast<std::uint64_t>(service.cancel(id)) + (i & 1);
+    });
+}
+
+void printLatency(const std::string& name, const galay::utils::HistogramSummary& summary) {
+    std::cout << std::left << std::setw(40) << name
+              << std::right << " n=" << summary.count
+              << " mean=" << std::fixed << std::setprecision(1) << summary.mean
+              << " p50=" << summary.p50
+              << " p99=" << summary.p99
+              << " p999=" << summary.p999
+              << " max=" << summary.max << " (ns)\n";
+}
+
+// 逐次计时 schedule + cancel，观察持锁路径的尾延迟
+galay::utils::HistogramSummary measureServiceLatency(std::size_t iterations) {
+    galay::utils::TimerService service(std::chrono::milliseconds(1));
+    for (std::size_t i = 0; i < 1024; ++i) {
+        service.schedule(std::chrono::seconds(20), []() {});
+    }
+    galay::utils::Histogram latency;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        galay::utils::ScopedTimer<galay::utils::TscClock> timer(latency);
+        service.cancel(service.schedule(std::chrono::seconds(30), []() {}));
+    }
+    return latency.summary();
+}
+
+} // namespace
+
+int main() {
+    constexpr std::size_t kIterations = 8'000'000;
+
+    std::cout << "request timeouts: " << kInFlight << " in flight, " << kTimeoutTicks
+              << "ms timeout, 90% cancelled, " << kOpsPerTick << " requests per 1ms tick\n";
+    std::cout << std::left << std::setw(40) << "case"
+              << std::right << std::setw(12) << "ns/op"
+              << std::setw(14) << "Mops/s" << '\n';
+
+    printResult(measureRequestTimeouts<HeapTimers>("priority_queue + lazy cancel", kIterations));
+    printResult(measureRequestTimeouts<MultimapTimers>("std::multimap", kIterations));
+    printResult(measureRequestTimeouts<WheelTimers>("TimerWheel", kIterations));
+    printResult(measureLockedMultimapScheduleCancel(kIterations));
+    printResult(measureServiceScheduleCancel(kIterations));
+
+    galay::utils::TscClock::calibrate();
+    printLatency("TimerService schedule+cancel latency", measureServiceLatency(1'000'000));
+
+    return 0;
+}
@@ -6,6 +6,7 @@
  *
  * @details 提供带虚拟节点的一致性哈希环，支持节点动态添加/移除、
  *          健康检查、加权节点和多副本查询。使用读写锁保证线程安全。
+ *          哈希函数可通过模板参数注入（如 XXH3Hasher），避免 std::function 间接调用。
  */
 
 #ifndef GALAY_UTILS_CONSISTENT_HASH_HPP
@@ -20,7 +21,9 @@
 #include <functional>
 #include <optional>
 #include <atomic>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 namespace galay::utils {
 
@@ -143,26 +146,32 @@ struct PhysicalNode {
     explicit PhysicalNode(NodeConfig cfg) : config(std::move(cfg)) {}
 };
 
+/// 默认的类型擦除哈希函数类型
+using ConsistentHashFunc = std::function<uint32_t(const std::string&)>;
+
 /**
  * @brief 一致性哈希环
  * @details 基于虚拟节点的一致性哈希实现，使用读写锁保证线程安全。
  *          支持节点动态添加/移除、健康检查和多副本查询。
+ *
+ * @tparam Hasher 以 const std::string& 调用、返回无符号整数的哈希函数对象；
+ *         返回值宽于 32 位时折叠为 32 位环坐标。默认 ConsistentHashFunc，空函数时使用 MurmurHash3
  */
-class ConsistentHash {
+template<typename Hasher = ConsistentHashFunc>
+class BasicConsistentHash {
 public:
     /// 哈希函数类型
-    using HashFunc = std::function<uint32_t(const std::string&)>;
+    using HashFunc = Hasher;
 
     /**
      * @brief 构造一致性哈希环
      * @param virtualNodes 每个物理节点对应的虚拟节点数量（默认 150）
-     * @param hashFunc 自定义哈希函数，为空时使用 MurmurHash3
+     * @param hashFunc 自定义哈希函数；类型为 ConsistentHashFunc 且为空时使用 MurmurHash3
      */
-    explicit ConsistentHash(size_t virtualNodes = 150,
-                            HashFunc hashFunc = nullptr)
+    explicit BasicConsistentHash(size_t virtualNodes = 150,
+                                 HashFunc hashFunc = HashFunc{})
         : m_virtualNodes(virtualNodes)
-        , m_hashFunc(hashFunc ? std::move(hashFunc) :
-                     [](const std::string& key) { return MurmurHash3::hash32(key); }) {}
+        , m_hashFunc(defaultHashFunc(std::move(hashFunc))) {}
 
     /**
      * @brief 添加节点到哈希环
@@ -177,7 +186,7 @@ public:
         size_t vnodes = m_virtualNodes * config.weight;
         for (size_t i = 0; i < vnodes; ++i) {
             std::string virtualKey = config.id + "#" + std::to_string(i);
-            uint32_t hash = m_hashFunc(virtualKey);
+            uint32_t hash = hashKey(virtualKey);
             m_ring[hash] = node;
         }
     }
@@ -199,7 +208,7 @@ public:
 
         for (size_t i = 0; i < vnodes; ++i) {
             std::string virtualKey = nodeId + "#" + std::to_string(i);
-            uint32_t hash = m_hashFunc(virtualKey);
+            uint32_t hash = hashKey(virtualKey);
             m_ring.erase(hash);
         }
 
@@ -218,7 +227,7 @@ public:
             return std::nullopt;
         }
 
-        uint32_t hash = m_hashFunc(key);
+        uint32_t hash = hashKey(key);
         auto it = m_ring.lower_bound(hash);
 
         if (it == m_ring.end()) {
@@ -242,7 +251,7 @@ public:
             return std::nullopt;
         }
 
-        uint32_t hash = m_hashFunc(key);
+        uint32_t hash = hashKey(key);
         auto it = m_ring.lower_bound(hash);
 
         for (size_t retry = 0; retry < maxRetries; ++retry) {
@@ -275,7 +284,7 @@ public:
             return result;
         }
 
-        uint32_t hash = m_hashFunc(key);
+        uint32_t hash = hashKey(key);
         auto it = m_ring.lower_bound(hash);
 
         std::set<std::string> seen;
@@ -316,6 +325,28 @@ public:
         }
     }
 
+    /// 为节点累计一次请求计数，节点不存在时忽略
+    void recordRequest(const std::string& nodeId) {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = m_nodes.find(nodeId);
+        if (it != m_nodes.end()) {
+            it->second->status.recordRequest();
+        }
+    }
+
+    /**
+     * @brief 在共享锁内逐个访问物理节点的配置与状态
+     * @details visitor 以 (const NodeConfig&, const NodeStatus&) 调用，顺序不保证；
+     *          visitor 内不得再调用修改环的接口。
+     */
+    template<typename Visitor>
+    void forEachNodeStatus(Visitor&& visitor) const {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        for (const auto& [id, node] : m_nodes) {
+            visitor(std::as_const(node->config), std::as_const(node->status));
+        }
+    }
+
     std::vector<NodeConfig> getAllNodes() const {
         std::shared_lock<std::shared_mutex> lock(m_mutex);
         std::vector<NodeConfig> result;
@@ -348,6 +379,27 @@ public:
     }
 
 private:
+    static HashFunc defaultHashFunc(HashFunc hashFunc) {
+        if constexpr (std::is_same_v<HashFunc, ConsistentHashFunc>) {
+            if (!hashFunc) {
+                return [](const std::string& key) { return MurmurHash3::hash32(key); };
+            }
+        }
+        return hashFunc;
+    }
+
+    uint32_t hashKey(const std::string& key) const {
+        const auto value = m_hashFunc(key);
+        static_assert(std::is_unsigned_v<decltype(value)>,
+                      "ConsistentHash Hasher result must be an unsigned integer");
+        if constexpr (sizeof(value) > sizeof(uint32_t)) {
+            const uint64_t wide = static_cast<uint64_t>(value);
+            return static_cast<uint32_t>(wide ^ (wide >> 32));
+        } else {
+            return static_cast<uint32_t>(value);
+        }
+    }
+
     size_t m_virtualNodes;
     HashFunc m_hashFunc;
     mutable std::shared_mutex m_mutex;
@@ -355,6 +407,9 @@ private:
     std::unordered_map<std::string, std::shared_ptr<PhysicalNode>> m_nodes;
 };
 
+/// 默认一致性哈希环（MurmurHash3 或运行时注入的 std::function）
+using ConsistentHash = BasicConsistentHash<>;
+
 } // namespace galay::utils
 
 #endif // GALAY_UTILS_CONSISTENT_HASH_HPP
@@ -5,15 +5,17 @@
  * @version 1.0.0
  *
  * @details 解析简单 .conf 格式的键值对配置文件，支持 [section] 分节、
- *          # 和 ; 注释行，支持逗号分隔的数组值。
+ *          # 和 ; 注释行，支持逗号分隔的数组值。解析器持有输入文本，
+ *          单趟扫描后键值以视图形式指向输入或 arena。
  */
 
 #ifndef GALAY_UTILS_PARSER_CONFIG_HPP
 #define GALAY_UTILS_PARSER_CONFIG_HPP
 
+#include "galay-utils/config/cursor.hpp"
 #include "galay-utils/config/detail.hpp"
 #include "galay-utils/config/parser_base.hpp"
-#include <unordered_map>
+#include <string_view>
 
 namespace galay::utils {
 
@@ -31,63 +33,44 @@ public:
     }
 
     bool parseString(const std::string& content) override {
-        m_values.clear();
-        m_last_error.clear();
-        std::string current_section;
-
-        std::istringstream input(content);
-        std::string line;
-        int line_num = 0;
-
-        while (std::getline(input, line)) {
-            ++line_num;
-            line = parser_detail::trim(line);
-
-            if (line.empty() || line[0] == '#' || line[0] == ';') {
-                continue;
-            }
-
-            if (line[0] == '[' && line.back() == ']') {
-                current_section = parser_detail::trim(line.substr(1, line.length() - 2));
-                continue;
-            }
-
-            auto equal_pos = line.find('=');
-            if (equal_pos == std::string::npos) {
-                m_last_error = "Invalid line " + std::to_string(line_num) + ": " + line;
-                return false;
-            }
-
-            std::string key = parser_detail::trim(line.substr(0, equal_pos));
-            std::string value = parser_detail::trim(line.substr(equal_pos + 1));
-            value = parser_detail::unquote(value);
+        return parseSource(content);
+    }
 
-            std::string full_key = current_section.empty() ? key : current_section + "." + key;
-            m_values[full_key] = value;
+    std::optional<std::string> getValue(const std::string& key) const override {
+        if (const auto* value = m_values.find(key)) {
+            return std::string(*value);
         }
-
-        return true;
+        return std::nullopt;
     }
 
-    std::optional<std::string> getValue(const std::string& key) const override {
-        auto iter = m_values.find(key);
-        if (iter != m_values.end()) {
-            return iter->second;
+    /**
+     * @brief 获取键值视图，不复制
+     * @return 值视图，在下一次解析或解析器析构前有效；不存在时返回 std::nullopt
+     */
+    std::optional<std::string_view> getValueView(std::string_view key) const {
+        if (const auto* value = m_values.find(key)) {
+            return *value;
         }
         return std::nullopt;
     }
 
     bool hasKey(const std::string& key) const override {
-        return m_values.find(key) != m_values.end();
+        return m_values.contains(key);
     }
 
     std::vector<std::string> getKeys() const override {
-        std::vector<std::string> keys;
-        keys.reserve(m_values.size());
-        for (const auto& entry : m_values) {
-            keys.push_back(entry.first);
+        return m_values.keys();
+    }
+
+    /**
+     * @brief 遍历全部键值视图（顺序未定义）
+     * @param visitor 以 (std::string_view key, std::string_view value) 调用
+     */
+    template<typename Visitor>
+    void forEachValue(Visitor&& visitor) const {
+        for (const auto& [key, value] : m_values) {
+            visitor(key, value);
         }
-        return keys;
     }
 
     /**
@@ -97,10 +80,10 @@ public:
      */
     std::vector<std::string> getKeysInSection(const std::string& section) const {
         std::vector<std::string> keys;
-        std::string prefix = section + ".";
         for (const auto& entry : m_values) {
-            if (entry.first.substr(0, prefix.length()) == prefix) {
-                keys.push_back(entry.first.substr(prefix.length()));
+            std::string_view key = entry.first;
+            if (key.length() > section.length() && key[section.length()] == '.' && key.starts_with(section)) {
+                keys.emplace_back(key.substr(section.length() + 1));
             }
         }
         return keys;
@@ -120,7 +103,43 @@ public:
     }
 
 protected:
-    std::unordered_map<std::string, std::string> m_values;
+    bool parseSource(std::string content) override {
+        m_values.reset(std::move(content));
+        m_last_error.clear();
+        std::string_view current_section;
+
+        parser_detail::LineCursor cursor(m_values.source());
+        std::string_view line;
+
+        while (cursor.next(line)) {
+            line = parser_detail::trimView(line);
+
+            if (line.empty() || line[0] == '#' || line[0] == ';') {
+                continue;
+            }
+
+            if (line[0] == '[' && line.back() == ']') {
+                current_section = parser_detail::trimView(line.substr(1, line.length() - 2));
+                continue;
+            }
+
+            auto equal_pos = line.find('=');
+            if (equal_pos == std::string_view::npos) {
+                m_last_error = "Invalid line " + std::to_string(cursor.lineNumber()) + ": " + std::string(line);
+                return false;
+            }
+
+            std::string_view key = parser_detail::trimView(line.substr(0, equal_pos));
+            std::string_view value = parser_detail::trimView(line.substr(equal_pos + 1));
+            value = parser_detail::unquoteView(value, m_values.arena());
+
+            m_values.assign(m_values.joinKey(current_section, key), value);
+        }
+
+        return true;
+    }
+
+    parser_detail::ViewTable m_values;
 };
 
 } // namespace galay::utils
@@ -0,0 +1,569 @@
+/**
+ * @file config_watcher.hpp
+ * @brief 配置文件热加载与快照发布
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details ConfigWatcher 在后台线程监视配置文件（Linux 使用 inotify 监视所在目录，其他平台或
+ *          inotify 不可用时按间隔轮询文件状态），变化后按扩展名创建解析器重新解析，
+ *          以原子 shared_ptr 发布不可变的 ConfigSnapshot。读者只做原子加载，从不等待解析或写者；
+ *          ConfigReader 按版本号缓存快照，版本未变时读取只需一次原子读与比较。
+ *          新快照以旧快照为布局加载，ConfigKey 句柄跨版本有效；发布后按键级差异触发变更回调。
+ */
+
+#ifndef GALAY_UTILS_CONFIG_WATCHER_HPP
+#define GALAY_UTILS_CONFIG_WATCHER_HPP
+
+#include "galay-utils/config/parser_manager.hpp"
+#include "galay-utils/config/typed_config.hpp"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <sys/stat.h>
+#endif
+
+namespace galay::utils {
+
+/**
+ * @brief 一次成功加载的不可变配置
+ */
+struct ConfigSnapshot {
+    uint64_t version = 0;   ///< 从 1 开始，每次内容变化后发布递增
+    TypedConfig values;
+};
+
+/**
+ * @brief ConfigWatcher 选项
+ */
+struct ConfigWatcherOptions {
+    std::chrono::milliseconds pollInterval{1000};   ///< 轮询间隔；使用 inotify 时作为兜底检查间隔
+    std::chrono::milliseconds settleDelay{20};      ///< 检测到变化后等待写入方完成的时间，合并连续事件
+    bool useInotify = true;                         ///< 为 false 时总是轮询
+};
+
+class ConfigWatcher;
+
+/**
+ * @brief 按版本号缓存快照的读者
+ * @details 每个线程持有一个实例。current() 先比较一次版本号，版本未变时直接返回缓存的快照；
+ *          只有发布新版本后的第一次读取才会原子加载 shared_ptr。实例本身非线程安全。
+ */
+class ConfigReader {
+public:
+    explicit ConfigReader(const ConfigWatcher& watcher) : m_watcher(&watcher) {}
+
+    /// 当前快照；在下一次 current() 调用或读者析构前保持有效
+    const ConfigSnapshot& current();
+
+    /// 按句柄读取当前快照中的值
+    template<ConfigValueType T>
+    ConfigRead<T> get(const ConfigKey<T>& key) {
+        return current().values.get(key);
+    }
+
+private:
+    const ConfigWatcher* m_watcher;
+    std::shared_ptr<const ConfigSnapshot> m_snapshot;
+    uint64_t m_version = 0;
+};
+
+/**
+ * @brief 配置文件监视器
+ * @details start() 同步完成首次加载后启动后台线程。重新解析、比较与回调都在后台线程执行；
+ *          解析失败时保留旧快照并记录 lastError()。内容未变化（如仅 touch）时不发布新版本。
+ *          变更回调在持有重新加载锁的线程上按版本顺序调用，回调内不应阻塞过久，也不能调用 reload() 或 stop()。
+ *          回调抛出的异常被捕获并记入 lastError() 与 callbackFailureCount()，不影响其余回调与已发布的快照。
+ */
+class ConfigWatcher {
+public:
+    using ChangeCallback = std::function<void(const ConfigSnapshot&, std::span<const ConfigChange>)>;
+
+    explicit ConfigWatcher(std::string path, ConfigWatcherOptions options = {})
+        : m_path(std::move(path))
+        , m_options(options) {}
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    ~ConfigWatcher() {
+        stop();
+    }
+
+    /**
+     * @brief 首次加载并启动监视线程
+     * @return 首次加载失败或已启动时返回 false
+     */
+    bool start() {
+        std::lock_guard<std::mutex> lifecycle(m_lifecycle);
+        if (m_worker.joinable() || !reload()) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = false;
+        }
+        openWatch();
+        m_worker = std::thread([this]() { run(); });
+        return true;
+    }
+
+    /// 停止监视线程（幂等），已发布的快照仍可读取
+    void stop() {
+        std::lock_guard<std::mutex> lifecycle(m_lifecycle);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeup.notify_one();
+#if defined(__linux__)
+        if (m_wakePipe[1] >= 0) {
+            const char byte = 0;
+            [[maybe_unused]] auto written = ::write(m_wakePipe[1], &byte, 1);
+        }
+#endif
+        if (m_worker.joinable()) {
+            m_worker.join();
+        }
+        closeWatch();
+    }
+
+    /**
+     * @brief 立即重新解析并在内容变化时发布
+     * @return 解析成功返回 true（内容未变化也返回 true）
+     * @details 可在任意线程调用，与后台线程互斥。
+     */
+    bool reload() {
+        std::lock_guard<std::mutex> lock(m_reloadMutex);
+        m_lastStat = statFile();
+        auto parser = ParserManager::instance().createParser(m_path);
+        if (!parser) {
+            return fail("Unsupported config file extension: " + m_path);
+        }
+        if (!parser->parseFile(m_path)) {
+            return fail(parser->lastError());
+        }
+
+        std::shared_ptr<const ConfigSnapshot> previous;
+        std::shared_ptr<const ConfigSnapshot> published;
+        std::vector<ConfigChange> changes;
+        {
+            // 与 key() 互斥：预留槽位的下标以当前快照的槽位数为基准，发布新快照后预留表随之清空
+            std::lock_guard<std::mutex> layout(m_layoutMutex);
+            previous = snapshot();
+            auto next = std::make_shared<ConfigSnapshot>();
+            next->values = loadValues(*parser, previous ? previous->values : emptyValues(), m_reserved);
+            if (previous) {
+                changes = TypedConfig::diff(previous->values, next->values);
+                if (changes.empty()) {
+                    clearError();
+                    return true;
+                }
+            }
+            next->version = (previous ? previous->version : 0) + 1;
+            published = std::move(next);
+            storeSnapshot(published);
+            m_version.store(published->version, std::memory_order_release);
+            m_reserved.clear();
+        }
+        clearError();
+
+        if (previous) {
+            std::vector<ChangeCallback> callbacks;
+            {
+                std::lock_guard<std::mutex> guard(m_callbackMutex);
+                callbacks.reserve(m_callbacks.size());
+                for (const auto& entry : m_callbacks) {
+                    callbacks.push_back(entry.second);
+                }
+            }
+            for (const auto& callback : callbacks) {
+                notify(callback, *published, changes);
+            }
+        }
+        return true;
+    }
+
+    /// 当前快照；首次加载成功前为空
+    std::shared_ptr<const ConfigSnapshot> snapshot() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        return m_snapshot.load(std::memory_order_acquire);
+#else
+        return std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire);
+#endif
+    }
+
+    /// 当前快照版本号，首次加载成功前为 0
+    uint64_t version() const {
+        return m_version.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 在当前快照上绑定句柄；句柄对之后发布的快照同样有效
+     * @details 当前快照中没有该键名（或首次加载尚未完成）时在布局中预留槽位，
+     *          之后发布的快照出现该键即可通过句柄读到，此前读取返回默认值。
+     */
+    template<ConfigValueType T>
+    ConfigKey<T> key(std::string_view name, T defaultValue = T{}) const {
+        std::lock_guard<std::mutex> lock(m_layoutMutex);
+        auto current = snapshot();
+        const TypedConfig& values = current ? current->values : emptyValues();
+        auto handle = values.key<T>(name, std::move(defaultValue));
+        if (handle.bound()) {
+            return handle;
+        }
+        size_t position = 0;
+        while (position < m_reserved.size() && m_reserved[position] != name) {
+            ++position;
+        }
+        if (position == m_reserved.size()) {
+            m_reserved.emplace_back(name);
+        }
+        return ConfigKey<T>(static_cast<uint32_t>(values.slotCount() + position), values.generation(),
+                            std::move(handle.m_name), std::move(handle.m_default));
+    }
+
+    /// 创建按版本缓存快照的读者
+    ConfigReader reader() const {
+        return ConfigReader(*this);
+    }
+
+    /**
+     * @brief 注册变更回调
+     * @return 回调 ID，用于 removeCallback()
+     * @details 首次加载不触发回调，之后每次发布新版本以新快照与逐键变更调用。
+     */
+    uint64_t onChange(ChangeCallback callback) {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        const uint64_t id = ++m_nextCallbackId;
+        m_callbacks.emplace_back(id, std::move(callback));
+        return id;
+    }
+
+    /// 注销变更回调，正在执行的一轮通知不受影响
+    bool removeCallback(uint64_t id) {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        for (auto iter = m_callbacks.begin(); iter != m_callbacks.end(); ++iter) {
+            if (iter->first == id) {
+                m_callbacks.erase(iter);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// 最近一次加载失败或变更回调异常的原因，下一次成功加载后清空
+    std::string lastError() const {
+        std::lock_guard<std::mutex> lock(m_errorMutex);
+        return m_lastError;
+    }
+
+    /// 累计加载失败次数
+    uint64_t failureCount() const {
+        return m_failures.load(std::memory_order_relaxed);
+    }
+
+    /// 累计抛出异常的变更回调调用次数
+    uint64_t callbackFailureCount() const {
+        return m_callbackFailures.load(std::memory_order_relaxed);
+    }
+
+    /// 监视线程是否使用 inotify（否则为轮询）
+    bool usingInotify() const {
+#if defined(__linux__)
+        return m_inotifyFd >= 0;
+#else
+        return false;
+#endif
+    }
+
+    const std::string& path() const { return m_path; }
+
+private:
+    /// 用于判断文件是否变化的状态：修改时间、大小与 inode
+    struct FileStat {
+        int64_t mtimeNs = -1;
+        int64_t size = -1;
+        uint64_t inode = 0;
+
+        bool operator==(const FileStat&) const = default;
+    };
+
+    FileStat statFile() const {
+        FileStat result;
+#if defined(_WIN32)
+        WIN32_FILE_ATTRIBUTE_DATA data;
+        if (GetFileAttributesExA(m_path.c_str(), GetFileExInfoStandard, &data)) {
+            result.mtimeNs = static_cast<int64_t>((static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+                                                  data.ftLastWriteTime.dwLowDateTime) * 100;
+            result.size = static_cast<int64_t>((static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow);
+        }
+#else
+        struct stat st;
+        if (::stat(m_path.c_str(), &st) == 0) {
+#if defined(__APPLE__)
+            result.mtimeNs = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1'000'000'000 + st.st_mtimespec.tv_nsec;
+#else
+            result.mtimeNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
+#endif
+            result.size = static_cast<int64_t>(st.st_size);
+            result.inode = static_cast<uint64_t>(st.st_ino);
+        }
+#endif
+        return result;
+    }
+
+    static const TypedConfig& emptyValues() {
+        static const TypedConfig empty;
+        return empty;
+    }
+
+    /// 按解析器实际类型加载，以便使用其视图遍历与数组接口（如 TOML 数组）
+    static TypedConfig loadValues(const ParserBase& parser, const TypedConfig& layout,
+                                  std::span<const std::string> reserved) {
+        auto build = [&layout, reserved](const auto& concrete) {
+            return TypedConfig(concrete, layout, reserved);
+        };
+        if (const auto* toml = dynamic_cast<const TomlParser*>(&parser)) {
+            return build(*toml);
+        }
+        if (const auto* config = dynamic_cast<const ConfigParser*>(&parser)) {
+            return build(*config);
+        }
+        if (const auto* env = dynamic_cast<const EnvParser*>(&parser)) {
+            return build(*env);
+        }
+        return build(parser);
+    }
+
+    void storeSnapshot(std::shared_ptr<const ConfigSnapshot> snapshot) {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        m_snapshot.store(std::move(snapshot), std::memory_order_release);
+#else
+        std::atomic_store_explicit(&m_snapshot, std::move(snapshot), std::memory_order_release);
+#endif
+    }
+
+    bool fail(std::string error) {
+        m_failures.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(m_errorMutex);
+        m_lastError = std::move(error);
+        return false;
+    }
+
+    /// 回调在后台线程上执行，异常逃出会直接 std::terminate，这里捕获后只记录
+    void notify(const ChangeCallback& callback, const ConfigSnapshot& published,
+                const std::vector<ConfigChange>& changes) {
+        try {
+            callback(published, std::span<const ConfigChange>(changes));
+        } catch (const std::exception& e) {
+            recordCallbackError(std::string("Config change callback threw: ") + e.what());
+        } catch (...) {
+            recordCallbackError("Config change callback threw a non-standard exception");
+        }
+    }
+
+    void recordCallbackError(std::string error) {
+        m_callbackFailures.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(m_errorMutex);
+        m_lastError = std::move(error);
+    }
+
+    void clearError() {
+        std::lock_guard<std::mutex> lock(m_errorMutex);
+        m_lastError.clear();
+    }
+
+    bool changedSinceLoad(const FileStat& current) {
+        std::lock_guard<std::mutex> lock(m_reloadMutex);
+        return current != m_lastStat;
+    }
+
+    /// 文件状态与上次加载时不同则重新加载
+    void reloadIfChanged() {
+        if (changedSinceLoad(statFile())) {
+            reload();
+        }
+    }
+
+    /**
+     * @brief 轮询模式下等待写入完成
+     * @details 每隔 settleDelay 重新 stat，连续两次状态一致才返回，避免原地写入时读到半份文件。
+     * @return 等待期间被 stop() 打断时返回 false
+     */
+    bool waitSettled(FileStat current) {
+        while (true) {
+            if (waitStopping(m_options.settleDelay)) {
+                return false;
+            }
+            FileStat next = statFile();
+            if (next == current) {
+                return true;
+            }
+            current = next;
+        }
+    }
+
+    bool waitStopping(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wakeup.wait_for(lock, timeout, [this]() { return m_stopping; });
+    }
+
+    bool stopping() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stopping;
+    }
+
+    void run() {
+#if defined(__linux__)
+        if (m_inotifyFd >= 0) {
+            runInotify();
+            return;
+        }
+#endif
+        while (!waitStopping(m_options.pollInterval)) {
+            const FileStat current = statFile();
+            if (!changedSinceLoad(current)) {
+                continue;
+            }
+            if (!waitSettled(current)) {
+                break;
+            }
+            reloadIfChanged();
+        }
+    }
+
+#if defined(__linux__)
+    /// 监视文件所在目录，兼容编辑器改名保存与符号链接切换（如 Kubernetes ConfigMap）
+    void openWatch() {
+        if (!m_options.useInotify || m_inotifyFd >= 0) {
+            return;
+        }
+        m_inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotifyFd < 0) {
+            return;
+        }
+        const auto slash = m_path.find_last_of('/');
+        const std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : m_path.substr(0, slash));
+        const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_ATTRIB;
+        if (::inotify_add_watch(m_inotifyFd, directory.c_str(), mask) < 0 || ::pipe2(m_wakePipe, O_CLOEXEC) != 0) {
+            closeWatch();
+        }
+    }
+
+    void closeWatch() {
+        auto closeFd = [](int& fd) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        };
+        closeFd(m_inotifyFd);
+        closeFd(m_wakePipe[0]);
+        closeFd(m_wakePipe[1]);
+    }
+
+    void drainInotify() {
+        alignas(inotify_event) char buffer[4096];
+        while (::read(m_inotifyFd, buffer, sizeof(buffer)) > 0) {
+        }
+    }
+
+    void runInotify() {
+        pollfd fds[2] = {{m_inotifyFd, POLLIN, 0}, {m_wakePipe[0], POLLIN, 0}};
+        const int timeout = static_cast<int>(m_options.pollInterval.count());
+        while (!stopping()) {
+            fds[0].revents = 0;
+            fds[1].revents = 0;
+            const int ready = ::poll(fds, 2, timeout > 0 ? timeout : -1);
+            if (ready < 0 && errno != EINTR) {
+                break;
+            }
+            if (fds[1].revents != 0) {
+                break;
+            }
+            if (fds[0].revents != 0) {
+                drainInotify();
+                if (waitStopping(m_options.settleDelay)) {
+                    break;
+                }
+                drainInotify();
+            }
+            // 事件只作为唤醒信号，是否重新加载以文件状态为准；超时唤醒时作为兜底检查
+            reloadIfChanged();
+        }
+    }
+#else
+    void openWatch() {}
+    void closeWatch() {}
+#endif
+
+    std::string m_path;
+    ConfigWatcherOptions m_options;
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<std::shared_ptr<const ConfigSnapshot>> m_snapshot;
+#else
+    std::shared_ptr<const ConfigSnapshot> m_snapshot;
+#endif
+    alignas(64) std::atomic<uint64_t> m_version{0};
+    std::atomic<uint64_t> m_failures{0};
+    std::atomic<uint64_t> m_callbackFailures{0};
+
+    std::mutex m_reloadMutex;
+    FileStat m_lastStat;
+
+    mutable std::mutex m_layoutMutex;
+    mutable std::vector<std::string> m_reserved;   ///< key() 预留、尚未进入已发布快照的键名
+
+    mutable std::mutex m_errorMutex;
+    std::string m_lastError;
+
+    std::mutex m_callbackMutex;
+    std::vector<std::pair<uint64_t, ChangeCallback>> m_callbacks;
+    uint64_t m_nextCallbackId = 0;
+
+    std::mutex m_lifecycle;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_stopping = false;
+    std::thread m_worker;
+
+#if defined(__linux__)
+    int m_inotifyFd = -1;
+    int m_wakePipe[2] = {-1, -1};
+#endif
+};
+
+inline const ConfigSnapshot& ConfigReader::current() {
+    if (m_watcher->version() != m_version || !m_snapshot) {
+        m_snapshot = m_watcher->snapshot();
+        if (!m_snapshot) {
+            static const ConfigSnapshot empty;
+            return empty;
+        }
+        m_version = m_snapshot->version;
+    }
+    return *m_snapshot;
+}
+
+} // namespace galay::utils
+
+#endif // GALAY_UTILS_CONFIG_WATCHER_HPP
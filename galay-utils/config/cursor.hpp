@@ -0,0 +1,267 @@
+/**
+ * @file cursor.hpp
+ * @brief 解析器的视图型单趟扫描核心
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 提供按行游标 LineCursor、块式字符串 arena StringArena 与键值视图表 ViewTable。
+ *          解析器接管整份输入（文件经 System::readFileStream 读入）后单趟扫描，键和值都是指向
+ *          输入或 arena 的 std::string_view；只有带转义的值和带分节前缀的键才写入 arena。
+ */
+
+#ifndef GALAY_UTILS_PARSER_CURSOR_HPP
+#define GALAY_UTILS_PARSER_CURSOR_HPP
+
+#include "galay-utils/config/detail.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace galay::utils::parser_detail {
+
+/// 与 std::isspace 在 "C" locale 下一致的空白判断
+inline bool isSpace(char character) {
+    return character == ' ' || (character >= '\t' && character <= '\r');
+}
+
+/**
+ * @brief 去除视图两端空白字符，不复制
+ */
+inline std::string_view trimView(std::string_view text) {
+    size_t start = 0;
+    size_t end = text.length();
+    while (start < end && isSpace(text[start])) {
+        ++start;
+    }
+    while (end > start && isSpace(text[end - 1])) {
+        --end;
+    }
+    return text.substr(start, end - start);
+}
+
+/**
+ * @brief 按行遍历文本的游标
+ * @details 用 memchr 查找换行，返回不含 '\n' 的行视图（'\r' 由调用方 trim 去除）。
+ *          行划分与 std::getline 一致：末尾换行之后不再产出空行。
+ */
+class LineCursor {
+public:
+    explicit LineCursor(std::string_view text) : m_text(text) {}
+
+    /**
+     * @brief 取下一行
+     * @param line 输出行视图
+     * @return 已到达末尾返回 false
+     */
+    bool next(std::string_view& line) {
+        if (m_pos >= m_text.size()) {
+            return false;
+        }
+        const char* begin = m_text.data() + m_pos;
+        const size_t remaining = m_text.size() - m_pos;
+        const void* newline = std::memchr(begin, '\n', remaining);
+        const size_t length = newline ? static_cast<size_t>(static_cast<const char*>(newline) - begin) : remaining;
+        line = std::string_view(begin, length);
+        m_pos += length + 1;
+        ++m_line;
+        return true;
+    }
+
+    /// 最近一次 next() 返回行的行号，从 1 开始
+    int lineNumber() const { return m_line; }
+
+private:
+    std::string_view m_text;
+    size_t m_pos = 0;
+    int m_line = 0;
+};
+
+/**
+ * @brief 只追加的块式字符串 arena
+ * @details 已返回的视图在 arena 生命周期内保持有效，追加新内容不会搬移旧数据。
+ */
+class StringArena {
+public:
+    explicit StringArena(size_t blockSize = 16 * 1024) : m_blockSize(blockSize) {}
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+    // 游标指向被移走的块，源对象须一并复位，否则复用源对象会写入目标仍在使用的内存
+    StringArena(StringArena&& other) noexcept
+        : m_blocks(std::move(other.m_blocks))
+        , m_cursor(std::exchange(other.m_cursor, nullptr))
+        , m_end(std::exchange(other.m_end, nullptr))
+        , m_blockSize(other.m_blockSize)
+        , m_bytes(std::exchange(other.m_bytes, 0)) {
+        other.m_blocks.clear();
+    }
+
+    StringArena& operator=(StringArena&& other) noexcept {
+        if (this != &other) {
+            m_blocks = std::move(other.m_blocks);
+            other.m_blocks.clear();
+            m_cursor = std::exchange(other.m_cursor, nullptr);
+            m_end = std::exchange(other.m_end, nullptr);
+            m_blockSize = other.m_blockSize;
+            m_bytes = std::exchange(other.m_bytes, 0);
+        }
+        return *this;
+    }
+
+    /// 分配 size 字节的未初始化空间
+    char* allocate(size_t size) {
+        if (size > m_blockSize / 4) {
+            m_blocks.push_back(std::make_unique<char[]>(size));
+            m_bytes += size;
+            return m_blocks.back().get();
+        }
+        if (m_cursor == nullptr || static_cast<size_t>(m_end - m_cursor) < size) {
+            m_blocks.push_back(std::make_unique<char[]>(m_blockSize));
+            m_cursor = m_blocks.back().get();
+            m_end = m_cursor + m_blockSize;
+            m_bytes += m_blockSize;
+        }
+        char* result = m_cursor;
+        m_cursor += size;
+        return result;
+    }
+
+    /// 把 text 复制进 arena 并返回指向副本的视图
+    std::string_view store(std::string_view text) {
+        if (text.empty()) {
+            return {};
+        }
+        char* data = allocate(text.size());
+        std::memcpy(data, text.data(), text.size());
+        return {data, text.size()};
+    }
+
+    /// 已申请的字节数
+    size_t bytes() const { return m_bytes; }
+
+private:
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char* m_cursor = nullptr;
+    char* m_end = nullptr;
+    size_t m_blockSize;
+    size_t m_bytes = 0;
+};
+
+/**
+ * @brief 视图版转义处理：不含反斜杠时原样返回，否则解码进 arena
+ */
+inline std::string_view decodeEscapes(std::string_view text, StringArena& arena) {
+    if (text.find('\\') == std::string_view::npos) {
+        return text;
+    }
+    char* data = arena.allocate(text.size());
+    return {data, decodeEscapesInto(text, data)};
+}
+
+/**
+ * @brief 视图版 unquote()：去除成对引号，仅在需要时解码转义
+ */
+inline std::string_view unquoteView(std::string_view text, StringArena& arena) {
+    const bool quoted = text.length() >= 2 &&
+        ((text.front() == '"' && text.back() == '"') ||
+         (text.front() == '\'' && text.back() == '\''));
+    if (!quoted) {
+        return text;
+    }
+    return decodeEscapes(text.substr(1, text.length() - 2), arena);
+}
+
+/**
+ * @brief 持有输入与 arena 的键值视图表
+ * @details reset() 接管整份输入文本；键值视图指向该文本或同一 arena。
+ *          输入与 arena 通过 shared_ptr 共享，解析器被复制后两份视图表仍指向有效内存，
+ *          重新解析时换用新的存储，不影响副本。
+ */
+class ViewTable {
+public:
+    using Map = std::unordered_map<std::string_view, std::string_view>;
+
+    ViewTable() : m_storage(std::make_shared<Storage>()) {}
+
+    /// 丢弃已有内容并接管新的输入文本
+    void reset(std::string source) {
+        m_values.clear();
+        m_storage = std::make_shared<Storage>();
+        m_storage->source = std::move(source);
+        // 行数是键数的上界，一次预留哈希桶以免解析大文件时反复 rehash
+        const std::string& text = m_storage->source;
+        m_values.reserve(static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+    }
+
+    /// 预留哈希桶
+    void reserve(size_t count) { m_values.reserve(count); }
+
+    /// 已接管的输入文本
+    std::string_view source() const { return m_storage->source; }
+
+    StringArena& arena() { return m_storage->arena; }
+
+    /// 拼接 "section.key"；section 为空时直接返回 key，不复制
+    std::string_view joinKey(std::string_view section, std::string_view key) {
+        if (section.empty()) {
+            return key;
+        }
+        char* data = m_storage->arena.allocate(section.size() + 1 + key.size());
+        std::memcpy(data, section.data(), section.size());
+        data[section.size()] = '.';
+        std::memcpy(data + section.size() + 1, key.data(), key.size());
+        return {data, section.size() + 1 + key.size()};
+    }
+
+    /// 写入键值，已存在时覆盖
+    void assign(std::string_view key, std::string_view value) {
+        m_values.insert_or_assign(key, value);
+    }
+
+    /// 写入键值，已存在时保留旧值并返回 false
+    bool insert(std::string_view key, std::string_view value) {
+        return m_values.emplace(key, value).second;
+    }
+
+    const std::string_view* find(std::string_view key) const {
+        auto iter = m_values.find(key);
+        return iter != m_values.end() ? &iter->second : nullptr;
+    }
+
+    bool contains(std::string_view key) const {
+        return m_values.find(key) != m_values.end();
+    }
+
+    size_t size() const { return m_values.size(); }
+    Map::const_iterator begin() const { return m_values.begin(); }
+    Map::const_iterator end() const { return m_values.end(); }
+
+    /// 以 std::string 形式返回全部键名（顺序未定义）
+    std::vector<std::string> keys() const {
+        std::vector<std::string> result;
+        result.reserve(m_values.size());
+        for (const auto& entry : m_values) {
+            result.emplace_back(entry.first);
+        }
+        return result;
+    }
+
+private:
+    struct Storage {
+        std::string source;
+        StringArena arena;
+    };
+
+    std::shared_ptr<Storage> m_storage;
+    Map m_values;
+};
+
+} // namespace galay::utils::parser_detail
+
+#endif // GALAY_UTILS_PARSER_CURSOR_HPP
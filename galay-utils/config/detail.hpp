@@ -13,6 +13,7 @@
 
 #include <cctype>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace galay::utils::parser_detail {
@@ -35,30 +36,39 @@ inline std::string trim(const std::string& text) {
 }
 
 /**
- * @brief 处理转义字符
- * @param text 输入字符串
- * @return 处理转义后的字符串
+ * @brief 解码转义字符并写入 out
+ * @param text 输入文本
+ * @param out 输出缓冲区，至少 text.size() 字节
+ * @return 写入的字节数
  */
-inline std::string processEscapes(const std::string& text) {
-    std::string result;
-    result.reserve(text.length());
-
+inline size_t decodeEscapesInto(std::string_view text, char* out) {
+    size_t written = 0;
     for (size_t index = 0; index < text.length(); ++index) {
-        if (text[index] == '\\' && index + 1 < text.length()) {
+        char character = text[index];
+        if (character == '\\' && index + 1 < text.length()) {
             switch (text[index + 1]) {
-                case 'n': result += '\n'; ++index; break;
-                case 't': result += '\t'; ++index; break;
-                case 'r': result += '\r'; ++index; break;
-                case '\\': result += '\\'; ++index; break;
-                case '"': result += '"'; ++index; break;
-                case '\'': result += '\''; ++index; break;
-                default: result += text[index]; break;
+                case 'n': character = '\n'; ++index; break;
+                case 't': character = '\t'; ++index; break;
+                case 'r': character = '\r'; ++index; break;
+                case '\\': character = '\\'; ++index; break;
+                case '"': character = '"'; ++index; break;
+                case '\'': character = '\''; ++index; break;
+                default: break;
             }
-        } else {
-            result += text[index];
         }
+        out[written++] = character;
     }
+    return written;
+}
 
+/**
+ * @brief 处理转义字符
+ * @param text 输入字符串
+ * @return 处理转义后的字符串
+ */
+inline std::string processEscapes(const std::string& text) {
+    std::string result(text.length(), '\0');
+    result.resize(decodeEscapesInto(text, result.data()));
     return result;
 }
 
@@ -11,9 +11,9 @@
 #ifndef GALAY_UTILS_PARSER_ENV_HPP
 #define GALAY_UTILS_PARSER_ENV_HPP
 
-#include "galay-utils/config/detail.hpp"
+#include "galay-utils/config/cursor.hpp"
 #include "galay-utils/config/parser_base.hpp"
-#include <unordered_map>
+#include <string_view>
 
 namespace galay::utils {
 
@@ -31,58 +31,79 @@ public:
     }
 
     bool parseString(const std::string& content) override {
-        m_values.clear();
+        return parseSource(content);
+    }
+
+    std::optional<std::string> getValue(const std::string& key) const override {
+        if (const auto* value = m_values.find(key)) {
+            return std::string(*value);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief 获取键值视图，不复制
+     * @return 值视图，在下一次解析或解析器析构前有效；不存在时返回 std::nullopt
+     */
+    std::optional<std::string_view> getValueView(std::string_view key) const {
+        if (const auto* value = m_values.find(key)) {
+            return *value;
+        }
+        return std::nullopt;
+    }
+
+    bool hasKey(const std::string& key) const override {
+        return m_values.contains(key);
+    }
+
+    std::vector<std::string> getKeys() const override {
+        return m_values.keys();
+    }
+
+    /**
+     * @brief 遍历全部键值视图（顺序未定义）
+     * @param visitor 以 (std::string_view key, std::string_view value) 调用
+     */
+    template<typename Visitor>
+    void forEachValue(Visitor&& visitor) const {
+        for (const auto& [key, value] : m_values) {
+            visitor(key, value);
+        }
+    }
+
+protected:
+    bool parseSource(std::string content) override {
+        m_values.reset(std::move(content));
         m_last_error.clear();
 
-        std::istringstream input(content);
-        std::string line;
+        parser_detail::LineCursor cursor(m_values.source());
+        std::string_view line;
 
-        while (std::getline(input, line)) {
-            line = parser_detail::trim(line);
+        while (cursor.next(line)) {
+            line = parser_detail::trimView(line);
             if (line.empty() || line[0] == '#') {
                 continue;
             }
 
-            if (line.substr(0, 7) == "export ") {
-                line = parser_detail::trim(line.substr(7));
+            if (line.starts_with("export ")) {
+                line = parser_detail::trimView(line.substr(7));
             }
 
             auto equal_pos = line.find('=');
-            if (equal_pos == std::string::npos) {
+            if (equal_pos == std::string_view::npos) {
                 continue;
             }
 
-            std::string key = parser_detail::trim(line.substr(0, equal_pos));
-            std::string value = parser_detail::trim(line.substr(equal_pos + 1));
-            m_values[key] = parser_detail::unquote(value);
+            std::string_view key = parser_detail::trimView(line.substr(0, equal_pos));
+            std::string_view value = parser_detail::trimView(line.substr(equal_pos + 1));
+            m_values.assign(key, parser_detail::unquoteView(value, m_values.arena()));
         }
 
         return true;
     }
 
-    std::optional<std::string> getValue(const std::string& key) const override {
-        auto iter = m_values.find(key);
-        if (iter != m_values.end()) {
-            return iter->second;
-        }
-        return std::nullopt;
-    }
-
-    bool hasKey(const std::string& key) const override {
-        return m_values.find(key) != m_values.end();
-    }
-
-    std::vector<std::string> getKeys() const override {
-        std::vector<std::string> keys;
-        keys.reserve(m_values.size());
-        for (const auto& entry : m_values) {
-            keys.push_back(entry.first);
-        }
-        return keys;
-    }
-
 private:
-    std::unordered_map<std::string, std::string> m_values;
+    parser_detail::ViewTable m_values;
 };
 
 } // namespace galay::utils
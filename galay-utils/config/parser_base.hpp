@@ -11,7 +11,8 @@
 #ifndef GALAY_UTILS_PARSER_BASE_HPP
 #define GALAY_UTILS_PARSER_BASE_HPP
 
-#include <fstream>
+#include "galay-utils/core/string.hpp"
+#include "galay-utils/process/system.hpp"
 #include <optional>
 #include <sstream>
 #include <string>
@@ -68,6 +69,8 @@ public:
      * @param key 键名
      * @param defaultValue 转换失败或键不存在时的默认值
      * @return 转换后的值或默认值
+     * @details 整数、浮点和 bool 与 StringUtils::tryParse() 共用 from_chars 路径，去除首尾空白后要求完整匹配；
+     *          其他类型按 std::istringstream 读取。
      */
     template<typename T>
     T getValueAs(const std::string& key, T defaultValue = T{}) const {
@@ -76,6 +79,10 @@ public:
             return defaultValue;
         }
 
+        if constexpr (detail::FastNumeric<T>) {
+            return StringUtils::tryParse<T>(*value).value_or(defaultValue);
+        }
+
         std::istringstream input(*value);
         T result;
         if (input >> result) {
@@ -91,16 +98,21 @@ public:
     const std::string& lastError() const { return m_last_error; }
 
 protected:
+    /**
+     * @brief 接管整份输入文本并解析
+     * @details 默认转交 parseString()；视图型解析器覆盖此函数，直接持有文本而不再复制。
+     */
+    virtual bool parseSource(std::string content) {
+        return parseString(content);
+    }
+
     bool parseFileContent(const std::string& path) {
-        std::ifstream file(path);
-        if (!file) {
+        auto content = System::readFileStream(path);
+        if (!content) {
             m_last_error = "Failed to open file: " + path;
             return false;
         }
-
-        std::ostringstream output;
-        output << file.rdbuf();
-        return parseString(output.str());
+        return parseSource(std::move(*content));
     }
 
     std::string m_last_error;
@@ -15,6 +15,7 @@
 #include "galay-utils/config/env.hpp"
 #include "galay-utils/config/ini.hpp"
 #include "galay-utils/config/toml.hpp"
+#include "galay-utils/config/typed_config.hpp"
 #include <functional>
 #include <memory>
 #include <unordered_map>
@@ -0,0 +1,1394 @@
+/**
+ * @file toml_document.hpp
+ * @brief TOML 1.0 文档模型与解析器
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details TomlDocument 完整实现 TOML 1.0：表、数组表、内联表、点分键与引号键、四种字符串、
+ *          十 / 十六 / 八 / 二进制整数、浮点（含 inf / nan）、布尔值与四种日期时间。
+ *          解析结果是带类型的树，不做键名拍平：节点连续存放在文档持有的节点 arena 中并以下标互相引用，
+ *          解码后的字符串写入 StringArena，未转义的字符串直接指向输入。键名驻留在文档自己的
+ *          StringInterner 中，表成员按 (父节点, Symbol) 建索引，按名查找只需一次驻留池探测与一次哈希查找。
+ */
+
+#ifndef GALAY_UTILS_PARSER_TOML_DOCUMENT_HPP
+#define GALAY_UTILS_PARSER_TOML_DOCUMENT_HPP
+
+#include "galay-utils/config/cursor.hpp"
+#include "galay-utils/core/ascii.hpp"
+#include "galay-utils/core/interner.hpp"
+#include "galay-utils/process/system.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace galay::utils {
+
+/**
+ * @brief TOML 值类型
+ */
+enum class TomlType : uint8_t {
+    None,
+    String,
+    Integer,
+    Float,
+    Boolean,
+    OffsetDateTime,  ///< 1979-05-27T07:32:00-08:00
+    LocalDateTime,   ///< 1979-05-27T07:32:00
+    LocalDate,       ///< 1979-05-27
+    LocalTime,       ///< 07:32:00
+    Array,
+    Table
+};
+
+/**
+ * @brief TOML 日期时间
+ * @details 哪些字段有效由值的 TomlType 决定：LocalTime 不含日期，LocalDate 不含时间，
+ *          只有 OffsetDateTime 的 offsetMinutes 有效。
+ */
+struct TomlDateTime {
+    int32_t year = 0;
+    uint8_t month = 0;
+    uint8_t day = 0;
+    uint8_t hour = 0;
+    uint8_t minute = 0;
+    uint8_t second = 0;
+    uint32_t nanosecond = 0;
+    int16_t offsetMinutes = 0;   ///< 相对 UTC 的偏移分钟数
+
+    bool operator==(const TomlDateTime&) const = default;
+};
+
+namespace parser_detail {
+
+/// 由 [表头] 定义
+inline constexpr uint8_t kTomlExplicit = 1;
+/// 由点分键创建
+inline constexpr uint8_t kTomlDotted = 2;
+/// 内联表及其子表，定义完成后不可再扩展
+inline constexpr uint8_t kTomlInline = 4;
+/// 由 [[数组表]] 创建的数组
+inline constexpr uint8_t kTomlArrayOfTables = 8;
+
+/**
+ * @brief 文档节点
+ * @details 解析期间子节点以 first / next 串成链表；解析完成后 first 改为 children 中的起始下标，
+ *          子节点按定义顺序连续存放。根节点下标为 0，因此 0 同时表示“无节点”。
+ */
+struct TomlNode {
+    std::string_view text;       ///< 标量的规范化文本
+    union {
+        int64_t integer = 0;     ///< 整数 / 布尔值 / 日期时间在 datetimes 中的下标
+        double real;
+    };
+    InternedString key;          ///< 在父表中的键名，数组元素为空
+    uint32_t first = 0;
+    uint32_t last = 0;
+    uint32_t next = 0;
+    uint32_t count = 0;
+    TomlType type = TomlType::None;
+    uint8_t flags = 0;
+};
+
+/**
+ * @brief 文档的全部存储，解析完成后只读，由文档副本共享
+ */
+struct TomlStorage {
+    std::string source;
+    StringArena arena;
+    StringInterner keys{64, 4096};
+    std::vector<TomlNode> nodes;
+    std::vector<uint32_t> children;
+    std::vector<TomlDateTime> datetimes;
+    std::unordered_map<uint64_t, uint32_t> members;
+
+    static uint64_t memberKey(uint32_t parent, InternedString key) {
+        return (uint64_t{parent} << 32) | key.symbol().id();
+    }
+
+    /// 表成员下标，不存在时返回 0
+    uint32_t member(uint32_t parent, InternedString key) const {
+        if (!key) {
+            return 0;
+        }
+        auto iter = members.find(memberKey(parent, key));
+        return iter != members.end() ? iter->second : 0;
+    }
+};
+
+class TomlBuilder;
+
+} // namespace parser_detail
+
+/**
+ * @brief 指向文档节点的轻量句柄
+ * @details 只含存储指针与节点下标，可按值传递；在文档（或共享同一存储的副本）存活且未重新解析前有效。
+ *          默认构造或查找失败得到无效句柄，对其继续查找仍返回无效句柄，因此可以链式访问。
+ */
+class TomlView {
+public:
+    /// 遍历数组元素或表成员（按定义顺序）
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TomlView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = TomlView;
+
+        Iterator() = default;
+
+        TomlView operator*() const { return TomlView(m_storage, *m_pos); }
+
+        Iterator& operator++() {
+            ++m_pos;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator result = *this;
+            ++m_pos;
+            return result;
+        }
+
+        bool operator==(const Iterator& other) const { return m_pos == other.m_pos; }
+
+    private:
+        friend class TomlView;
+
+        Iterator(const parser_detail::TomlStorage* storage, const uint32_t* pos)
+            : m_storage(storage), m_pos(pos) {}
+
+        const parser_detail::TomlStorage* m_storage = nullptr;
+        const uint32_t* m_pos = nullptr;
+    };
+
+    TomlView() = default;
+
+    bool valid() const { return m_storage != nullptr; }
+    explicit operator bool() const { return valid(); }
+
+    TomlType type() const { return valid() ? node().type : TomlType::None; }
+    bool isTable() const { return type() == TomlType::Table; }
+    bool isArray() const { return type() == TomlType::Array; }
+    bool isString() const { return type() == TomlType::String; }
+    bool isInteger() const { return type() == TomlType::Integer; }
+    bool isFloat() const { return type() == TomlType::Float; }
+    bool isBoolean() const { return type() == TomlType::Boolean; }
+    bool isDateTime() const {
+        const TomlType kind = type();
+        return kind >= TomlType::OffsetDateTime && kind <= TomlType::LocalTime;
+    }
+
+    /// 在父表中的键名；数组元素与根表返回空视图
+    std::string_view key() const { return valid() ? node().key.view() : std::string_view{}; }
+
+    /**
+     * @brief 标量的规范化文本
+     * @details 字符串为解码后的内容，整数为十进制，浮点去除下划线与正号，布尔值与日期时间为原文；
+     *          数组与表返回空视图。
+     */
+    std::string_view text() const { return valid() ? node().text : std::string_view{}; }
+
+    /// 数组元素数或表成员数，标量为 0
+    size_t size() const { return isContainer() ? node().count : 0; }
+    bool empty() const { return size() == 0; }
+
+    std::optional<std::string_view> asString() const {
+        if (!isString()) {
+            return std::nullopt;
+        }
+        return node().text;
+    }
+
+    std::optional<int64_t> asInteger() const {
+        if (!isInteger()) {
+            return std::nullopt;
+        }
+        return node().integer;
+    }
+
+    /// 浮点值；整数按 double 返回
+    std::optional<double> asFloat() const {
+        if (isFloat()) {
+            return node().real;
+        }
+        if (isInteger()) {
+            return static_cast<double>(node().integer);
+        }
+        return std::nullopt;
+    }
+
+    std::optional<bool> asBool() const {
+        if (!isBoolean()) {
+            return std::nullopt;
+        }
+        return node().integer != 0;
+    }
+
+    std::optional<TomlDateTime> asDateTime() const {
+        if (!isDateTime()) {
+            return std::nullopt;
+        }
+        return m_storage->datetimes[static_cast<size_t>(node().integer)];
+    }
+
+    /**
+     * @brief 按类型读取
+     * @tparam T bool、整数类型（越界返回 std::nullopt）、浮点类型、std::string_view、std::string 或 TomlDateTime
+     */
+    template<typename T>
+    std::optional<T> as() const {
+        if constexpr (std::is_same_v<T, bool>) {
+            return asBool();
+        } else if constexpr (std::is_integral_v<T>) {
+            auto value = asInteger();
+            if (!value || !std::in_range<T>(*value)) {
+                return std::nullopt;
+            }
+            return static_cast<T>(*value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            auto value = asFloat();
+            if (!value) {
+                return std::nullopt;
+            }
+            return static_cast<T>(*value);
+        } else if constexpr (std::is_same_v<T, std::string_view>) {
+            return asString();
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            auto value = asString();
+            if (!value) {
+                return std::nullopt;
+            }
+            return std::string(*value);
+        } else {
+            static_assert(std::is_same_v<T, TomlDateTime>, "Unsupported TOML value type");
+            return asDateTime();
+        }
+    }
+
+    /// 按类型读取，类型不符或不存在时返回 defaultValue
+    template<typename T>
+    T valueOr(T defaultValue) const {
+        auto value = as<T>();
+        return value ? std::move(*value) : std::move(defaultValue);
+    }
+
+    /// 数组元素或第 index 个表成员
+    TomlView operator[](size_t index) const {
+        if (index >= size()) {
+            return {};
+        }
+        return TomlView(m_storage, m_storage->children[node().first + index]);
+    }
+
+    /// 表成员（单个键名，不按点拆分）
+    TomlView operator[](std::string_view key) const {
+        if (!isTable()) {
+            return {};
+        }
+        return (*this)[m_storage->keys.find(key)];
+    }
+
+    /// 用预先驻留的键名查找表成员，见 TomlDocument::findKey()
+    TomlView operator[](InternedString key) const {
+        if (!isTable()) {
+            return {};
+        }
+        const uint32_t index = m_storage->member(m_index, key);
+        return index != 0 ? TomlView(m_storage, index) : TomlView();
+    }
+
+    /**
+     * @brief 按点分路径查找
+     * @details 路径段在表上按键名查找，在数组上按十进制下标查找，如 "upstream.0.host"。
+     *          键名本身含点时改用 at({...}) 逐段查找。
+     */
+    TomlView at(std::string_view path) const {
+        TomlView current = *this;
+        while (current && !path.empty()) {
+            const size_t dot = path.find('.');
+            current = current.child(path.substr(0, dot));
+            path = dot == std::string_view::npos ? std::string_view{} : path.substr(dot + 1);
+        }
+        return current;
+    }
+
+    /// 逐段查找，段语义同 at(path)
+    TomlView at(std::initializer_list<std::string_view> path) const {
+        TomlView current = *this;
+        for (std::string_view segment : path) {
+            if (!current) {
+                break;
+            }
+            current = current.child(segment);
+        }
+        return current;
+    }
+
+    Iterator begin() const {
+        return isContainer() ? Iterator(m_storage, m_storage->children.data() + node().first) : Iterator();
+    }
+
+    Iterator end() const {
+        return isContainer() ? Iterator(m_storage, m_storage->children.data() + node().first + node().count)
+                             : Iterator();
+    }
+
+private:
+    friend class TomlDocument;
+
+    TomlView(const parser_detail::TomlStorage* storage, uint32_t index)
+        : m_storage(storage), m_index(index) {}
+
+    const parser_detail::TomlNode& node() const { return m_storage->nodes[m_index]; }
+
+    bool isContainer() const {
+        const TomlType kind = type();
+        return kind == TomlType::Array || kind == TomlType::Table;
+    }
+
+    TomlView child(std::string_view segment) const {
+        if (!isArray()) {
+            return (*this)[segment];
+        }
+        size_t index = 0;
+        const char* end = segment.data() + segment.size();
+        auto [ptr, ec] = std::from_chars(segment.data(), end, index);
+        if (ec != std::errc() || ptr != end || segment.empty()) {
+            return {};
+        }
+        return (*this)[index];
+    }
+
+    const parser_detail::TomlStorage* m_storage = nullptr;
+    uint32_t m_index = 0;
+};
+
+namespace parser_detail {
+
+/**
+ * @brief TOML 1.0 递归下降解析器
+ * @details 直接在整份输入上按字符扫描（多行字符串与数组会跨行），错误信息带行号；
+ *          行号只在出错时计算。树的嵌套深度限制为 kMaxDepth，表头与点分键的每一段、数组与内联表都计入，
+ *          冻结内联表与 TomlParser 展平时的递归因此有界。
+ */
+class TomlBuilder {
+public:
+    static constexpr int kMaxDepth = 128;
+
+    TomlBuilder(TomlStorage& storage, std::string& error)
+        : m_storage(storage), m_error(error) {}
+
+    bool run() {
+        const std::string_view text = m_storage.source;
+        m_begin = text.data();
+        m_pos = m_begin;
+        m_end = m_begin + text.size();
+
+        const size_t invalid = detail::utf8FirstInvalid(text.data(), text.size());
+        if (invalid != std::string_view::npos) {
+            m_pos = m_begin + invalid;
+            return fail("Invalid UTF-8 in TOML document");
+        }
+        if (text.starts_with("\xEF\xBB\xBF")) {
+            m_pos += 3;
+        }
+
+        // 行数是键值数的粗略上界，一次预留节点与成员索引
+        const size_t lines = static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1;
+        m_storage.nodes.reserve(lines + 1);
+        m_storage.members.reserve(lines);
+        m_storage.nodes.emplace_back();
+        m_storage.nodes[0].type = TomlType::Table;
+        m_storage.nodes[0].flags = kTomlExplicit;
+
+        uint32_t current = 0;
+        int currentDepth = 0;
+        while (m_pos < m_end) {
+            skipBlank();
+            if (m_pos == m_end) {
+                break;
+            }
+            const char character = *m_pos;
+            if (character == '[') {
+                if (!parseTableHeader(current, currentDepth)) {
+                    return false;
+                }
+            } else if (character != '#' && character != '\n' && character != '\r') {
+                if (!parseKeyValue(current, currentDepth)) {
+                    return false;
+                }
+            }
+            if (!finishLine()) {
+                return false;
+            }
+        }
+
+        seal();
+        return true;
+    }
+
+private:
+    static bool isControl(char character) {
+        const auto byte = static_cast<unsigned char>(character);
+        return (byte < 0x20 && character != '\t') || byte == 0x7F;
+    }
+
+    static bool isDigit(char character) { return character >= '0' && character <= '9'; }
+
+    static bool isBareKeyChar(char character) {
+        return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') ||
+               isDigit(character) || character == '_' || character == '-';
+    }
+
+    bool fail(std::string_view message, std::string_view detail = {}) {
+        const auto line = std::count(m_begin, m_pos, '\n') + 1;
+        m_error.assign(message);
+        m_error += " at line " + std::to_string(line);
+        if (!detail.empty()) {
+            m_error += ": ";
+            m_error += detail;
+        }
+        return false;
+    }
+
+    bool peek(char character, size_t offset = 0) const {
+        return static_cast<size_t>(m_end - m_pos) > offset && m_pos[offset] == character;
+    }
+
+    bool peekDigit(size_t offset) const {
+        return static_cast<size_t>(m_end - m_pos) > offset && isDigit(m_pos[offset]);
+    }
+
+    void skipBlank() {
+        while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\t')) {
+            ++m_pos;
+        }
+    }
+
+    /// 当前位置是换行时跳过并返回 true；单独的 '\r' 视为错误
+    bool skipNewline(bool& ok) {
+        ok = true;
+        if (peek('\n')) {
+            ++m_pos;
+            return true;
+        }
+        if (peek('\r')) {
+            if (!peek('\n', 1)) {
+                ok = fail("Invalid carriage return in TOML document");
+                return false;
+            }
+            m_pos += 2;
+            return true;
+        }
+        return false;
+    }
+
+    /// 跳过从 '#' 到行尾的注释，不消费换行
+    bool skipComment() {
+        ++m_pos;
+        while (m_pos < m_end && *m_pos != '\n') {
+            if (*m_pos == '\r' && peek('\n', 1)) {
+                break;
+            }
+            if (isControl(*m_pos)) {
+                return fail("Invalid control character in TOML comment");
+            }
+            ++m_pos;
+        }
+        return true;
+    }
+
+    /// 键值对或表头之后只允许空白、注释与换行
+    bool finishLine() {
+        skipBlank();
+        if (peek('#') && !skipComment()) {
+            return false;
+        }
+        if (m_pos == m_end) {
+            return true;
+        }
+        bool ok = true;
+        if (skipNewline(ok)) {
+            return true;
+        }
+        return ok && fail("Expected newline in TOML document", std::string_view(m_pos, 1));
+    }
+
+    /// 数组内部可以出现空白、换行与注释
+    bool skipArrayBlank() {
+        while (m_pos < m_end) {
+            skipBlank();
+            if (peek('#')) {
+                if (!skipComment()) {
+                    return false;
+                }
+                continue;
+            }
+            bool ok = true;
+            if (!skipNewline(ok)) {
+                return ok;
+            }
+        }
+        return true;
+    }
+
+    uint32_t addNode(uint32_t parent, InternedString key, TomlType type, uint8_t flags) {
+        const auto index = static_cast<uint32_t>(m_storage.nodes.size());
+        TomlNode& node = m_storage.nodes.emplace_back();
+        node.key = key;
+        node.type = type;
+        node.flags = flags;
+
+        TomlNode& owner = m_storage.nodes[parent];
+        if (owner.count == 0) {
+            owner.first = index;
+        } else {
+            m_storage.nodes[owner.last].next = index;
+        }
+        owner.last = index;
+        ++owner.count;
+        if (key) {
+            m_storage.members.emplace(TomlStorage::memberKey(parent, key), index);
+        }
+        return index;
+    }
+
+    bool parseKey() {
+        m_parts.clear();
+        while (true) {
+            skipBlank();
+            std::string_view part;
+            if (peek('"')) {
+                if (peek('"', 1) && peek('"', 2)) {
+                    return fail("Invalid TOML key");
+                }
+                if (!parseBasicString(part)) {
+                    return false;
+                }
+            } else if (peek('\'')) {
+                if (peek('\'', 1) && peek('\'', 2)) {
+                    return fail("Invalid TOML key");
+                }
+                if (!parseLiteralString(part)) {
+                    return false;
+                }
+            } else {
+                const char* start = m_pos;
+                while (m_pos < m_end && isBareKeyChar(*m_pos)) {
+                    ++m_pos;
+                }
+                if (m_pos == start) {
+                    return fail("Invalid TOML key");
+                }
+                part = std::string_view(start, static_cast<size_t>(m_pos - start));
+            }
+            m_parts.push_back(m_storage.keys.intern(part));
+            skipBlank();
+            if (!peek('.')) {
+                return true;
+            }
+            if (m_parts.size() >= static_cast<size_t>(kMaxDepth)) {
+                return fail("TOML key has too many segments");
+            }
+            ++m_pos;
+        }
+    }
+
+    /// depth 输出 current 在树中的深度，根表为 0
+    bool parseTableHeader(uint32_t& current, int& depth) {
+        ++m_pos;
+        const bool arrayOfTables = peek('[');
+        if (arrayOfTables) {
+            ++m_pos;
+        }
+        if (!parseKey()) {
+            return false;
+        }
+        if (!peek(']') || (arrayOfTables && !peek(']', 1))) {
+            return fail("Invalid TOML table header");
+        }
+        m_pos += arrayOfTables ? 2 : 1;
+
+        uint32_t table = 0;
+        int tableDepth = 0;
+        for (size_t index = 0; index + 1 < m_parts.size(); ++index) {
+            const InternedString key = m_parts[index];
+            const uint32_t child = m_storage.member(table, key);
+            ++tableDepth;
+            if (child == 0) {
+                table = addNode(table, key, TomlType::Table, 0);
+                continue;
+            }
+            const TomlNode& node = m_storage.nodes[child];
+            if (node.type == TomlType::Table && !(node.flags & kTomlInline)) {
+                table = child;
+            } else if (node.type == TomlType::Array && (node.flags & kTomlArrayOfTables)) {
+                table = node.last;
+                ++tableDepth;
+            } else {
+                return fail("TOML table conflicts with existing value", key.view());
+            }
+        }
+        depth = tableDepth + (arrayOfTables ? 2 : 1);
+        if (depth > kMaxDepth) {
+            return fail("TOML value nested too deeply");
+        }
+
+        const InternedString key = m_parts.back();
+        const uint32_t child = m_storage.member(table, key);
+        if (arrayOfTables) {
+            uint32_t array = child;
+            if (array == 0) {
+                array = addNode(table, key, TomlType::Array, kTomlArrayOfTables);
+            } else if (m_storage.nodes[array].type != TomlType::Array ||
+                       !(m_storage.nodes[array].flags & kTomlArrayOfTables)) {
+                return fail("TOML array of tables conflicts with existing value", key.view());
+            }
+            current = addNode(array, {}, TomlType::Table, kTomlExplicit);
+            return true;
+        }
+
+        if (child == 0) {
+            current = addNode(table, key, TomlType::Table, kTomlExplicit);
+            return true;
+        }
+        TomlNode& node = m_storage.nodes[child];
+        if (node.type != TomlType::Table || (node.flags & (kTomlExplicit | kTomlDotted | kTomlInline))) {
+            return fail("Duplicate TOML table", key.view());
+        }
+        node.flags |= kTomlExplicit;
+        current = child;
+        return true;
+    }
+
+    /// depth 为 table 在树中的深度，值节点位于 depth + 键段数
+    bool parseKeyValue(uint32_t table, int depth) {
+        if (!parseKey()) {
+            return false;
+        }
+        if (depth + static_cast<int>(m_parts.size()) > kMaxDepth) {
+            return fail("TOML value nested too deeply");
+        }
+        for (size_t index = 0; index + 1 < m_parts.size(); ++index) {
+            const InternedString key = m_parts[index];
+            const uint32_t child = m_storage.member(table, key);
+            if (child == 0) {
+                table = addNode(table, key, TomlType::Table, kTomlDotted);
+                continue;
+            }
+            const TomlNode& node = m_storage.nodes[child];
+            if (node.type != TomlType::Table || (node.flags & (kTomlExplicit | kTomlInline))) {
+                return fail("TOML dotted key conflicts with existing value", key.view());
+            }
+            table = child;
+        }
+
+        const InternedString key = m_parts.back();
+        if (!peek('=')) {
+            return fail("Expected '=' after TOML key", key.view());
+        }
+        ++m_pos;
+        skipBlank();
+        if (m_storage.member(table, key) != 0) {
+            return fail("Duplicate TOML key", key.view());
+        }
+        return parseValue(table, key, depth + static_cast<int>(m_parts.size()) - 1);
+    }
+
+    bool parseValue(uint32_t parent, InternedString key, int depth) {
+        if (m_pos == m_end) {
+            return fail("Missing TOML value");
+        }
+        std::string_view text;
+        switch (*m_pos) {
+            case '"':
+                if (!parseBasicString(text)) {
+                    return false;
+                }
+                addScalar(parent, key, TomlType::String, text);
+                return true;
+            case '\'':
+                if (!parseLiteralString(text)) {
+                    return false;
+                }
+                addScalar(parent, key, TomlType::String, text);
+                return true;
+            case 't':
+            case 'f':
+                return parseBool(parent, key);
+            case '[':
+                return parseArray(parent, key, depth);
+            case '{':
+                return parseInlineTable(parent, key, depth);
+            default:
+                if (peekDigit(0) && peekDigit(1) && ((peekDigit(2) && peekDigit(3) && peek('-', 4)) || peek(':', 2))) {
+                    return parseDateTime(parent, key);
+                }
+                return parseNumber(parent, key);
+        }
+    }
+
+    uint32_t addScalar(uint32_t parent, InternedString key, TomlType type, std::string_view text) {
+        const uint32_t index = addNode(parent, key, type, 0);
+        m_storage.nodes[index].text = text;
+        return index;
+    }
+
+    bool parseBool(uint32_t parent, InternedString key) {
+        const std::string_view rest(m_pos, static_cast<size_t>(m_end - m_pos));
+        for (std::string_view literal : {std::string_view("true"), std::string_view("false")}) {
+            if (rest.starts_with(literal) && (rest.size() == literal.size() || !isBareKeyChar(rest[literal.size()]))) {
+                const uint32_t index = addScalar(parent, key, TomlType::Boolean, rest.substr(0, literal.size()));
+                m_storage.nodes[index].integer = literal.size() == 4 ? 1 : 0;
+                m_pos += literal.size();
+                return true;
+            }
+        }
+        return fail("Invalid TOML value");
+    }
+
+    bool parseBasicString(std::string_view& out) {
+        const bool multiline = peek('"', 1) && peek('"', 2);
+        m_pos += multiline ? 3 : 1;
+        if (multiline) {
+            bool ok = true;
+            skipNewline(ok);
+            if (!ok) {
+                return false;
+            }
+        }
+        const char* start = m_pos;
+        const char* contentEnd = nullptr;
+        while (contentEnd == nullptr) {
+            if (m_pos == m_end) {
+                return fail("Unterminated TOML string");
+            }
+            const char character = *m_pos;
+            if (character == '\\') {
+                m_pos += 2;
+                if (m_pos > m_end) {
+                    m_pos = m_end;
+                    return fail("Unterminated TOML string");
+                }
+                continue;
+            }
+            if (character == '"') {
+                if (!multiline) {
+                    contentEnd = m_pos++;
+                    break;
+                }
+                if (!closeMultiline('"', contentEnd)) {
+                    return false;
+                }
+                continue;
+            }
+            if (character == '\n' || character == '\r') {
+                if (!multiline) {
+                    return fail("Unterminated TOML string");
+                }
+                bool ok = true;
+                skipNewline(ok);
+                if (!ok) {
+                    return false;
+                }
+                continue;
+            }
+            if (isControl(character)) {
+                return fail("Invalid control character in TOML string");
+            }
+            ++m_pos;
+        }
+        return decodeBasic(std::string_view(start, static_cast<size_t>(contentEnd - start)), multiline, out);
+    }
+
+    bool parseLiteralString(std::string_view& out) {
+        const bool multiline = peek('\'', 1) && peek('\'', 2);
+        m_pos += multiline ? 3 : 1;
+        if (multiline) {
+            bool ok = true;
+            skipNewline(ok);
+            if (!ok) {
+                return false;
+            }
+        }
+        const char* start = m_pos;
+        const char* contentEnd = nullptr;
+        while (contentEnd == nullptr) {
+            if (m_pos == m_end) {
+                return fail("Unterminated TOML string");
+            }
+            const char character = *m_pos;
+            if (character == '\'') {
+                if (!multiline) {
+                    contentEnd = m_pos++;
+                    break;
+                }
+                if (!closeMultiline('\'', contentEnd)) {
+                    return false;
+                }
+                continue;
+            }
+            if (character == '\n' || character == '\r') {
+                if (!multiline) {
+                    return fail("Unterminated TOML string");
+                }
+                bool ok = true;
+                skipNewline(ok);
+                if (!ok) {
+                    return false;
+                }
+                continue;
+            }
+            if (isControl(character)) {
+                return fail("Invalid control character in TOML string");
+            }
+            ++m_pos;
+        }
+        out = std::string_view(start, static_cast<size_t>(contentEnd - start));
+        return true;
+    }
+
+    /// 多行字符串中遇到引号：连续 3 到 5 个引号时最后 3 个是结束符，前面的属于内容
+    bool closeMultiline(char quote, const char*& contentEnd) {
+        size_t run = 0;
+        while (peek(quote, run)) {
+            ++run;
+        }
+        if (run < 3) {
+            m_pos += run;
+            return true;
+        }
+        if (run > 5) {
+            return fail("Too many quotes in TOML multi-line string");
+        }
+        contentEnd = m_pos + run - 3;
+        m_pos += run;
+        return true;
+    }
+
+    static int hexValue(char character) {
+        if (isDigit(character)) {
+            return character - '0';
+        }
+        if (character >= 'a' && character <= 'f') {
+            return character - 'a' + 10;
+        }
+        if (character >= 'A' && character <= 'F') {
+            return character - 'A' + 10;
+        }
+        return -1;
+    }
+
+    static size_t encodeUtf8(uint32_t code, char* out) {
+        if (code < 0x80) {
+            out[0] = static_cast<char>(code);
+            return 1;
+        }
+        if (code < 0x800) {
+            out[0] = static_cast<char>(0xC0 | (code >> 6));
+            out[1] = static_cast<char>(0x80 | (code & 0x3F));
+            return 2;
+        }
+        if (code < 0x10000) {
+            out[0] = static_cast<char>(0xE0 | (code >> 12));
+            out[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out[2] = static_cast<char>(0x80 | (code & 0x3F));
+            return 3;
+        }
+        out[0] = static_cast<char>(0xF0 | (code >> 18));
+        out[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out[3] = static_cast<char>(0x80 | (code & 0x3F));
+        return 4;
+    }
+
+    /// 解码基本字符串；无转义时直接返回输入视图，否则写入 arena（输出不长于输入）
+    bool decodeBasic(std::string_view raw, bool multiline, std::string_view& out) {
+        if (raw.find('\\') == std::string_view::npos) {
+            out = raw;
+            return true;
+        }
+        char* data = m_storage.arena.allocate(raw.size());
+        size_t length = 0;
+        size_t index = 0;
+        while (index < raw.size()) {
+            if (raw[index] != '\\') {
+                data[length++] = raw[index++];
+                continue;
+            }
+            const char escaped = raw[++index];
+            ++index;
+            switch (escaped) {
+                case 'b': data[length++] = '\b'; break;
+                case 't': data[length++] = '\t'; break;
+                case 'n': data[length++] = '\n'; break;
+                case 'f': data[length++] = '\f'; break;
+                case 'r': data[length++] = '\r'; break;
+                case '"': data[length++] = '"'; break;
+                case '\\': data[length++] = '\\'; break;
+                case 'u':
+                case 'U': {
+                    const size_t digits = escaped == 'u' ? 4 : 8;
+                    if (index + digits > raw.size()) {
+                        return fail("Invalid TOML unicode escape");
+                    }
+                    uint32_t code = 0;
+                    for (size_t offset = 0; offset < digits; ++offset) {
+                        const int value = hexValue(raw[index + offset]);
+                        if (value < 0) {
+                            return fail("Invalid TOML unicode escape");
+                        }
+                        code = (code << 4) | static_cast<uint32_t>(value);
+                    }
+                    if (code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+                        return fail("Invalid TOML unicode scalar value");
+                    }
+                    index += digits;
+                    length += encodeUtf8(code, data + length);
+                    break;
+                }
+                default: {
+                    // 行尾反斜杠：吞掉其后的空白与换行
+                    size_t cursor = index - 1;
+                    while (multiline && cursor < raw.size() && (raw[cursor] == ' ' || raw[cursor] == '\t')) {
+                        ++cursor;
+                    }
+                    // 扫描阶段跳过了反斜杠后的第一个字符，这里补验 CR 必须与 LF 成对
+                    const bool lineEnd = cursor < raw.size() &&
+                                         (raw[cursor] == '\n' ||
+                                          (raw[cursor] == '\r' && cursor + 1 < raw.size() && raw[cursor + 1] == '\n'));
+                    if (!multiline || !lineEnd) {
+                        return fail("Invalid TOML escape");
+                    }
+                    while (cursor < raw.size() && isSpace(raw[cursor])) {
+                        ++cursor;
+                    }
+                    index = cursor;
+                    break;
+                }
+            }
+        }
+        out = std::string_view(data, length);
+        return true;
+    }
+
+    /// 读取下划线分隔的数字串，下划线两侧必须都是数字；返回是否读到至少一位
+    static bool scanDigits(std::string_view text, size_t& index, int base) {
+        const size_t start = index;
+        bool previousDigit = false;
+        while (index < text.size()) {
+            const char character = text[index];
+            if (character == '_') {
+                if (!previousDigit || index + 1 >= text.size() || hexValue(text[index + 1]) < 0 ||
+                    hexValue(text[index + 1]) >= base) {
+                    return false;
+                }
+                previousDigit = false;
+                ++index;
+                continue;
+            }
+            const int value = hexValue(character);
+            if (value < 0 || value >= base) {
+                break;
+            }
+            previousDigit = true;
+            ++index;
+        }
+        return index > start;
+    }
+
+    /// 去除下划线与正号后写入 m_scratch
+    void stripNumber(std::string_view text) {
+        m_scratch.clear();
+        for (char character : text) {
+            if (character != '_' && character != '+') {
+                m_scratch += character;
+            }
+        }
+    }
+
+    bool parseNumber(uint32_t parent, InternedString key) {
+        const char* start = m_pos;
+        while (m_pos < m_end && (isBareKeyChar(*m_pos) || *m_pos == '+' || *m_pos == '.')) {
+            ++m_pos;
+        }
+        const std::string_view token(start, static_cast<size_t>(m_pos - start));
+        if (token.empty()) {
+            return fail("Invalid TOML value");
+        }
+        const bool hasSign = token.front() == '+' || token.front() == '-';
+        const std::string_view body = token.substr(hasSign ? 1 : 0);
+
+        if (body == "inf" || body == "nan") {
+            double value = body == "inf" ? std::numeric_limits<double>::infinity()
+                                         : std::numeric_limits<double>::quiet_NaN();
+            if (token.front() == '-') {
+                value = -value;
+            }
+            const uint32_t index = addScalar(parent, key, TomlType::Float, token.front() == '+' ? body : token);
+            m_storage.nodes[index].real = value;
+            return true;
+        }
+
+        if (body.size() > 2 && body[0] == '0' && (body[1] == 'x' || body[1] == 'o' || body[1] == 'b')) {
+            const int base = body[1] == 'x' ? 16 : (body[1] == 'o' ? 8 : 2);
+            size_t index = 2;
+            if (hasSign || !scanDigits(body, index, base) || index != body.size()) {
+                return fail("Invalid TOML integer", token);
+            }
+            stripNumber(body.substr(2));
+            int64_t value = 0;
+            auto [ptr, ec] = std::from_chars(m_scratch.data(), m_scratch.data() + m_scratch.size(), value, base);
+            if (ec != std::errc()) {
+                return fail("TOML integer out of range", token);
+            }
+            char buffer[24];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            const std::string_view text(buffer, static_cast<size_t>(result.ptr - buffer));
+            const uint32_t node = addScalar(parent, key, TomlType::Integer, m_storage.arena.store(text));
+            m_storage.nodes[node].integer = value;
+            return true;
+        }
+
+        size_t index = 0;
+        if (!scanDigits(body, index, 10) || (body[0] == '0' && index > 1)) {
+            return fail("Invalid TOML number", token);
+        }
+        bool isFloat = false;
+        if (index < body.size() && body[index] == '.') {
+            isFloat = true;
+            ++index;
+            if (!scanDigits(body, index, 10)) {
+                return fail("Invalid TOML float", token);
+            }
+        }
+        if (index < body.size() && (body[index] == 'e' || body[index] == 'E')) {
+            isFloat = true;
+            ++index;
+            if (index < body.size() && (body[index] == '+' || body[index] == '-')) {
+                ++index;
+            }
+            if (!scanDigits(body, index, 10)) {
+                return fail("Invalid TOML float", token);
+            }
+        }
+        if (index != body.size()) {
+            return fail("Invalid TOML number", token);
+        }
+
+        const bool canonical = token.front() != '+' && token.find('_') == std::string_view::npos;
+        stripNumber(token);
+        const char* first = m_scratch.data();
+        const char* last = first + m_scratch.size();
+        const std::string_view text = canonical ? token : m_storage.arena.store(m_scratch);
+        if (isFloat) {
+            double value = 0;
+            auto [ptr, ec] = std::from_chars(first, last, value);
+            if (ec != std::errc() || ptr != last) {
+                return fail("TOML float out of range", token);
+            }
+            m_storage.nodes[addScalar(parent, key, TomlType::Float, text)].real = value;
+            return true;
+        }
+        int64_t value = 0;
+        auto [ptr, ec] = std::from_chars(first, last, value);
+        if (ec != std::errc() || ptr != last) {
+            return fail("TOML integer out of range", token);
+        }
+        m_storage.nodes[addScalar(parent, key, TomlType::Integer, text)].integer = value;
+        return true;
+    }
+
+    bool readNumber(size_t digits, int& value) {
+        value = 0;
+        for (size_t index = 0; index < digits; ++index) {
+            if (!peekDigit(0)) {
+                return false;
+            }
+            value = value * 10 + (*m_pos++ - '0');
+        }
+        return true;
+    }
+
+    bool readSeparated(char separator, int& value) {
+        if (!peek(separator)) {
+            return false;
+        }
+        ++m_pos;
+        return readNumber(2, value);
+    }
+
+    static int daysInMonth(int year, int month) {
+        static constexpr int kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        return month == 2 && leap ? 29 : kDays[month - 1];
+    }
+
+    bool parseDateTime(uint32_t parent, InternedString key) {
+        const char* start = m_pos;
+        TomlDateTime value;
+        bool hasDate = false;
+        bool hasTime = true;
+        bool hasOffset = false;
+        int year = 0;
+        int month = 0;
+        int day = 0;
+
+        if (peek('-', 4)) {
+            if (!readNumber(4, year) || !readSeparated('-', month) || !readSeparated('-', day) ||
+                month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+                return fail("Invalid TOML date");
+            }
+            hasDate = true;
+            value.year = year;
+            value.month = static_cast<uint8_t>(month);
+            value.day = static_cast<uint8_t>(day);
+            if (peek('T') || peek('t') || (peek(' ') && peekDigit(1))) {
+                ++m_pos;
+            } else {
+                hasTime = false;
+            }
+        }
+
+        if (hasTime) {
+            int hour = 0;
+            int minute = 0;
+            int second = 0;
+            if (!readNumber(2, hour) || !readSeparated(':', minute) || !readSeparated(':', second) ||
+                hour > 23 || minute > 59 || second > 60) {
+                return fail("Invalid TOML time");
+            }
+            value.hour = static_cast<uint8_t>(hour);
+            value.minute = static_cast<uint8_t>(minute);
+            value.second = static_cast<uint8_t>(second);
+            if (peek('.')) {
+                ++m_pos;
+                if (!peekDigit(0)) {
+                    return fail("Invalid TOML time");
+                }
+                uint32_t scale = 100'000'000;
+                while (peekDigit(0)) {
+                    value.nanosecond += static_cast<uint32_t>(*m_pos++ - '0') * scale;
+                    scale /= 10;
+                }
+            }
+            if (hasDate && (peek('Z') || peek('z'))) {
+                ++m_pos;
+                hasOffset = true;
+            } else if (hasDate && (peek('+') || peek('-'))) {
+                const int sign = *m_pos++ == '-' ? -1 : 1;
+                int offsetHour = 0;
+                int offsetMinute = 0;
+                if (!readNumber(2, offsetHour) || !readSeparated(':', offsetMinute) ||
+                    offsetHour > 23 || offsetMinute > 59) {
+                    return fail("Invalid TOML time offset");
+                }
+                value.offsetMinutes = static_cast<int16_t>(sign * (offsetHour * 60 + offsetMinute));
+                hasOffset = true;
+            }
+        }
+
+        TomlType type = TomlType::LocalTime;
+        if (hasDate) {
+            type = !hasTime ? TomlType::LocalDate : (hasOffset ? TomlType::OffsetDateTime : TomlType::LocalDateTime);
+        }
+        const uint32_t index = addScalar(parent, key, type, std::string_view(start, static_cast<size_t>(m_pos - start)));
+        m_storage.nodes[index].integer = static_cast<int64_t>(m_storage.datetimes.size());
+        m_storage.datetimes.push_back(value);
+        return true;
+    }
+
+    bool parseArray(uint32_t parent, InternedString key, int depth) {
+        if (depth >= kMaxDepth) {
+            return fail("TOML value nested too deeply");
+        }
+        const uint32_t array = addNode(parent, key, TomlType::Array, 0);
+        ++m_pos;
+        while (true) {
+            if (!skipArrayBlank()) {
+                return false;
+            }
+            if (peek(']')) {
+                ++m_pos;
+                return true;
+            }
+            if (m_pos == m_end) {
+                return fail("Unterminated TOML array");
+            }
+            if (!parseValue(array, {}, depth + 1) || !skipArrayBlank()) {
+                return false;
+            }
+            if (peek(',')) {
+                ++m_pos;
+            } else if (peek(']')) {
+                ++m_pos;
+                return true;
+            } else {
+                return fail(m_pos == m_end ? "Unterminated TOML array" : "Expected ',' or ']' in TOML array");
+            }
+        }
+    }
+
+    bool parseInlineTable(uint32_t parent, InternedString key, int depth) {
+        if (depth >= kMaxDepth) {
+            return fail("TOML value nested too deeply");
+        }
+        const uint32_t table = addNode(parent, key, TomlType::Table, 0);
+        ++m_pos;
+        skipBlank();
+        if (peek('}')) {
+            ++m_pos;
+            freeze(table);
+            return true;
+        }
+        while (true) {
+            if (!parseKeyValue(table, depth + 1)) {
+                return false;
+            }
+            skipBlank();
+            if (peek(',')) {
+                ++m_pos;
+            } else if (peek('}')) {
+                ++m_pos;
+                freeze(table);
+                return true;
+            } else {
+                return fail("Expected ',' or '}' in TOML inline table");
+            }
+        }
+    }
+
+    /// 内联表及其中由点分键创建的子表在定义完成后不可扩展
+    void freeze(uint32_t table) {
+        TomlNode& node = m_storage.nodes[table];
+        node.flags |= kTomlInline;
+        uint32_t child = node.count != 0 ? node.first : 0;
+        for (uint32_t index = 0; index < m_storage.nodes[table].count; ++index) {
+            if (m_storage.nodes[child].type == TomlType::Table) {
+                freeze(child);
+            }
+            child = m_storage.nodes[child].next;
+        }
+    }
+
+    /// 把各容器的子节点链表整理为 children 中的连续区间
+    void seal() {
+        auto& nodes = m_storage.nodes;
+        auto& children = m_storage.children;
+        children.reserve(nodes.size() - 1);
+        for (TomlNode& node : nodes) {
+            if (node.type != TomlType::Array && node.type != TomlType::Table) {
+                continue;
+            }
+            const auto offset = static_cast<uint32_t>(children.size());
+            uint32_t child = node.first;
+            for (uint32_t index = 0; index < node.count; ++index) {
+                children.push_back(child);
+                child = nodes[child].next;
+            }
+            node.first = offset;
+        }
+    }
+
+    TomlStorage& m_storage;
+    std::string& m_error;
+    const char* m_begin = nullptr;
+    const char* m_pos = nullptr;
+    const char* m_end = nullptr;
+    std::vector<InternedString> m_parts;
+    std::string m_scratch;
+};
+
+} // namespace parser_detail
+
+/**
+ * @brief TOML 1.0 文档
+ * @details 解析成功后只读；复制文档只复制共享指针，副本与原文档共享同一份存储。
+ *          重新解析换用新的存储，此前取得的 TomlView 仍指向旧存储，仅在旧存储仍被某个副本持有时有效。
+ *
+ * @code
+ * TomlDocument doc;
+ * if (doc.parseFile("service.toml")) {
+ *     for (TomlView upstream : doc["upstream"]) {
+ *         auto host = upstream["host"].valueOr<std::string_view>("localhost");
+ *         auto port = upstream["port"].valueOr<int>(80);
+ *     }
+ *     auto timeout = doc.at("server.timeout_ms").valueOr<int64_t>(1000);
+ * }
+ * @endcode
+ */
+class TomlDocument {
+public:
+    TomlDocument() = default;
+
+    /**
+     * @brief 解析 TOML 文本，文档接管输入
+     * @return 失败时返回 false，文档变为空，lastError() 给出带行号的原因
+     */
+    bool parseString(std::string content) {
+        auto storage = std::make_shared<parser_detail::TomlStorage>();
+        storage->source = std::move(content);
+        m_last_error.clear();
+        parser_detail::TomlBuilder builder(*storage, m_last_error);
+        if (!builder.run()) {
+            m_storage.reset();
+            return false;
+        }
+        m_storage = std::move(storage);
+        return true;
+    }
+
+    bool parseFile(const std::string& path) {
+        auto content = System::readFileStream(path);
+        if (!content) {
+            m_storage.reset();
+            m_last_error = "Failed to open file: " + path;
+            return false;
+        }
+        return parseString(std::move(*content));
+    }
+
+    const std::string& lastError() const { return m_last_error; }
+
+    /// 根表；未成功解析时返回无效句柄
+    TomlView root() const { return m_storage ? TomlView(m_storage.get(), 0) : TomlView(); }
+
+    TomlView operator[](std::string_view key) const { return root()[key]; }
+    TomlView operator[](InternedString key) const { return root()[key]; }
+    TomlView at(std::string_view path) const { return root().at(path); }
+    TomlView at(std::initializer_list<std::string_view> path) const { return root().at(path); }
+
+    /**
+     * @brief 取得本文档中已驻留的键名，供热路径按 InternedString 查找表成员
+     * @return 文档中没有该键名时返回无效句柄；句柄仅对本次解析结果有效
+     */
+    InternedString findKey(std::string_view key) const {
+        return m_storage ? m_storage->keys.find(key) : InternedString();
+    }
+
+    /// 节点数（含根表）
+    size_t nodeCount() const { return m_storage ? m_storage->nodes.size() : 0; }
+
+private:
+    std::shared_ptr<const parser_detail::TomlStorage> m_storage;
+    std::string m_last_error;
+};
+
+} // namespace galay::utils
+
+#endif // GALAY_UTILS_PARSER_TOML_DOCUMENT_HPP
@@ -0,0 +1,447 @@
+/**
+ * @file typed_config.hpp
+ * @brief 预解析的类型化配置存储与键句柄
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details TypedConfig 在加载时把解析器中的每个值一次性解析为字符串、bool、整数、浮点和数组，
+ *          按槽位连续存放；ConfigKey<T> 在绑定时把键名解析为槽位下标并校验类型，
+ *          之后的读取只是一次下标访问，不再哈希键名、复制字符串或重新解析。
+ *          数组以 std::span 读取，不含逗号的值按单元素数组返回，不额外分配。
+ *          以旧配置为布局重新加载时保留原有槽位下标，已创建的句柄可继续用于新配置。
+ */
+
+#ifndef GALAY_UTILS_PARSER_TYPED_CONFIG_HPP
+#define GALAY_UTILS_PARSER_TYPED_CONFIG_HPP
+
+#include "galay-utils/config/cursor.hpp"
+#include "galay-utils/config/detail.hpp"
+#include "galay-utils/config/parser_base.hpp"
+#include "galay-utils/core/string.hpp"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace galay::utils {
+
+/**
+ * @brief TypedConfig 支持的值类型
+ * @details bool、整数、浮点、std::string 以及 std::vector<std::string>（数组）。
+ */
+template<typename T>
+concept ConfigValueType = detail::FastNumeric<T> ||
+                          std::is_same_v<T, std::string> ||
+                          std::is_same_v<T, std::vector<std::string>>;
+
+/// 读取结果：数值按值返回，字符串返回存储内的引用，数组返回指向存储的 span
+template<ConfigValueType T>
+using ConfigRead = std::conditional_t<std::is_arithmetic_v<T>, T,
+                   std::conditional_t<std::is_same_v<T, std::string>, const std::string&,
+                                      std::span<const std::string>>>;
+
+class TypedConfig;
+class ConfigWatcher;
+
+/// 配置项变更类型
+enum class ConfigChangeKind {
+    Added,
+    Removed,
+    Modified
+};
+
+/**
+ * @brief 两份配置之间单个键的变更
+ */
+struct ConfigChange {
+    ConfigChangeKind kind;
+    std::string key;
+    std::string oldValue;   ///< Added 时为空
+    std::string newValue;   ///< Removed 时为空
+};
+
+/**
+ * @brief 绑定到 TypedConfig 槽位的类型化键句柄
+ * @tparam T 值类型
+ * @details 由 TypedConfig::key() 或 ConfigWatcher::key() 创建。键名存在即绑定到其槽位，
+ *          类型在每次读取时检查，值无法转换为 T 时读取返回默认值。
+ *          句柄对创建它的 TypedConfig 以及以它为布局加载的后续配置有效；
+ *          句柄记录布局代数，后续配置压缩过布局后改按键名查找。
+ */
+template<ConfigValueType T>
+class ConfigKey {
+public:
+    static constexpr uint32_t kUnbound = std::numeric_limits<uint32_t>::max();
+
+    ConfigKey() = default;
+
+    /// 是否绑定到了有效槽位
+    bool bound() const { return m_slot != kUnbound; }
+
+    /// 槽位下标，未绑定时为 kUnbound
+    uint32_t slot() const { return m_slot; }
+
+    /// 创建句柄时的布局代数，与读取配置的代数不同时下标失效
+    uint32_t generation() const { return m_generation; }
+
+    /// 键名
+    const std::string& name() const { return m_name; }
+
+    /// 未绑定时返回的默认值
+    const T& defaultValue() const { return m_default; }
+
+private:
+    friend class TypedConfig;
+    friend class ConfigWatcher;
+
+    ConfigKey(uint32_t slot, uint32_t generation, std::string name, T defaultValue)
+        : m_slot(slot), m_generation(generation), m_name(std::move(name)), m_default(std::move(defaultValue)) {}
+
+    uint32_t m_slot = kUnbound;
+    uint32_t m_generation = 0;
+    std::string m_name;
+    T m_default{};
+};
+
+/**
+ * @brief 加载时预解析全部值的只读配置存储
+ * @details 从任意解析器构造：逐键读取原始文本，解析出 bool / 整数 / 浮点 / 数组并存入槽位。
+ *          含逗号的值才切分为数组，优先使用解析器自身的 getArray()（如 TOML 数组），否则按逗号切分。
+ *          构造后不再修改，可在多个线程间共享只读访问。
+ *          以旧配置为布局加载时，旧配置中的每个键保持原槽位，已删除的键留作空槽，
+ *          随后是调用方预留的键名，新增键追加在最后。
+ *          空槽多于有效键时加载后压缩布局：丢弃空槽并递增布局代数，旧代数的句柄改按键名查找，
+ *          因此长期运行、键集合不断变化时槽位数不超过有效键数的两倍。
+ */
+class TypedConfig {
+public:
+    TypedConfig() = default;
+
+    /**
+     * @brief 从解析器加载全部键值
+     * @tparam Parser ParserBase 派生类型
+     */
+    template<typename Parser>
+        requires std::is_base_of_v<ParserBase, Parser>
+    explicit TypedConfig(const Parser& parser) {
+        load(parser);
+    }
+
+    /**
+     * @brief 以 layout 的槽位布局加载解析器中的键值
+     * @param reserved 预留的键名，依次占用 layout.slotCount() 起的槽位；须不在 layout 中
+     * @details layout 中每个键保持原槽位下标（本次不存在的键成为空槽），预留键名紧随其后，
+     *          新增键追加在最后，因此基于 layout 创建的 ConfigKey 以及按预留下标创建的句柄可直接读取新配置。
+     *          空槽多于有效键时压缩布局，此后旧句柄按键名查找，重新调用 key() 可恢复下标读取。
+     */
+    template<typename Parser>
+        requires std::is_base_of_v<ParserBase, Parser>
+    TypedConfig(const Parser& parser, const TypedConfig& layout, std::span<const std::string> reserved = {}) {
+        m_slots.reserve(layout.m_slots.size() + reserved.size());
+        m_index.reserve(layout.m_slots.size() + reserved.size());
+        for (const Slot& previous : layout.m_slots) {
+            addEmptySlot(previous.name);
+        }
+        for (const std::string& name : reserved) {
+            addEmptySlot(name);
+        }
+        m_generation = layout.m_generation;
+        load(parser);
+        if (m_slots.size() - m_present > m_present) {
+            compact();
+        }
+    }
+
+    TypedConfig(TypedConfig&&) noexcept = default;
+    TypedConfig& operator=(TypedConfig&&) noexcept = default;
+
+    /**
+     * @brief 绑定键名，返回类型化句柄
+     * @param name 键名（点分节表示法）
+     * @param defaultValue 键不存在或值无法转换为 T 时的读取结果
+     * @details 键名在槽位布局中即绑定（含布局保留的空槽），不检查当前值的类型，
+     *          以便后续配置修正取值后句柄能读到新值；布局中没有该键名时句柄未绑定。
+     *          整数要求值完整匹配且落在 T 的取值范围内；bool 接受 true / false / 1 / 0。
+     */
+    template<ConfigValueType T>
+    ConfigKey<T> key(std::string_view name, T defaultValue = T{}) const {
+        auto iter = m_index.find(name);
+        if (iter == m_index.end()) {
+            return ConfigKey<T>(ConfigKey<T>::kUnbound, m_generation, std::string(name), std::move(defaultValue));
+        }
+        return ConfigKey<T>(iter->second, m_generation, std::string(name), std::move(defaultValue));
+    }
+
+    /**
+     * @brief 按句柄读取值
+     * @details 句柄须由本对象或其布局来源的 key() 创建。句柄未绑定、键已删除或新值无法转换为 T 时
+     *          返回句柄的默认值，此时字符串引用与数组 span 指向句柄自身，需在句柄存活期间使用。
+     *          句柄的布局代数与本对象不同时按键名查找。
+     */
+    template<ConfigValueType T>
+    ConfigRead<T> get(const ConfigKey<T>& key) const {
+        const Slot* found = resolve(key);
+        if (found == nullptr || !accepts<T>(*found)) {
+            return key.defaultValue();
+        }
+        const Slot& slot = *found;
+        if constexpr (std::is_same_v<T, bool>) {
+            return slot.boolean;
+        } else if constexpr (std::is_integral_v<T>) {
+            return static_cast<T>(slot.integer);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<T>(slot.real);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return slot.text;
+        } else {
+            if (slot.kinds & kList) {
+                return slot.array;
+            }
+            return slot.text.empty() ? std::span<const std::string>{} : std::span<const std::string>(&slot.text, 1);
+        }
+    }
+
+    /// 键是否存在
+    bool contains(std::string_view name) const {
+        auto iter = m_index.find(name);
+        return iter != m_index.end() && (m_slots[iter->second].kinds & kPresent);
+    }
+
+    /// 键的原始文本，不存在时返回 std::nullopt
+    std::optional<std::string_view> text(std::string_view name) const {
+        auto iter = m_index.find(name);
+        if (iter == m_index.end() || !(m_slots[iter->second].kinds & kPresent)) {
+            return std::nullopt;
+        }
+        return std::string_view(m_slots[iter->second].text);
+    }
+
+    /**
+     * @brief 遍历全部键与原始文本（按槽位顺序）
+     * @param visitor 以 (std::string_view key, std::string_view text) 调用
+     */
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        for (const Slot& slot : m_slots) {
+            if (slot.kinds & kPresent) {
+                visitor(slot.name, std::string_view(slot.text));
+            }
+        }
+    }
+
+    /// 键的数量（不含布局保留的空槽）
+    size_t size() const { return m_present; }
+
+    /// 槽位数量（含空槽），句柄下标小于该值
+    size_t slotCount() const { return m_slots.size(); }
+
+    /// 布局代数：压缩布局时递增，以本对象为布局的加载若未压缩则沿用
+    uint32_t generation() const { return m_generation; }
+
+    /**
+     * @brief 比较两份配置的原始文本，返回逐键变更
+     * @details after 以 before 为布局加载时按槽位逐一比较，不需要哈希查找；否则按键名查找。
+     */
+    static std::vector<ConfigChange> diff(const TypedConfig& before, const TypedConfig& after) {
+        std::vector<ConfigChange> changes;
+        for (size_t index = 0; index < after.m_slots.size(); ++index) {
+            const Slot& current = after.m_slots[index];
+            const Slot* previous = before.matchingSlot(index, current.name);
+            const bool had = previous != nullptr && (previous->kinds & kPresent);
+            const bool has = (current.kinds & kPresent) != 0;
+            if (has && !had) {
+                changes.push_back({ConfigChangeKind::Added, std::string(current.name), {}, current.text});
+            } else if (has && previous->text != current.text) {
+                changes.push_back({ConfigChangeKind::Modified, std::string(current.name), previous->text, current.text});
+            } else if (!has && had) {
+                changes.push_back({ConfigChangeKind::Removed, std::string(current.name), previous->text, {}});
+            }
+        }
+        for (size_t index = 0; index < before.m_slots.size(); ++index) {
+            const Slot& previous = before.m_slots[index];
+            if ((previous.kinds & kPresent) && after.matchingSlot(index, previous.name) == nullptr) {
+                changes.push_back({ConfigChangeKind::Removed, std::string(previous.name), previous.text, {}});
+            }
+        }
+        return changes;
+    }
+
+private:
+    enum Kind : uint8_t {
+        kBool = 1u << 0,
+        kSigned = 1u << 1,     ///< 整数，存于 integer
+        kUnsigned = 1u << 2,   ///< 超出 int64_t 的无符号整数，按位存于 integer
+        kReal = 1u << 3,
+        kList = 1u << 4,       ///< 含逗号，切分结果存于 array
+        kPresent = 1u << 5     ///< 键存在；布局保留的空槽没有此位
+    };
+
+    struct Slot {
+        std::string_view name;
+        std::string text;
+        std::vector<std::string> array;   ///< 仅 kList 时非空
+        int64_t integer = 0;
+        double real = 0.0;
+        bool boolean = false;
+        uint8_t kinds = 0;
+    };
+
+    template<ConfigValueType T>
+    const Slot* resolve(const ConfigKey<T>& key) const {
+        if (key.generation() == m_generation) {
+            // kUnbound 大于任何槽位下标，一次比较同时排除未绑定句柄
+            return key.slot() < m_slots.size() ? &m_slots[key.slot()] : nullptr;
+        }
+        auto iter = m_index.find(key.name());
+        return iter != m_index.end() ? &m_slots[iter->second] : nullptr;
+    }
+
+    /// 丢弃空槽并重建键名存储与索引，使旧代数的句柄改按键名查找
+    void compact() {
+        parser_detail::StringArena keys;
+        std::vector<Slot> slots;
+        slots.reserve(m_present);
+        m_index.clear();
+        for (Slot& slot : m_slots) {
+            if (!(slot.kinds & kPresent)) {
+                continue;
+            }
+            slot.name = keys.store(slot.name);
+            m_index.emplace(slot.name, static_cast<uint32_t>(slots.size()));
+            slots.push_back(std::move(slot));
+        }
+        m_keys = std::move(keys);
+        m_slots = std::move(slots);
+        ++m_generation;
+    }
+
+    void addEmptySlot(std::string_view name) {
+        Slot slot;
+        slot.name = m_keys.store(name);
+        m_index.emplace(slot.name, static_cast<uint32_t>(m_slots.size()));
+        m_slots.push_back(std::move(slot));
+    }
+
+    template<typename Parser>
+    void load(const Parser& parser) {
+        if constexpr (requires { parser.forEachValue([](std::string_view, std::string_view) {}); }) {
+            size_t count = 0;
+            parser.forEachValue([&count](std::string_view, std::string_view) { ++count; });
+            m_slots.reserve(m_slots.size() + count);
+            m_index.reserve(m_slots.size() + count);
+            parser.forEachValue([this, &parser](std::string_view key, std::string_view value) {
+                addSlot(parser, key, value);
+            });
+        } else {
+            auto keys = parser.getKeys();
+            m_slots.reserve(m_slots.size() + keys.size());
+            m_index.reserve(m_slots.size() + keys.size());
+            for (const auto& key : keys) {
+                addSlot(parser, key, parser.getValue(key).value_or(std::string{}));
+            }
+        }
+    }
+
+    template<typename Parser>
+    void addSlot(const Parser& parser, std::string_view key, std::string_view value) {
+        Slot slot;
+        slot.text = std::string(value);
+        slot.kinds = kPresent;
+        if (value.find(',') != std::string_view::npos) {
+            if constexpr (requires { parser.getArray(std::string{}); }) {
+                slot.array = parser.getArray(std::string(key));
+            } else {
+                slot.array = parser_detail::splitCommaSeparated(slot.text);
+            }
+            slot.kinds |= kList;
+        }
+        parseScalars(slot);
+        ++m_present;
+        if (auto iter = m_index.find(key); iter != m_index.end()) {
+            slot.name = m_slots[iter->second].name;
+            m_slots[iter->second] = std::move(slot);
+            return;
+        }
+        slot.name = m_keys.store(key);
+        m_index.emplace(slot.name, static_cast<uint32_t>(m_slots.size()));
+        m_slots.push_back(std::move(slot));
+    }
+
+    /// 与 other 中 index 槽位对应的本对象槽位：同名时按下标直接命中，否则按键名查找
+    const Slot* matchingSlot(size_t index, std::string_view name) const {
+        if (index < m_slots.size() && m_slots[index].name == name) {
+            return &m_slots[index];
+        }
+        auto iter = m_index.find(name);
+        return iter != m_index.end() ? &m_slots[iter->second] : nullptr;
+    }
+
+    static void parseScalars(Slot& slot) {
+        const std::string_view text = parser_detail::trimView(slot.text);
+        if (text.empty()) {
+            return;
+        }
+        if (auto value = StringUtils::tryParse<bool>(text)) {
+            slot.boolean = *value;
+            slot.kinds |= kBool;
+        }
+        // 首字符不可能开始一个数字（含 inf / nan）时跳过数值解析
+        const char first = text.front();
+        const bool numeric = (first >= '0' && first <= '9') || first == '+' || first == '-' || first == '.' ||
+                             first == 'i' || first == 'I' || first == 'n' || first == 'N';
+        if (!numeric) {
+            return;
+        }
+        if (auto value = StringUtils::tryParse<int64_t>(text)) {
+            slot.integer = *value;
+            slot.real = static_cast<double>(*value);
+            slot.kinds |= kSigned | kReal;
+            return;
+        }
+        if (auto wide = StringUtils::tryParse<uint64_t>(text)) {
+            slot.integer = static_cast<int64_t>(*wide);
+            slot.real = static_cast<double>(*wide);
+            slot.kinds |= kUnsigned | kReal;
+            return;
+        }
+        if (auto value = StringUtils::tryParse<double>(text)) {
+            slot.real = *value;
+            slot.kinds |= kReal;
+        }
+    }
+
+    template<ConfigValueType T>
+    static bool accepts(const Slot& slot) {
+        if constexpr (std::is_same_v<T, bool>) {
+            return (slot.kinds & kBool) != 0;
+        } else if constexpr (std::is_integral_v<T>) {
+            if (slot.kinds & kSigned) {
+                return std::in_range<T>(slot.integer);
+            }
+            if (slot.kinds & kUnsigned) {
+                return std::in_range<T>(static_cast<uint64_t>(slot.integer));
+            }
+            return false;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return (slot.kinds & kReal) != 0;
+        } else {
+            return (slot.kinds & kPresent) != 0;
+        }
+    }
+
+    parser_detail::StringArena m_keys;
+    std::vector<Slot> m_slots;
+    std::unordered_map<std::string_view, uint32_t> m_index;
+    size_t m_present = 0;
+    uint32_t m_generation = 0;
+};
+
+} // namespace galay::utils
+
+#endif // GALAY_UTILS_PARSER_TYPED_CONFIG_HPP
@@ -0,0 +1,393 @@
+/**
+ * @file ascii.hpp
+ * @brief ASCII 字符分类、大小写转换与 UTF-8 校验内核
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 与 locale 无关，只处理 ASCII 字符，非 ASCII 字节原样保留。大小写转换在 x86-64 上
+ *          运行时分派 AVX2 / SSE2，AArch64 上使用 NEON；分类与 UTF-8 校验使用 SSE2 / NEON 基线指令。
+ *          同时提供大小写不敏感的哈希、相等与排序函数对象，可直接用作 LruCache / unordered_map 的模板参数。
+ */
+
+#ifndef GALAY_UTILS_ASCII_HPP
+#define GALAY_UTILS_ASCII_HPP
+
+#include "galay-utils/encoding/codec.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace galay::utils {
+
+/**
+ * @brief ASCII 字符类别位
+ */
+enum AsciiClass : uint8_t {
+    kAsciiDigit = 1 << 0,   ///< 0-9
+    kAsciiHex = 1 << 1,     ///< 0-9 a-f A-F
+    kAsciiSpace = 1 << 2,   ///< 空格 \t \n \v \f \r
+    kAsciiUpper = 1 << 3,   ///< A-Z
+    kAsciiLower = 1 << 4,   ///< a-z
+    kAsciiAlpha = kAsciiUpper | kAsciiLower
+};
+
+namespace detail {
+
+/// 每个字节对应的 AsciiClass 位集合，非 ASCII 字节为 0
+inline constexpr std::array<uint8_t, 256> asciiClassTable = [] {
+    std::array<uint8_t, 256> table{};
+    for (int c = '0'; c <= '9'; ++c) table[c] = kAsciiDigit | kAsciiHex;
+    for (int c = 'A'; c <= 'Z'; ++c) table[c] = kAsciiUpper;
+    for (int c = 'a'; c <= 'z'; ++c) table[c] = kAsciiLower;
+    for (int c = 'A'; c <= 'F'; ++c) table[c] |= kAsciiHex;
+    for (int c = 'a'; c <= 'f'; ++c) table[c] |= kAsciiHex;
+    for (char c : {' ', '\t', '\n', '\v', '\f', '\r'}) table[static_cast<unsigned char>(c)] = kAsciiSpace;
+    return table;
+}();
+
+inline bool asciiIs(char ch, uint8_t classes) {
+    return (asciiClassTable[static_cast<unsigned char>(ch)] & classes) != 0;
+}
+
+inline char asciiToLowerChar(char ch) {
+    return asciiIs(ch, kAsciiUpper) ? static_cast<char>(ch | 0x20) : ch;
+}
+
+inline char asciiToUpperChar(char ch) {
+    return asciiIs(ch, kAsciiLower) ? static_cast<char>(ch & ~0x20) : ch;
+}
+
+/// 8 字节 SWAR 转小写：仅 'A'-'Z' 置 0x20 位
+inline uint64_t asciiFoldLower64(uint64_t x) {
+    const uint64_t heptets = x & 0x7F7F7F7F7F7F7F7Full;
+    const uint64_t aboveZ = heptets + 0x2525252525252525ull;   // 字节 > 'Z' 时最高位为 1
+    const uint64_t atLeastA = heptets + 0x3F3F3F3F3F3F3F3Full; // 字节 >= 'A' 时最高位为 1
+    const uint64_t upper = ~x & (atLeastA ^ aboveZ) & 0x8080808080808080ull;
+    return x | (upper >> 2);
+}
+
+inline uint64_t asciiLoad64(const char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, 8);
+    return value;
+}
+
+/// 读取不足 8 字节的尾部，高位补 0
+inline uint64_t asciiLoadTail(const char* p, size_t length) {
+    uint64_t value = 0;
+    std::memcpy(&value, p, length);
+    return value;
+}
+
+inline void asciiCaseScalar(const char* in, size_t length, char* out, bool upper) {
+    for (size_t i = 0; i < length; ++i) {
+        out[i] = upper ? asciiToUpperChar(in[i]) : asciiToLowerChar(in[i]);
+    }
+}
+
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+/// SSE2：'A'-'Z'（或 'a'-'z'）字节翻转 0x20 位，返回已处理字节数
+inline size_t asciiCaseSse2(const char* in, size_t length, char* out, bool upper) {
+    const __m128i first = _mm_set1_epi8(upper ? 'a' : 'A');
+    const __m128i span = _mm_set1_epi8(25);
+    const __m128i flip = _mm_set1_epi8(0x20);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i offset = _mm_sub_epi8(chunk, first);
+        const __m128i inRange = _mm_cmpeq_epi8(_mm_min_epu8(offset, span), offset);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_xor_si128(chunk, _mm_and_si128(inRange, flip)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline size_t asciiCaseAvx2(const char* in, size_t length, char* out, bool upper) {
+    const __m256i first = _mm256_set1_epi8(upper ? 'a' : 'A');
+    const __m256i span = _mm256_set1_epi8(25);
+    const __m256i flip = _mm256_set1_epi8(0x20);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const __m256i offset = _mm256_sub_epi8(chunk, first);
+        const __m256i inRange = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, span), offset);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_xor_si256(chunk, _mm256_and_si256(inRange, flip)));
+    }
+    return i;
+}
+#elif defined(GALAY_UTILS_CODEC_NEON)
+inline size_t asciiCaseNeon(const char* in, size_t length, char* out, bool upper) {
+    const uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(upper ? 'a' : 'A'));
+    const uint8x16_t span = vdupq_n_u8(25);
+    const uint8x16_t flip = vdupq_n_u8(0x20);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(in + i));
+        const uint8x16_t inRange = vcleq_u8(vsubq_u8(chunk, first), span);
+        vst1q_u8(reinterpret_cast<uint8_t*>(out + i), veorq_u8(chunk, vandq_u8(inRange, flip)));
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief ASCII 大小写转换，in 与 out 可以是同一块内存
+ */
+inline void asciiConvertCase(const char* in, size_t length, char* out, bool upper) {
+    size_t done = 0;
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+    if (length >= 32 && codecSelectBackend() == CodecBackend::Avx2) {
+        done = asciiCaseAvx2(in, length, out, upper);
+    }
+    done += asciiCaseSse2(in + done, length - done, out + done, upper);
+#elif defined(GALAY_UTILS_CODEC_NEON)
+    done = asciiCaseNeon(in, length, out, upper);
+#endif
+    asciiCaseScalar(in + done, length - done, out + done, upper);
+}
+
+/**
+ * @brief 判断所有字节是否都属于 classes 之一（kAsciiDigit / kAsciiHex / kAsciiSpace 的组合）
+ * @details 空输入返回 true。
+ */
+inline bool asciiAllOf(const char* data, size_t length, uint8_t classes) {
+    size_t i = 0;
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i lowerA = _mm_set1_epi8('a');
+    const __m128i five = _mm_set1_epi8(5);
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i four = _mm_set1_epi8(4);
+    const __m128i blank = _mm_set1_epi8(' ');
+    for (; i + 16 <= length; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i ok = _mm_setzero_si128();
+        if (classes & (kAsciiDigit | kAsciiHex)) {
+            const __m128i digit = _mm_sub_epi8(chunk, zero);
+            ok = _mm_or_si128(ok, _mm_cmpeq_epi8(_mm_min_epu8(digit, nine), digit));
+        }
+        if (classes & kAsciiHex) {
+            const __m128i letter = _mm_sub_epi8(_mm_or_si128(chunk, caseBit), lowerA);
+            ok = _mm_or_si128(ok, _mm_cmpeq_epi8(_mm_min_epu8(letter, five), letter));
+        }
+        if (classes & kAsciiSpace) {
+            const __m128i control = _mm_sub_epi8(chunk, tab);
+            ok = _mm_or_si128(ok, _mm_cmpeq_epi8(_mm_min_epu8(control, four), control));
+            ok = _mm_or_si128(ok, _mm_cmpeq_epi8(chunk, blank));
+        }
+        if (_mm_movemask_epi8(ok) != 0xFFFF) {
+            return false;
+        }
+    }
+#elif defined(GALAY_UTILS_CODEC_NEON)
+    const uint8x16_t zero = vdupq_n_u8('0');
+    const uint8x16_t nine = vdupq_n_u8(9);
+    const uint8x16_t lowerA = vdupq_n_u8('a');
+    const uint8x16_t five = vdupq_n_u8(5);
+    const uint8x16_t caseBit = vdupq_n_u8(0x20);
+    const uint8x16_t tab = vdupq_n_u8('\t');
+    const uint8x16_t four = vdupq_n_u8(4);
+    const uint8x16_t blank = vdupq_n_u8(' ');
+    for (; i + 16 <= length; i += 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        uint8x16_t ok = vdupq_n_u8(0);
+        if (classes & (kAsciiDigit | kAsciiHex)) {
+            ok = vorrq_u8(ok, vcleq_u8(vsubq_u8(chunk, zero), nine));
+        }
+        if (classes & kAsciiHex) {
+            ok = vorrq_u8(ok, vcleq_u8(vsubq_u8(vorrq_u8(chunk, caseBit), lowerA), five));
+        }
+        if (classes & kAsciiSpace) {
+            ok = vorrq_u8(ok, vcleq_u8(vsubq_u8(chunk, tab), four));
+            ok = vorrq_u8(ok, vceqq_u8(chunk, blank));
+        }
+        if (vminvq_u8(ok) != 0xFF) {
+            return false;
+        }
+    }
+#endif
+    for (; i < length; ++i) {
+        if (!asciiIs(data[i], classes)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 返回第一个非 ASCII 字节的位置，全部为 ASCII 时返回 length
+ */
+inline size_t asciiPrefixLength(const char* data, size_t length) {
+    size_t i = 0;
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+    for (; i + 16 <= length; i += 16) {
+        const int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+#elif defined(GALAY_UTILS_CODEC_NEON)
+    for (; i + 16 <= length; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(data + i))) >= 0x80) {
+            break;
+        }
+    }
+#else
+    for (; i + 8 <= length; i += 8) {
+        if (asciiLoad64(data + i) & 0x8080808080808080ull) {
+            break;
+        }
+    }
+#endif
+    while (i < length && static_cast<unsigned char>(data[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * @brief 查找第一个非法 UTF-8 序列的起始位置
+ * @return 合法时返回 std::string_view::npos
+ * @details 按 Unicode 表 3-7 校验：拒绝超长编码、代理区（U+D800-U+DFFF）、大于 U+10FFFF 的码点
+ *          以及截断序列。连续 ASCII 段以 16 字节为单位跳过。
+ */
+inline size_t utf8FirstInvalid(const char* data, size_t length) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    size_t i = 0;
+    while (i < length) {
+        i += asciiPrefixLength(data + i, length - i);
+        if (i >= length) {
+            break;
+        }
+        const unsigned char lead = bytes[i];
+        size_t need;
+        unsigned char low = 0x80;
+        unsigned char high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            need = 1;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            need = 2;
+            if (lead == 0xE0) low = 0xA0;
+            if (lead == 0xED) high = 0x9F;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            need = 3;
+            if (lead == 0xF0) low = 0x90;
+            if (lead == 0xF4) high = 0x8F;
+        } else {
+            return i;
+        }
+        if (length - i <= need) {
+            return i;
+        }
+        if (bytes[i + 1] < low || bytes[i + 1] > high) {
+            return i;
+        }
+        for (size_t k = 2; k <= need; ++k) {
+            if ((bytes[i + k] & 0xC0) != 0x80) {
+                return i;
+            }
+        }
+        i += need + 1;
+    }
+    return std::string_view::npos;
+}
+
+} // namespace detail
+
+/**
+ * @brief ASCII 大小写不敏感哈希
+ * @details 每次按 SWAR 折叠 8 字节为小写后混合，结果跨进程稳定。支持异构查找。
+ */
+struct AsciiCaseInsensitiveHash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view str) const noexcept {
+        uint64_t hash = 0x9E3779B97F4A7C15ull ^ (str.size() * 0xC2B2AE3D27D4EB4Full);
+        const char* p = str.data();
+        size_t remaining = str.size();
+        while (remaining >= 8) {
+            hash = mix(hash, detail::asciiFoldLower64(detail::asciiLoad64(p)));
+            p += 8;
+            remaining -= 8;
+        }
+        if (remaining > 0) {
+            // 长度不小于 8 时回退读取末尾 8 字节，避免变长 memcpy
+            const uint64_t tail = str.size() >= 8 ? detail::asciiLoad64(str.data() + str.size() - 8)
+                                                  : detail::asciiLoadTail(p, remaining);
+            hash = mix(hash, detail::asciiFoldLower64(tail));
+        }
+        // MurmurHash3 fmix64
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ull;
+        hash ^= hash >> 33;
+        return static_cast<size_t>(hash);
+    }
+
+private:
+    static uint64_t mix(uint64_t hash, uint64_t chunk) {
+        return std::rotl((hash ^ chunk) * 0x9FB21C651E98DF25ull, 29);
+    }
+};
+
+/**
+ * @brief ASCII 大小写不敏感相等比较，每次比较 8 字节
+ */
+struct AsciiCaseInsensitiveEqual {
+    using is_transparent = void;
+
+    bool operator()(std::string_view lhs, std::string_view rhs) const noexcept {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        size_t i = 0;
+        for (; i + 8 <= lhs.size(); i += 8) {
+            if (detail::asciiFoldLower64(detail::asciiLoad64(lhs.data() + i))
+                != detail::asciiFoldLower64(detail::asciiLoad64(rhs.data() + i))) {
+                return false;
+            }
+        }
+        const size_t rest = lhs.size() - i;
+        if (rest == 0) {
+            return true;
+        }
+        if (lhs.size() >= 8) {
+            const size_t last = lhs.size() - 8;
+            return detail::asciiFoldLower64(detail::asciiLoad64(lhs.data() + last))
+                == detail::asciiFoldLower64(detail::asciiLoad64(rhs.data() + last));
+        }
+        return detail::asciiFoldLower64(detail::asciiLoadTail(lhs.data(), rest))
+            == detail::asciiFoldLower64(detail::asciiLoadTail(rhs.data(), rest));
+    }
+};
+
+/**
+ * @brief ASCII 大小写不敏感字典序比较，可用作 std::map 的比较器
+ */
+struct AsciiCaseInsensitiveLess {
+    using is_transparent = void;
+
+    bool operator()(std::string_view lhs, std::string_view rhs) const noexcept {
+        const size_t common = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+        for (size_t i = 0; i < common; ++i) {
+            const auto a = static_cast<unsigned char>(detail::asciiToLowerChar(lhs[i]));
+            const auto b = static_cast<unsigned char>(detail::asciiToLowerChar(rhs[i]));
+            if (a != b) {
+                return a < b;
+            }
+        }
+        return lhs.size() < rhs.size();
+    }
+};
+
+} // namespace galay::utils
+
+#endif // GALAY_UTILS_ASCII_HPP
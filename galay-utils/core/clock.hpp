@@ -0,0 +1,365 @@
+/**
+ * @file clock.hpp
+ * @brief 热路径时钟源
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 提供三种与 std::chrono 时钟接口兼容的单调时钟，可直接作为 LruCache、BasicCircuitBreaker、
+ *          限流器、StopWatch、Deadline 等组件的 Clock 模板参数：
+ *          - TscClock：读取 TSC（x86-64 rdtsc）或通用计时器（AArch64 cntvct_el0），按校准系数换算为纳秒；
+ *          - CoarseClock：Linux 上使用 CLOCK_MONOTONIC_COARSE，精度为一个调度 tick；
+ *          - CachedClock：后台线程按固定间隔刷新的缓存时间，读取只是一次原子 load。
+ *          三者的纪元均与 std::chrono::steady_clock 对齐（TscClock 为校准时刻的近似对齐）。
+ */
+
+#ifndef GALAY_UTILS_CLOCK_HPP
+#define GALAY_UTILS_CLOCK_HPP
+
+#include "galay-utils/common/defn.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <thread>
+
+#if defined(GALAY_ARCH_X64) && (defined(GALAY_COMPILER_GCC) || defined(GALAY_COMPILER_CLANG))
+#define GALAY_UTILS_CLOCK_TSC 1
+#include <cpuid.h>
+#elif defined(GALAY_ARCH_ARM64) && (defined(GALAY_COMPILER_GCC) || defined(GALAY_COMPILER_CLANG))
+#define GALAY_UTILS_CLOCK_CNTVCT 1
+#endif
+
+namespace galay::utils {
+
+namespace detail {
+
+inline int64_t steadyNowNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// 读取硬件计数器原始值；不支持的平台返回 0
+GALAY_FORCE_INLINE uint64_t readCycleCounter() noexcept {
+#if defined(GALAY_UTILS_CLOCK_TSC)
+    return __builtin_ia32_rdtsc();
+#elif defined(GALAY_UTILS_CLOCK_CNTVCT)
+    uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return 0;
+#endif
+}
+
+/// 硬件计数器是否恒频且不随 C-state 停止
+inline bool cycleCounterInvariant() noexcept {
+#if defined(GALAY_UTILS_CLOCK_TSC)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(0x80000000u, &eax, &ebx, &ecx, &edx) || eax < 0x80000007u) {
+        return false;
+    }
+    if (!__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;
+#elif defined(GALAY_UTILS_CLOCK_CNTVCT)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief 计数器到纳秒的换算参数
+ * @details ns = baseNs + ((ticks - baseTicks) * multiplier) >> kShift，乘法使用 128 位中间值，
+ *          不会因运行时间变长而溢出。
+ */
+struct CycleCalibration {
+    static constexpr unsigned kShift = 32;
+
+    bool hardware = false;
+    uint64_t baseTicks = 0;
+    int64_t baseNs = 0;
+    uint64_t multiplier = 0;
+    double ticksPerSecond = 0.0;
+
+    static CycleCalibration measure() noexcept {
+        CycleCalibration calibration;
+        if (!cycleCounterInvariant()) {
+            return calibration;
+        }
+#if defined(GALAY_UTILS_CLOCK_CNTVCT)
+        uint64_t frequency;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+        calibration.ticksPerSecond = static_cast<double>(frequency);
+        sample(calibration.baseTicks, calibration.baseNs);
+#elif defined(GALAY_UTILS_CLOCK_TSC)
+        // 以 steady_clock 为参照测量 10ms 内的 TSC 增量，采样点取两次 rdtsc 的中点以抵消读时钟开销
+        uint64_t startTicks = 0;
+        int64_t startNs = 0;
+        sample(startTicks, startNs);
+        uint64_t endTicks = 0;
+        int64_t endNs = 0;
+        do {
+            sample(endTicks, endNs);
+        } while (endNs - startNs < 10'000'000);
+        if (endTicks <= startTicks) {
+            return calibration;
+        }
+        calibration.ticksPerSecond =
+            static_cast<double>(endTicks - startTicks) * 1e9 / static_cast<double>(endNs - startNs);
+        calibration.baseTicks = endTicks;
+        calibration.baseNs = endNs;
+#endif
+        if (!(calibration.ticksPerSecond >= 1e6)) {
+            return calibration;
+        }
+        calibration.multiplier = static_cast<uint64_t>(
+            1e9 / calibration.ticksPerSecond * static_cast<double>(uint64_t{1} << kShift) + 0.5);
+        calibration.hardware = true;
+        return calibration;
+    }
+
+    /// 取多次采样中两次计数器读数间隔最小的一组，排除被抢占或首次进入 vDSO 的慢样本
+    static void sample(uint64_t& ticks, int64_t& ns) noexcept {
+        ticks = 0;
+        ns = 0;
+        uint64_t bestWindow = UINT64_MAX;
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            const uint64_t before = readCycleCounter();
+            const int64_t now = steadyNowNs();
+            const uint64_t after = readCycleCounter();
+            if (after - before < bestWindow) {
+                bestWindow = after - before;
+                ticks = before + (after - before) / 2;
+                ns = now;
+            }
+        }
+    }
+
+    GALAY_FORCE_INLINE int64_t toNs(uint64_t ticks) const noexcept {
+#if defined(GALAY_UTILS_CLOCK_TSC) || defined(GALAY_UTILS_CLOCK_CNTVCT)
+        // 计数器在校准后读数可能略小于 baseTicks（跨核微小偏差），按有符号差值处理
+        const int64_t delta = static_cast<int64_t>(ticks - baseTicks);
+        const __int128 scaled = static_cast<__int128>(delta) * static_cast<__int128>(multiplier);
+        return baseNs + static_cast<int64_t>(scaled >> kShift);
+#else
+        (void)ticks;
+        return baseNs;
+#endif
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief 基于 CPU 周期计数器的单调时钟
+ * @details 首次使用时以 steady_clock 为参照校准一次（x86-64 约阻塞 10ms，AArch64 直接读取 cntfrq_el0），
+ *          之后每次 now() 只是一次 rdtsc / mrs 加一次 128 位乘法，不进入内核也不走 vDSO。
+ *          CPU 未报告恒频 TSC（invariant TSC）或平台不支持时退化为 steady_clock，hardware() 返回 false。
+ *          rdtsc 不是序列化指令，适合时间戳与超时判断，不适合测量几十个周期以内的指令序列；
+ *          依赖各核 TSC 同步（现代 x86-64 与 ARMv8 通用计时器均满足），虚拟机迁移可能引入偏差；
+ *          校准后不跟随 NTP 对 CLOCK_MONOTONIC 的频率微调，长时间运行与 steady_clock 会有 ppm 级偏差。
+ *          需要避免首次调用的校准延迟时，可在启动阶段先调用 calibrate()。
+ */
+class TscClock {
+public:
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<TscClock>;
+
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept {
+        const detail::CycleCalibration& state = calibration();
+        if (GALAY_LIKELY(state.hardware)) {
+            return time_point(duration(state.toNs(detail::readCycleCounter())));
+        }
+        return time_point(duration(detail::steadyNowNs()));
+    }
+
+    /**
+     * @brief 立即完成校准（幂等）
+     */
+    static void calibrate() noexcept {
+        (void)calibration();
+    }
+
+    /**
+     * @brief 是否使用硬件计数器；false 表示已退化为 steady_clock
+     */
+    static bool hardware() noexcept {
+        return calibration().hardware;
+    }
+
+    /**
+     * @brief 校准得到的计数器频率（Hz），退化时为 0
+     */
+    static double ticksPerSecond() noexcept {
+        return calibration().ticksPerSecond;
+    }
+
+    /**
+     * @brief 读取未换算的计数器值，退化时返回 steady_clock 纳秒数
+     */
+    static uint64_t ticks() noexcept {
+        if (calibration().hardware) {
+            return detail::readCycleCounter();
+        }
+        return static_cast<uint64_t>(detail::steadyNowNs());
+    }
+
+private:
+    static const detail::CycleCalibration& calibration() noexcept {
+        static const detail::CycleCalibration state = detail::CycleCalibration::measure();
+        return state;
+    }
+};
+
+/**
+ * @brief 低精度单调时钟
+ * @details Linux 上读取 CLOCK_MONOTONIC_COARSE：经 vDSO 返回上一个调度 tick 记录的时间，
+ *          不读硬件计时器，精度通常为 1-4ms（见 resolution()）。与 steady_clock 同纪元。
+ *          其他平台退化为 steady_clock。适合 TTL、熔断超时等毫秒级判断。
+ */
+class CoarseClock {
+public:
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<CoarseClock>;
+
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept {
+#if defined(GALAY_PLATFORM_LINUX) && defined(CLOCK_MONOTONIC_COARSE)
+        timespec ts;
+        ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+        return time_point(duration(static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec));
+#else
+        return time_point(duration(detail::steadyNowNs()));
+#endif
+    }
+
+    /**
+     * @brief 时钟精度；退化为 steady_clock 时返回 1ns
+     */
+    static duration resolution() noexcept {
+#if defined(GALAY_PLATFORM_LINUX) && defined(CLOCK_MONOTONIC_COARSE)
+        timespec ts;
+        if (::clock_getres(CLOCK_MONOTONIC_COARSE, &ts) == 0) {
+            return duration(static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec);
+        }
+#endif
+        return duration(1);
+    }
+};
+
+/**
+ * @brief 后台线程刷新的缓存时钟
+ * @details 首次调用 now() 时启动一个刷新线程，按 interval()（默认 1ms）把 steady_clock 当前值写入原子变量；
+ *          now() 只读取该值，开销等同一次原子 load。读数最多落后一个刷新间隔加线程调度延迟，
+ *          且在刷新间隔内保持不变。刷新线程在进程退出析构静态对象时停止；fork 后子进程中不存在刷新线程，
+ *          读数会停在 fork 时刻，需要在子进程中调用 refresh() 或改用其他时钟。
+ */
+class CachedClock {
+public:
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<CachedClock>;
+
+    static constexpr bool is_steady = true;
+    static constexpr std::chrono::microseconds kDefaultInterval{1000};
+
+    static time_point now() noexcept {
+        return time_point(duration(updater().current.load(std::memory_order_relaxed)));
+    }
+
+    /**
+     * @brief 启动刷新线程（幂等），可在启动阶段调用以避免首次 now() 创建线程
+     */
+    static void start() {
+        (void)updater();
+    }
+
+    /**
+     * @brief 设置刷新间隔，下一次刷新后生效；不大于 0 时按 kDefaultInterval 处理
+     */
+    static void setInterval(std::chrono::microseconds interval) {
+        if (interval <= std::chrono::microseconds::zero()) {
+            interval = kDefaultInterval;
+        }
+        updater().intervalUs.store(interval.count(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 当前刷新间隔
+     */
+    static std::chrono::microseconds interval() {
+        return std::chrono::microseconds(updater().intervalUs.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief 立即以 steady_clock 刷新一次缓存值
+     */
+    static void refresh() {
+        updater().store();
+    }
+
+private:
+    struct Updater {
+        alignas(64) std::atomic<int64_t> current{detail::steadyNowNs()};
+        std::atomic<int64_t> intervalUs{kDefaultInterval.count()};
+        std::mutex mutex;
+        std::condition_variable wakeup;
+        bool stopping = false;
+        std::thread worker;
+
+        Updater()
+            : worker([this]() { run(); }) {}
+
+        ~Updater() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wakeup.notify_one();
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+
+        void store() noexcept {
+            const int64_t now = detail::steadyNowNs();
+            int64_t previous = current.load(std::memory_order_relaxed);
+            // refresh() 与刷新线程可能并发写入，只前进不后退
+            while (previous < now
+                   && !current.compare_exchange_weak(previous, now, std::memory_order_relaxed)) {
+            }
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!stopping) {
+                const auto interval =
+                    std::chrono::microseconds(intervalUs.load(std::memory_order_relaxed));
+                wakeup.wait_for(lock, interval, [this]() { return stopping; });
+                store();
+            }
+        }
+    };
+
+    static Updater& updater() {
+        static Updater state;
+        return state;
+    }
+};
+
+} // namespace galay::utils
+
+#endif // GALAY_UTILS_CLOCK_HPP
@@ -0,0 +1,439 @@
+/**
+ * @file histogram.hpp
+ * @brief HDR 风格对数线性直方图与延迟打点
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 值域按 2 的幂分段，每段再线性划分为 2^precisionBits 个桶，相对误差不超过 2^-precisionBits。
+ *          Histogram 为每个记录线程分配独立分片，记录路径只做单写者的 relaxed 原子读写，不加锁、
+ *          不使用 RMW 指令；snapshot() 时合并全部分片。ScopedTimer 在析构时把 StopWatch 的经过时间
+ *          记入直方图。
+ */
+
+#ifndef GALAY_UTILS_HISTOGRAM_HPP
+#define GALAY_UTILS_HISTOGRAM_HPP
+
+#include "galay-utils/common/defn.hpp"
+#include "galay-utils/core/time.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace galay::utils {
+
+namespace detail {
+
+/**
+ * @brief 对数线性桶布局
+ * @details 小于 2^s 的值各占一个桶；其余值按最高位所在的段划分，每段 2^s 个桶。
+ */
+class HistogramLayout {
+public:
+    HistogramLayout(uint64_t highestTrackableValue, unsigned precisionBits) noexcept
+        : m_bits(std::clamp(precisionBits, 1u, 12u))
+        , m_highest(std::max<uint64_t>(highestTrackableValue, 1))
+        , m_bucketCount(indexOf(m_highest) + 1) {}
+
+    unsigned precisionBits() const noexcept { return m_bits; }
+    uint64_t highestTrackableValue() const noexcept { return m_highest; }
+    size_t bucketCount() const noexcept { return m_bucketCount; }
+
+    /// 超过 highestTrackableValue 的值落入最后一个桶
+    size_t indexOf(uint64_t value) const noexcept {
+        value = std::min(value, m_highest);
+        const unsigned top = 63u - static_cast<unsigned>(std::countl_zero(value | (uint64_t{1} << m_bits)));
+        const unsigned shift = top - m_bits;
+        return (static_cast<size_t>(shift) << m_bits) + static_cast<size_t>(value >> shift);
+    }
+
+    /// 与桶内最大值等价的值（桶上界）
+    uint64_t highestEquivalentValue(size_t index) const noexcept {
+        const size_t segment = index >> m_bits;
+        if (segment == 0) {
+            return index;
+        }
+        const unsigned shift = static_cast<unsigned>(segment - 1);
+        const uint64_t mantissa = (index & ((size_t{1} << m_bits) - 1)) | (uint64_t{1} << m_bits);
+        return (mantissa << shift) + ((uint64_t{1} << shift) - 1);
+    }
+
+    bool operator==(const HistogramLayout& other) const noexcept {
+        return m_bits == other.m_bits && m_highest == other.m_highest;
+    }
+
+private:
+    unsigned m_bits;
+    uint64_t m_highest;
+    size_t m_bucketCount;
+};
+
+/// 单个线程独占写入的分片
+struct alignas(64) HistogramShard {
+    explicit HistogramShard(size_t bucketCount)
+        : buckets(std::make_unique<std::atomic<uint64_t>[]>(bucketCount)) {}
+
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> min{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max{0};
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+    std::thread::id owner;
+};
+
+/// 线程本地的 直方图 ID -> 分片 直接映射缓存；ID 不复用，已销毁直方图的表项不会再被命中
+struct HistogramShardCache {
+    static constexpr size_t kWays = 16;
+    std::array<uint64_t, kWays> ids{};
+    std::array<HistogramShard*, kWays> shards{};
+};
+
+inline HistogramShardCache& histogramShardCache() noexcept {
+    thread_local HistogramShardCache cache;
+    return cache;
+}
+
+inline uint64_t nextHistogramId() noexcept {
+    static std::atomic<uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+/**
+ * @brief 常用统计量
+ */
+struct HistogramSummary {
+    uint64_t count = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    double mean = 0.0;
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+};
+
+/**
+ * @brief 直方图快照
+ * @details 非线程安全的普通值类型，可合并布局相同的其他快照。
+ */
+class HistogramSnapshot {
+public:
+    HistogramSnapshot(uint64_t highestTrackableValue, unsigned precisionBits)
+        : m_layout(highestTrackableValue, precisionBits)
+        , m_buckets(m_layout.bucketCount(), 0) {}
+
+    uint64_t count() const noexcept { return m_count; }
+    uint64_t sum() const noexcept { return m_sum; }
+    bool empty() const noexcept { return m_count == 0; }
+
+    /// 记录到的最小值，没有记录时返回 0
+    uint64_t min() const noexcept { return m_min > m_max ? 0 : m_min; }
+
+    /// 记录到的最大值（精确值，不受 highestTrackableValue 截断）
+    uint64_t max() const noexcept { return m_max; }
+
+    double mean() const noexcept {
+        return m_count == 0 ? 0.0 : static_cast<double>(m_sum) / static_cast<double>(m_count);
+    }
+
+    /**
+     * @brief 百分位值
+     * @param percentile 取值 [0, 100]，超出范围时截断
+     * @return 覆盖该百分位的桶上界，并截断到 [min(), max()]；没有记录时返回 0
+     */
+    uint64_t percentile(double percentile) const noexcept {
+        uint64_t value = 0;
+        percentiles(std::span<const double>(&percentile, 1), std::span<uint64_t>(&value, 1));
+        return value;
+    }
+
+    /**
+     * @brief 单次遍历计算多个百分位
+     * @param percentiles 升序排列的百分位
+     * @param out 输出，长度不小于 percentiles
+     */
+    void percentiles(std::span<const double> percentiles, std::span<uint64_t> out) const noexcept {
+        const size_t n = std::min(percentiles.size(), out.size());
+        if (m_count == 0) {
+            std::fill_n(out.begin(), n, uint64_t{0});
+            return;
+        }
+        uint64_t cumulative = 0;
+        size_t index = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t rank = rankOf(percentiles[i]);
+            while (index < m_buckets.size() && cumulative + m_buckets[index] < rank) {
+                cumulative += m_buckets[index++];
+            }
+            // 最后一个桶还包含超出上限的值，以精确的 max 作为上界
+            const uint64_t upper = index + 1 < m_buckets.size()
+                ? m_layout.highestEquivalentValue(index)
+                : m_max;
+            out[i] = std::min(std::max(upper, min()), m_max);
+        }
+    }
+
+    HistogramSummary summary() const noexcept {
+        static constexpr std::array<double, 4> kPercentiles{50.0, 90.0, 99.0, 99.9};
+        std::array<uint64_t, 4> values{};
+        percentiles(kPercentiles, values);
+        return HistogramSummary{count(), min(), max(), mean(), values[0], values[1], values[2], values[3]};
+    }
+
+    /// 指定值所在桶的计数
+    uint64_t countAt(uint64_t value) const noexcept {
+        return m_buckets[m_layout.indexOf(value)];
+    }
+
+    /**
+     * @brief 合并另一个快照
+     * @throws std::invalid_argument 两者的 highestTrackableValue 或 precisionBits 不同
+     */
+    void merge(const HistogramSnapshot& other) {
+        if (!(m_layout == other.m_layout)) {
+            throw std::invalid_argument("HistogramSnapshot layout mismatch");
+        }
+        for (size_t i = 0; i < m_buckets.size(); ++i) {
+            m_buckets[i] += other.m_buckets[i];
+        }
+        accumulate(other.m_count, other.m_sum, other.m_min, other.m_max);
+    }
+
+    uint64_t highestTrackableValue() const noexcept { return m_layout.highestTrackableValue(); }
+    unsigned precisionBits() const noexcept { return m_layout.precisionBits(); }
+
+private:
+    friend class Histogram;
+
+    uint64_t rankOf(double percentile) const noexcept {
+        const double clamped = std::clamp(percentile, 0.0, 100.0);
+        const double rank = std::ceil(clamped / 100.0 * static_cast<double>(m_count));
+        return std::clamp<uint64_t>(static_cast<uint64_t>(rank), 1, m_count);
+    }
+
+    void accumulate(uint64_t count, uint64_t sum, uint64_t min, uint64_t max) noexcept {
+        if (count == 0) {
+            return;
+        }
+        m_count += count;
+        m_sum += sum;
+        // 与并发记录交错时分片的 min / max 可能尚未写入
+        if (min <= max) {
+            m_min = std::min(m_min, min);
+            m_max = std::max(m_max, max);
+        }
+    }
+
+    detail::HistogramLayout m_layout;
+    std::vector<uint64_t> m_buckets;
+    uint64_t m_count = 0;
+    uint64_t m_sum = 0;
+    uint64_t m_min = std::numeric_limits<uint64_t>::max();
+    uint64_t m_max = 0;
+};
+
+/**
+ * @brief 线程分片的对数线性直方图
+ * @details
+ * - record() 线程安全且无锁：每个线程首次记录时在直方图中登记一个分片（此时持锁），之后通过线程本地
+ *   缓存直接定位分片，只做单写者的 relaxed load / store
+ * - 线程退出后分片保留在直方图中，计数不会丢失；同一线程 ID 被新线程复用时继续使用该分片
+ * - snapshot() 合并所有分片，与并发记录之间只保证每个字段各自原子，不保证跨字段一致
+ * - 每个记录线程占用 bucketCount() * 8 字节，默认配置约 36KB
+ */
+class Histogram {
+public:
+    /// 默认上限：1 小时（以纳秒计）
+    static constexpr uint64_t kDefaultHighestTrackableValue = 3'600'000'000'000ull;
+    /// 默认精度：相对误差不超过 1/128
+    static constexpr unsigned kDefaultPrecisionBits = 7;
+
+    /**
+     * @param highestTrackableValue 可区分的最大值，更大的值计入最后一个桶（max() 仍为精确值）
+     * @param precisionBits 每段的线性桶位数，取值 [1, 12]，超出时截断
+     */
+    explicit Histogram(uint64_t highestTrackableValue = kDefaultHighestTrackableValue,
+                       unsigned precisionBits = kDefaultPrecisionBits)
+        : m_layout(highestTrackableValue, precisionBits)
+        , m_id(detail::nextHistogramId()) {}
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    /**
+     * @brief 记录一个值
+     * @param value 记录值，单位由调用方约定
+     * @param count 重复次数
+     */
+    void record(uint64_t value, uint64_t count = 1) noexcept {
+        detail::HistogramShard& shard = localShard();
+        bump(shard.buckets[m_layout.indexOf(value)], count);
+        bump(shard.count, count);
+        bump(shard.sum, value * count);
+        if (value < shard.min.load(std::memory_order_relaxed)) {
+            shard.min.store(value, std::memory_order_relaxed);
+        }
+        if (value > shard.max.load(std::memory_order_relaxed)) {
+            shard.max.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief 以纳秒为单位记录时长，负值按 0 处理
+     */
+    template<typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> elapsed) noexcept {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+    }
+
+    /**
+     * @brief 合并所有线程分片
+     */
+    HistogramSnapshot snapshot() const {
+        HistogramSnapshot result(m_layout.highestTrackableValue(), m_layout.precisionBits());
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& shard : m_shards) {
+            for (size_t i = 0; i < result.m_buckets.size(); ++i) {
+                result.m_buckets[i] += shard->buckets[i].load(std::memory_order_relaxed);
+            }
+            result.accumulate(shard->count.load(std::memory_order_relaxed),
+                              shard->sum.load(std::memory_order_relaxed),
+                              shard->min.load(std::memory_order_relaxed),
+                              shard->max.load(std::memory_order_relaxed));
+        }
+        return result;
+    }
+
+    HistogramSummary summary() const {
+        return snapshot().summary();
+    }
+
+    /**
+     * @brief 清零所有分片
+     * @details 与并发 record() 同时进行时，正在写入的个别记录可能在清零后仍然可见
+     */
+    void reset() noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& shard : m_shards) {
+            for (size_t i = 0; i < m_layout.bucketCount(); ++i) {
+                shard->buckets[i].store(0, std::memory_order_relaxed);
+            }
+            shard->count.store(0, std::memory_order_relaxed);
+            shard->sum.store(0, std::memory_order_relaxed);
+            shard->min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+            shard->max.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /// 已登记的线程分片数
+    size_t shardCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_shards.size();
+    }
+
+    size_t bucketCount() const noexcept { return m_layout.bucketCount(); }
+    uint64_t highestTrackableValue() const noexcept { return m_layout.highestTrackableValue(); }
+    unsigned precisionBits() const noexcept { return m_layout.precisionBits(); }
+
+private:
+    static void bump(std::atomic<uint64_t>& counter, uint64_t delta) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    detail::HistogramShard& localShard() noexcept {
+        auto& cache = detail::histogramShardCache();
+        const size_t way = static_cast<size_t>(m_id) & (detail::HistogramShardCache::kWays - 1);
+        if (GALAY_LIKELY(cache.ids[way] == m_id)) {
+            return *cache.shards[way];
+        }
+        detail::HistogramShard& shard = registerShard();
+        cache.ids[way] = m_id;
+        cache.shards[way] = &shard;
+        return shard;
+    }
+
+    detail::HistogramShard& registerShard() {
+        const std::thread::id self = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& shard : m_shards) {
+            if (shard->owner == self) {
+                return *shard;
+            }
+        }
+        auto shard = std::make_unique<detail::HistogramShard>(m_layout.bucketCount());
+        shard->owner = self;
+        m_shards.push_back(std::move(shard));
+        return *m_shards.back();
+    }
+
+    detail::HistogramLayout m_layout;
+    uint64_t m_id;
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<detail::HistogramShard>> m_shards;
+};
+
+/**
+ * @brief 作用域计时器
+ * @details 构造时启动 StopWatch，析构时把经过时间（纳秒）记入 Histogram。非线程安全，应在单个线程内使用。
+ * @tparam Clock 满足 std::chrono 时钟接口的类型，热路径可使用 TscClock
+ */
+template<typename Clock = std::chrono::steady_clock>
+class ScopedTimer {
+public:
+    using duration = typename Clock::duration;
+
+    explicit ScopedTimer(Histogram& histogram)
+        : m_histogram(&histogram) {}
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    ~ScopedTimer() {
+        if (m_histogram != nullptr) {
+            m_histogram->record(m_watch.elapsed());
+        }
+    }
+
+    /**
+     * @brief 立即记录并停止计时，析构时不再记录
+     * @return 经过时间；已停止或取消时返回 duration::zero()
+     */
+    duration stop() noexcept {
+        if (m_histogram == nullptr) {
+            return duration::zero();
+        }
+        const duration elapsed = m_watch.elapsed();
+        m_histogram->record(elapsed);
+        m_histogram = nullptr;
+        return elapsed;
+    }
+
+    /**
+     * @brief 放弃本次计时，析构时不记录
+     */
+    void cancel() noexcept { m_histogram = nullptr; }
+
+    const StopWatch<Clock>& watch() const noexcept { return m_watch; }
+
+private:
+    Histogram* m_histogram;
+    StopWatch<Clock> m_watch;
+};
+
+} // namespace galay::utils
+
+#endif // GALAY_UTILS_HISTOGRAM_HPP
@@ -0,0 +1,388 @@
+/**
+ * @file interner.hpp
+ * @brief 并发字符串驻留池（符号表）
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 相同内容的字符串只保存一份，返回稳定的 32 位 Symbol 或指针大小的 InternedString 句柄。
+ *          字符串连同预先计算的 XXH3 哈希存放在按块分配的 arena 中，地址在驻留池生命周期内不变；
+ *          已存在字符串的查找、Symbol 到字符串的解析均无锁，只有插入新字符串时持有写锁。
+ */
+
+#ifndef GALAY_UTILS_INTERNER_HPP
+#define GALAY_UTILS_INTERNER_HPP
+
+#include "galay-utils/crypto/xxhash3.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace galay::utils {
+
+namespace detail {
+
+/// arena 中的字符串记录，字符内容（以 '\0' 结尾）紧跟在结构体之后
+struct InternEntry {
+    uint64_t hash;
+    uint32_t length;
+    uint32_t id;
+
+    const char* data() const noexcept {
+        return reinterpret_cast<const char*>(this + 1);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief 驻留字符串的 32 位 ID
+ * @details 同一个 StringInterner 内从 1 开始按插入顺序分配，0 表示无效。
+ */
+class Symbol {
+public:
+    constexpr Symbol() noexcept = default;
+    constexpr explicit Symbol(uint32_t id) noexcept : m_id(id) {}
+
+    constexpr uint32_t id() const noexcept { return m_id; }
+    constexpr bool valid() const noexcept { return m_id != 0; }
+    constexpr explicit operator bool() const noexcept { return valid(); }
+
+    constexpr auto operator<=>(const Symbol&) const noexcept = default;
+
+private:
+    uint32_t m_id = 0;
+};
+
+/**
+ * @brief 指向驻留字符串的句柄，大小与指针相同
+ * @details 可直接取得内容、长度、预计算哈希与 Symbol，无需访问驻留池；相等比较只比较指针。
+ *          不同驻留池中内容相同的句柄互不相等。默认构造的句柄无效，view() 返回空视图。
+ */
+class InternedString {
+public:
+    constexpr InternedString() noexcept = default;
+
+    std::string_view view() const noexcept {
+        return m_entry ? std::string_view(m_entry->data(), m_entry->length) : std::string_view{};
+    }
+
+    /// 以 '\0' 结尾的内容，无效句柄返回 ""
+    const char* c_str() const noexcept { return m_entry ? m_entry->data() : ""; }
+    size_t size() const noexcept { return m_entry ? m_entry->length : 0; }
+    bool empty() const noexcept { return size() == 0; }
+
+    /// 驻留时计算的 XXH3 64 位哈希
+    uint64_t hash() const noexcept { return m_entry ? m_entry->hash : 0; }
+    Symbol symbol() const noexcept { return Symbol(m_entry ? m_entry->id : 0); }
+
+    bool valid() const noexcept { return m_entry != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+    operator std::string_view() const noexcept { return view(); }
+
+    bool operator==(const InternedString&) const noexcept = default;
+
+private:
+    friend class StringInterner;
+
+    explicit InternedString(const detail::InternEntry* entry) noexcept : m_entry(entry) {}
+
+    const detail::InternEntry* m_entry = nullptr;
+};
+
+/**
+ * @brief Symbol 哈希函数对象，可作为 unordered_map / LruCache 的哈希模板参数
+ */
+struct SymbolHash {
+    size_t operator()(Symbol symbol) const noexcept {
+        const uint64_t mixed = uint64_t{symbol.id()} * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(mixed ^ (mixed >> 32));
+    }
+};
+
+/**
+ * @brief InternedString 哈希函数对象，直接返回驻留时预计算的哈希
+ */
+struct InternedStringHash {
+    size_t operator()(InternedString str) const noexcept {
+        return static_cast<size_t>(str.hash());
+    }
+};
+
+/**
+ * @brief InternedString 相等比较，只比较指针
+ */
+struct InternedStringEqual {
+    bool operator()(InternedString lhs, InternedString rhs) const noexcept {
+        return lhs == rhs;
+    }
+};
+
+/**
+ * @brief 并发字符串驻留池
+ * @details
+ * - 哈希表为线性探测开放寻址，装载因子不超过 1/2；读线程无锁探测，扩容时旧表保留到驻留池析构，
+ *   因此并发读者不会访问已释放内存
+ * - Symbol 到记录的映射存放在容量倍增的分段数组中，解析无锁
+ * - 字符串与哈希一起写入 arena，扩容只搬移指针，不重新计算哈希
+ * - 驻留的字符串不会被单独释放，适合配置键、路由名、节点 ID 等有限集合
+ */
+class StringInterner {
+public:
+    static constexpr uint32_t kMaxSymbols = 0xFFFFFFFEu;
+
+    /**
+     * @brief 构造驻留池
+     * @param expectedSize 预计字符串数量，用于确定初始哈希表大小
+     * @param arenaBlockSize arena 每块字节数，超长字符串单独分配
+     */
+    explicit StringInterner(size_t expectedSize = 1024, size_t arenaBlockSize = 64 * 1024)
+        : m_blockSize(std::max<size_t>(arenaBlockSize, 256)) {
+        auto table = makeTable(std::bit_ceil(std::max<size_t>(16, expectedSize * 2)));
+        m_table.store(table.get(), std::memory_order_relaxed);
+        m_tables.push_back(std::move(table));
+    }
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    ~StringInterner() {
+        for (auto& segment : m_segments) {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief 进程级共享驻留池
+     */
+    static StringInterner& global() {
+        static StringInterner instance(4096);
+        return instance;
+    }
+
+    /**
+     * @brief 计算与驻留池一致的字符串哈希，可预先计算后传给 intern / find
+     */
+    static uint64_t hashOf(std::string_view str) noexcept {
+        return XXH3::hash64(str);
+    }
+
+    /**
+     * @brief 驻留字符串，已存在时无锁返回
+     * @throws std::length_error 字符串数量超过 kMaxSymbols 或单个字符串长度超过 4GB
+     */
+    InternedString intern(std::string_view str) {
+        return intern(str, hashOf(str));
+    }
+
+    /**
+     * @brief 使用预先计算的哈希驻留字符串
+     * @param hash 必须等于 hashOf(str)
+     */
+    InternedString intern(std::string_view str, uint64_t hash) {
+        if (const auto* entry = probe(*m_table.load(std::memory_order_acquire), str, hash)) {
+            return InternedString(entry);
+        }
+
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        Table* table = m_table.load(std::memory_order_relaxed);
+        if (const auto* entry = probe(*table, str, hash)) {
+            return InternedString(entry);
+        }
+
+        const uint32_t count = m_count.load(std::memory_order_relaxed);
+        if (count >= kMaxSymbols || str.size() > UINT32_MAX) {
+            throw std::length_error("StringInterner capacity exceeded");
+        }
+        if ((size_t{count} + 1) * 2 > table->mask + 1) {
+            table = grow(*table);
+        }
+
+        const uint32_t id = count + 1;
+        const auto* entry = allocateEntry(str, hash, id);
+        storeEntry(id, entry);
+        // 先发布数量再发布槽位：读者通过槽位拿到 Symbol 后 resolve 一定可见
+        m_count.store(id, std::memory_order_release);
+        insertSlot(*table, entry);
+        return InternedString(entry);
+    }
+
+    /**
+     * @brief 驻留字符串并返回 Symbol
+     */
+    Symbol internSymbol(std::string_view str) {
+        return intern(str).symbol();
+    }
+
+    /**
+     * @brief 无锁查找已驻留的字符串，不存在时返回无效句柄
+     */
+    InternedString find(std::string_view str) const noexcept {
+        return find(str, hashOf(str));
+    }
+
+    /**
+     * @brief 使用预先计算的哈希无锁查找
+     */
+    InternedString find(std::string_view str, uint64_t hash) const noexcept {
+        return InternedString(probe(*m_table.load(std::memory_order_acquire), str, hash));
+    }
+
+    /**
+     * @brief 无锁解析 Symbol，未知 ID 返回无效句柄
+     */
+    InternedString resolve(Symbol symbol) const noexcept {
+        const uint32_t id = symbol.id();
+        if (id == 0 || id > m_count.load(std::memory_order_acquire)) {
+            return {};
+        }
+        const auto [segment, offset] = locate(id);
+        return InternedString(m_segments[segment].load(std::memory_order_acquire)[offset]);
+    }
+
+    /**
+     * @brief 解析 Symbol 对应的字符串，未知 ID 返回空视图
+     */
+    std::string_view view(Symbol symbol) const noexcept {
+        return resolve(symbol).view();
+    }
+
+    /**
+     * @brief 已驻留字符串数量
+     */
+    size_t size() const noexcept {
+        return m_count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief arena 已分配的字节数（不含哈希表与 ID 表）
+     */
+    size_t arenaBytes() const {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return m_arenaBytes;
+    }
+
+private:
+    using Entry = detail::InternEntry;
+
+    struct Table {
+        size_t mask;
+        std::unique_ptr<std::atomic<const Entry*>[]> slots;
+    };
+
+    /// 第 0 段容纳 2^kFirstSegmentBits 个 ID，之后每段容量翻倍
+    static constexpr unsigned kFirstSegmentBits = 10;
+    static constexpr size_t kSegmentCount = 33 - kFirstSegmentBits;
+
+    static std::unique_ptr<Table> makeTable(size_t capacity) {
+        auto table = std::make_unique<Table>();
+        table->mask = capacity - 1;
+        table->slots.reset(new std::atomic<const Entry*>[capacity]());
+        return table;
+    }
+
+    static const Entry* probe(const Table& table, std::string_view str, uint64_t hash) noexcept {
+        for (size_t slot = hash & table.mask;; slot = (slot + 1) & table.mask) {
+            const Entry* entry = table.slots[slot].load(std::memory_order_acquire);
+            if (entry == nullptr) {
+                return nullptr;
+            }
+            if (entry->hash == hash && entry->length == str.size()
+                && (str.empty() || std::memcmp(entry->data(), str.data(), str.size()) == 0)) {
+                return entry;
+            }
+        }
+    }
+
+    static void insertSlot(Table& table, const Entry* entry) {
+        size_t slot = entry->hash & table.mask;
+        while (table.slots[slot].load(std::memory_order_relaxed) != nullptr) {
+            slot = (slot + 1) & table.mask;
+        }
+        table.slots[slot].store(entry, std::memory_order_release);
+    }
+
+    /// 调用方持有写锁；旧表继续保留给仍在探测的读者
+    Table* grow(const Table& current) {
+        auto table = makeTable((current.mask + 1) * 2);
+        for (size_t i = 0; i <= current.mask; ++i) {
+            if (const Entry* entry = current.slots[i].load(std::memory_order_relaxed)) {
+                insertSlot(*table, entry);
+            }
+        }
+        Table* published = table.get();
+        m_tables.push_back(std::move(table));
+        m_table.store(published, std::memory_order_release);
+        return published;
+    }
+
+    static std::pair<size_t, size_t> locate(uint32_t id) noexcept {
+        const uint64_t adjusted = uint64_t{id} - 1 + (uint64_t{1} << kFirstSegmentBits);
+        const auto segment = static_cast<size_t>(std::bit_width(adjusted)) - 1 - kFirstSegmentBits;
+        return {segment, static_cast<size_t>(adjusted - (uint64_t{1} << (segment + kFirstSegmentBits)))};
+    }
+
+    void storeEntry(uint32_t id, const Entry* entry) {
+        const auto [segment, offset] = locate(id);
+        const Entry** entries = m_segments[segment].load(std::memory_order_relaxed);
+        if (entries == nullptr) {
+            entries = new const Entry*[size_t{1} << (segment + kFirstSegmentBits)]();
+            m_segments[segment].store(entries, std::memory_order_release);
+        }
+        entries[offset] = entry;
+    }
+
+    const Entry* allocateEntry(std::string_view str, uint64_t hash, uint32_t id) {
+        const size_t bytes = (sizeof(Entry) + str.size() + 1 + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+        std::byte* memory;
+        if (bytes > m_blockSize / 4) {
+            // 超长字符串单独分配，不浪费当前块的剩余空间
+            m_blocks.emplace_back(new std::byte[bytes]);
+            memory = m_blocks.back().get();
+        } else {
+            if (m_blockRemaining < bytes) {
+                m_blocks.emplace_back(new std::byte[m_blockSize]);
+                m_blockCursor = m_blocks.back().get();
+                m_blockRemaining = m_blockSize;
+            }
+            memory = m_blockCursor;
+            m_blockCursor += bytes;
+            m_blockRemaining -= bytes;
+        }
+        m_arenaBytes += bytes;
+
+        auto* entry = new (memory) Entry{hash, static_cast<uint32_t>(str.size()), id};
+        char* data = reinterpret_cast<char*>(entry + 1);
+        if (!str.empty()) {
+            std::memcpy(data, str.data(), str.size());
+        }
+        data[str.size()] = '\0';
+        return entry;
+    }
+
+    std::atomic<Table*> m_table{nullptr};
+    std::atomic<uint32_t> m_count{0};
+    std::array<std::atomic<const Entry**>, kSegmentCount> m_segments{};
+
+    mutable std::mutex m_writeMutex;
+    std::vector<std::unique_ptr<Table>> m_tables;
+    std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+    std::byte* m_blockCursor = nullptr;
+    size_t m_blockRemaining = 0;
+    size_t m_blockSize;
+    size_t m_arenaBytes = 0;
+};
+
+} // namespace galay::utils
+
+#endif // GALAY_UTILS_INTERNER_HPP
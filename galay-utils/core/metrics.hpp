@@ -0,0 +1,755 @@
+/**
+ * @file metrics.hpp
+ * @brief 指标注册表：分片计数器、仪表、直方图与 Prometheus / JSON 导出
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details Counter 按 CPU 分片计数，记录路径只对本 CPU 的缓存行做一次 relaxed fetch_add；Gauge 为单个原子值；
+ *          直方图复用 core/histogram.hpp 的线程分片 Histogram。MetricsRegistry 按名称持有这些指标，
+ *          并接受在导出时才读取组件状态的采集回调，组件本身无需在热路径上额外计数。
+ *          snapshot() 生成的 MetricsSnapshot 可导出为 Prometheus 文本格式或 JSON。
+ */
+
+#ifndef GALAY_UTILS_METRICS_HPP
+#define GALAY_UTILS_METRICS_HPP
+
+#include "galay-utils/common/defn.hpp"
+#include "galay-utils/core/histogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(GALAY_PLATFORM_LINUX)
+#include <sched.h>
+#endif
+
+namespace galay::utils {
+
+/// 标签列表，按名称排序后作为同名指标下各序列的标识
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/// 指标类型；Summary 由 Histogram 导出，包含分位数、总和与计数
+enum class MetricType { Counter, Gauge, Summary };
+
+namespace detail {
+
+inline constexpr size_t kMaxMetricStripes = 64;
+
+/// 分片数：CPU 数向上取 2 的幂，不超过 kMaxMetricStripes
+inline size_t metricStripeCount() noexcept {
+    static const size_t count = std::bit_ceil(
+        std::clamp<size_t>(std::thread::hardware_concurrency(), 1, kMaxMetricStripes));
+    return count;
+}
+
+/// 当前 CPU 编号；平台不支持时退化为按线程轮转分配的固定编号
+inline size_t metricStripeHint() noexcept {
+#if defined(GALAY_PLATFORM_LINUX)
+    const int cpu = ::sched_getcpu();
+    if (GALAY_LIKELY(cpu >= 0)) {
+        return static_cast<size_t>(cpu);
+    }
+#endif
+    static std::atomic<size_t> next{0};
+    thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+struct alignas(64) MetricStripe {
+    std::atomic<uint64_t> value{0};
+};
+
+inline bool isMetricNameChar(char c, bool first) noexcept {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' ||
+           (!first && c >= '0' && c <= '9');
+}
+
+/// Prometheus 指标名：[a-zA-Z_:][a-zA-Z0-9_:]*
+inline bool isValidMetricName(std::string_view name) noexcept {
+    if (name.empty()) {
+        return false;
+    }
+    for (size_t i = 0; i < name.size(); ++i) {
+        if (!isMetricNameChar(name[i], i == 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Prometheus 标签名：[a-zA-Z_][a-zA-Z0-9_]*，且不以 "__" 开头
+inline bool isValidLabelName(std::string_view name) noexcept {
+    if (!isValidMetricName(name) || name.starts_with("__")) {
+        return false;
+    }
+    return name.find(':') == std::string_view::npos;
+}
+
+/// 校验标签名并按名称排序
+inline MetricLabels canonicalLabels(MetricLabels labels) {
+    std::sort(labels.begin(), labels.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (!isValidLabelName(labels[i].first)) {
+            throw std::invalid_argument("Invalid metric label name: " + labels[i].first);
+        }
+        if (i > 0 && labels[i].first == labels[i - 1].first) {
+            throw std::invalid_argument("Duplicate metric label name: " + labels[i].first);
+        }
+    }
+    return labels;
+}
+
+inline void appendMetricNumber(std::string& out, double value, bool json) {
+    if (std::isnan(value)) {
+        out += json ? "null" : "NaN";
+        return;
+    }
+    if (std::isinf(value)) {
+        out += json ? "null" : (value > 0 ? "+Inf" : "-Inf");
+        return;
+    }
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+inline void appendMetricNumber(std::string& out, uint64_t value) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+/// Prometheus 标签值转义：反斜杠、双引号与换行；HELP 文本不转义双引号
+inline void appendPrometheusEscaped(std::string& out, std::string_view text, bool quote) {
+    for (const char c : text) {
+        switch (c) {
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '"':
+            out += quote ? "\\\"" : "\"";
+            break;
+        default: out += c; break;
+        }
+    }
+}
+
+inline void appendJsonString(std::string& out, std::string_view text) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    out += '"';
+    for (const char c : text) {
+        const auto byte = static_cast<unsigned char>(c);
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (byte < 0x20) {
+                out += "\\u00";
+                out += kHex[byte >> 4];
+                out += kHex[byte & 0x0f];
+            } else {
+                out += c;
+            }
+            break;
+        }
+    }
+    out += '"';
+}
+
+inline const char* metricTypeName(MetricType type) noexcept {
+    switch (type) {
+    case MetricType::Counter: return "counter";
+    case MetricType::Gauge: return "gauge";
+    case MetricType::Summary: return "summary";
+    }
+    return "untyped";
+}
+
+} // namespace detail
+
+/**
+ * @brief 按 CPU 分片的单调计数器
+ * @details inc() 只对当前 CPU 所在分片做一次 relaxed fetch_add，不同 CPU 之间没有缓存行争用；
+ *          value() 汇总所有分片。Linux 上按 sched_getcpu() 选择分片，其他平台按线程固定分片。
+ *          每个计数器占用 分片数 * 64 字节。
+ */
+class Counter {
+public:
+    Counter()
+        : m_mask(detail::metricStripeCount() - 1)
+        , m_stripes(std::make_unique<detail::MetricStripe[]>(m_mask + 1)) {}
+
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    void inc(uint64_t delta = 1) noexcept {
+        const size_t stripe = m_mask == 0 ? 0 : (detail::metricStripeHint() & m_mask);
+        m_stripes[stripe].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /// 汇总值；与并发 inc() 交错时只保证不小于调用开始前已完成的计数
+    uint64_t value() const noexcept {
+        uint64_t total = 0;
+        for (size_t i = 0; i <= m_mask; ++i) {
+            total += m_stripes[i].value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /// 清零；与并发 inc() 同时进行时个别增量可能保留
+    void reset() noexcept {
+        for (size_t i = 0; i <= m_mask; ++i) {
+            m_stripes[i].value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    size_t m_mask;
+    std::unique_ptr<detail::MetricStripe[]> m_stripes;
+};
+
+/**
+ * @brief 可增可减的仪表
+ * @details 单个原子值；适合低频 set() 或增减，高频单调计数应使用 Counter。
+ */
+class Gauge {
+public:
+    Gauge() = default;
+    Gauge(const Gauge&) = delete;
+    Gauge& operator=(const Gauge&) = delete;
+
+    void set(int64_t value) noexcept { m_value.store(value, std::memory_order_relaxed); }
+    void add(int64_t delta) noexcept { m_value.fetch_add(delta, std::memory_order_relaxed); }
+    void sub(int64_t delta) noexcept { m_value.fetch_sub(delta, std::memory_order_relaxed); }
+    void inc() noexcept { add(1); }
+    void dec() noexcept { sub(1); }
+    int64_t value() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<int64_t> m_value{0};
+};
+
+/**
+ * @brief 一个序列在快照中的值
+ * @details Counter / Gauge 使用 value；Summary 使用 summary 与 sum。
+ */
+struct MetricSample {
+    MetricLabels labels;
+    double value = 0.0;
+    HistogramSummary summary{};
+    uint64_t sum = 0;
+};
+
+/**
+ * @brief 同名指标的全部序列
+ */
+struct MetricFamily {
+    std::string name;
+    std::string help;
+    MetricType type = MetricType::Counter;
+    std::vector<MetricSample> samples;
+};
+
+/**
+ * @brief 指标快照，按名称排序
+ */
+class MetricsSnapshot {
+public:
+    MetricsSnapshot() = default;
+    explicit MetricsSnapshot(std::vector<MetricFamily> families)
+        : m_families(std::move(families)) {}
+
+    const std::vector<MetricFamily>& families() const noexcept { return m_families; }
+    bool empty() const noexcept { return m_families.empty(); }
+
+    const MetricFamily* find(std::string_view name) const noexcept {
+        const auto it = std::lower_bound(m_families.begin(), m_families.end(), name,
+                                         [](const MetricFamily& family, std::string_view key) {
+                                             return family.name < key;
+                                         });
+        return it != m_families.end() && it->name == name ? &*it : nullptr;
+    }
+
+    /**
+     * @brief 查找指定序列
+     * @param labels 标签，顺序不限
+     */
+    const MetricSample* sample(std::string_view name, MetricLabels labels = {}) const {
+        const MetricFamily* family = find(name);
+        if (family == nullptr) {
+            return nullptr;
+        }
+        labels = detail::canonicalLabels(std::move(labels));
+        for (const auto& sample : family->samples) {
+            if (sample.labels == labels) {
+                return &sample;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Counter / Gauge 序列的值，Summary 返回计数
+    std::optional<double> value(std::string_view name, MetricLabels labels = {}) const {
+        const MetricFamily* family = find(name);
+        const MetricSample* found = family == nullptr ? nullptr : sample(name, std::move(labels));
+        if (found == nullptr) {
+            return std::nullopt;
+        }
+        return family->type == MetricType::Summary ? static_cast<double>(found->summary.count) : found->value;
+    }
+
+    /**
+     * @brief 导出 Prometheus 文本格式（0.0.4）
+     * @details Summary 输出 quantile 为 0.5 / 0.9 / 0.99 / 0.999 的序列以及 _sum 与 _count。
+     */
+    std::string toPrometheus() const {
+        std::string out;
+        out.reserve(m_families.size() * 128);
+        for (const auto& family : m_families) {
+            if (!family.help.empty()) {
+                out += "# HELP ";
+                out += family.name;
+                out += ' ';
+                detail::appendPrometheusEscaped(out, family.help, false);
+                out += '\n';
+            }
+            out += "# TYPE ";
+            out += family.name;
+            out += ' ';
+            out += detail::metricTypeName(family.type);
+            out += '\n';
+            for (const auto& sample : family.samples) {
+                if (family.type != MetricType::Summary) {
+                    appendPrometheusLine(out, family.name, {}, sample.labels, {}, sample.value);
+                    continue;
+                }
+                const HistogramSummary& s = sample.summary;
+                appendPrometheusLine(out, family.name, {}, sample.labels, "0.5", static_cast<double>(s.p50));
+                appendPrometheusLine(out, family.name, {}, sample.labels, "0.9", static_cast<double>(s.p90));
+                appendPrometheusLine(out, family.name, {}, sample.labels, "0.99", static_cast<double>(s.p99));
+                appendPrometheusLine(out, family.name, {}, sample.labels, "0.999", static_cast<double>(s.p999));
+                appendPrometheusLine(out, family.name, "_sum", sample.labels, {}, static_cast<double>(sample.sum));
+                appendPrometheusLine(out, family.name, "_count", sample.labels, {}, static_cast<double>(s.count));
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief 导出 JSON
+     * @details 形如 {"metrics":[{"name":...,"type":...,"help":...,"samples":[{"labels":{...},"value":...}]}]}；
+     *          Summary 序列输出 count / sum / min / max / mean / p50 / p90 / p99 / p999，NaN 与无穷输出为 null。
+     */
+    std::string toJson() const {
+        std::string out;
+        out.reserve(m_families.size() * 160);
+        out += "{\"metrics\":[";
+        for (size_t f = 0; f < m_families.size(); ++f) {
+            const MetricFamily& family = m_families[f];
+            if (f > 0) {
+                out += ',';
+            }
+            out += "{\"name\":";
+            detail::appendJsonString(out, family.name);
+            out += ",\"type\":\"";
+            out += detail::metricTypeName(family.type);
+            out += "\",\"help\":";
+            detail::appendJsonString(out, family.help);
+            out += ",\"samples\":[";
+            for (size_t i = 0; i < family.samples.size(); ++i) {
+                const MetricSample& sample = family.samples[i];
+                if (i > 0) {
+                    out += ',';
+                }
+                out += "{\"labels\":{";
+                for (size_t l = 0; l < sample.labels.size(); ++l) {
+                    if (l > 0) {
+                        out += ',';
+                    }
+                    detail::appendJsonString(out, sample.labels[l].first);
+                    out += ':';
+                    detail::appendJsonString(out, sample.labels[l].second);
+                }
+                out += '}';
+                if (family.type != MetricType::Summary) {
+                    out += ",\"value\":";
+                    detail::appendMetricNumber(out, sample.value, true);
+                } else {
+                    const HistogramSummary& s = sample.summary;
+                    appendJsonField(out, "count", s.count);
+                    appendJsonField(out, "sum", sample.sum);
+                    appendJsonField(out, "min", s.min);
+                    appendJsonField(out, "max", s.max);
+                    out += ",\"mean\":";
+                    detail::appendMetricNumber(out, s.mean, true);
+                    appendJsonField(out, "p50", s.p50);
+                    appendJsonField(out, "p90", s.p90);
+                    appendJsonField(out, "p99", s.p99);
+                    appendJsonField(out, "p999", s.p999);
+                }
+                out += '}';
+            }
+            out += "]}";
+        }
+        out += "]}";
+        return out;
+    }
+
+private:
+    static void appendPrometheusLine(std::string& out, std::string_view name, std::string_view suffix,
+                                     const MetricLabels& labels, std::string_view quantile, double value) {
+        out += name;
+        out += suffix;
+        if (!labels.empty() || !quantile.empty()) {
+            out += '{';
+            bool first = true;
+            for (const auto& [key, text] : labels) {
+                if (!first) {
+                    out += ',';
+                }
+                first = false;
+                out += key;
+                out += "=\"";
+                detail::appendPrometheusEscaped(out, text, true);
+                out += '"';
+            }
+            if (!quantile.empty()) {
+                if (!first) {
+                    out += ',';
+                }
+                out += "quantile=\"";
+                out += quantile;
+                out += '"';
+            }
+            out += '}';
+        }
+        out += ' ';
+        detail::appendMetricNumber(out, value, false);
+        out += '\n';
+    }
+
+    static void appendJsonField(std::string& out, std::string_view key, uint64_t value) {
+        out += ",\"";
+        out += key;
+        out += "\":";
+        detail::appendMetricNumber(out, value);
+    }
+
+    std::vector<MetricFamily> m_families;
+};
+
+/**
+ * @brief 采集回调的输出接口
+ * @details 由 MetricsRegistry::snapshot() 构造并传给采集回调；同名指标的类型以首次写入为准，
+ *          类型不一致的后续写入被忽略。指标名非法或标签名非法时抛出 std::invalid_argument。
+ */
+class MetricsWriter {
+public:
+    void counter(std::string_view name, std::string_view help, double value, MetricLabels labels = {}) {
+        write(name, help, MetricType::Counter, std::move(labels), [value](MetricSample& sample) {
+            sample.value = value;
+        });
+    }
+
+    void gauge(std::string_view name, std::string_view help, double value, MetricLabels labels = {}) {
+        write(name, help, MetricType::Gauge, std::move(labels), [value](MetricSample& sample) {
+            sample.value = value;
+        });
+    }
+
+    void summary(std::string_view name, std::string_view help, const HistogramSnapshot& snapshot,
+                 MetricLabels labels = {}) {
+        write(name, help, MetricType::Summary, std::move(labels), [&snapshot](MetricSample& sample) {
+            sample.summary = snapshot.summary();
+            sample.sum = snapshot.sum();
+        });
+    }
+
+    /// 写入指标时为名称加上的前缀，与所属注册表一致
+    const std::string& prefix() const noexcept { return m_prefix; }
+
+private:
+    friend class MetricsRegistry;
+
+    explicit MetricsWriter(std::string prefix)
+        : m_prefix(std::move(prefix)) {}
+
+    template<typename Fill>
+    void write(std::string_view name, std::string_view help, MetricType type, MetricLabels labels, Fill&& fill) {
+        std::string fullName = m_prefix;
+        fullName += name;
+        if (!detail::isValidMetricName(fullName)) {
+            throw std::invalid_argument("Invalid metric name: " + fullName);
+        }
+        auto it = m_families.find(fullName);
+        if (it == m_families.end()) {
+            MetricFamily family;
+            family.name = fullName;
+            family.help = std::string(help);
+            family.type = type;
+            it = m_families.emplace(std::move(fullName), std::move(family)).first;
+        } else if (it->second.type != type) {
+            return;
+        }
+        MetricSample sample;
+        sample.labels = detail::canonicalLabels(std::move(labels));
+        fill(sample);
+        it->second.samples.push_back(std::move(sample));
+    }
+
+    MetricsSnapshot finish() {
+        std::vector<MetricFamily> families;
+        families.reserve(m_families.size());
+        for (auto& [name, family] : m_families) {
+            families.push_back(std::move(family));
+        }
+        return MetricsSnapshot(std::move(families));
+    }
+
+    std::string m_prefix;
+    std::map<std::string, MetricFamily, std::less<>> m_families;
+};
+
+class MetricsRegistry;
+
+/**
+ * @brief 采集回调的注册句柄
+ * @details 析构或 reset() 时注销回调；注销与 snapshot() 互斥，返回后回调不会再被调用。
+ *          注册表必须比句柄存活更久。
+ */
+class MetricsRegistration {
+public:
+    MetricsRegistration() = default;
+    MetricsRegistration(const MetricsRegistration&) = delete;
+    MetricsRegistration& operator=(const MetricsRegistration&) = delete;
+
+    MetricsRegistration(MetricsRegistration&& other) noexcept
+        : m_registry(std::exchange(other.m_registry, nullptr))
+        , m_id(other.m_id) {}
+
+    MetricsRegistration& operator=(MetricsRegistration&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_registry = std::exchange(other.m_registry, nullptr);
+            m_id = other.m_id;
+        }
+        return *this;
+    }
+
+    ~MetricsRegistration() { reset(); }
+
+    inline void reset() noexcept;
+
+    bool active() const noexcept { return m_registry != nullptr; }
+
+private:
+    friend class MetricsRegistry;
+
+    MetricsRegistration(MetricsRegistry* registry, uint64_t id) noexcept
+        : m_registry(registry)
+        , m_id(id) {}
+
+    MetricsRegistry* m_registry = nullptr;
+    uint64_t m_id = 0;
+};
+
+/**
+ * @brief 指标注册表
+ * @details
+ * - counter() / gauge() / histogram() 按 名称 + 标签 获取或创建指标，返回的引用在注册表存活期间有效；
+ *   应在初始化时取得引用并保存，记录路径直接操作指标对象，不经过注册表
+ * - addCollector() 注册在导出时调用的回调，用于读取组件已有的状态（见 tool/component_metrics.hpp）
+ * - 注册表方法线程安全；snapshot() 持锁期间依次调用采集回调，回调中不得访问同一注册表
+ * - prefix 会加在所有指标名之前，例如 "galay_"
+ */
+class MetricsRegistry {
+public:
+    explicit MetricsRegistry(std::string prefix = {})
+        : m_prefix(std::move(prefix)) {
+        if (!m_prefix.empty() && !detail::isValidMetricName(m_prefix)) {
+            throw std::invalid_argument("Invalid metric prefix: " + m_prefix);
+        }
+    }
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /// 进程级默认注册表，无前缀
+    static MetricsRegistry& global() {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    const std::string& prefix() const noexcept { return m_prefix; }
+
+    /**
+     * @brief 获取或创建计数器
+     * @throws std::invalid_argument 名称或标签名非法，或同名指标已注册为其他类型
+     */
+    Counter& counter(std::string_view name, std::string_view help = {}, MetricLabels labels = {}) {
+        return series(name, help, MetricType::Counter, std::move(labels), &Series::counter, [](Series& series) {
+            series.counter = std::make_unique<Counter>();
+        });
+    }
+
+    /// 获取或创建仪表，异常同 counter()
+    Gauge& gauge(std::string_view name, std::string_view help = {}, MetricLabels labels = {}) {
+        return series(name, help, MetricType::Gauge, std::move(labels), &Series::gauge, [](Series& series) {
+            series.gauge = std::make_unique<Gauge>();
+        });
+    }
+
+    /**
+     * @brief 获取或创建直方图，导出为 Summary
+     * @details 序列已存在时忽略 highestTrackableValue 与 precisionBits；异常同 counter()
+     */
+    Histogram& histogram(std::string_view name, std::string_view help = {}, MetricLabels labels = {},
+                         uint64_t highestTrackableValue = Histogram::kDefaultHighestTrackableValue,
+                         unsigned precisionBits = Histogram::kDefaultPrecisionBits) {
+        return series(name, help, MetricType::Summary, std::move(labels), &Series::histogram,
+                      [highestTrackableValue, precisionBits](Series& series) {
+            series.histogram = std::make_unique<Histogram>(highestTrackableValue, precisionBits);
+        });
+    }
+
+    /**
+     * @brief 注册采集回调
+     * @return 注册句柄，析构时注销
+     */
+    [[nodiscard]] MetricsRegistration addCollector(std::function<void(MetricsWriter&)> collector) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const uint64_t id = ++m_nextCollectorId;
+        m_collectors.emplace(id, std::move(collector));
+        return MetricsRegistration(this, id);
+    }
+
+    /// 已注册的采集回调数
+    size_t collectorCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_collectors.size();
+    }
+
+    /**
+     * @brief 读取全部指标并调用采集回调
+     * @details 采集回调抛出的异常会传播给调用方
+     */
+    MetricsSnapshot snapshot() const {
+        MetricsWriter writer(m_prefix);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& [name, family] : m_families) {
+            for (const auto& series : family.series) {
+                switch (family.type) {
+                case MetricType::Counter:
+                    writer.write(name, family.help, family.type, series.labels, [&series](MetricSample& sample) {
+                        sample.value = static_cast<double>(series.counter->value());
+                    });
+                    break;
+                case MetricType::Gauge:
+                    writer.write(name, family.help, family.type, series.labels, [&series](MetricSample& sample) {
+                        sample.value = static_cast<double>(series.gauge->value());
+                    });
+                    break;
+                case MetricType::Summary: {
+                    const HistogramSnapshot histogram = series.histogram->snapshot();
+                    writer.write(name, family.help, family.type, series.labels, [&histogram](MetricSample& sample) {
+                        sample.summary = histogram.summary();
+                        sample.sum = histogram.sum();
+                    });
+                    break;
+                }
+                }
+            }
+        }
+        for (const auto& [id, collector] : m_collectors) {
+            collector(writer);
+        }
+        return writer.finish();
+    }
+
+    std::string toPrometheus() const { return snapshot().toPrometheus(); }
+    std::string toJson() const { return snapshot().toJson(); }
+
+private:
+    friend class MetricsRegistration;
+
+    struct Series {
+        MetricLabels labels;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    struct Family {
+        MetricType type;
+        std::string help;
+        std::vector<Series> series;
+    };
+
+    /// 获取或创建序列并在持锁期间取出指标；指标本身在堆上，地址不随 Family::series 扩容变化
+    template<typename Metric, typename Create>
+    Metric& series(std::string_view name, std::string_view help, MetricType type, MetricLabels labels,
+                   std::unique_ptr<Metric> Series::* member, Create&& create) {
+        if (!detail::isValidMetricName(m_prefix + std::string(name))) {
+            throw std::invalid_argument("Invalid metric name: " + m_prefix + std::string(name));
+        }
+        labels = detail::canonicalLabels(std::move(labels));
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_families.find(name);
+        if (it == m_families.end()) {
+            it = m_families.emplace(std::string(name), Family{type, std::string(help), {}}).first;
+        } else if (it->second.type != type) {
+            throw std::invalid_argument("Metric registered with a different type: " + std::string(name));
+        }
+        for (auto& existing : it->second.series) {
+            if (existing.labels == labels) {
+                return *(existing.*member);
+            }
+        }
+        Series created;
+        created.labels = std::move(labels);
+        create(created);
+        Metric& metric = *(created.*member);
+        it->second.series.push_back(std::move(created));
+        return metric;
+    }
+
+    void removeCollector(uint64_t id) noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_collectors.erase(id);
+    }
+
+    std::string m_prefix;
+    mutable std::mutex m_mutex;
+    std::map<std::string, Family, std::less<>> m_families;
+    std::map<uint64_t, std::function<void(MetricsWriter&)>> m_collectors;
+    uint64_t m_nextCollectorId = 0;
+};
+
+inline void MetricsRegistration::reset() noexcept {
+    if (m_registry != nullptr) {
+        m_registry->removeCollector(m_id);
+        m_registry = nullptr;
+    }
+}
+
+} // namespace galay::utils
+
+#endif // GALAY_UTILS_METRICS_HPP
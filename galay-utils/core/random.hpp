@@ -4,237 +4,204 @@
  * @author galay-utils
  * @version 1.0.0
  *
- * @details 提供本地无锁随机数生成器和线程安全单例随机数生成器，支持整数、
- *          浮点数、布尔值、字符串、十六进制、字节和 UUID 生成。
+ * @details 提供 xoshiro256** / wyrand 引擎、本地无锁随机数生成器和线程本地随机数生成器，
+ *          支持整数、浮点数、布尔值、字符串、十六进制、字节和 UUID 生成。
+ *          有界整数使用 Lemire 近似无除法算法，字节批量生成每次引擎调用产出 8 字节。
+ *          这些生成器不具备密码学安全性，令牌、盐值等场景请使用 SecureRandom。
  */
 
 #ifndef GALAY_UTILS_RANDOM_HPP
 #define GALAY_UTILS_RANDOM_HPP
 
 #include "galay-utils/common/defn.hpp"
+#include "galay-utils/encoding/hex.hpp"
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <random>
+#include <span>
 #include <string>
 #include <string_view>
-#include <mutex>
+
+#if defined(GALAY_COMPILER_MSVC)
+#include <intrin.h>
+#endif
 
 namespace galay::utils {
 
+namespace detail {
+
+/// SplitMix64：把单个 64 位种子扩展为引擎状态
+inline uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/// 64x64 -> 128 位乘法，返回低 64 位，高 64 位写入 high
+inline uint64_t mul128(uint64_t a, uint64_t b, uint64_t& high) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    high = static_cast<uint64_t>(product >> 64);
+    return static_cast<uint64_t>(product);
+#elif defined(GALAY_COMPILER_MSVC) && defined(GALAY_ARCH_X64)
+    return _umul128(a, b, &high);
+#else
+    const uint64_t aLo = a & 0xFFFFFFFFu, aHi = a >> 32;
+    const uint64_t bLo = b & 0xFFFFFFFFu, bHi = b >> 32;
+    const uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+    const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return (mid << 32) | (ll & 0xFFFFFFFFu);
+#endif
+}
+
+} // namespace detail
+
 /**
- * @brief 本地随机数生成器
- * @details 使用 Mersenne Twister 19937_64 引擎。不包含互斥锁，非线程安全；
- *          多线程或多个协程并发共享同一个实例时必须由调用方外部同步。
- *          推荐在协程热路径或单线程上下文中使用独立实例，避免共享单例锁竞争。
+ * @brief xoshiro256** 引擎
+ * @details 256 位状态、周期 2^256 - 1，满足 UniformRandomBitGenerator，可直接配合标准分布使用。
+ *          jump() 前进 2^128 步，用于为并行任务切分互不重叠的子序列。
  */
-class RandomGenerator {
+class Xoshiro256StarStar {
 public:
-    /**
-     * @brief 使用随机设备构造生成器
-     */
-    RandomGenerator() {
-        reseed();
-    }
+    using result_type = uint64_t;
 
-    /**
-     * @brief 使用固定种子构造生成器
-     * @param seedValue 种子值；相同种子会生成相同序列
-     */
-    explicit RandomGenerator(uint64_t seedValue)
-        : m_engine(seedValue) {}
-
-    /**
-     * @brief 生成随机整数
-     * @param min 最小值（含）
-     * @param max 最大值（含）
-     * @return min < max 时返回闭区间随机数；否则返回 min
-     */
-    int randomInt(int min, int max) {
-        if (min >= max) return min;
-        std::uniform_int_distribution<int> dist(min, max);
-        return dist(m_engine);
-    }
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
 
     /**
-     * @brief 生成随机 32 位无符号整数
-     * @param min 最小值（含）
-     * @param max 最大值（含）
-     * @return min < max 时返回闭区间随机数；否则返回 min
+     * @brief 以 SplitMix64 扩展的单个种子构造
      */
-    uint32_t randomUint32(uint32_t min, uint32_t max) {
-        if (min >= max) return min;
-        std::uniform_int_distribution<uint32_t> dist(min, max);
-        return dist(m_engine);
+    explicit Xoshiro256StarStar(uint64_t seedValue = 0x853c49e6748fea9bull) {
+        seed(seedValue);
     }
 
     /**
-     * @brief 生成随机 64 位无符号整数
-     * @param min 最小值（含）
-     * @param max 最大值（含）
-     * @return min < max 时返回闭区间随机数；否则返回 min
+     * @brief 以完整状态构造；状态不能全为 0
      */
-    uint64_t randomUint64(uint64_t min, uint64_t max) {
-        if (min >= max) return min;
-        std::uniform_int_distribution<uint64_t> dist(min, max);
-        return dist(m_engine);
-    }
+    explicit Xoshiro256StarStar(const std::array<uint64_t, 4>& state)
+        : m_state(state) {}
 
-    /**
-     * @brief 生成随机双精度浮点数
-     * @param min 最小值（含）
-     * @param max 最大值（不含）
-     * @return min < max 时返回半开区间随机数；否则返回 min
-     */
-    double randomDouble(double min, double max) {
-        if (min >= max) return min;
-        std::uniform_real_distribution<double> dist(min, max);
-        return dist(m_engine);
-    }
-
-    /**
-     * @brief 生成随机单精度浮点数
-     * @param min 最小值（含）
-     * @param max 最大值（不含）
-     * @return min < max 时返回半开区间随机数；否则返回 min
-     */
-    float randomFloat(float min, float max) {
-        if (min >= max) return min;
-        std::uniform_real_distribution<float> dist(min, max);
-        return dist(m_engine);
+    void seed(uint64_t seedValue) {
+        for (auto& word : m_state) {
+            word = detail::splitMix64(seedValue);
+        }
     }
 
-    /**
-     * @brief 生成随机布尔值
-     * @param probability 为 true 的概率；小于等于 0 返回 false，大于等于 1 返回 true
-     * @return 随机布尔值
-     */
-    bool randomBool(double probability = 0.5) {
-        if (probability <= 0.0) return false;
-        if (probability >= 1.0) return true;
-        std::bernoulli_distribution dist(probability);
-        return dist(m_engine);
+    result_type operator()() {
+        const uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
     }
 
     /**
-     * @brief 生成随机字符串
-     * @param length 字符串长度
-     * @param charset 字符集（默认为字母数字）；为空时返回空字符串
-     * @return 随机字符串；length 为 0 或 charset 为空时返回空字符串
+     * @brief 前进 2^128 步
      */
-    std::string randomString(size_t length,
-                             std::string_view charset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789") {
-        if (charset.empty() || length == 0) return "";
-
-        std::string result;
-        result.resize(length); // 预分配内存
-
-        std::uniform_int_distribution<size_t> dist(0, charset.length() - 1);
-
-        for (size_t i = 0; i < length; ++i) {
-            result[i] = charset[dist(m_engine)]; // 直接赋值，避免+=操作
+    void jump() {
+        static constexpr uint64_t kJump[4] = {
+            0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+        std::array<uint64_t, 4> next{};
+        for (uint64_t mask : kJump) {
+            for (int bit = 0; bit < 64; ++bit) {
+                if (mask & (uint64_t{1} << bit)) {
+                    for (size_t i = 0; i < 4; ++i) {
+                        next[i] ^= m_state[i];
+                    }
+                }
+                (*this)();
+            }
         }
+        m_state = next;
+    }
 
-        return result;
+private:
+    static constexpr uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
     }
 
-    /**
-     * @brief 生成随机十六进制字符串
-     * @param length 字符串长度
-     * @param uppercase 是否使用大写字母
-     * @return 随机十六进制字符串；length 为 0 时返回空字符串
-     */
-    std::string randomHex(size_t length, bool uppercase = false) {
-        if (length == 0) return "";
+    std::array<uint64_t, 4> m_state;
+};
 
-        const char* hexChars = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+/**
+ * @brief wyrand 引擎
+ * @details 64 位状态、每次一次 128 位乘法，是目前最快的高质量 64 位生成器之一；
+ *          周期 2^64，适合单次抽样与 ID 生成，不适合需要超长不重叠序列的模拟。
+ */
+class WyRand {
+public:
+    using result_type = uint64_t;
 
-        std::string result;
-        result.resize(length); // 预分配内存
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
 
-        std::uniform_int_distribution<int> dist(0, 15);
+    explicit WyRand(uint64_t seedValue = 0) : m_state(seedValue) {}
 
-        for (size_t i = 0; i < length; ++i) {
-            result[i] = hexChars[dist(m_engine)]; // 直接赋值
-        }
+    void seed(uint64_t seedValue) { m_state = seedValue; }
 
-        return result;
+    result_type operator()() {
+        m_state += 0xa0761d6478bd642full;
+        uint64_t high;
+        const uint64_t low = detail::mul128(m_state, m_state ^ 0xe7037ed1a0b428dbull, high);
+        return high ^ low;
     }
 
-    /**
-     * @brief 生成随机字节序列
-     * @param buffer 输出缓冲区；为空时直接返回
-     * @param length 字节数量
-     */
-    void randomBytes(uint8_t* buffer, size_t length) {
-        if (buffer == nullptr || length == 0) return;
+private:
+    uint64_t m_state;
+};
 
-        std::uniform_int_distribution<int> dist(0, 255);
+/**
+ * @brief 本地随机数生成器
+ * @details Engine 须输出完整 64 位（min() == 0、max() == UINT64_MAX）。不包含互斥锁，非线程安全；
+ *          多线程或多个协程并发共享同一个实例时必须由调用方外部同步。
+ *          推荐在协程热路径或单线程上下文中使用独立实例，或使用线程本地的 Randomizer::instance()。
+ */
+template<typename Engine>
+class BasicRandomGenerator {
+    static_assert(Engine::min() == 0 && Engine::max() == std::numeric_limits<uint64_t>::max(),
+                  "BasicRandomGenerator requires a full 64-bit engine");
 
-        for (size_t i = 0; i < length; ++i) {
-            buffer[i] = static_cast<uint8_t>(dist(m_engine));
-        }
-    }
+public:
+    using engine_type = Engine;
 
     /**
-     * @brief 生成 UUID（版本 4）
-     * @return 36 字符的 UUID 字符串
+     * @brief 使用随机设备构造生成器
      */
-    std::string uuid() {
-        std::uniform_int_distribution<int> dist(0, 15);
-        std::uniform_int_distribution<int> dist2(8, 11);
-
-        const char* hexChars = "0123456789abcdef";
-        std::string uuid(36, '-');
-
-        for (int i = 0; i < 36; ++i) {
-            if (i == 8 || i == 13 || i == 18 || i == 23) {
-                continue;
-            } else if (i == 14) {
-                uuid[i] = '4';
-            } else if (i == 19) {
-                uuid[i] = hexChars[dist2(m_engine)];
-            } else {
-                uuid[i] = hexChars[dist(m_engine)];
-            }
-        }
-
-        return uuid;
+    BasicRandomGenerator() {
+        reseed();
     }
 
     /**
-     * @brief 使用固定种子重置生成器状态
+     * @brief 使用固定种子构造生成器
      * @param seedValue 种子值；相同种子会生成相同序列
      */
-    void seed(uint64_t seed) {
-        m_engine.seed(seed);
-    }
-
-    /**
-     * @brief 使用随机设备重新播种
-     */
-    void reseed() {
-        std::random_device rd;
-        m_engine.seed(rd());
-    }
-
-private:
-    std::mt19937_64 m_engine;
-};
+    explicit BasicRandomGenerator(uint64_t seedValue)
+        : m_engine(seedValue) {}
 
-/**
- * @brief 线程安全随机数生成器单例
- * @details 单例模式，内部持有 RandomGenerator 并使用互斥锁保护共享状态。
- *          所有需要推进随机引擎状态的方法都会短暂加锁，因此可安全跨线程共享，
- *          但不适合协程调度线程或高频热路径；这些场景应优先使用调用方自持有、
- *          自同步的 RandomGenerator。
- */
-class Randomizer {
-public:
     /**
-     * @brief 获取单例实例
-     * @return 随机数生成器实例引用
+     * @brief 生成 [0, bound) 内均匀分布的整数（Lemire 近似无除法算法）
+     * @param bound 上界（不含）；为 0 时返回 0
+     * @details 绝大多数调用只需一次乘法，仅在低位落入拒绝区间时才计算一次取模。
      */
-    static Randomizer& instance() {
-        static Randomizer instance;
-        return instance;
+    uint64_t uniform(uint64_t bound) {
+        if (bound == 0) return 0;
+        uint64_t high;
+        uint64_t low = detail::mul128(m_engine(), bound, high);
+        if (low < bound) {
+            const uint64_t threshold = (0 - bound) % bound;
+            while (low < threshold) {
+                low = detail::mul128(m_engine(), bound, high);
+            }
+        }
+        return high;
     }
 
     /**
@@ -245,8 +212,8 @@ public:
      */
     int randomInt(int min, int max) {
         if (min >= max) return min;
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_generator.randomInt(min, max);
+        const uint64_t span = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+        return static_cast<int>(min + static_cast<int64_t>(uniform(span)));
     }
 
     /**
@@ -257,8 +224,7 @@ public:
      */
     uint32_t randomUint32(uint32_t min, uint32_t max) {
         if (min >= max) return min;
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_generator.randomUint32(min, max);
+        return min + static_cast<uint32_t>(uniform(static_cast<uint64_t>(max - min) + 1));
     }
 
     /**
@@ -269,8 +235,9 @@ public:
      */
     uint64_t randomUint64(uint64_t min, uint64_t max) {
         if (min >= max) return min;
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_generator.randomUint64(min, max);
+        const uint64_t span = max - min + 1;
+        // span 溢出为 0 表示取满整个 64 位范围
+        return span == 0 ? m_engine() : min + uniform(span);
     }
 
     /**
@@ -281,8 +248,9 @@ public:
      */
     double randomDouble(double min, double max) {
         if (min >= max) return min;
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_generator.randomDouble(min, max);
+        const double value = min + unitDouble() * (max - min);
+        // 舍入可能得到 max，此时退回到 max 之下最近的可表示值
+        return value < max ? value : std::nextafter(max, min);
     }
 
     /**
@@ -293,8 +261,9 @@ public:
      */
     float randomFloat(float min, float max) {
         if (min >= max) return min;
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_generator.randomFloat(min, max);
+        const float unit = static_cast<float>(m_engine() >> 40) * 0x1.0p-24f;
+        const float value = min + unit * (max - min);
+        return value < max ? value : std::nextafter(max, min);
     }
 
     /**
@@ -305,8 +274,7 @@ public:
     bool randomBool(double probability = 0.5) {
         if (probability <= 0.0) return false;
         if (probability >= 1.0) return true;
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_generator.randomBool(probability);
+        return unitDouble() < probability;
     }
 
     /**
@@ -318,8 +286,12 @@ public:
     std::string randomString(size_t length,
                              std::string_view charset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789") {
         if (charset.empty() || length == 0) return "";
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_generator.randomString(length, charset);
+
+        std::string result(length, '\0');
+        for (size_t i = 0; i < length; ++i) {
+            result[i] = charset[uniform(charset.size())];
+        }
+        return result;
     }
 
     /**
@@ -327,11 +299,38 @@ public:
      * @param length 字符串长度
      * @param uppercase 是否使用大写字母
      * @return 随机十六进制字符串；length 为 0 时返回空字符串
+     * @details 批量生成 (length + 1) / 2 个随机字节后经 HexCodec 编码，每次引擎调用产出 16 个字符。
      */
     std::string randomHex(size_t length, bool uppercase = false) {
         if (length == 0) return "";
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_generator.randomHex(length, uppercase);
+
+        const size_t byteCount = (length + 1) / 2;
+        std::string result(byteCount * 2, '\0');
+        // 随机字节先写在结果的后半段，再从前往后原地展开为十六进制
+        uint8_t* raw = reinterpret_cast<uint8_t*>(result.data()) + byteCount;
+        fill(std::span<uint8_t>(raw, byteCount));
+        detail::hexEncodeScalar(raw, byteCount, result.data(), uppercase);
+        result.resize(length);
+        return result;
+    }
+
+    /**
+     * @brief 批量填充随机字节，每次引擎调用产出 8 字节
+     * @param output 输出缓冲区
+     */
+    void fill(std::span<uint8_t> output) {
+        uint8_t* out = output.data();
+        size_t remaining = output.size();
+        while (remaining >= 8) {
+            const uint64_t value = m_engine();
+            std::memcpy(out, &value, 8);
+            out += 8;
+            remaining -= 8;
+        }
+        if (remaining > 0) {
+            const uint64_t value = m_engine();
+            std::memcpy(out, &value, remaining);
+        }
     }
 
     /**
@@ -341,8 +340,7 @@ public:
      */
     void randomBytes(uint8_t* buffer, size_t length) {
         if (buffer == nullptr || length == 0) return;
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_generator.randomBytes(buffer, length);
+        fill(std::span<uint8_t>(buffer, length));
     }
 
     /**
@@ -350,36 +348,80 @@ public:
      * @return 36 字符的 UUID 字符串
      */
     std::string uuid() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_generator.uuid();
+        std::array<uint8_t, 16> raw;
+        fill(raw);
+        raw[6] = static_cast<uint8_t>((raw[6] & 0x0F) | 0x40);
+        raw[8] = static_cast<uint8_t>((raw[8] & 0x3F) | 0x80);
+        std::string result(36, '\0');
+        detail::hexFormatUuid(raw.data(), result.data());
+        return result;
+    }
+
+    /**
+     * @brief 直接获取一个 64 位随机数
+     */
+    uint64_t next() {
+        return m_engine();
+    }
+
+    /**
+     * @brief 访问底层引擎，可配合标准库分布使用
+     */
+    Engine& engine() {
+        return m_engine;
     }
 
     /**
      * @brief 使用固定种子重置生成器状态
      * @param seedValue 种子值；相同种子会生成相同序列
      */
-    void seed(uint64_t seed) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_generator.seed(seed);
+    void seed(uint64_t seedValue) {
+        m_engine.seed(seedValue);
     }
 
     /**
      * @brief 使用随机设备重新播种
      */
     void reseed() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_generator.reseed();
+        std::random_device rd;
+        m_engine.seed((static_cast<uint64_t>(rd()) << 32) ^ rd());
     }
 
 private:
-    Randomizer() = default;
-    ~Randomizer() = default;
+    double unitDouble() {
+        return static_cast<double>(m_engine() >> 11) * 0x1.0p-53;
+    }
+
+    Engine m_engine;
+};
+
+/// 默认本地随机数生成器，使用 xoshiro256** 引擎
+using RandomGenerator = BasicRandomGenerator<Xoshiro256StarStar>;
+/// 使用 wyrand 引擎的本地随机数生成器
+using WyRandGenerator = BasicRandomGenerator<WyRand>;
+
+/**
+ * @brief 线程本地随机数生成器
+ * @details instance() 返回调用线程独享的实例，各线程首次访问时独立播种；
+ *          全部方法无锁，可在协程热路径中直接调用。seed() / reseed() 只影响调用线程的序列。
+ *          线程本地实例不可跨线程传递引用使用。
+ */
+class Randomizer : public RandomGenerator {
+public:
+    /**
+     * @brief 获取当前线程的实例
+     * @return 随机数生成器实例引用
+     */
+    static Randomizer& instance() {
+        static thread_local Randomizer instance;
+        return instance;
+    }
 
     Randomizer(const Randomizer&) = delete;
     Randomizer& operator=(const Randomizer&) = delete;
 
-    RandomGenerator m_generator;
-    std::mutex m_mutex;
+private:
+    Randomizer() = default;
 };
 
 } // namespace galay::utils
@@ -2,16 +2,37 @@
 #define GALAY_UTILS_STRING_HPP
 
 #include "galay-utils/common/defn.hpp"
+#include "galay-utils/core/ascii.hpp"
+#include "galay-utils/encoding/hex.hpp"
 #include <vector>
 #include <string>
 #include <string_view>
 #include <sstream>
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cctype>
 #include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdio>
+#include <cstring>
 #include <iomanip>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <cstdlib>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <system_error>
 #include <type_traits>
+#include <utility>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
 
 namespace galay::utils {
 
@@ -25,6 +46,454 @@ namespace galay::utils {
  *          前后缀检查、替换、十六进制转换、类型判断和格式化等。
  */
 
+namespace detail {
+
+/// 查找 [pos, size) 中首个等于 set 内任一字符（1 到 4 个）的位置，未找到返回 npos
+inline size_t findAnyOfSmall(const char* data, size_t size, size_t pos, const char* set, size_t setSize) {
+    const char c0 = set[0];
+    const char c1 = setSize > 1 ? set[1] : c0;
+    const char c2 = setSize > 2 ? set[2] : c0;
+    const char c3 = setSize > 3 ? set[3] : c0;
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+    const __m128i v0 = _mm_set1_epi8(c0);
+    const __m128i v1 = _mm_set1_epi8(c1);
+    const __m128i v2 = _mm_set1_epi8(c2);
+    const __m128i v3 = _mm_set1_epi8(c3);
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        const __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, v0), _mm_cmpeq_epi8(chunk, v1)),
+                                         _mm_or_si128(_mm_cmpeq_epi8(chunk, v2), _mm_cmpeq_epi8(chunk, v3)));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+        if (mask != 0) {
+            return pos + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+#elif defined(GALAY_UTILS_CODEC_NEON)
+    const uint8x16_t v0 = vdupq_n_u8(static_cast<uint8_t>(c0));
+    const uint8x16_t v1 = vdupq_n_u8(static_cast<uint8_t>(c1));
+    const uint8x16_t v2 = vdupq_n_u8(static_cast<uint8_t>(c2));
+    const uint8x16_t v3 = vdupq_n_u8(static_cast<uint8_t>(c3));
+    for (; pos + 16 <= size; pos += 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(data + pos));
+        const uint8x16_t hit = vorrq_u8(vorrq_u8(vceqq_u8(chunk, v0), vceqq_u8(chunk, v1)),
+                                        vorrq_u8(vceqq_u8(chunk, v2), vceqq_u8(chunk, v3)));
+        // 每字节压成 4 位，得到 64 位掩码
+        const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+        if (mask != 0) {
+            return pos + static_cast<size_t>(__builtin_ctzll(mask) >> 2);
+        }
+    }
+#endif
+    for (; pos < size; ++pos) {
+        const char ch = data[pos];
+        if (ch == c0 || ch == c1 || ch == c2 || ch == c3) {
+            return pos;
+        }
+    }
+    return std::string_view::npos;
+}
+
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+/**
+ * @brief SSE2 子串候选过滤：同时比较模式首字节与末字节，命中位再逐个 memcmp 中间部分
+ * @details pos 推进到未处理的位置；找到返回下标，否则返回 npos。要求 needleSize >= 2。
+ */
+inline size_t findSubstringSse2(const char* data, size_t size, const char* needle, size_t needleSize, size_t& pos) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needleSize - 1]);
+    for (; pos + needleSize - 1 + 16 <= size; pos += 16) {
+        const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + needleSize - 1));
+        unsigned mask = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last))));
+        while (mask != 0) {
+            const size_t candidate = pos + static_cast<size_t>(__builtin_ctz(mask));
+            if (std::memcmp(data + candidate + 1, needle + 1, needleSize - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return std::string_view::npos;
+}
+
+__attribute__((target("avx2")))
+inline size_t findSubstringAvx2(const char* data, size_t size, const char* needle, size_t needleSize, size_t& pos) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needleSize - 1]);
+    for (; pos + needleSize - 1 + 32 <= size; pos += 32) {
+        const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos + needleSize - 1));
+        unsigned mask = static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last))));
+        while (mask != 0) {
+            const size_t candidate = pos + static_cast<size_t>(__builtin_ctz(mask));
+            if (std::memcmp(data + candidate + 1, needle + 1, needleSize - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return std::string_view::npos;
+}
+#elif defined(GALAY_UTILS_CODEC_NEON)
+inline size_t findSubstringNeon(const char* data, size_t size, const char* needle, size_t needleSize, size_t& pos) {
+    const uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(needle[0]));
+    const uint8x16_t last = vdupq_n_u8(static_cast<uint8_t>(needle[needleSize - 1]));
+    for (; pos + needleSize - 1 + 16 <= size; pos += 16) {
+        const uint8x16_t head = vld1q_u8(reinterpret_cast<const uint8_t*>(data + pos));
+        const uint8x16_t tail = vld1q_u8(reinterpret_cast<const uint8_t*>(data + pos + needleSize - 1));
+        const uint8x16_t hit = vandq_u8(vceqq_u8(head, first), vceqq_u8(tail, last));
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+        while (mask != 0) {
+            const size_t candidate = pos + static_cast<size_t>(__builtin_ctzll(mask) >> 2);
+            if (std::memcmp(data + candidate + 1, needle + 1, needleSize - 2) == 0) {
+                return candidate;
+            }
+            mask &= ~(uint64_t{0xF} << (__builtin_ctzll(mask) & ~3));
+        }
+    }
+    return std::string_view::npos;
+}
+#endif
+
+/**
+ * @brief 在 data[pos, size) 中查找 needle，语义与 std::string_view::find 一致
+ * @details 单字节模式走 memchr；更长的模式用首 / 末字节 SIMD 过滤候选位置
+ *          （x86-64 运行时分派 AVX2 / SSE2，AArch64 使用 NEON），剩余尾部交给 std::string_view::find。
+ */
+inline size_t findSubstring(std::string_view str, std::string_view needle, size_t pos = 0) {
+    if (needle.empty()) {
+        return pos <= str.size() ? pos : std::string_view::npos;
+    }
+    if (pos >= str.size() || needle.size() > str.size() - pos) {
+        return std::string_view::npos;
+    }
+    if (needle.size() == 1) {
+        const void* hit = std::memchr(str.data() + pos, needle[0], str.size() - pos);
+        return hit == nullptr ? std::string_view::npos : static_cast<size_t>(static_cast<const char*>(hit) - str.data());
+    }
+    size_t found = std::string_view::npos;
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+    if (str.size() - pos >= 64 && codecSelectBackend() == CodecBackend::Avx2) {
+        found = findSubstringAvx2(str.data(), str.size(), needle.data(), needle.size(), pos);
+    }
+    if (found == std::string_view::npos) {
+        found = findSubstringSse2(str.data(), str.size(), needle.data(), needle.size(), pos);
+    }
+#elif defined(GALAY_UTILS_CODEC_NEON)
+    found = findSubstringNeon(str.data(), str.size(), needle.data(), needle.size(), pos);
+#endif
+    return found != std::string_view::npos ? found : str.find(needle, pos);
+}
+
+/// 字符类型（char / signed char / unsigned char / wchar_t / charN_t）按字符而非数值处理
+template<typename T>
+inline constexpr bool isCharLike = std::is_same_v<std::remove_cv_t<T>, char>
+                                || std::is_same_v<std::remove_cv_t<T>, signed char>
+                                || std::is_same_v<std::remove_cv_t<T>, unsigned char>
+                                || std::is_same_v<std::remove_cv_t<T>, wchar_t>
+                                || std::is_same_v<std::remove_cv_t<T>, char8_t>
+                                || std::is_same_v<std::remove_cv_t<T>, char16_t>
+                                || std::is_same_v<std::remove_cv_t<T>, char32_t>;
+
+/// 走 from_chars / to_chars 快速路径的整数类型
+template<typename T>
+concept NumericInteger = std::is_integral_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool> && !isCharLike<T>;
+
+/// 走快速路径的全部数值类型（整数、浮点、bool）
+template<typename T>
+concept FastNumeric = NumericInteger<T> || std::is_floating_point_v<T> || std::is_same_v<std::remove_cv_t<T>, bool>;
+
+/// 以小端序读取 8 个字符
+inline uint64_t loadEightChars(const char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, 8);
+    if constexpr (std::endian::native == std::endian::big) {
+        value = std::byteswap(value);
+    }
+    return value;
+}
+
+/// 8 个字符是否全为 '0'-'9'
+inline bool isEightDigits(uint64_t chars) {
+    return (((chars & 0xF0F0F0F0F0F0F0F0ull)
+           | (((chars + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))
+           == 0x3333333333333333ull);
+}
+
+/// SWAR 一次解析 8 位十进制数字（调用方须先用 isEightDigits 校验）
+inline uint32_t parseEightDigits(uint64_t chars) {
+    chars = ((chars & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+    chars = ((chars & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+    return static_cast<uint32_t>(((chars & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32);
+}
+
+/**
+ * @brief 解析十进制整数，语义与 std::from_chars(first, last, value) 一致
+ * @details 数字位数不超过 digits10 时不可能溢出，按 8 位一组 SWAR 累加；
+ *          更长的数字串（含前导零）交给 std::from_chars 处理溢出与边界。
+ */
+template<NumericInteger T>
+inline std::from_chars_result parseInteger(const char* first, const char* last, T& value) {
+    constexpr ptrdiff_t maxDigits = std::numeric_limits<T>::digits10;
+    const char* p = first;
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        if (p != last && *p == '-') {
+            negative = true;
+            ++p;
+        }
+    }
+    const char* digits = p;
+    uint64_t accumulator = 0;
+    while (last - p >= 8) {
+        const uint64_t chunk = loadEightChars(p);
+        if (!isEightDigits(chunk)) {
+            break;
+        }
+        if (p - digits + 8 > maxDigits) {
+            return std::from_chars(first, last, value);
+        }
+        accumulator = accumulator * 100000000ull + parseEightDigits(chunk);
+        p += 8;
+    }
+    while (p != last && static_cast<unsigned char>(*p - '0') < 10) {
+        if (p - digits + 1 > maxDigits) {
+            return std::from_chars(first, last, value);
+        }
+        accumulator = accumulator * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    if (p == digits) {
+        return {first, std::errc::invalid_argument};
+    }
+    if constexpr (std::is_signed_v<T>) {
+        const auto magnitude = static_cast<int64_t>(accumulator);
+        value = static_cast<T>(negative ? -magnitude : magnitude);
+    } else {
+        value = static_cast<T>(accumulator);
+    }
+    return {p, std::errc{}};
+}
+
+/// 去除左侧 ASCII 空白（与 C locale 的 isspace 一致），不分配内存
+inline std::string_view trimLeftSpaceView(std::string_view str) {
+    size_t start = 0;
+    while (start < str.size() && asciiIs(str[start], kAsciiSpace)) {
+        ++start;
+    }
+    return str.substr(start);
+}
+
+/// 去除右侧 ASCII 空白，不分配内存
+inline std::string_view trimRightSpaceView(std::string_view str) {
+    size_t end = str.size();
+    while (end > 0 && asciiIs(str[end - 1], kAsciiSpace)) {
+        --end;
+    }
+    return str.substr(0, end);
+}
+
+/// 去除首尾 ASCII 空白，不分配内存
+inline std::string_view trimSpaceView(std::string_view str) {
+    return trimRightSpaceView(trimLeftSpaceView(str));
+}
+
+} // namespace detail
+
+/**
+ * @brief 分隔符策略概念
+ * @details find(str, pos) 返回 {分隔符起始下标或 npos, 分隔符长度}。
+ */
+template<typename D>
+concept SplitDelimiter = requires(const D& delimiter, std::string_view str, size_t pos) {
+    { delimiter.find(str, pos) } -> std::same_as<std::pair<size_t, size_t>>;
+};
+
+/**
+ * @brief 单字符分隔符，底层为 memchr
+ */
+struct SplitByChar {
+    char delimiter;
+
+    std::pair<size_t, size_t> find(std::string_view str, size_t pos) const {
+        const void* hit = std::memchr(str.data() + pos, delimiter, str.size() - pos);
+        if (hit == nullptr) {
+            return {std::string_view::npos, 1};
+        }
+        return {static_cast<size_t>(static_cast<const char*>(hit) - str.data()), 1};
+    }
+};
+
+/**
+ * @brief 多字符分隔符；分隔符为空时不切分
+ */
+struct SplitByString {
+    std::string_view delimiter;
+
+    std::pair<size_t, size_t> find(std::string_view str, size_t pos) const {
+        if (delimiter.empty()) {
+            return {std::string_view::npos, 0};
+        }
+        return {detail::findSubstring(str, delimiter, pos), delimiter.size()};
+    }
+};
+
+/**
+ * @brief 任一字符分隔符
+ * @details 字符集不超过 4 个时使用 SSE2 / NEON 每次比较 16 字节，否则使用 256 位位图逐字节查表。
+ *          字符集为空时不切分。
+ */
+class SplitByAnyOf {
+public:
+    explicit SplitByAnyOf(std::string_view chars)
+        : m_chars(chars) {
+        for (char ch : chars) {
+            const auto byte = static_cast<unsigned char>(ch);
+            m_bitmap[byte >> 6] |= uint64_t{1} << (byte & 63);
+        }
+    }
+
+    std::pair<size_t, size_t> find(std::string_view str, size_t pos) const {
+        if (m_chars.empty()) {
+            return {std::string_view::npos, 1};
+        }
+        if (m_chars.size() <= 4) {
+            return {detail::findAnyOfSmall(str.data(), str.size(), pos, m_chars.data(), m_chars.size()), 1};
+        }
+        for (; pos < str.size(); ++pos) {
+            const auto byte = static_cast<unsigned char>(str[pos]);
+            if (m_bitmap[byte >> 6] & (uint64_t{1} << (byte & 63))) {
+                return {pos, 1};
+            }
+        }
+        return {std::string_view::npos, 1};
+    }
+
+private:
+    std::string_view m_chars;
+    std::array<uint64_t, 4> m_bitmap{};
+};
+
+/**
+ * @brief 单字符分隔符，引号内的分隔符不切分
+ * @details 引号字符保留在字段中，不校验引号是否成对；未闭合的引号一直延续到字符串末尾。
+ */
+struct SplitByQuotedChar {
+    char delimiter;
+    char quote = '"';
+
+    std::pair<size_t, size_t> find(std::string_view str, size_t pos) const {
+        const char set[2] = {delimiter, quote};
+        bool inQuotes = false;
+        while (true) {
+            pos = detail::findAnyOfSmall(str.data(), str.size(), pos, set, 2);
+            if (pos == std::string_view::npos) {
+                return {pos, 1};
+            }
+            if (str[pos] == quote) {
+                inQuotes = !inQuotes;
+            } else if (!inQuotes) {
+                return {pos, 1};
+            }
+            ++pos;
+        }
+    }
+};
+
+/**
+ * @brief 惰性切分视图，逐个产出 std::string_view 字段，不分配内存
+ * @details 字段规则与 StringUtils::split 一致：空输入不产出字段；否则 N 个分隔符产出 N + 1 个字段，
+ *          首尾与连续分隔符产生空字段。字段引用原字符串，调用方需保证其生命周期长于视图和字段。
+ */
+template<SplitDelimiter Delimiter>
+class SplitView {
+public:
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        std::string_view operator*() const {
+            return m_view->m_str.substr(m_start, m_end - m_start);
+        }
+
+        iterator& operator++() {
+            if (m_next == std::string_view::npos) {
+                m_start = std::string_view::npos;
+            } else {
+                locate(m_next);
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs) {
+            return lhs.m_start == rhs.m_start;
+        }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) {
+            return it.m_start == std::string_view::npos;
+        }
+
+    private:
+        friend class SplitView;
+
+        explicit iterator(const SplitView* view)
+            : m_view(view) {
+            if (!view->m_str.empty()) {
+                locate(0);
+            }
+        }
+
+        void locate(size_t start) {
+            m_start = start;
+            const auto [position, length] = m_view->m_delimiter.find(m_view->m_str, start);
+            if (position == std::string_view::npos) {
+                m_end = m_view->m_str.size();
+                m_next = std::string_view::npos;
+            } else {
+                m_end = position;
+                m_next = position + length;
+            }
+        }
+
+        const SplitView* m_view = nullptr;
+        size_t m_start = std::string_view::npos;
+        size_t m_end = 0;
+        size_t m_next = std::string_view::npos;
+    };
+
+    SplitView(std::string_view str, Delimiter delimiter)
+        : m_str(str), m_delimiter(std::move(delimiter)) {}
+
+    iterator begin() const {
+        return iterator(this);
+    }
+
+    std::default_sentinel_t end() const {
+        return {};
+    }
+
+    bool empty() const {
+        return m_str.empty();
+    }
+
+private:
+    std::string_view m_str;
+    Delimiter m_delimiter;
+};
+
 /**
  * @brief 字符串工具类
  * @details 提供静态方法进行常见字符串操作。
@@ -35,78 +504,91 @@ public:
      * @brief Split string by character delimiter
      */
     static std::vector<std::string> split(std::string_view str, char delimiter) {
-        std::vector<std::string> result;
-        if (str.empty()) return result;
-
-        size_t start = 0;
-        size_t end = str.find(delimiter);
-
-        while (end != std::string_view::npos) {
-            result.emplace_back(str.substr(start, end - start));
-            start = end + 1;
-            end = str.find(delimiter, start);
-        }
-
-        // 总是添加最后的子串
-        result.emplace_back(str.substr(start));
-
-        return result;
+        return collect(SplitView<SplitByChar>(str, SplitByChar{delimiter}));
     }
 
     /**
      * @brief Split string by string delimiter
      */
     static std::vector<std::string> split(std::string_view str, std::string_view delimiter) {
-        std::vector<std::string> result;
-        if (str.empty()) return result;
-
-        if (delimiter.empty()) {
-            result.emplace_back(str);
-            return result;
-        }
+        return collect(SplitView<SplitByString>(str, SplitByString{delimiter}));
+    }
 
-        size_t start = 0;
-        size_t end = str.find(delimiter);
+    /**
+     * @brief Split string by character, respecting quoted sections
+     */
+    static std::vector<std::string> splitRespectQuotes(std::string_view str, char delimiter, char quote = '"') {
+        return collect(SplitView<SplitByQuotedChar>(str, SplitByQuotedChar{delimiter, quote}));
+    }
 
-        while (end != std::string_view::npos) {
-            result.emplace_back(str.substr(start, end - start));
-            start = end + delimiter.length();
-            end = str.find(delimiter, start);
-        }
+    /**
+     * @brief 按单字符惰性切分，字段为原字符串的 string_view
+     */
+    static SplitView<SplitByChar> splitView(std::string_view str, char delimiter) {
+        return {str, SplitByChar{delimiter}};
+    }
 
-        // 总是添加最后的子串
-        result.emplace_back(str.substr(start));
+    /**
+     * @brief 按多字符分隔符惰性切分；分隔符为空时产出整个字符串
+     */
+    static SplitView<SplitByString> splitView(std::string_view str, std::string_view delimiter) {
+        return {str, SplitByString{delimiter}};
+    }
 
-        return result;
+    /**
+     * @brief 按字符集中任一字符惰性切分
+     */
+    static SplitView<SplitByAnyOf> splitViewAnyOf(std::string_view str, std::string_view delimiters) {
+        return {str, SplitByAnyOf(delimiters)};
     }
 
     /**
-     * @brief Split string by character, respecting quoted sections
+     * @brief 按单字符惰性切分，引号内的分隔符不切分，字段保留引号
      */
-    static std::vector<std::string> splitRespectQuotes(std::string_view str, char delimiter, char quote = '"') {
-        std::vector<std::string> result;
-        std::string current;
-        bool inQuotes = false;
+    static SplitView<SplitByQuotedChar> splitViewRespectQuotes(std::string_view str, char delimiter,
+                                                                char quote = '"') {
+        return {str, SplitByQuotedChar{delimiter, quote}};
+    }
 
-        for (size_t i = 0; i < str.length(); ++i) {
-            char ch = str[i];
+    /**
+     * @brief 切分到调用方提供的定长数组
+     * @param str 输入字符串
+     * @param delimiter 分隔符策略（SplitByChar / SplitByString / SplitByAnyOf / SplitByQuotedChar）
+     * @param output 输出字段数组
+     * @return 写入的字段数
+     * @details 字段数超过 output.size() 时，最后一个槽位保存未切分的剩余部分（类似 maxsplit），
+     *          因此始终不丢数据；output 为空时返回 0。
+     */
+    template<SplitDelimiter Delimiter>
+    static size_t splitInto(std::string_view str, const Delimiter& delimiter, std::span<std::string_view> output) {
+        if (str.empty() || output.empty()) return 0;
 
-            if (ch == quote) {
-                inQuotes = !inQuotes;
-                current += ch;
-            } else if (ch == delimiter && !inQuotes) {
-                result.push_back(std::move(current));
-                current.clear();
-            } else {
-                current += ch;
+        size_t count = 0;
+        size_t start = 0;
+        while (count + 1 < output.size()) {
+            const auto [position, length] = delimiter.find(str, start);
+            if (position == std::string_view::npos) {
+                break;
             }
+            output[count++] = str.substr(start, position - start);
+            start = position + length;
         }
+        output[count++] = str.substr(start);
+        return count;
+    }
 
-        if (!current.empty() || (!str.empty() && str.back() == delimiter)) {
-            result.push_back(std::move(current));
-        }
+    /**
+     * @brief 按单字符切分到调用方提供的定长数组
+     */
+    static size_t splitInto(std::string_view str, char delimiter, std::span<std::string_view> output) {
+        return splitInto(str, SplitByChar{delimiter}, output);
+    }
 
-        return result;
+    /**
+     * @brief 按多字符分隔符切分到调用方提供的定长数组
+     */
+    static size_t splitInto(std::string_view str, std::string_view delimiter, std::span<std::string_view> output) {
+        return splitInto(str, SplitByString{delimiter}, output);
     }
 
     /**
@@ -127,61 +609,109 @@ public:
      * @brief Trim whitespace from both ends
      */
     static std::string trim(std::string_view str) {
-        size_t start = 0;
-        size_t end = str.length();
-
-        while (start < end && std::isspace(static_cast<unsigned char>(str[start]))) {
-            ++start;
-        }
-        while (end > start && std::isspace(static_cast<unsigned char>(str[end - 1]))) {
-            --end;
-        }
-
-        return std::string(str.substr(start, end - start));
+        return std::string(detail::trimSpaceView(str));
     }
 
     /**
      * @brief Trim whitespace from left
      */
     static std::string trimLeft(std::string_view str) {
-        size_t start = 0;
-        while (start < str.length() && std::isspace(static_cast<unsigned char>(str[start]))) {
-            ++start;
-        }
-        return std::string(str.substr(start));
+        return std::string(detail::trimLeftSpaceView(str));
     }
 
     /**
      * @brief Trim whitespace from right
      */
     static std::string trimRight(std::string_view str) {
-        size_t end = str.length();
-        while (end > 0 && std::isspace(static_cast<unsigned char>(str[end - 1]))) {
-            --end;
-        }
-        return std::string(str.substr(0, end));
+        return std::string(detail::trimRightSpaceView(str));
+    }
+
+    /**
+     * @brief 去除首尾 ASCII 空白，返回原字符串的视图，不分配内存
+     */
+    static std::string_view trimView(std::string_view str) {
+        return detail::trimSpaceView(str);
+    }
+
+    /**
+     * @brief 去除左侧 ASCII 空白，返回视图
+     */
+    static std::string_view trimLeftView(std::string_view str) {
+        return detail::trimLeftSpaceView(str);
+    }
+
+    /**
+     * @brief 去除右侧 ASCII 空白，返回视图
+     */
+    static std::string_view trimRightView(std::string_view str) {
+        return detail::trimRightSpaceView(str);
     }
 
     /**
      * @brief Convert string to lowercase
+     * @details 只转换 ASCII 字母，与 locale 无关，非 ASCII 字节原样保留
      */
     static std::string toLower(std::string_view str) {
         std::string result(str);
-        std::transform(result.begin(), result.end(), result.begin(),
-                       [](unsigned char c) { return std::tolower(c); });
+        toLowerInPlace(result);
         return result;
     }
 
     /**
      * @brief Convert string to uppercase
+     * @details 只转换 ASCII 字母，与 locale 无关，非 ASCII 字节原样保留
      */
     static std::string toUpper(std::string_view str) {
         std::string result(str);
-        std::transform(result.begin(), result.end(), result.begin(),
-                       [](unsigned char c) { return std::toupper(c); });
+        toUpperInPlace(result);
         return result;
     }
 
+    /**
+     * @brief 原地转换为 ASCII 小写（SIMD），不分配内存
+     */
+    static void toLowerInPlace(std::span<char> str) {
+        detail::asciiConvertCase(str.data(), str.size(), str.data(), false);
+    }
+
+    /**
+     * @brief 原地转换为 ASCII 大写（SIMD），不分配内存
+     */
+    static void toUpperInPlace(std::span<char> str) {
+        detail::asciiConvertCase(str.data(), str.size(), str.data(), true);
+    }
+
+    /**
+     * @brief 将 str 的 ASCII 小写形式写入 out
+     * @return 写入字节数；out 容量不足时返回 0 且不写入
+     */
+    static size_t toLowerInto(std::string_view str, std::span<char> out) {
+        if (out.size() < str.size()) {
+            return 0;
+        }
+        detail::asciiConvertCase(str.data(), str.size(), out.data(), false);
+        return str.size();
+    }
+
+    /**
+     * @brief 将 str 的 ASCII 大写形式写入 out
+     * @return 写入字节数；out 容量不足时返回 0 且不写入
+     */
+    static size_t toUpperInto(std::string_view str, std::span<char> out) {
+        if (out.size() < str.size()) {
+            return 0;
+        }
+        detail::asciiConvertCase(str.data(), str.size(), out.data(), true);
+        return str.size();
+    }
+
+    /**
+     * @brief ASCII 大小写不敏感的相等比较
+     */
+    static bool equalsIgnoreCase(std::string_view lhs, std::string_view rhs) {
+        return AsciiCaseInsensitiveEqual{}(lhs, rhs);
+    }
+
     /**
      * @brief Check if string starts with prefix
      */
@@ -202,29 +732,40 @@ public:
      * @brief Check if string contains substring
      */
     static bool contains(std::string_view str, std::string_view substr) {
-        return str.find(substr) != std::string_view::npos;
+        return detail::findSubstring(str, substr) != std::string_view::npos;
+    }
+
+    /**
+     * @brief 查找子串，语义与 std::string_view::find 一致
+     * @details 首 / 末字节 SIMD 过滤候选位置，单字节模式走 memchr
+     */
+    static size_t find(std::string_view str, std::string_view substr, size_t pos = 0) {
+        return detail::findSubstring(str, substr, pos);
     }
 
     /**
      * @brief Replace all occurrences of a substring
+     * @details 先统计匹配数得出输出长度，只分配一次；多组替换请使用 MultiReplacer
      */
     static std::string replace(std::string_view str, std::string_view from, std::string_view to) {
         if (from.empty()) return std::string(str);
 
-        std::string result;
-        result.reserve(str.length());
+        const size_t matches = count(str, from);
+        if (matches == 0) {
+            return std::string(str);
+        }
 
+        std::string result(str.size() - matches * from.size() + matches * to.size(), '\0');
+        char* out = result.data();
         size_t start = 0;
-        size_t pos = str.find(from);
-
+        size_t pos = detail::findSubstring(str, from);
         while (pos != std::string_view::npos) {
-            result.append(str.substr(start, pos - start));
-            result.append(to);
-            start = pos + from.length();
-            pos = str.find(from, start);
+            out = std::copy(str.data() + start, str.data() + pos, out);
+            out = std::copy(to.begin(), to.end(), out);
+            start = pos + from.size();
+            pos = detail::findSubstring(str, from, start);
         }
-
-        result.append(str.substr(start));
+        std::copy(str.data() + start, str.data() + str.size(), out);
         return result;
     }
 
@@ -234,7 +775,7 @@ public:
     static std::string replaceFirst(std::string_view str, std::string_view from, std::string_view to) {
         if (from.empty()) return std::string(str);
 
-        size_t pos = str.find(from);
+        size_t pos = detail::findSubstring(str, from);
         if (pos == std::string_view::npos) {
             return std::string(str);
         }
@@ -256,6 +797,7 @@ public:
 
     /**
      * @brief Count occurrences of a substring
+     * @details 不重叠计数
      */
     static size_t count(std::string_view str, std::string_view substr) {
         if (substr.empty()) return 0;
@@ -263,7 +805,7 @@ public:
         size_t count = 0;
         size_t pos = 0;
 
-        while ((pos = str.find(substr, pos)) != std::string_view::npos) {
+        while ((pos = detail::findSubstring(str, substr, pos)) != std::string_view::npos) {
             ++count;
             pos += substr.length();
         }
@@ -279,19 +821,7 @@ public:
             return {};
         }
 
-        static const char* lowerHex = "0123456789abcdef";
-        static const char* upperHex = "0123456789ABCDEF";
-        const char* hexChars = uppercase ? upperHex : lowerHex;
-
-        std::string result;
-        result.reserve(len * 2);
-
-        for (size_t i = 0; i < len; ++i) {
-            result += hexChars[(data[i] >> 4) & 0x0F];
-            result += hexChars[data[i] & 0x0F];
-        }
-
-        return result;
+        return HexCodec::encode(std::span<const uint8_t>(data, len), uppercase);
     }
 
     /**
@@ -302,25 +832,10 @@ public:
             return {};
         }
 
-        std::vector<uint8_t> result;
-        result.reserve(hex.length() / 2);
-
-        auto hexCharToValue = [](char c) -> int {
-            if (c >= '0' && c <= '9') return c - '0';
-            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
-            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
-            return -1;
-        };
-
-        for (size_t i = 0; i + 1 < hex.length(); i += 2) {
-            int high = hexCharToValue(hex[i]);
-            int low = hexCharToValue(hex[i + 1]);
-            if (high < 0 || low < 0) {
-                return {};
-            }
-            result.push_back(static_cast<uint8_t>((high << 4) | low));
+        std::vector<uint8_t> result(HexCodec::decodedLength(hex.length()));
+        if (!HexCodec::decodeInto(hex, result)) {
+            return {};
         }
-
         return result;
     }
 
@@ -350,21 +865,39 @@ public:
      * @brief Check if string is a valid integer
      */
     static bool isInteger(std::string_view str) {
-        if (str.empty()) return false;
-
-        size_t start = 0;
-        if (str[0] == '+' || str[0] == '-') {
-            start = 1;
-            if (str.length() == 1) return false;
+        if (!str.empty() && (str[0] == '+' || str[0] == '-')) {
+            str.remove_prefix(1);
         }
+        return isDigits(str);
+    }
 
-        for (size_t i = start; i < str.length(); ++i) {
-            if (!std::isdigit(static_cast<unsigned char>(str[i]))) {
-                return false;
-            }
-        }
+    /**
+     * @brief 判断是否非空且全部为十进制数字（SIMD）
+     */
+    static bool isDigits(std::string_view str) {
+        return !str.empty() && detail::asciiAllOf(str.data(), str.size(), kAsciiDigit);
+    }
 
-        return true;
+    /**
+     * @brief 判断是否非空且全部为十六进制数字（SIMD）
+     */
+    static bool isHexDigits(std::string_view str) {
+        return !str.empty() && detail::asciiAllOf(str.data(), str.size(), kAsciiHex);
+    }
+
+    /**
+     * @brief 判断是否全部为 ASCII 字节（SIMD），空串返回 true
+     */
+    static bool isAscii(std::string_view str) {
+        return detail::asciiPrefixLength(str.data(), str.size()) == str.size();
+    }
+
+    /**
+     * @brief 校验 UTF-8 编码是否合法
+     * @details 拒绝超长编码、代理区码点、大于 U+10FFFF 的码点与截断序列；ASCII 段按 16 字节跳过。
+     */
+    static bool isValidUtf8(std::string_view str) {
+        return detail::utf8FirstInvalid(str.data(), str.size()) == std::string_view::npos;
     }
 
     /**
@@ -410,12 +943,7 @@ public:
      * @brief Check if string is empty or contains only whitespace
      */
     static bool isBlank(std::string_view str) {
-        for (char c : str) {
-            if (!std::isspace(static_cast<unsigned char>(c))) {
-                return false;
-            }
-        }
-        return true;
+        return detail::asciiAllOf(str.data(), str.size(), kAsciiSpace);
     }
 
     /**
@@ -430,6 +958,7 @@ public:
 
     /**
      * @brief Format string with printf-style arguments
+     * @details 先格式化到 256 字节栈缓冲区，只有输出更长时才再调用一次 snprintf。
      */
     template<typename... Args>
     static std::string format(const char* fmt, Args&&... args) {
@@ -437,55 +966,397 @@ public:
             return {};
         }
 
-        int size = std::snprintf(nullptr, 0, fmt, std::forward<Args>(args)...);
+        char stackBuffer[256];
+        const int size = std::snprintf(stackBuffer, sizeof(stackBuffer), fmt, args...);
         if (size <= 0) return "";
-        std::string result(size + 1, '\0');
-        std::snprintf(result.data(), result.size(), fmt, std::forward<Args>(args)...);
-        result.resize(size);
+        if (static_cast<size_t>(size) < sizeof(stackBuffer)) {
+            return std::string(stackBuffer, static_cast<size_t>(size));
+        }
+        std::string result(static_cast<size_t>(size) + 1, '\0');
+        std::snprintf(result.data(), result.size(), fmt, args...);
+        result.resize(static_cast<size_t>(size));
         return result;
     }
 
     /**
-     * @brief Parse string to type T
+     * @brief printf 风格格式化到调用方缓冲区
+     * @param output 输出缓冲区；非空时总是以 '\0' 结尾
+     * @param fmt printf 格式字符串
+     * @return 完整输出所需的字符数（不含 '\0'）；大于等于 output.size() 表示已截断；fmt 为空或编码错误返回 0
      */
-    template<typename T>
-    static T parse(std::string_view str, T defaultValue = T{}) {
-        const std::string text = trim(str);
-        if (text.empty()) {
-            return defaultValue;
+    template<typename... Args>
+    static size_t formatInto(std::span<char> output, const char* fmt, Args&&... args) {
+        if (fmt == nullptr) {
+            if (!output.empty()) output[0] = '\0';
+            return 0;
+        }
+        int size;
+        if constexpr (sizeof...(Args) == 0) {
+            size = std::snprintf(output.data(), output.size(), "%s", fmt);
+        } else {
+            size = std::snprintf(output.data(), output.size(), fmt, args...);
         }
+        return size < 0 ? 0 : static_cast<size_t>(size);
+    }
 
-        if constexpr (std::is_floating_point_v<T>) {
-            char* end = nullptr;
-            errno = 0;
-            const long double value = std::strtold(text.c_str(), &end);
-            if (end == text.c_str() || *end != '\0' || errno == ERANGE) {
-                return defaultValue;
+#if defined(__cpp_lib_format)
+    /**
+     * @brief std::format 风格格式化到调用方缓冲区
+     * @param output 输出缓冲区；不追加 '\0'
+     * @return 完整输出所需的字符数；大于 output.size() 表示已截断
+     */
+    template<typename... Args>
+    static size_t formatTo(std::span<char> output, std::format_string<Args...> fmt, Args&&... args) {
+        const auto result = std::format_to_n(output.data(), static_cast<ptrdiff_t>(output.size()), fmt,
+                                             std::forward<Args>(args)...);
+        return static_cast<size_t>(result.size);
+    }
+#endif
+
+    /**
+     * @brief 解析数值，失败返回 std::nullopt
+     * @tparam T 整数、浮点或 bool
+     * @details 去除首尾空白后要求完整匹配，不分配内存。整数走 SWAR 8 位一组的十进制快速路径，
+     *          浮点使用 std::from_chars（支持 inf / nan，不支持十六进制浮点）。
+     *          允许一个前导 '+'；bool 接受 "1" / "0" / "true" / "false"。
+     */
+    template<detail::FastNumeric T>
+    static std::optional<T> tryParse(std::string_view str) {
+        str = detail::trimSpaceView(str);
+        if (str.empty()) {
+            return std::nullopt;
+        }
+
+        if constexpr (std::is_same_v<std::remove_cv_t<T>, bool>) {
+            if (str == "1" || str == "true") return true;
+            if (str == "0" || str == "false") return false;
+            return std::nullopt;
+        } else {
+            const char* first = str.data();
+            const char* last = first + str.size();
+            if (*first == '+') {
+                ++first;
+                if (first == last || *first == '-' || *first == '+') {
+                    return std::nullopt;
+                }
+            }
+            T value{};
+            std::from_chars_result result;
+            if constexpr (detail::NumericInteger<T>) {
+                result = detail::parseInteger(first, last, value);
+            } else {
+                result = std::from_chars(first, last, value);
+            }
+            if (result.ec != std::errc{} || result.ptr != last) {
+                return std::nullopt;
             }
-            return static_cast<T>(value);
+            return value;
         }
+    }
 
-        std::istringstream iss{text};
-        T value;
-        if (iss >> value) {
-            iss >> std::ws;
-            if (!iss.eof()) {
+    /**
+     * @brief Parse string to type T
+     * @details 数值类型走 tryParse() 快速路径；其他类型使用 std::istringstream。
+     */
+    template<typename T>
+    static T parse(std::string_view str, T defaultValue = T{}) {
+        if constexpr (detail::FastNumeric<T>) {
+            return tryParse<T>(str).value_or(defaultValue);
+        } else {
+            const std::string text = trim(str);
+            if (text.empty()) {
                 return defaultValue;
             }
-            return value;
+
+            std::istringstream iss{text};
+            T value;
+            if (iss >> value) {
+                iss >> std::ws;
+                if (!iss.eof()) {
+                    return defaultValue;
+                }
+                return value;
+            }
+            return defaultValue;
+        }
+    }
+
+    /**
+     * @brief 数值写入调用方缓冲区，不追加 '\0'
+     * @return 写入的字符数；缓冲区不足时返回 0
+     * @details 浮点输出可往返的最短表示；bool 输出 "1" / "0"，与 toString() 一致。
+     */
+    template<detail::FastNumeric T>
+    static size_t toChars(std::span<char> output, T value) {
+        if constexpr (std::is_same_v<std::remove_cv_t<T>, bool>) {
+            if (output.empty()) return 0;
+            output[0] = value ? '1' : '0';
+            return 1;
+        } else {
+            const auto result = std::to_chars(output.data(), output.data() + output.size(), value);
+            return result.ec == std::errc{} ? static_cast<size_t>(result.ptr - output.data()) : 0;
         }
-        return defaultValue;
     }
 
     /**
      * @brief Convert value to string
+     * @details 数值类型使用 std::to_chars，输出与 std::ostream 默认格式一致（浮点为 6 位有效数字的 %g）；
+     *          其他类型使用 std::ostringstream。
      */
     template<typename T>
     static std::string toString(const T& value) {
-        std::ostringstream oss;
-        oss << value;
-        return oss.str();
+        if constexpr (std::is_same_v<std::remove_cv_t<T>, bool>) {
+            return value ? "1" : "0";
+        } else if constexpr (detail::NumericInteger<T>) {
+            char buffer[24];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            return std::string(buffer, result.ptr);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            char buffer[64];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, 6);
+            return std::string(buffer, result.ptr);
+        } else {
+            std::ostringstream oss;
+            oss << value;
+            return oss.str();
+        }
+    }
+
+private:
+    template<typename View>
+    static std::vector<std::string> collect(const View& view) {
+        std::vector<std::string> result;
+        for (std::string_view field : view) {
+            result.emplace_back(field);
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief 预编译的多模式单趟替换器
+ * @details 构造时按模式首字节建立过滤表，并为每个首字节记录模式长度（从长到短）。
+ *          替换只扫描一次输入：候选位置按首字节跳转（不超过 4 种首字节时 SSE2 / NEON 扫描），
+ *          再按长度从长到短过滤末字节并查开放寻址表，采用“最左最长”匹配，替换结果不再参与匹配。
+ *          apply 先计算输出长度再一次性写入。构造后只读，可在多线程间共享。
+ */
+class MultiReplacer {
+public:
+    /**
+     * @brief 由 {模式, 替换} 列表构造
+     * @throws std::invalid_argument 模式为空或重复
+     */
+    MultiReplacer(std::initializer_list<std::pair<std::string_view, std::string_view>> rules) {
+        for (const auto& [from, to] : rules) {
+            add(from, to);
+        }
+        finalize();
+    }
+
+    /**
+     * @brief 由任意 pair 序列（如 std::map<std::string, std::string>）构造
+     * @throws std::invalid_argument 模式为空或重复
+     */
+    template<typename Range>
+        requires requires(const Range& range) {
+            { std::string_view(std::begin(range)->first) };
+            { std::string_view(std::begin(range)->second) };
+        }
+    explicit MultiReplacer(const Range& rules) {
+        for (const auto& [from, to] : rules) {
+            add(from, to);
+        }
+        finalize();
+    }
+
+    /**
+     * @brief 模式数量
+     */
+    size_t patternCount() const {
+        return m_replacements.size();
     }
+
+    /**
+     * @brief 计算替换后的输出长度，不分配内存
+     */
+    size_t outputSize(std::string_view str) const {
+        size_t size = 0;
+        forEachSegment(str, [&](std::string_view segment) { size += segment.size(); });
+        return size;
+    }
+
+    /**
+     * @brief 执行全部替换，输出只分配一次
+     */
+    std::string apply(std::string_view str) const {
+        std::string result;
+        applyTo(str, result);
+        return result;
+    }
+
+    /**
+     * @brief 执行全部替换并覆盖 out，复用 out 已有容量
+     */
+    void applyTo(std::string_view str, std::string& out) const {
+        out.resize(outputSize(str));
+        write(str, out.data());
+    }
+
+    /**
+     * @brief 执行全部替换并写入调用方缓冲区
+     * @return 完整输出长度；大于 out.size() 时不写入任何内容
+     */
+    size_t applyInto(std::string_view str, std::span<char> out) const {
+        const size_t size = outputSize(str);
+        if (size <= out.size()) {
+            write(str, out.data());
+        }
+        return size;
+    }
+
+private:
+    void add(std::string_view from, std::string_view to) {
+        if (from.empty()) {
+            throw std::invalid_argument("MultiReplacer pattern must not be empty");
+        }
+        m_patterns.emplace_back(from);
+        m_replacements.emplace_back(to);
+
+        const auto first = static_cast<unsigned char>(from[0]);
+        if (m_bucketOf[first] == 0) {
+            m_lengths.emplace_back();
+            m_bucketOf[first] = static_cast<uint16_t>(m_lengths.size());
+            m_firstBytes.push_back(from[0]);
+        }
+        auto& lengths = m_lengths[m_bucketOf[first] - 1];
+        auto it = std::find_if(lengths.begin(), lengths.end(),
+                               [&](const LengthFilter& filter) { return filter.length == from.size(); });
+        if (it == lengths.end()) {
+            it = lengths.insert(lengths.end(), LengthFilter{from.size(), {}});
+        }
+        const auto last = static_cast<unsigned char>(from.back());
+        it->lastBytes[last >> 6] |= uint64_t{1} << (last & 63);
+    }
+
+    void finalize() {
+        for (auto& lengths : m_lengths) {
+            std::sort(lengths.begin(), lengths.end(),
+                      [](const LengthFilter& a, const LengthFilter& b) { return a.length > b.length; });
+        }
+
+        // 装载因子不超过 1/2 的线性探测表，槽位保存模式下标 + 1
+        m_slots.assign(std::bit_ceil(std::max<size_t>(16, m_patterns.size() * 2)), 0);
+        m_slotMask = m_slots.size() - 1;
+        for (size_t i = 0; i < m_patterns.size(); ++i) {
+            size_t slot = hashKey(m_patterns[i]) & m_slotMask;
+            while (m_slots[slot] != 0) {
+                if (m_patterns[m_slots[slot] - 1] == m_patterns[i]) {
+                    throw std::invalid_argument("MultiReplacer pattern is duplicated: " + m_patterns[i]);
+                }
+                slot = (slot + 1) & m_slotMask;
+            }
+            m_slots[slot] = static_cast<uint32_t>(i + 1);
+        }
+    }
+
+    /// 取首尾各 8 字节与长度混合，模式多为模板占位符，区分度足够
+    static size_t hashKey(std::string_view key) {
+        uint64_t head = 0;
+        uint64_t tail = 0;
+        if (key.size() >= 8) {
+            std::memcpy(&head, key.data(), 8);
+            std::memcpy(&tail, key.data() + key.size() - 8, 8);
+        } else {
+            std::memcpy(&head, key.data(), key.size());
+        }
+        uint64_t hash = (head ^ 0x9E3779B97F4A7C15ull) * 0xBF58476D1CE4E5B9ull
+                      ^ (tail + key.size()) * 0x94D049BB133111EBull;
+        // 占位符往往只在中间几个字节不同，把高位扩散到低位槽位索引
+        hash ^= hash >> 31;
+        hash *= 0xD6E8FEB86659FD93ull;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+
+    /// 查找与 key 完全相等的模式，返回下标，未找到返回 npos
+    size_t lookup(std::string_view key) const {
+        for (size_t slot = hashKey(key) & m_slotMask; m_slots[slot] != 0; slot = (slot + 1) & m_slotMask) {
+            const std::string& pattern = m_patterns[m_slots[slot] - 1];
+            if (pattern.size() == key.size() && std::memcmp(pattern.data(), key.data(), key.size()) == 0) {
+                return m_slots[slot] - 1;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    size_t nextCandidate(std::string_view str, size_t pos) const {
+        if (m_firstBytes.size() <= 4) {
+            return detail::findAnyOfSmall(str.data(), str.size(), pos, m_firstBytes.data(), m_firstBytes.size());
+        }
+        while (pos < str.size() && m_bucketOf[static_cast<unsigned char>(str[pos])] == 0) {
+            ++pos;
+        }
+        return pos < str.size() ? pos : std::string_view::npos;
+    }
+
+    /// 依次产出原文片段与替换片段
+    template<typename Emit>
+    void forEachSegment(std::string_view str, Emit&& emit) const {
+        size_t start = 0;
+        if (!m_firstBytes.empty()) {
+            size_t pos = nextCandidate(str, 0);
+            while (pos != std::string_view::npos) {
+                size_t matched = 0;
+                for (const LengthFilter& filter : m_lengths[m_bucketOf[static_cast<unsigned char>(str[pos])] - 1]) {
+                    const size_t length = filter.length;
+                    if (length > str.size() - pos) {
+                        continue;
+                    }
+                    const auto last = static_cast<unsigned char>(str[pos + length - 1]);
+                    if ((filter.lastBytes[last >> 6] & (uint64_t{1} << (last & 63))) == 0) {
+                        continue;
+                    }
+                    const size_t index = lookup(str.substr(pos, length));
+                    if (index != std::string_view::npos) {
+                        emit(str.substr(start, pos - start));
+                        emit(std::string_view(m_replacements[index]));
+                        matched = length;
+                        break;
+                    }
+                }
+                if (matched != 0) {
+                    start = pos + matched;
+                    pos = start;
+                } else {
+                    ++pos;
+                }
+                pos = nextCandidate(str, pos);
+            }
+        }
+        emit(str.substr(start));
+    }
+
+    void write(std::string_view str, char* out) const {
+        forEachSegment(str, [&](std::string_view segment) {
+            if (!segment.empty()) {
+                std::memcpy(out, segment.data(), segment.size());
+                out += segment.size();
+            }
+        });
+    }
+
+    /// 同一首字节下某个模式长度，以及该长度模式末字节集合（查哈希表前的过滤）
+    struct LengthFilter {
+        size_t length;
+        std::array<uint64_t, 4> lastBytes;
+    };
+
+    std::vector<std::string> m_patterns;
+    std::vector<std::string> m_replacements;
+    std::vector<uint32_t> m_slots;
+    size_t m_slotMask = 0;
+    std::array<uint16_t, 256> m_bucketOf{};          ///< 首字节 -> m_lengths 下标 + 1，0 表示无模式
+    std::vector<std::vector<LengthFilter>> m_lengths; ///< 每个首字节对应的模式长度，从长到短
+    std::string m_firstBytes;
 };
 
 } // namespace galay::utils
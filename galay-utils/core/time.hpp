@@ -4,22 +4,473 @@
  * @author galay-utils
  * @version 1.0.0
  *
- * @details 提供秒表、截止时间和退避策略等纯工具类型。不创建线程，
- *          不挂接调度器，不提供阻塞等待语义。
+ * @details 提供秒表、截止时间和退避策略等纯工具类型，以及按秒缓存的 RFC 1123 / ISO-8601 /
+ *          RFC 3339 时间戳格式化与解析。不创建线程，不挂接调度器，不提供阻塞等待语义。
  */
 
 #ifndef GALAY_UTILS_TIME_HPP
 #define GALAY_UTILS_TIME_HPP
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <climits>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <ctime>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 
 namespace galay::utils {
 
+namespace detail {
+
+/// 公历日期，年份不限范围
+struct CivilDate {
+    int64_t year;
+    unsigned month;
+    unsigned day;
+};
+
+/// Unix epoch 天数转公历日期（Howard Hinnant civil_from_days）
+constexpr CivilDate civilFromDays(int64_t days) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const auto dayOfEra = static_cast<unsigned>(days - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned monthIndex = (5 * dayOfYear + 2) / 153;
+    const unsigned day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    const unsigned month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    return {static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0), month, day};
+}
+
+/// 公历日期转 Unix epoch 天数（Howard Hinnant days_from_civil）
+constexpr int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2 ? 1 : 0;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+constexpr unsigned daysInMonth(int64_t year, unsigned month) {
+    constexpr unsigned kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : kDays[month - 1];
+}
+
+constexpr int64_t floorDiv(int64_t value, int64_t divisor) {
+    const int64_t quotient = value / divisor;
+    return quotient - ((value % divisor != 0) && ((value < 0) != (divisor < 0)) ? 1 : 0);
+}
+
+inline constexpr char weekdayNames[] = "SunMonTueWedThuFriSat";
+inline constexpr char monthNames[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+/// 右对齐写入 width 位十进制数字，高位补 0
+inline void writeDigits(char* out, uint32_t value, unsigned width) {
+    for (unsigned i = width; i > 0; --i) {
+        out[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+/// 读取 width 位十进制数字，任一字符不是数字时返回 false
+inline bool readDigits(std::string_view text, size_t pos, unsigned width, unsigned& value) {
+    if (pos + width > text.size()) {
+        return false;
+    }
+    value = 0;
+    for (unsigned i = 0; i < width; ++i) {
+        const auto digit = static_cast<unsigned>(static_cast<unsigned char>(text[pos + i]) - '0');
+        if (digit > 9) {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief 时间戳小数部分精度
+ */
+enum class TimePrecision : uint8_t {
+    Seconds,        ///< 不输出小数部分
+    Milliseconds,   ///< 3 位小数
+    Microseconds    ///< 6 位小数
+};
+
+/**
+ * @brief 按秒缓存的时间戳格式化器
+ * @details 缓存上一次格式化的秒级文本：同一秒内只补写小数位，同一分钟内只改写秒字段，
+ *          跨分钟才重新计算日期。日期由 epoch 天数直接换算，不调用 gmtime / strftime，
+ *          也不读取时区数据库；本地时间请通过 RFC 3339 的 UTC 偏移参数表达。
+ *          实例非线程安全，通过 local() 取得线程本地实例。输出写入调用方缓冲区，年份限 0000-9999，
+ *          缓冲区不足或超出年份范围时返回 0。
+ */
+class TimeFormatter {
+public:
+    using Clock = std::chrono::system_clock;
+    using Microseconds = std::chrono::sys_time<std::chrono::microseconds>;
+
+    static constexpr size_t kRfc1123Size = 29;      ///< "Sun, 06 Nov 1994 08:49:37 GMT"
+    static constexpr size_t kIso8601MaxSize = 27;   ///< "1994-11-06T08:49:37.123456Z"
+    static constexpr size_t kRfc3339MaxSize = 32;   ///< "1994-11-06T08:49:37.123456+08:00"
+
+    /**
+     * @brief 线程本地实例
+     */
+    static TimeFormatter& local() {
+        thread_local TimeFormatter formatter;
+        return formatter;
+    }
+
+    /**
+     * @brief 以当前时间格式化 RFC 1123（HTTP Date 头）
+     */
+    size_t formatRfc1123(std::span<char> out) {
+        return formatRfc1123(out, std::chrono::floor<std::chrono::seconds>(Clock::now()));
+    }
+
+    /**
+     * @brief 格式化 RFC 1123 / IMF-fixdate，固定 29 字节
+     */
+    size_t formatRfc1123(std::span<char> out, std::chrono::sys_seconds time) {
+        if (out.size() < kRfc1123Size) {
+            return 0;
+        }
+        const int64_t second = time.time_since_epoch().count();
+        if (second != m_rfc1123.second) {
+            if (!rebuildRfc1123(second)) {
+                return 0;
+            }
+        }
+        std::memcpy(out.data(), m_rfc1123.text.data(), kRfc1123Size);
+        return kRfc1123Size;
+    }
+
+    /**
+     * @brief 以当前时间格式化 ISO-8601 UTC 时间
+     */
+    size_t formatIso8601(std::span<char> out, TimePrecision precision = TimePrecision::Milliseconds) {
+        return formatIso8601(out, Clock::now(), precision);
+    }
+
+    /**
+     * @brief 格式化 ISO-8601 扩展格式 UTC 时间，如 "1994-11-06T08:49:37.123Z"
+     */
+    size_t formatIso8601(std::span<char> out, Clock::time_point time,
+                         TimePrecision precision = TimePrecision::Milliseconds) {
+        return formatDateTime(out, time, 0, precision);
+    }
+
+    /**
+     * @brief 格式化 RFC 3339 时间
+     * @param utcOffset 输出使用的 UTC 偏移，0 时输出 "Z"，绝对值须小于 24 小时
+     */
+    size_t formatRfc3339(std::span<char> out, Clock::time_point time,
+                         std::chrono::minutes utcOffset = std::chrono::minutes{0},
+                         TimePrecision precision = TimePrecision::Milliseconds) {
+        if (utcOffset.count() <= -24 * 60 || utcOffset.count() >= 24 * 60) {
+            return 0;
+        }
+        return formatDateTime(out, time, static_cast<int32_t>(utcOffset.count()), precision);
+    }
+
+    /**
+     * @brief 解析 RFC 1123 / IMF-fixdate
+     * @details 要求形如 "Sun, 06 Nov 1994 08:49:37 GMT" 的 29 字节文本；星期名只校验拼写，不校验与日期一致
+     */
+    static std::optional<std::chrono::sys_seconds> parseRfc1123(std::string_view text) {
+        if (text.size() != kRfc1123Size || text.substr(3, 2) != ", " || text[7] != ' ' || text[11] != ' '
+            || text[16] != ' ' || text.substr(25) != " GMT"
+            || !isNameAt(detail::weekdayNames, text.substr(0, 3))) {
+            return std::nullopt;
+        }
+        if (!isNameAt(detail::monthNames, text.substr(8, 3))) {
+            return std::nullopt;
+        }
+        const size_t monthPos = std::string_view(detail::monthNames).find(text.substr(8, 3));
+        unsigned day;
+        unsigned year;
+        if (!detail::readDigits(text, 5, 2, day) || !detail::readDigits(text, 12, 4, year)) {
+            return std::nullopt;
+        }
+        std::optional<int64_t> seconds = parseClock(text, 17);
+        const auto month = static_cast<unsigned>(monthPos / 3 + 1);
+        if (!seconds || day == 0 || day > detail::daysInMonth(year, month)) {
+            return std::nullopt;
+        }
+        return std::chrono::sys_seconds(std::chrono::seconds(detail::daysFromCivil(year, month, day) * 86400 + *seconds));
+    }
+
+    /**
+     * @brief 解析 ISO-8601 扩展格式日期时间
+     * @details 接受 "YYYY-MM-DD"、"YYYY-MM-DDTHH:MM[:SS[.fff…]]"，小数点可为 '.' 或 ','；
+     *          时区为 "Z"、"±HH"、"±HHMM"、"±HH:MM"，缺省按 UTC 处理。小数超过 6 位时截断。
+     */
+    static std::optional<Microseconds> parseIso8601(std::string_view text) {
+        return parseDateTime(text, false);
+    }
+
+    /**
+     * @brief 解析 RFC 3339 日期时间
+     * @details 要求完整的 "YYYY-MM-DDTHH:MM:SS[.fff…]" 与时区（"Z" 或 "±HH:MM"），
+     *          分隔符 'T' / 't' / ' ' 与 'Z' / 'z' 均可；不支持闰秒 60。
+     */
+    static std::optional<Microseconds> parseRfc3339(std::string_view text) {
+        return parseDateTime(text, true);
+    }
+
+private:
+    struct SecondCache {
+        int64_t second = INT64_MIN;
+        int32_t offsetMinutes = 0;
+        std::array<char, 19> text{};
+        std::array<char, 6> zone{'Z'};   ///< "Z" 或 "±HH:MM"
+    };
+
+    struct Rfc1123Cache {
+        int64_t second = INT64_MIN;
+        std::array<char, kRfc1123Size> text{};
+    };
+
+    /// 写入 "YYYY-MM-DDTHH:MM:SS"，年份超出 0000-9999 时返回 false
+    static bool writeDateTime(char* out, int64_t second) {
+        const int64_t days = detail::floorDiv(second, 86400);
+        const auto secondOfDay = static_cast<uint32_t>(second - days * 86400);
+        const detail::CivilDate date = detail::civilFromDays(days);
+        if (date.year < 0 || date.year > 9999) {
+            return false;
+        }
+        detail::writeDigits(out, static_cast<uint32_t>(date.year), 4);
+        out[4] = '-';
+        detail::writeDigits(out + 5, date.month, 2);
+        out[7] = '-';
+        detail::writeDigits(out + 8, date.day, 2);
+        out[10] = 'T';
+        detail::writeDigits(out + 11, secondOfDay / 3600, 2);
+        out[13] = ':';
+        detail::writeDigits(out + 14, secondOfDay / 60 % 60, 2);
+        out[16] = ':';
+        detail::writeDigits(out + 17, secondOfDay % 60, 2);
+        return true;
+    }
+
+    bool rebuildRfc1123(int64_t second) {
+        char* text = m_rfc1123.text.data();
+        if (m_rfc1123.second != INT64_MIN
+            && detail::floorDiv(second, 60) == detail::floorDiv(m_rfc1123.second, 60)) {
+            detail::writeDigits(text + 23, static_cast<uint32_t>(second - detail::floorDiv(second, 60) * 60), 2);
+            m_rfc1123.second = second;
+            return true;
+        }
+        char dateTime[19];
+        if (!writeDateTime(dateTime, second)) {
+            return false;
+        }
+        const int64_t days = detail::floorDiv(second, 86400);
+        const auto weekday = static_cast<size_t>((days % 7 + 11) % 7);   // 1970-01-01 为星期四
+        const detail::CivilDate date = detail::civilFromDays(days);
+        std::memcpy(text, detail::weekdayNames + weekday * 3, 3);
+        text[3] = ',';
+        text[4] = ' ';
+        std::memcpy(text + 5, dateTime + 8, 2);
+        text[7] = ' ';
+        std::memcpy(text + 8, detail::monthNames + (date.month - 1) * 3, 3);
+        text[11] = ' ';
+        std::memcpy(text + 12, dateTime, 4);
+        text[16] = ' ';
+        std::memcpy(text + 17, dateTime + 11, 8);
+        std::memcpy(text + 25, " GMT", 4);
+        m_rfc1123.second = second;
+        return true;
+    }
+
+    size_t formatDateTime(std::span<char> out, Clock::time_point time, int32_t offsetMinutes, TimePrecision precision) {
+        const int64_t micros = std::chrono::floor<std::chrono::microseconds>(time).time_since_epoch().count();
+        const int64_t utcSecond = detail::floorDiv(micros, 1000000);
+        const auto fraction = static_cast<uint32_t>(micros - utcSecond * 1000000);
+        const int64_t second = utcSecond + int64_t{offsetMinutes} * 60;
+
+        const size_t fractionSize = precision == TimePrecision::Seconds ? 0
+                                  : precision == TimePrecision::Milliseconds ? 4 : 7;
+        const size_t zoneSize = offsetMinutes == 0 ? 1 : 6;
+        const size_t size = 19 + fractionSize + zoneSize;
+        if (out.size() < size) {
+            return 0;
+        }
+
+        SecondCache& cache = m_dateTime;
+        if (second != cache.second || offsetMinutes != cache.offsetMinutes) {
+            if (cache.second != INT64_MIN && offsetMinutes == cache.offsetMinutes
+                && detail::floorDiv(second, 60) == detail::floorDiv(cache.second, 60)) {
+                detail::writeDigits(cache.text.data() + 17,
+                                    static_cast<uint32_t>(second - detail::floorDiv(second, 60) * 60), 2);
+            } else if (!writeDateTime(cache.text.data(), second)) {
+                return 0;
+            }
+            if (offsetMinutes != cache.offsetMinutes) {
+                writeZone(cache.zone.data(), offsetMinutes);
+            }
+            cache.second = second;
+            cache.offsetMinutes = offsetMinutes;
+        }
+
+        char* cursor = out.data();
+        std::memcpy(cursor, cache.text.data(), 19);
+        cursor += 19;
+        if (fractionSize != 0) {
+            *cursor = '.';
+            if (precision == TimePrecision::Milliseconds) {
+                detail::writeDigits(cursor + 1, fraction / 1000, 3);
+            } else {
+                detail::writeDigits(cursor + 1, fraction, 6);
+            }
+            cursor += fractionSize;
+        }
+        if (zoneSize == 1) {
+            *cursor = 'Z';
+        } else {
+            std::memcpy(cursor, cache.zone.data(), 6);
+        }
+        return size;
+    }
+
+    static void writeZone(char* out, int32_t offsetMinutes) {
+        if (offsetMinutes == 0) {
+            out[0] = 'Z';
+            return;
+        }
+        const auto magnitude = static_cast<uint32_t>(offsetMinutes < 0 ? -offsetMinutes : offsetMinutes);
+        out[0] = offsetMinutes < 0 ? '-' : '+';
+        detail::writeDigits(out + 1, magnitude / 60, 2);
+        out[3] = ':';
+        detail::writeDigits(out + 4, magnitude % 60, 2);
+    }
+
+    /// name 是否为 names（每项 3 字节）中的一项
+    static bool isNameAt(std::string_view names, std::string_view name) {
+        const size_t pos = names.find(name);
+        return pos != std::string_view::npos && pos % 3 == 0;
+    }
+
+    /// 解析 pos 起的 "HH:MM:SS"，返回当日秒数
+    static std::optional<int64_t> parseClock(std::string_view text, size_t pos) {
+        unsigned hour;
+        unsigned minute;
+        unsigned second;
+        if (!detail::readDigits(text, pos, 2, hour) || pos + 2 >= text.size() || text[pos + 2] != ':'
+            || !detail::readDigits(text, pos + 3, 2, minute) || pos + 5 >= text.size() || text[pos + 5] != ':'
+            || !detail::readDigits(text, pos + 6, 2, second) || hour > 23 || minute > 59 || second > 59) {
+            return std::nullopt;
+        }
+        return int64_t{hour} * 3600 + minute * 60 + second;
+    }
+
+    static std::optional<Microseconds> parseDateTime(std::string_view text, bool strict) {
+        unsigned year;
+        unsigned month;
+        unsigned day;
+        if (!detail::readDigits(text, 0, 4, year) || text.size() < 10 || text[4] != '-' || text[7] != '-'
+            || !detail::readDigits(text, 5, 2, month) || !detail::readDigits(text, 8, 2, day)
+            || month == 0 || month > 12 || day == 0 || day > detail::daysInMonth(year, month)) {
+            return std::nullopt;
+        }
+        int64_t micros = detail::daysFromCivil(year, month, day) * 86400 * 1000000;
+        if (text.size() == 10) {
+            return strict ? std::nullopt : std::optional<Microseconds>(Microseconds(std::chrono::microseconds(micros)));
+        }
+
+        const char separator = text[10];
+        if (separator != 'T' && !(strict && (separator == 't' || separator == ' '))) {
+            return std::nullopt;
+        }
+        unsigned hour;
+        unsigned minute;
+        unsigned second = 0;
+        if (!detail::readDigits(text, 11, 2, hour) || text.size() < 16 || text[13] != ':'
+            || !detail::readDigits(text, 14, 2, minute) || hour > 23 || minute > 59) {
+            return std::nullopt;
+        }
+        size_t pos = 16;
+        if (pos < text.size() && text[pos] == ':') {
+            if (!detail::readDigits(text, pos + 1, 2, second) || second > 59) {
+                return std::nullopt;
+            }
+            pos += 3;
+        } else if (strict) {
+            return std::nullopt;
+        }
+        micros += (int64_t{hour} * 3600 + minute * 60 + second) * 1000000;
+
+        if (pos < text.size() && (text[pos] == '.' || (!strict && text[pos] == ','))) {
+            ++pos;
+            const size_t start = pos;
+            uint32_t fraction = 0;
+            uint32_t scale = 1000000;
+            while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+                if (scale > 1) {
+                    scale /= 10;
+                    fraction += static_cast<uint32_t>(text[pos] - '0') * scale;
+                }
+                ++pos;
+            }
+            if (pos == start) {
+                return std::nullopt;
+            }
+            micros += fraction;
+        }
+
+        if (pos == text.size()) {
+            return strict ? std::nullopt : std::optional<Microseconds>(Microseconds(std::chrono::microseconds(micros)));
+        }
+        const char zone = text[pos];
+        if (zone == 'Z' || (strict && zone == 'z')) {
+            return pos + 1 == text.size() ? std::optional<Microseconds>(Microseconds(std::chrono::microseconds(micros)))
+                                          : std::nullopt;
+        }
+        if (zone != '+' && zone != '-') {
+            return std::nullopt;
+        }
+        unsigned offsetHours;
+        unsigned offsetMinutes = 0;
+        if (!detail::readDigits(text, pos + 1, 2, offsetHours) || offsetHours > 23) {
+            return std::nullopt;
+        }
+        pos += 3;
+        if (pos < text.size()) {
+            if (text[pos] == ':') {
+                ++pos;
+            } else if (strict) {
+                return std::nullopt;
+            }
+            if (!detail::readDigits(text, pos, 2, offsetMinutes) || offsetMinutes > 59) {
+                return std::nullopt;
+            }
+            pos += 2;
+        } else if (strict) {
+            return std::nullopt;
+        }
+        if (pos != text.size()) {
+            return std::nullopt;
+        }
+        const int64_t offset = (int64_t{offsetHours} * 60 + offsetMinutes) * 60 * 1000000;
+        micros += zone == '+' ? -offset : offset;
+        return Microseconds(std::chrono::microseconds(micros));
+    }
+
+    Rfc1123Cache m_rfc1123;
+    SecondCache m_dateTime;
+};
+
 /**
  * @brief 通用时间工具
  * @details 提供系统时钟时间戳和本地/GMT 时间格式化。只做纯计算和标准库
@@ -27,6 +478,9 @@ namespace galay::utils {
  */
 class Time {
 public:
+    /// RFC 1123 / HTTP Date 的 strftime 格式
+    static constexpr const char* kRfc1123Format = "%a, %d %b %Y %H:%M:%S GMT";
+
     /**
      * @brief 获取 Unix epoch 至当前时间的毫秒数
      * @return 当前系统时间毫秒时间戳
@@ -92,8 +546,13 @@ public:
      * @brief 获取当前 GMT 时间字符串
      * @param format strftime 格式字符串
      * @return 当前 GMT 时间字符串
+     * @details 默认格式（RFC 1123）走 TimeFormatter 线程本地缓存，不调用 gmtime_r / strftime
      */
-    static std::string currentGMTTime(const char* format = "%a, %d %b %Y %H:%M:%S GMT") {
+    static std::string currentGMTTime(const char* format = kRfc1123Format) {
+        if (format != nullptr && std::strcmp(format, kRfc1123Format) == 0) {
+            char buffer[TimeFormatter::kRfc1123Size];
+            return std::string(buffer, TimeFormatter::local().formatRfc1123(buffer));
+        }
         return formatTime(std::time(nullptr), format, true);
     }
 
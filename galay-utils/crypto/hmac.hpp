@@ -5,27 +5,125 @@
  * @version 1.0.0
  *
  * @details 提供 SHA-256 哈希计算和基于 SHA-256 的 HMAC 消息认证码生成功能。
- *          纯头文件实现，不依赖外部加密库。
+ *          纯头文件实现，不依赖外部加密库。x86-64 上运行时检测 SHA-NI，
+ *          ARMv8 上在编译目标启用 SHA2 扩展时使用硬件指令，其余情况回退到标量实现。
  */
 
 #ifndef GALAY_UTILS_HMAC_H
 #define GALAY_UTILS_HMAC_H
 
+#include "galay-utils/common/defn.hpp"
+#include "galay-utils/encoding/hex.hpp"
 #include <string>
 #include <cstring>
 #include <cstdint>
+#include <algorithm>
 #include <array>
-#include <vector>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+#if defined(GALAY_ARCH_X64) && (defined(GALAY_COMPILER_GCC) || defined(GALAY_COMPILER_CLANG))
+#define GALAY_UTILS_SHA256_SHANI 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(GALAY_ARCH_ARM64) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define GALAY_UTILS_SHA256_ARM_SHA2 1
+#include <arm_neon.h>
+#endif
 
 namespace galay::utils
 {
+    /**
+     * @brief SHA-256 计算后端
+     */
+    enum class SHA256Backend
+    {
+        Scalar,     ///< 可移植标量实现
+        ShaNi,      ///< x86 SHA-NI 指令（运行时检测）
+        ArmSha2,    ///< ARMv8 SHA2 指令（编译目标启用 SHA2 扩展时可用）
+    };
+
+    /**
+     * @brief SHA-256 批量计算模式
+     */
+    enum class SHA256BatchMode
+    {
+        Auto,           ///< 单消息硬件指令可用时逐条计算，否则在支持 AVX2 时使用 multi-buffer
+        MultiBuffer,    ///< 强制 AVX2 8 路 multi-buffer（不支持时回退为逐条计算）
+        SingleBuffer,   ///< 逐条使用单消息最快后端
+    };
+
     /**
      * @brief SHA-256 哈希算法实现
-     * @details 提供 SHA-256 哈希计算，返回原始字节数组或十六进制字符串。
+     * @details 提供一次性与流式（init/update/finalize）两种接口，均不分配堆内存，仅在最后一个块补位。
+     *          压缩函数在运行时选择 SHA-NI / ARMv8 SHA2 指令路径，不支持时回退到标量实现。
      */
     class SHA256
     {
     public:
+        static constexpr size_t kDigestSize = 32;   ///< 摘要字节数
+        static constexpr size_t kBlockSize = 64;    ///< 分组字节数
+
+        /**
+         * @brief 流式哈希上下文
+         * @details 由 init() 初始化，可多次 update()，最后调用 finalize() 取摘要。
+         *          上下文为普通值类型，可拷贝以复用公共前缀的中间状态。
+         */
+        struct Context
+        {
+            uint32_t state[8];          ///< 中间哈希状态
+            uint64_t length;            ///< 已输入字节总数
+            uint8_t buffer[kBlockSize]; ///< 未满一个分组的输入缓存
+            size_t bufferLength;        ///< 缓存中的有效字节数
+            SHA256Backend backend;      ///< 压缩函数后端
+        };
+
+        /**
+         * @brief 初始化流式上下文，使用当前平台最快的后端
+         * @param ctx 上下文
+         */
+        static void init(Context& ctx);
+
+        /**
+         * @brief 初始化流式上下文并指定后端
+         * @param ctx 上下文
+         * @param backend 期望后端，当前平台不支持时回退到标量实现
+         */
+        static void init(Context& ctx, SHA256Backend backend);
+
+        /**
+         * @brief 追加输入数据
+         * @param ctx 上下文
+         * @param data 输入数据指针
+         * @param length 数据长度
+         */
+        static void update(Context& ctx, const uint8_t* data, size_t length);
+
+        /**
+         * @brief 结束哈希并输出摘要
+         * @details 调用后上下文不可继续 update()，需重新 init()。
+         * @param ctx 上下文
+         * @return 32 字节的哈希值数组
+         */
+        static std::array<uint8_t, 32> finalize(Context& ctx);
+
+        /**
+         * @brief 获取当前平台最快的可用后端
+         * @return 后端枚举
+         */
+        static SHA256Backend bestBackend();
+
+        /**
+         * @brief 判断指定后端在当前平台是否可用
+         * @param backend 后端
+         * @return 可用返回 true
+         */
+        static bool isBackendSupported(SHA256Backend backend);
+
         /**
          * @brief 计算 SHA-256 哈希值
          * @param data 输入数据指针
@@ -49,6 +147,38 @@ namespace galay::utils
          */
         static std::string hashHex(const std::string& data);
 
+        /**
+         * @brief 批量计算多条独立消息的 SHA-256
+         * @details 无 SHA 硬件指令但支持 AVX2 时以 8 路 multi-buffer 并行压缩，适合大量短消息；
+         *          SHA-NI / ARMv8 SHA2 单消息吞吐已不低于 multi-buffer，此时逐条计算。不分配堆内存。
+         * @param inputs 输入消息列表
+         * @param outputs 输出摘要列表，长度必须与 inputs 相同
+         * @throw std::invalid_argument 长度不一致
+         */
+        static void hashBatch(std::span<const std::string_view> inputs,
+                              std::span<std::array<uint8_t, 32>> outputs);
+
+        /**
+         * @brief 以相同前缀状态批量计算多条消息的 SHA-256
+         * @details 等价于对每条消息拷贝 prefix 后 update() + finalize()。prefix 已按分组对齐
+         *          （bufferLength == 0，例如 HMAC 的 ipad/opad 中间状态）时走 multi-buffer 路径。
+         * @param prefix 已吸收公共前缀的上下文
+         * @param inputs 输入消息列表
+         * @param outputs 输出摘要列表，长度必须与 inputs 相同
+         * @param mode 批量计算模式
+         * @throw std::invalid_argument 长度不一致
+         */
+        static void hashBatch(const Context& prefix,
+                              std::span<const std::string_view> inputs,
+                              std::span<std::array<uint8_t, 32>> outputs,
+                              SHA256BatchMode mode = SHA256BatchMode::Auto);
+
+        /**
+         * @brief 判断 AVX2 multi-buffer 批量路径是否可用
+         * @return 当前平台支持 AVX2 时返回 true
+         */
+        static bool isBatchAccelerated();
+
     private:
         static constexpr uint32_t K[64] = {
             0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
@@ -70,6 +200,128 @@ namespace galay::utils
         static inline uint32_t gamma1(uint32_t x) { return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10); }
 
         static void transform(uint32_t state[8], const uint8_t block[64]);
+        static void compress(SHA256Backend backend, uint32_t state[8], const uint8_t* blocks, size_t count);
+#if defined(GALAY_UTILS_SHA256_SHANI)
+        static void transformShaNi(uint32_t state[8], const uint8_t* blocks, size_t count);
+#endif
+#if defined(GALAY_UTILS_SHA256_ARM_SHA2)
+        static void transformArmSha2(uint32_t state[8], const uint8_t* blocks, size_t count);
+#endif
+#if defined(GALAY_UTILS_SHA256_SHANI)
+        static void compressX8Avx2(uint32_t state[8][8], const uint8_t* const blocks[8], uint32_t activeMask);
+        static void hashLanesAvx2(const Context& prefix, const std::string_view* inputs,
+                                  std::array<uint8_t, 32>* outputs, size_t count);
+#endif
+    };
+
+    /**
+     * @brief 预计算的 HMAC-SHA256 密钥
+     * @details 构造时吸收 K XOR ipad / K XOR opad 两个分组并缓存中间状态，
+     *          之后每条消息只需压缩消息本身与外层一个分组，不再重复处理密钥。
+     *          对象不可变，可在多线程间共享只读使用；析构时清零缓存的密钥状态。
+     */
+    class HmacKey
+    {
+    public:
+        /**
+         * @brief 由原始密钥构造
+         * @param key 密钥指针
+         * @param keyLen 密钥长度，超过 64 字节时先做 SHA-256
+         */
+        HmacKey(const uint8_t* key, size_t keyLen);
+
+        /**
+         * @brief 由字符串密钥构造
+         * @param key 密钥
+         */
+        explicit HmacKey(std::string_view key);
+
+        HmacKey(const HmacKey&) = default;
+        HmacKey& operator=(const HmacKey&) = default;
+        ~HmacKey();
+
+        /**
+         * @brief 计算单条消息的 HMAC-SHA256
+         * @param data 数据指针
+         * @param dataLen 数据长度
+         * @return 32 字节的 HMAC 值数组
+         */
+        std::array<uint8_t, 32> sign(const uint8_t* data, size_t dataLen) const;
+
+        /**
+         * @brief 计算单条消息的 HMAC-SHA256
+         * @param data 数据
+         * @return 32 字节的 HMAC 值数组
+         */
+        std::array<uint8_t, 32> sign(std::string_view data) const;
+
+        /**
+         * @brief 计算 HMAC-SHA256 并写入调用方缓冲区
+         * @param data 数据字节
+         * @param out 32 字节输出缓冲区
+         */
+        void signInto(std::span<const std::byte> data, std::span<uint8_t, 32> out) const;
+
+        /**
+         * @brief 对分段数据计算 HMAC-SHA256 并写入调用方缓冲区
+         * @details 各段按顺序拼接参与计算，适合 RingBuffer::readSpans() 得到的环绕数据，无需线性化。
+         * @param segments 数据分段
+         * @param out 32 字节输出缓冲区
+         */
+        void signInto(std::span<const std::span<const std::byte>> segments, std::span<uint8_t, 32> out) const;
+
+        /**
+         * @brief 常量时间校验单条消息的 HMAC-SHA256
+         * @param data 数据字节
+         * @param expectedTag 期望 HMAC，长度必须为 32
+         * @return 匹配返回 true
+         */
+        bool verify(std::span<const std::byte> data, std::span<const uint8_t> expectedTag) const;
+
+        /**
+         * @brief 常量时间校验分段数据的 HMAC-SHA256
+         * @param segments 数据分段
+         * @param expectedTag 期望 HMAC，长度必须为 32
+         * @return 匹配返回 true
+         */
+        bool verify(std::span<const std::span<const std::byte>> segments, std::span<const uint8_t> expectedTag) const;
+
+        /**
+         * @brief 常量时间校验单条消息的 HMAC-SHA256
+         * @param data 数据
+         * @param expectedTag 期望 HMAC，长度必须为 32
+         * @return 匹配返回 true
+         */
+        bool verify(std::string_view data, std::span<const uint8_t> expectedTag) const;
+
+        /**
+         * @brief 批量计算多条消息的 HMAC-SHA256
+         * @details 内外两层哈希均走 SHA256::hashBatch() 的 multi-buffer 路径，不分配堆内存。
+         * @param messages 消息列表
+         * @param tags 输出 HMAC 列表，长度必须与 messages 相同
+         * @throw std::invalid_argument 长度不一致
+         */
+        void signBatch(std::span<const std::string_view> messages,
+                       std::span<std::array<uint8_t, 32>> tags) const;
+
+        /**
+         * @brief 批量校验多条消息的 HMAC-SHA256
+         * @details 摘要比较为常量时间，不因首个不同字节提前返回。
+         * @param messages 消息列表
+         * @param expected 期望 HMAC 列表
+         * @param results 每条消息的校验结果
+         * @return 校验通过的消息数量
+         * @throw std::invalid_argument 三个列表长度不一致
+         */
+        size_t verifyBatch(std::span<const std::string_view> messages,
+                           std::span<const std::array<uint8_t, 32>> expected,
+                           std::span<bool> results) const;
+
+    private:
+        void finish(SHA256::Context& inner, std::span<uint8_t, 32> out) const;
+
+        SHA256::Context m_inner;
+        SHA256::Context m_outer;
     };
 
     /**
@@ -105,6 +357,73 @@ namespace galay::utils
          * @return 32 字节的 HMAC 值数组
          */
         static std::array<uint8_t, 32> hmacSha256(const std::string& key, const std::string& data);
+
+        /**
+         * @brief 计算 HMAC-SHA256 并写入调用方缓冲区（不分配内存）
+         * @param key 密钥字节
+         * @param data 数据字节
+         * @param out 32 字节输出缓冲区
+         */
+        static void hmacSha256Into(std::span<const std::byte> key, std::span<const std::byte> data,
+                                   std::span<uint8_t, 32> out);
+
+        /**
+         * @brief 对分段数据计算 HMAC-SHA256 并写入调用方缓冲区
+         * @details 适合 RingBuffer::readSpans() 得到的环绕数据，无需先拷贝成连续内存。
+         * @param key 密钥字节
+         * @param segments 数据分段，按顺序拼接
+         * @param out 32 字节输出缓冲区
+         */
+        static void hmacSha256Into(std::span<const std::byte> key,
+                                   std::span<const std::span<const std::byte>> segments,
+                                   std::span<uint8_t, 32> out);
+
+        /**
+         * @brief 计算 HMAC-SHA256 并写入调用方缓冲区（字符串视图版本）
+         * @param key 密钥
+         * @param data 数据，例如 ByteQueueView::view() 的结果
+         * @param out 32 字节输出缓冲区
+         */
+        static void hmacSha256Into(std::string_view key, std::string_view data, std::span<uint8_t, 32> out);
+
+        /**
+         * @brief 常量时间校验 HMAC-SHA256
+         * @param key 密钥字节
+         * @param data 数据字节
+         * @param expectedTag 期望 HMAC，长度必须为 32
+         * @return 匹配返回 true；长度不为 32 时返回 false
+         */
+        static bool verify(std::span<const std::byte> key, std::span<const std::byte> data,
+                           std::span<const uint8_t> expectedTag);
+
+        /**
+         * @brief 常量时间校验分段数据的 HMAC-SHA256
+         * @param key 密钥字节
+         * @param segments 数据分段，按顺序拼接
+         * @param expectedTag 期望 HMAC，长度必须为 32
+         * @return 匹配返回 true；长度不为 32 时返回 false
+         */
+        static bool verify(std::span<const std::byte> key,
+                           std::span<const std::span<const std::byte>> segments,
+                           std::span<const uint8_t> expectedTag);
+
+        /**
+         * @brief 常量时间校验 HMAC-SHA256（字符串视图版本）
+         * @param key 密钥
+         * @param data 数据
+         * @param expectedTag 期望 HMAC，长度必须为 32
+         * @return 匹配返回 true；长度不为 32 时返回 false
+         */
+        static bool verify(std::string_view key, std::string_view data, std::span<const uint8_t> expectedTag);
+
+        /**
+         * @brief 常量时间比较两段字节
+         * @details 比较耗时只取决于长度，不因首个不同字节提前返回；长度不同直接返回 false。
+         * @param lhs 左操作数
+         * @param rhs 右操作数
+         * @return 长度与内容均相同返回 true
+         */
+        static bool constantTimeEqual(std::span<const uint8_t> lhs, std::span<const uint8_t> rhs);
     };
 
     // Implementation
@@ -164,82 +483,571 @@ namespace galay::utils
         state[7] += h;
     }
 
-    inline std::array<uint8_t, 32> SHA256::hash(const uint8_t* data, size_t length)
+#if defined(GALAY_UTILS_SHA256_SHANI)
+    __attribute__((target("sha,sse4.1,ssse3")))
+    inline void SHA256::transformShaNi(uint32_t state[8], const uint8_t* blocks, size_t count)
     {
-        uint32_t state[8] = {
+        const __m128i shuffleMask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        // state 为 ABCD/EFGH，SHA-NI 需要 ABEF/CDGH 排列
+        __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+        __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+        tmp = _mm_shuffle_epi32(tmp, 0xB1);
+        state1 = _mm_shuffle_epi32(state1, 0x1B);
+        __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+        state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+        while (count--)
+        {
+            const __m128i abefSave = state0;
+            const __m128i cdghSave = state1;
+            __m128i msgs[4];
+
+            // 每轮处理 4 个消息字；前 4 组直接加载，后 12 组由 sha256msg1/msg2 扩展
+            for (int q = 0; q < 16; ++q)
+            {
+                __m128i& current = msgs[q & 3];
+                if (q < 4)
+                {
+                    current = _mm_shuffle_epi8(
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + q * 16)), shuffleMask);
+                }
+
+                __m128i msg = _mm_add_epi32(current,
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(&K[q * 4])));
+                state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+
+                if (q >= 3 && q <= 14)
+                {
+                    __m128i& next = msgs[(q + 1) & 3];
+                    next = _mm_add_epi32(next, _mm_alignr_epi8(current, msgs[(q + 3) & 3], 4));
+                    next = _mm_sha256msg2_epu32(next, current);
+                }
+
+                msg = _mm_shuffle_epi32(msg, 0x0E);
+                state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+                if (q >= 1 && q <= 12)
+                {
+                    __m128i& previous = msgs[(q + 3) & 3];
+                    previous = _mm_sha256msg1_epu32(previous, current);
+                }
+            }
+
+            state0 = _mm_add_epi32(state0, abefSave);
+            state1 = _mm_add_epi32(state1, cdghSave);
+            blocks += kBlockSize;
+        }
+
+        tmp = _mm_shuffle_epi32(state0, 0x1B);
+        state1 = _mm_shuffle_epi32(state1, 0xB1);
+        state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+        state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+    }
+#endif
+
+#if defined(GALAY_UTILS_SHA256_ARM_SHA2)
+    inline void SHA256::transformArmSha2(uint32_t state[8], const uint8_t* blocks, size_t count)
+    {
+        uint32x4_t state0 = vld1q_u32(&state[0]);
+        uint32x4_t state1 = vld1q_u32(&state[4]);
+
+        while (count--)
+        {
+            const uint32x4_t abcdSave = state0;
+            const uint32x4_t efghSave = state1;
+            uint32x4_t msgs[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                msgs[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + i * 16)));
+            }
+
+            for (int q = 0; q < 16; ++q)
+            {
+                uint32x4_t& current = msgs[q & 3];
+                const uint32x4_t wk = vaddq_u32(current, vld1q_u32(&K[q * 4]));
+                if (q < 12)
+                {
+                    current = vsha256su0q_u32(current, msgs[(q + 1) & 3]);
+                }
+
+                const uint32x4_t previous = state0;
+                state0 = vsha256hq_u32(state0, state1, wk);
+                state1 = vsha256h2q_u32(state1, previous, wk);
+
+                if (q < 12)
+                {
+                    current = vsha256su1q_u32(current, msgs[(q + 2) & 3], msgs[(q + 3) & 3]);
+                }
+            }
+
+            state0 = vaddq_u32(state0, abcdSave);
+            state1 = vaddq_u32(state1, efghSave);
+            blocks += kBlockSize;
+        }
+
+        vst1q_u32(&state[0], state0);
+        vst1q_u32(&state[4], state1);
+    }
+#endif
+
+    inline bool SHA256::isBackendSupported(SHA256Backend backend)
+    {
+        switch (backend)
+        {
+        case SHA256Backend::Scalar:
+            return true;
+        case SHA256Backend::ShaNi:
+#if defined(GALAY_UTILS_SHA256_SHANI)
+        {
+            static const bool supported = []() {
+                unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+                if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+                {
+                    return false;
+                }
+                const bool ssse3 = (ecx & (1u << 9)) != 0;
+                const bool sse41 = (ecx & (1u << 19)) != 0;
+                if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+                {
+                    return false;
+                }
+                const bool sha = (ebx & (1u << 29)) != 0;
+                return ssse3 && sse41 && sha;
+            }();
+            return supported;
+        }
+#else
+            return false;
+#endif
+        case SHA256Backend::ArmSha2:
+#if defined(GALAY_UTILS_SHA256_ARM_SHA2)
+            return true;
+#else
+            return false;
+#endif
+        }
+        return false;
+    }
+
+    inline SHA256Backend SHA256::bestBackend()
+    {
+        static const SHA256Backend best = []() {
+            if (isBackendSupported(SHA256Backend::ShaNi))
+            {
+                return SHA256Backend::ShaNi;
+            }
+            if (isBackendSupported(SHA256Backend::ArmSha2))
+            {
+                return SHA256Backend::ArmSha2;
+            }
+            return SHA256Backend::Scalar;
+        }();
+        return best;
+    }
+
+    inline void SHA256::compress(SHA256Backend backend, uint32_t state[8], const uint8_t* blocks, size_t count)
+    {
+        switch (backend)
+        {
+#if defined(GALAY_UTILS_SHA256_SHANI)
+        case SHA256Backend::ShaNi:
+            transformShaNi(state, blocks, count);
+            return;
+#endif
+#if defined(GALAY_UTILS_SHA256_ARM_SHA2)
+        case SHA256Backend::ArmSha2:
+            transformArmSha2(state, blocks, count);
+            return;
+#endif
+        default:
+            for (size_t i = 0; i < count; ++i)
+            {
+                transform(state, blocks + i * kBlockSize);
+            }
+            return;
+        }
+    }
+
+    inline void SHA256::init(Context& ctx)
+    {
+        init(ctx, bestBackend());
+    }
+
+    inline void SHA256::init(Context& ctx, SHA256Backend backend)
+    {
+        static constexpr uint32_t initialState[8] = {
             0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
             0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
         };
+        std::memcpy(ctx.state, initialState, sizeof(initialState));
+        ctx.length = 0;
+        ctx.bufferLength = 0;
+        ctx.backend = isBackendSupported(backend) ? backend : SHA256Backend::Scalar;
+    }
+
+    inline void SHA256::update(Context& ctx, const uint8_t* data, size_t length)
+    {
+        if (length == 0)
+        {
+            return;
+        }
+        ctx.length += length;
+
+        // 先补齐缓存中的残余分组
+        if (ctx.bufferLength != 0)
+        {
+            const size_t take = std::min(kBlockSize - ctx.bufferLength, length);
+            std::memcpy(ctx.buffer + ctx.bufferLength, data, take);
+            ctx.bufferLength += take;
+            data += take;
+            length -= take;
+            if (ctx.bufferLength < kBlockSize)
+            {
+                return;
+            }
+            compress(ctx.backend, ctx.state, ctx.buffer, 1);
+            ctx.bufferLength = 0;
+        }
 
-        size_t totalBits = length * 8;
-        size_t paddedLength = ((length + 8) / 64 + 1) * 64;
+        // 整块直接从调用方内存压缩，不做拷贝
+        const size_t blocks = length / kBlockSize;
+        if (blocks != 0)
+        {
+            compress(ctx.backend, ctx.state, data, blocks);
+            data += blocks * kBlockSize;
+            length -= blocks * kBlockSize;
+        }
 
-        std::vector<uint8_t> padded(paddedLength, 0);
-        std::memcpy(padded.data(), data, length);
+        if (length != 0)
+        {
+            std::memcpy(ctx.buffer, data, length);
+            ctx.bufferLength = length;
+        }
+    }
 
-        // Append '1' bit
-        padded[length] = 0x80;
+    inline std::array<uint8_t, 32> SHA256::finalize(Context& ctx)
+    {
+        const uint64_t totalBits = ctx.length * 8;
 
-        // Append length in bits as 64-bit big-endian
-        for (int i = 0; i < 8; ++i)
+        // Append '1' bit，若剩余空间放不下 64 位长度则多压缩一块
+        ctx.buffer[ctx.bufferLength++] = 0x80;
+        if (ctx.bufferLength > kBlockSize - 8)
         {
-            padded[paddedLength - 1 - i] = (totalBits >> (i * 8)) & 0xFF;
+            std::memset(ctx.buffer + ctx.bufferLength, 0, kBlockSize - ctx.bufferLength);
+            compress(ctx.backend, ctx.state, ctx.buffer, 1);
+            ctx.bufferLength = 0;
         }
+        std::memset(ctx.buffer + ctx.bufferLength, 0, kBlockSize - 8 - ctx.bufferLength);
 
-        // Process blocks
-        for (size_t i = 0; i < paddedLength; i += 64)
+        // Append length in bits as 64-bit big-endian
+        for (int i = 0; i < 8; ++i)
         {
-            transform(state, &padded[i]);
+            ctx.buffer[kBlockSize - 1 - i] = static_cast<uint8_t>((totalBits >> (i * 8)) & 0xFF);
         }
+        compress(ctx.backend, ctx.state, ctx.buffer, 1);
+        ctx.bufferLength = 0;
 
         // Produce final hash
         std::array<uint8_t, 32> result;
         for (int i = 0; i < 8; ++i)
         {
-            result[i * 4] = (state[i] >> 24) & 0xFF;
-            result[i * 4 + 1] = (state[i] >> 16) & 0xFF;
-            result[i * 4 + 2] = (state[i] >> 8) & 0xFF;
-            result[i * 4 + 3] = state[i] & 0xFF;
+            result[i * 4] = (ctx.state[i] >> 24) & 0xFF;
+            result[i * 4 + 1] = (ctx.state[i] >> 16) & 0xFF;
+            result[i * 4 + 2] = (ctx.state[i] >> 8) & 0xFF;
+            result[i * 4 + 3] = ctx.state[i] & 0xFF;
         }
 
         return result;
     }
 
+    inline std::array<uint8_t, 32> SHA256::hash(const uint8_t* data, size_t length)
+    {
+        Context ctx;
+        init(ctx);
+        update(ctx, data, length);
+        return finalize(ctx);
+    }
+
     inline std::string SHA256::hashHex(const uint8_t* data, size_t length)
     {
-        auto hashBytes = hash(data, length);
+        return HexCodec::encode(std::span<const uint8_t>(hash(data, length)));
+    }
+
+    inline std::string SHA256::hashHex(const std::string& data)
+    {
+        return hashHex(reinterpret_cast<const uint8_t*>(data.data()), data.length());
+    }
+
+#if defined(GALAY_UTILS_SHA256_SHANI)
+    namespace detail
+    {
+        template<int N>
+        __attribute__((target("avx2")))
+        inline __m256i sha256RotrX8(__m256i x)
+        {
+            return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+        }
 
-        static const char hexChars[] = "0123456789abcdef";
-        std::string result;
-        result.reserve(64);
+        __attribute__((target("avx2")))
+        inline __m256i sha256LoadWordX8(const uint8_t* const blocks[8], int t)
+        {
+            uint32_t words[8];
+            for (int lane = 0; lane < 8; ++lane)
+            {
+                std::memcpy(&words[lane], blocks[lane] + t * 4, 4);
+            }
+            // 大端字节序转换：每个 32 位字内字节逆序
+            const __m256i swap = _mm256_setr_epi8(
+                3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+            return _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words)), swap);
+        }
+    } // namespace detail
+
+    __attribute__((target("avx2")))
+    inline void SHA256::compressX8Avx2(uint32_t state[8][8], const uint8_t* const blocks[8], uint32_t activeMask)
+    {
+        using detail::sha256RotrX8;
 
-        for (uint8_t byte : hashBytes)
+        // state[word][lane]：8 条消息的同一状态字放在一个 256 位向量中
+        __m256i v[8];
+        for (int i = 0; i < 8; ++i)
         {
-            result.push_back(hexChars[byte >> 4]);
-            result.push_back(hexChars[byte & 0x0F]);
+            v[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[i]));
         }
+        __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
 
-        return result;
+        __m256i w[16];
+        for (int t = 0; t < 64; ++t)
+        {
+            __m256i wt;
+            if (t < 16)
+            {
+                wt = detail::sha256LoadWordX8(blocks, t);
+            }
+            else
+            {
+                const __m256i w15 = w[(t - 15) & 15];
+                const __m256i w2 = w[(t - 2) & 15];
+                const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(sha256RotrX8<7>(w15), sha256RotrX8<18>(w15)),
+                                                    _mm256_srli_epi32(w15, 3));
+                const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(sha256RotrX8<17>(w2), sha256RotrX8<19>(w2)),
+                                                    _mm256_srli_epi32(w2, 10));
+                wt = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0),
+                                      _mm256_add_epi32(w[(t - 7) & 15], s1));
+            }
+            w[t & 15] = wt;
+
+            const __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(sha256RotrX8<6>(e), sha256RotrX8<11>(e)), sha256RotrX8<25>(e));
+            const __m256i chv = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, S1),
+                _mm256_add_epi32(_mm256_add_epi32(chv, _mm256_set1_epi32(static_cast<int>(K[t]))), wt));
+            const __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(sha256RotrX8<2>(a), sha256RotrX8<13>(a)), sha256RotrX8<22>(a));
+            const __m256i majv = _mm256_xor_si256(_mm256_and_si256(a, b),
+                _mm256_and_si256(c, _mm256_xor_si256(a, b)));
+            const __m256i t2 = _mm256_add_epi32(S0, majv);
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi32(d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm256_add_epi32(t1, t2);
+        }
+
+        // 未激活的通道保持原状态
+        const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        const __m256i mask = _mm256_cmpeq_epi32(
+            _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(activeMask)), lanes), lanes);
+        const __m256i result[8] = {a, b, c, d, e, f, g, h};
+        for (int i = 0; i < 8; ++i)
+        {
+            const __m256i updated = _mm256_add_epi32(v[i], result[i]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(state[i]),
+                                _mm256_blendv_epi8(v[i], updated, mask));
+        }
     }
 
-    inline std::string SHA256::hashHex(const std::string& data)
+    inline void SHA256::hashLanesAvx2(const Context& prefix, const std::string_view* inputs,
+                                      std::array<uint8_t, 32>* outputs, size_t count)
     {
-        return hashHex(reinterpret_cast<const uint8_t*>(data.data()), data.length());
+        static constexpr uint8_t idleBlock[kBlockSize] = {};
+        alignas(32) uint32_t state[8][8];
+        uint8_t tails[8][kBlockSize * 2];
+        size_t fullBlocks[8] = {};
+        size_t totalBlocks[8] = {};
+        size_t maxBlocks = 0;
+
+        for (size_t lane = 0; lane < 8; ++lane)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                state[i][lane] = prefix.state[i];
+            }
+            if (lane >= count)
+            {
+                continue;
+            }
+
+            // 整块直接引用输入，仅最后 1～2 块拷入补位缓冲
+            const auto* data = reinterpret_cast<const uint8_t*>(inputs[lane].data());
+            const size_t length = inputs[lane].size();
+            const size_t full = length / kBlockSize;
+            const size_t rest = length % kBlockSize;
+            const size_t tailBlocks = rest < kBlockSize - 8 ? 1 : 2;
+            uint8_t* tail = tails[lane];
+            if (rest != 0)
+            {
+                std::memcpy(tail, data + full * kBlockSize, rest);
+            }
+            tail[rest] = 0x80;
+            std::memset(tail + rest + 1, 0, tailBlocks * kBlockSize - rest - 1);
+            const uint64_t totalBits = (prefix.length + length) * 8;
+            for (int i = 0; i < 8; ++i)
+            {
+                tail[tailBlocks * kBlockSize - 1 - i] = static_cast<uint8_t>((totalBits >> (i * 8)) & 0xFF);
+            }
+
+            fullBlocks[lane] = full;
+            totalBlocks[lane] = full + tailBlocks;
+            maxBlocks = std::max(maxBlocks, totalBlocks[lane]);
+        }
+
+        for (size_t block = 0; block < maxBlocks; ++block)
+        {
+            const uint8_t* pointers[8];
+            uint32_t activeMask = 0;
+            for (size_t lane = 0; lane < 8; ++lane)
+            {
+                if (block < totalBlocks[lane])
+                {
+                    activeMask |= 1u << lane;
+                    pointers[lane] = block < fullBlocks[lane]
+                        ? reinterpret_cast<const uint8_t*>(inputs[lane].data()) + block * kBlockSize
+                        : tails[lane] + (block - fullBlocks[lane]) * kBlockSize;
+                }
+                else
+                {
+                    pointers[lane] = idleBlock;
+                }
+            }
+            compressX8Avx2(state, pointers, activeMask);
+        }
+
+        for (size_t lane = 0; lane < count; ++lane)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                const uint32_t word = state[i][lane];
+                outputs[lane][i * 4] = (word >> 24) & 0xFF;
+                outputs[lane][i * 4 + 1] = (word >> 16) & 0xFF;
+                outputs[lane][i * 4 + 2] = (word >> 8) & 0xFF;
+                outputs[lane][i * 4 + 3] = word & 0xFF;
+            }
+        }
     }
+#endif
 
-    inline std::array<uint8_t, 32> HMAC::hmacSha256(const uint8_t* key, size_t keyLen,
-                                                     const uint8_t* data, size_t dataLen)
+    inline bool SHA256::isBatchAccelerated()
+    {
+#if defined(GALAY_UTILS_SHA256_SHANI)
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    inline void SHA256::hashBatch(std::span<const std::string_view> inputs,
+                                  std::span<std::array<uint8_t, 32>> outputs)
     {
-        constexpr size_t blockSize = 64;
+        Context prefix;
+        init(prefix);
+        hashBatch(prefix, inputs, outputs);
+    }
+
+    inline void SHA256::hashBatch(const Context& prefix,
+                                  std::span<const std::string_view> inputs,
+                                  std::span<std::array<uint8_t, 32>> outputs,
+                                  SHA256BatchMode mode)
+    {
+        if (inputs.size() != outputs.size())
+        {
+            throw std::invalid_argument("inputs and outputs size mismatch");
+        }
+
+        size_t index = 0;
+#if defined(GALAY_UTILS_SHA256_SHANI)
+        const bool multiBuffer = mode == SHA256BatchMode::MultiBuffer ||
+            (mode == SHA256BatchMode::Auto && prefix.backend == SHA256Backend::Scalar);
+        if (multiBuffer && prefix.bufferLength == 0 && isBatchAccelerated())
+        {
+            // 满 8 路时走 multi-buffer；不足 8 路的尾部交给单消息后端
+            for (; index + 8 <= inputs.size(); index += 8)
+            {
+                hashLanesAvx2(prefix, inputs.data() + index, outputs.data() + index, 8);
+            }
+        }
+#endif
+        for (; index < inputs.size(); ++index)
+        {
+            Context ctx = prefix;
+            update(ctx, reinterpret_cast<const uint8_t*>(inputs[index].data()), inputs[index].size());
+            outputs[index] = finalize(ctx);
+        }
+    }
+
+    namespace detail
+    {
+        /**
+         * @brief 常量时间比较两段等长字节
+         * @param lhs 左操作数
+         * @param rhs 右操作数
+         * @param length 字节数
+         * @return 全部相等返回 true
+         */
+        inline bool constantTimeEqual(const uint8_t* lhs, const uint8_t* rhs, size_t length)
+        {
+            volatile uint8_t diff = 0;
+            for (size_t i = 0; i < length; ++i)
+            {
+                diff = diff | static_cast<uint8_t>(lhs[i] ^ rhs[i]);
+            }
+            return diff == 0;
+        }
+
+        /**
+         * @brief 清零可能含有密钥材料的内存，避免被编译器优化掉
+         * @param data 内存指针
+         * @param length 字节数
+         */
+        inline void secureZero(void* data, size_t length)
+        {
+            volatile uint8_t* p = static_cast<volatile uint8_t*>(data);
+            while (length--)
+            {
+                *p++ = 0;
+            }
+        }
+    } // namespace detail
+
+    inline HmacKey::HmacKey(const uint8_t* key, size_t keyLen)
+    {
+        constexpr size_t blockSize = SHA256::kBlockSize;
         uint8_t keyBlock[blockSize] = {0};
 
         // If key is longer than block size, hash it
         if (keyLen > blockSize)
         {
             auto hashedKey = SHA256::hash(key, keyLen);
-            std::memcpy(keyBlock, hashedKey.data(), 32);
+            std::memcpy(keyBlock, hashedKey.data(), hashedKey.size());
         }
-        else
+        else if (keyLen != 0)
         {
             std::memcpy(keyBlock, key, keyLen);
         }
@@ -254,41 +1062,201 @@ namespace galay::utils
             opad[i] = keyBlock[i] ^ 0x5c;
         }
 
+        SHA256::init(m_inner);
+        SHA256::update(m_inner, ipad, blockSize);
+        SHA256::init(m_outer);
+        SHA256::update(m_outer, opad, blockSize);
+
+        detail::secureZero(keyBlock, sizeof(keyBlock));
+        detail::secureZero(ipad, sizeof(ipad));
+        detail::secureZero(opad, sizeof(opad));
+    }
+
+    inline HmacKey::HmacKey(std::string_view key)
+        : HmacKey(reinterpret_cast<const uint8_t*>(key.data()), key.size())
+    {
+    }
+
+    inline HmacKey::~HmacKey()
+    {
+        detail::secureZero(&m_inner, sizeof(m_inner));
+        detail::secureZero(&m_outer, sizeof(m_outer));
+    }
+
+    inline std::array<uint8_t, 32> HmacKey::sign(const uint8_t* data, size_t dataLen) const
+    {
         // Inner hash: H(K XOR ipad, text)
-        std::vector<uint8_t> innerData(blockSize + dataLen);
-        std::memcpy(innerData.data(), ipad, blockSize);
-        std::memcpy(innerData.data() + blockSize, data, dataLen);
-        auto innerHash = SHA256::hash(innerData.data(), innerData.size());
+        SHA256::Context ctx = m_inner;
+        SHA256::update(ctx, data, dataLen);
+
+        std::array<uint8_t, 32> tag;
+        finish(ctx, tag);
+        return tag;
+    }
+
+    inline std::array<uint8_t, 32> HmacKey::sign(std::string_view data) const
+    {
+        return sign(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    }
 
+    inline void HmacKey::finish(SHA256::Context& inner, std::span<uint8_t, 32> out) const
+    {
         // Outer hash: H(K XOR opad, innerHash)
-        std::vector<uint8_t> outerData(blockSize + 32);
-        std::memcpy(outerData.data(), opad, blockSize);
-        std::memcpy(outerData.data() + blockSize, innerHash.data(), 32);
+        auto innerHash = SHA256::finalize(inner);
+        SHA256::Context ctx = m_outer;
+        SHA256::update(ctx, innerHash.data(), innerHash.size());
+        const auto tag = SHA256::finalize(ctx);
+        std::memcpy(out.data(), tag.data(), tag.size());
+    }
+
+    inline void HmacKey::signInto(std::span<const std::byte> data, std::span<uint8_t, 32> out) const
+    {
+        SHA256::Context ctx = m_inner;
+        SHA256::update(ctx, reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        finish(ctx, out);
+    }
 
-        return SHA256::hash(outerData.data(), outerData.size());
+    inline void HmacKey::signInto(std::span<const std::span<const std::byte>> segments,
+                                  std::span<uint8_t, 32> out) const
+    {
+        SHA256::Context ctx = m_inner;
+        for (const auto& segment : segments)
+        {
+            SHA256::update(ctx, reinterpret_cast<const uint8_t*>(segment.data()), segment.size());
+        }
+        finish(ctx, out);
     }
 
-    inline std::array<uint8_t, 32> HMAC::hmacSha256(const std::string& key, const std::string& data)
+    inline bool HmacKey::verify(std::span<const std::byte> data, std::span<const uint8_t> expectedTag) const
     {
-        return hmacSha256(reinterpret_cast<const uint8_t*>(key.data()), key.length(),
-                         reinterpret_cast<const uint8_t*>(data.data()), data.length());
+        std::array<uint8_t, 32> tag;
+        signInto(data, tag);
+        return HMAC::constantTimeEqual(tag, expectedTag);
     }
 
-    inline std::string HMAC::hmacSha256Hex(const std::string& key, const std::string& data)
+    inline bool HmacKey::verify(std::span<const std::span<const std::byte>> segments,
+                                std::span<const uint8_t> expectedTag) const
     {
-        auto hmac = hmacSha256(key, data);
+        std::array<uint8_t, 32> tag;
+        signInto(segments, tag);
+        return HMAC::constantTimeEqual(tag, expectedTag);
+    }
 
-        static const char hexChars[] = "0123456789abcdef";
-        std::string result;
-        result.reserve(64);
+    inline bool HmacKey::verify(std::string_view data, std::span<const uint8_t> expectedTag) const
+    {
+        return verify(std::as_bytes(std::span(data.data(), data.size())), expectedTag);
+    }
 
-        for (uint8_t byte : hmac)
+    inline void HmacKey::signBatch(std::span<const std::string_view> messages,
+                                   std::span<std::array<uint8_t, 32>> tags) const
+    {
+        if (messages.size() != tags.size())
         {
-            result.push_back(hexChars[byte >> 4]);
-            result.push_back(hexChars[byte & 0x0F]);
+            throw std::invalid_argument("messages and tags size mismatch");
         }
 
-        return result;
+        // 分组处理，内层摘要放在栈上，避免按批量大小分配
+        constexpr size_t groupSize = 64;
+        std::array<uint8_t, 32> inner[groupSize];
+        std::string_view innerViews[groupSize];
+        for (size_t offset = 0; offset < messages.size(); offset += groupSize)
+        {
+            const size_t n = std::min(groupSize, messages.size() - offset);
+            SHA256::hashBatch(m_inner, messages.subspan(offset, n), std::span(inner, n));
+            for (size_t i = 0; i < n; ++i)
+            {
+                innerViews[i] = std::string_view(reinterpret_cast<const char*>(inner[i].data()), inner[i].size());
+            }
+            SHA256::hashBatch(m_outer, std::span<const std::string_view>(innerViews, n), tags.subspan(offset, n));
+        }
+    }
+
+    inline size_t HmacKey::verifyBatch(std::span<const std::string_view> messages,
+                                       std::span<const std::array<uint8_t, 32>> expected,
+                                       std::span<bool> results) const
+    {
+        if (messages.size() != expected.size() || messages.size() != results.size())
+        {
+            throw std::invalid_argument("messages, expected and results size mismatch");
+        }
+
+        constexpr size_t groupSize = 64;
+        std::array<uint8_t, 32> tags[groupSize];
+        size_t matched = 0;
+        for (size_t offset = 0; offset < messages.size(); offset += groupSize)
+        {
+            const size_t n = std::min(groupSize, messages.size() - offset);
+            signBatch(messages.subspan(offset, n), std::span(tags, n));
+            for (size_t i = 0; i < n; ++i)
+            {
+                const bool ok = HMAC::constantTimeEqual(tags[i], expected[offset + i]);
+                results[offset + i] = ok;
+                matched += ok ? 1 : 0;
+            }
+        }
+        return matched;
+    }
+
+    inline std::array<uint8_t, 32> HMAC::hmacSha256(const uint8_t* key, size_t keyLen,
+                                                     const uint8_t* data, size_t dataLen)
+    {
+        return HmacKey(key, keyLen).sign(data, dataLen);
+    }
+
+    inline void HMAC::hmacSha256Into(std::span<const std::byte> key, std::span<const std::byte> data,
+                                     std::span<uint8_t, 32> out)
+    {
+        HmacKey(reinterpret_cast<const uint8_t*>(key.data()), key.size()).signInto(data, out);
+    }
+
+    inline void HMAC::hmacSha256Into(std::span<const std::byte> key,
+                                     std::span<const std::span<const std::byte>> segments,
+                                     std::span<uint8_t, 32> out)
+    {
+        HmacKey(reinterpret_cast<const uint8_t*>(key.data()), key.size()).signInto(segments, out);
+    }
+
+    inline void HMAC::hmacSha256Into(std::string_view key, std::string_view data, std::span<uint8_t, 32> out)
+    {
+        HmacKey(key).signInto(std::as_bytes(std::span(data.data(), data.size())), out);
+    }
+
+    inline bool HMAC::verify(std::span<const std::byte> key, std::span<const std::byte> data,
+                             std::span<const uint8_t> expectedTag)
+    {
+        return HmacKey(reinterpret_cast<const uint8_t*>(key.data()), key.size()).verify(data, expectedTag);
+    }
+
+    inline bool HMAC::verify(std::span<const std::byte> key,
+                             std::span<const std::span<const std::byte>> segments,
+                             std::span<const uint8_t> expectedTag)
+    {
+        return HmacKey(reinterpret_cast<const uint8_t*>(key.data()), key.size()).verify(segments, expectedTag);
+    }
+
+    inline bool HMAC::verify(std::string_view key, std::string_view data, std::span<const uint8_t> expectedTag)
+    {
+        return HmacKey(key).verify(data, expectedTag);
+    }
+
+    inline bool HMAC::constantTimeEqual(std::span<const uint8_t> lhs, std::span<const uint8_t> rhs)
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+        return detail::constantTimeEqual(lhs.data(), rhs.data(), lhs.size());
+    }
+
+    inline std::array<uint8_t, 32> HMAC::hmacSha256(const std::string& key, const std::string& data)
+    {
+        return hmacSha256(reinterpret_cast<const uint8_t*>(key.data()), key.length(),
+                         reinterpret_cast<const uint8_t*>(data.data()), data.length());
+    }
+
+    inline std::string HMAC::hmacSha256Hex(const std::string& key, const std::string& data)
+    {
+        return HexCodec::encode(std::span<const uint8_t>(hmacSha256(key, data)));
     }
 
 } // namespace galay::utils
@@ -5,16 +5,27 @@
  * @version 1.0.0
  *
  * @details 提供 MD5 摘要计算功能，支持字符串和原始字节数据输入，
- *          返回十六进制字符串或 16 字节原始哈希值。支持 C++17 的 string_view 接口。
+ *          返回十六进制字符串或 16 字节原始哈希值。支持 C++17 的 string_view 接口、
+ *          init/update/finalize 流式接口，以及 x86-64 上 SSE2 4 路 / AVX2 8 路批量计算。
  */
 
 #ifndef GALAY_UTILS_MD5_H
 #define GALAY_UTILS_MD5_H
 
+#include "galay-utils/common/defn.hpp"
+#include "galay-utils/encoding/hex.hpp"
 #include <string>
 #include <cstring>
 #include <cstdint>
+#include <algorithm>
 #include <array>
+#include <span>
+#include <stdexcept>
+
+#if defined(GALAY_ARCH_X64) && (defined(GALAY_COMPILER_GCC) || defined(GALAY_COMPILER_CLANG))
+#define GALAY_UTILS_MD5_X86_SIMD 1
+#include <immintrin.h>
+#endif
 
 #if __cplusplus >= 201703L
 #include <string_view>
@@ -75,15 +86,66 @@ namespace galay::utils
         static std::array<uint8_t, 16> MD5RawView(std::string_view input);
 #endif
 
-    private:
-        // MD5 context for incremental hashing
+        /**
+         * @brief 流式哈希上下文
+         * @details 由 init() 初始化，可多次 update()，最后调用 finalize() 取摘要；
+         *          适合分块到达的上传数据，无需整体缓冲。普通值类型，可拷贝。
+         */
         struct Context
         {
-            uint32_t state[4];      // ABCD
-            uint32_t count[2];      // Number of bits, modulo 2^64 (lsb first)
-            uint8_t buffer[64];     // Input buffer
+            uint32_t state[4];      ///< ABCD
+            uint32_t count[2];      ///< Number of bits, modulo 2^64 (lsb first)
+            uint8_t buffer[64];     ///< Input buffer
         };
 
+        /**
+         * @brief 初始化流式上下文
+         * @param ctx 上下文
+         */
+        static void init(Context& ctx);
+
+        /**
+         * @brief 追加输入数据
+         * @param ctx 上下文
+         * @param input 输入数据指针
+         * @param length 数据长度
+         */
+        static void update(Context& ctx, const uint8_t* input, size_t length);
+
+        /**
+         * @brief 结束哈希并写出摘要
+         * @details 调用后上下文不可继续 update()，需重新 init()。
+         * @param ctx 上下文
+         * @param digest 16 字节输出缓冲区
+         */
+        static void finalize(Context& ctx, uint8_t digest[16]);
+
+        /**
+         * @brief 结束哈希并返回摘要
+         * @param ctx 上下文
+         * @return 16 字节的 MD5 哈希数组
+         */
+        static std::array<uint8_t, 16> finalize(Context& ctx);
+
+        /**
+         * @brief 批量计算多个独立对象的 MD5（原始字节）
+         * @details x86-64 上支持 AVX2 时以 8 路、否则以 SSE2 4 路并行压缩，
+         *          不足一组的尾部逐条计算；其他平台逐条计算。不分配堆内存。
+         * @param inputs 输入数据列表
+         * @param outputs 输出摘要列表，长度必须与 inputs 相同
+         * @throw std::invalid_argument 长度不一致
+         */
+        static void MD5RawBatch(std::span<const std::string_view> inputs,
+                                std::span<std::array<uint8_t, 16>> outputs);
+
+        /**
+         * @brief 获取批量计算的并行路数
+         * @return 8（AVX2）、4（SSE2）或 1（逐条）
+         */
+        static size_t batchLanes();
+
+    private:
+
         // MD5 constants
         static constexpr uint32_t S11 = 7;
         static constexpr uint32_t S12 = 12;
@@ -141,11 +203,17 @@ namespace galay::utils
         }
 
         // Core MD5 functions
-        static void init(Context& ctx);
-        static void update(Context& ctx, const uint8_t* input, size_t length);
-        static void finalize(Context& ctx, uint8_t digest[16]);
         static void transform(uint32_t state[4], const uint8_t block[64]);
 
+#if defined(GALAY_UTILS_MD5_X86_SIMD)
+        static void compressX4Sse2(uint32_t state[4][4], const uint8_t* const blocks[4], uint32_t activeMask);
+        static void compressX8Avx2(uint32_t state[4][8], const uint8_t* const blocks[8], uint32_t activeMask);
+
+        template<size_t Lanes, typename Kernel>
+        static void hashLanes(const std::string_view* inputs, std::array<uint8_t, 16>* outputs,
+                              size_t count, Kernel kernel);
+#endif
+
         // Utility functions
         static void encode(uint8_t* output, const uint32_t* input, size_t length);
         static void decode(uint32_t* output, const uint8_t* input, size_t length);
@@ -169,17 +237,18 @@ namespace galay::utils
     inline void MD5Util::update(Context& ctx, const uint8_t* input, size_t length)
     {
         // Compute number of bytes mod 64
-        uint32_t index = (ctx.count[0] >> 3) & 0x3F;
+        size_t index = (ctx.count[0] >> 3) & 0x3F;
 
-        // Update number of bits
-        if ((ctx.count[0] += (length << 3)) < (length << 3))
-            ctx.count[1]++;
-        ctx.count[1] += (length >> 29);
+        // Update number of bits (64-bit counter, wraps modulo 2^64)
+        const uint64_t bits = ((static_cast<uint64_t>(ctx.count[1]) << 32) | ctx.count[0]) +
+                              (static_cast<uint64_t>(length) << 3);
+        ctx.count[0] = static_cast<uint32_t>(bits);
+        ctx.count[1] = static_cast<uint32_t>(bits >> 32);
 
-        uint32_t partLen = 64 - index;
+        size_t partLen = 64 - index;
 
         // Transform as many times as possible
-        uint32_t i = 0;
+        size_t i = 0;
         if (length >= partLen)
         {
             std::memcpy(&ctx.buffer[index], input, partLen);
@@ -220,6 +289,13 @@ namespace galay::utils
         encode(digest, ctx.state, 16);
     }
 
+    inline std::array<uint8_t, 16> MD5Util::finalize(Context& ctx)
+    {
+        std::array<uint8_t, 16> digest;
+        finalize(ctx, digest.data());
+        return digest;
+    }
+
     inline void MD5Util::transform(uint32_t state[4], const uint8_t block[64])
     {
         uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
@@ -329,17 +405,279 @@ namespace galay::utils
 
     inline std::string MD5Util::toHexString(const uint8_t* data, size_t length)
     {
-        static const char hexChars[] = "0123456789abcdef";
-        std::string result;
-        result.reserve(length * 2);
+        return HexCodec::encode(std::span<const uint8_t>(data, length));
+    }
+
+#if defined(GALAY_UTILS_MD5_X86_SIMD)
+    namespace detail
+    {
+        /// MD5 每步的消息字下标、循环左移位数与加法常量
+        struct Md5Step
+        {
+            uint8_t index;
+            uint8_t shift;
+            uint32_t constant;
+        };
+
+        inline constexpr Md5Step kMd5Steps[64] = {
+            {0, 7, 0xd76aa478}, {1, 12, 0xe8c7b756}, {2, 17, 0x242070db}, {3, 22, 0xc1bdceee},
+            {4, 7, 0xf57c0faf}, {5, 12, 0x4787c62a}, {6, 17, 0xa8304613}, {7, 22, 0xfd469501},
+            {8, 7, 0x698098d8}, {9, 12, 0x8b44f7af}, {10, 17, 0xffff5bb1}, {11, 22, 0x895cd7be},
+            {12, 7, 0x6b901122}, {13, 12, 0xfd987193}, {14, 17, 0xa679438e}, {15, 22, 0x49b40821},
+            {1, 5, 0xf61e2562}, {6, 9, 0xc040b340}, {11, 14, 0x265e5a51}, {0, 20, 0xe9b6c7aa},
+            {5, 5, 0xd62f105d}, {10, 9, 0x02441453}, {15, 14, 0xd8a1e681}, {4, 20, 0xe7d3fbc8},
+            {9, 5, 0x21e1cde6}, {14, 9, 0xc33707d6}, {3, 14, 0xf4d50d87}, {8, 20, 0x455a14ed},
+            {13, 5, 0xa9e3e905}, {2, 9, 0xfcefa3f8}, {7, 14, 0x676f02d9}, {12, 20, 0x8d2a4c8a},
+            {5, 4, 0xfffa3942}, {8, 11, 0x8771f681}, {11, 16, 0x6d9d6122}, {14, 23, 0xfde5380c},
+            {1, 4, 0xa4beea44}, {4, 11, 0x4bdecfa9}, {7, 16, 0xf6bb4b60}, {10, 23, 0xbebfbc70},
+            {13, 4, 0x289b7ec6}, {0, 11, 0xeaa127fa}, {3, 16, 0xd4ef3085}, {6, 23, 0x04881d05},
+            {9, 4, 0xd9d4d039}, {12, 11, 0xe6db99e5}, {15, 16, 0x1fa27cf8}, {2, 23, 0xc4ac5665},
+            {0, 6, 0xf4292244}, {7, 10, 0x432aff97}, {14, 15, 0xab9423a7}, {5, 21, 0xfc93a039},
+            {12, 6, 0x655b59c3}, {3, 10, 0x8f0ccc92}, {10, 15, 0xffeff47d}, {1, 21, 0x85845dd1},
+            {8, 6, 0x6fa87e4f}, {15, 10, 0xfe2ce6e0}, {6, 15, 0xa3014314}, {13, 21, 0x4e0811a1},
+            {4, 6, 0xf7537e82}, {11, 10, 0xbd3af235}, {2, 15, 0x2ad7d2bb}, {9, 21, 0xeb86d391},
+        };
+
+        inline uint32_t md5LoadLe32(const uint8_t* p)
+        {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+    } // namespace detail
+
+    inline void MD5Util::compressX4Sse2(uint32_t state[4][4], const uint8_t* const blocks[4], uint32_t activeMask)
+    {
+        // state[word][lane]：4 个对象的同一状态字放在一个 128 位向量中
+        __m128i x[16];
+        for (int t = 0; t < 16; ++t)
+        {
+            x[t] = _mm_setr_epi32(static_cast<int>(detail::md5LoadLe32(blocks[0] + t * 4)),
+                                  static_cast<int>(detail::md5LoadLe32(blocks[1] + t * 4)),
+                                  static_cast<int>(detail::md5LoadLe32(blocks[2] + t * 4)),
+                                  static_cast<int>(detail::md5LoadLe32(blocks[3] + t * 4)));
+        }
+
+        const __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[0]));
+        const __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[1]));
+        const __m128i s2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[2]));
+        const __m128i s3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[3]));
+        const __m128i ones = _mm_set1_epi32(-1);
+        __m128i a = s0, b = s1, c = s2, d = s3;
+
+#if defined(GALAY_COMPILER_GCC)
+#pragma GCC unroll 64
+#endif
+        for (int i = 0; i < 64; ++i)
+        {
+            __m128i f;
+            switch (i >> 4)
+            {
+            case 0: f = _mm_or_si128(_mm_and_si128(b, c), _mm_andnot_si128(b, d)); break;
+            case 1: f = _mm_or_si128(_mm_and_si128(b, d), _mm_andnot_si128(d, c)); break;
+            case 2: f = _mm_xor_si128(_mm_xor_si128(b, c), d); break;
+            default: f = _mm_xor_si128(c, _mm_or_si128(b, _mm_xor_si128(d, ones))); break;
+            }
+            const detail::Md5Step& step = detail::kMd5Steps[i];
+            __m128i sum = _mm_add_epi32(_mm_add_epi32(a, f),
+                _mm_add_epi32(x[step.index], _mm_set1_epi32(static_cast<int>(step.constant))));
+            sum = _mm_or_si128(_mm_sll_epi32(sum, _mm_cvtsi32_si128(step.shift)),
+                               _mm_srl_epi32(sum, _mm_cvtsi32_si128(32 - step.shift)));
+            a = d;
+            d = c;
+            c = b;
+            b = _mm_add_epi32(b, sum);
+        }
+
+        // 未激活的通道保持原状态
+        const __m128i lanes = _mm_setr_epi32(1, 2, 4, 8);
+        const __m128i mask = _mm_cmpeq_epi32(
+            _mm_and_si128(_mm_set1_epi32(static_cast<int>(activeMask)), lanes), lanes);
+        const __m128i before[4] = {s0, s1, s2, s3};
+        const __m128i after[4] = {_mm_add_epi32(s0, a), _mm_add_epi32(s1, b),
+                                  _mm_add_epi32(s2, c), _mm_add_epi32(s3, d)};
+        for (int i = 0; i < 4; ++i)
+        {
+            const __m128i merged = _mm_or_si128(_mm_and_si128(mask, after[i]), _mm_andnot_si128(mask, before[i]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(state[i]), merged);
+        }
+    }
+
+    __attribute__((target("avx2")))
+    inline void MD5Util::compressX8Avx2(uint32_t state[4][8], const uint8_t* const blocks[8], uint32_t activeMask)
+    {
+        // state[word][lane]：8 个对象的同一状态字放在一个 256 位向量中
+        __m256i x[16];
+        for (int t = 0; t < 16; ++t)
+        {
+            x[t] = _mm256_setr_epi32(static_cast<int>(detail::md5LoadLe32(blocks[0] + t * 4)),
+                                     static_cast<int>(detail::md5LoadLe32(blocks[1] + t * 4)),
+                                     static_cast<int>(detail::md5LoadLe32(blocks[2] + t * 4)),
+                                     static_cast<int>(detail::md5LoadLe32(blocks[3] + t * 4)),
+                                     static_cast<int>(detail::md5LoadLe32(blocks[4] + t * 4)),
+                                     static_cast<int>(detail::md5LoadLe32(blocks[5] + t * 4)),
+                                     static_cast<int>(detail::md5LoadLe32(blocks[6] + t * 4)),
+                                     static_cast<int>(detail::md5LoadLe32(blocks[7] + t * 4)));
+        }
+
+        const __m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[0]));
+        const __m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[1]));
+        const __m256i s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[2]));
+        const __m256i s3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[3]));
+        const __m256i ones = _mm256_set1_epi32(-1);
+        __m256i a = s0, b = s1, c = s2, d = s3;
+
+#if defined(GALAY_COMPILER_GCC)
+#pragma GCC unroll 64
+#endif
+        for (int i = 0; i < 64; ++i)
+        {
+            __m256i f;
+            switch (i >> 4)
+            {
+            case 0: f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_andnot_si256(b, d)); break;
+            case 1: f = _mm256_or_si256(_mm256_and_si256(b, d), _mm256_andnot_si256(d, c)); break;
+            case 2: f = _mm256_xor_si256(_mm256_xor_si256(b, c), d); break;
+            default: f = _mm256_xor_si256(c, _mm256_or_si256(b, _mm256_xor_si256(d, ones))); break;
+            }
+            const detail::Md5Step& step = detail::kMd5Steps[i];
+            __m256i sum = _mm256_add_epi32(_mm256_add_epi32(a, f),
+                _mm256_add_epi32(x[step.index], _mm256_set1_epi32(static_cast<int>(step.constant))));
+            sum = _mm256_or_si256(_mm256_sll_epi32(sum, _mm_cvtsi32_si128(step.shift)),
+                                  _mm256_srl_epi32(sum, _mm_cvtsi32_si128(32 - step.shift)));
+            a = d;
+            d = c;
+            c = b;
+            b = _mm256_add_epi32(b, sum);
+        }
+
+        // 未激活的通道保持原状态
+        const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        const __m256i mask = _mm256_cmpeq_epi32(
+            _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(activeMask)), lanes), lanes);
+        const __m256i before[4] = {s0, s1, s2, s3};
+        const __m256i after[4] = {_mm256_add_epi32(s0, a), _mm256_add_epi32(s1, b),
+                                  _mm256_add_epi32(s2, c), _mm256_add_epi32(s3, d)};
+        for (int i = 0; i < 4; ++i)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(state[i]),
+                                _mm256_blendv_epi8(before[i], after[i], mask));
+        }
+    }
+
+    template<size_t Lanes, typename Kernel>
+    inline void MD5Util::hashLanes(const std::string_view* inputs, std::array<uint8_t, 16>* outputs,
+                                   size_t count, Kernel kernel)
+    {
+        static constexpr uint8_t idleBlock[64] = {};
+        static constexpr uint32_t initialState[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+        alignas(32) uint32_t state[4][Lanes];
+        uint8_t tails[Lanes][128];
+        size_t fullBlocks[Lanes] = {};
+        size_t totalBlocks[Lanes] = {};
+        size_t maxBlocks = 0;
+
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                state[i][lane] = initialState[i];
+            }
+            if (lane >= count)
+            {
+                continue;
+            }
+
+            // 整块直接引用输入，仅最后 1～2 块拷入补位缓冲
+            const auto* data = reinterpret_cast<const uint8_t*>(inputs[lane].data());
+            const size_t length = inputs[lane].size();
+            const size_t full = length / 64;
+            const size_t rest = length % 64;
+            const size_t tailBlocks = rest < 56 ? 1 : 2;
+            uint8_t* tail = tails[lane];
+            if (rest != 0)
+            {
+                std::memcpy(tail, data + full * 64, rest);
+            }
+            tail[rest] = 0x80;
+            std::memset(tail + rest + 1, 0, tailBlocks * 64 - rest - 1);
+            const uint64_t totalBits = static_cast<uint64_t>(length) << 3;
+            for (int i = 0; i < 8; ++i)
+            {
+                tail[tailBlocks * 64 - 8 + i] = static_cast<uint8_t>((totalBits >> (i * 8)) & 0xFF);
+            }
+
+            fullBlocks[lane] = full;
+            totalBlocks[lane] = full + tailBlocks;
+            maxBlocks = std::max(maxBlocks, totalBlocks[lane]);
+        }
 
-        for (size_t i = 0; i < length; ++i)
+        for (size_t block = 0; block < maxBlocks; ++block)
         {
-            result.push_back(hexChars[data[i] >> 4]);
-            result.push_back(hexChars[data[i] & 0x0F]);
+            const uint8_t* pointers[Lanes];
+            uint32_t activeMask = 0;
+            for (size_t lane = 0; lane < Lanes; ++lane)
+            {
+                if (block < totalBlocks[lane])
+                {
+                    activeMask |= 1u << lane;
+                    pointers[lane] = block < fullBlocks[lane]
+                        ? reinterpret_cast<const uint8_t*>(inputs[lane].data()) + block * 64
+                        : tails[lane] + (block - fullBlocks[lane]) * 64;
+                }
+                else
+                {
+                    pointers[lane] = idleBlock;
+                }
+            }
+            kernel(state, pointers, activeMask);
         }
 
-        return result;
+        for (size_t lane = 0; lane < count; ++lane)
+        {
+            uint32_t words[4] = {state[0][lane], state[1][lane], state[2][lane], state[3][lane]};
+            encode(outputs[lane].data(), words, 16);
+        }
+    }
+#endif
+
+    inline size_t MD5Util::batchLanes()
+    {
+#if defined(GALAY_UTILS_MD5_X86_SIMD)
+        static const size_t lanes = __builtin_cpu_supports("avx2") ? 8 : 4;
+        return lanes;
+#else
+        return 1;
+#endif
+    }
+
+    inline void MD5Util::MD5RawBatch(std::span<const std::string_view> inputs,
+                                     std::span<std::array<uint8_t, 16>> outputs)
+    {
+        if (inputs.size() != outputs.size())
+        {
+            throw std::invalid_argument("inputs and outputs size mismatch");
+        }
+
+        size_t index = 0;
+#if defined(GALAY_UTILS_MD5_X86_SIMD)
+        const size_t lanes = batchLanes();
+        for (; index + lanes <= inputs.size(); index += lanes)
+        {
+            if (lanes == 8)
+            {
+                hashLanes<8>(inputs.data() + index, outputs.data() + index, 8, &MD5Util::compressX8Avx2);
+            }
+            else
+            {
+                hashLanes<4>(inputs.data() + index, outputs.data() + index, 4, &MD5Util::compressX4Sse2);
+            }
+        }
+#endif
+        for (; index < inputs.size(); ++index)
+        {
+            outputs[index] = MD5Raw(reinterpret_cast<const unsigned char*>(inputs[index].data()),
+                                    inputs[index].size());
+        }
     }
 
     inline std::array<uint8_t, 16> MD5Util::MD5Raw(const unsigned char* data, size_t length)
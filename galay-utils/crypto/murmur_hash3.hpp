@@ -11,6 +11,7 @@
 #ifndef GALAY_UTILS_MURMURHASH3_H
 #define GALAY_UTILS_MURMURHASH3_H
 
+#include "galay-utils/encoding/hex.hpp"
 #include <string>
 #include <cstring>
 #include <cstdint>
@@ -296,23 +297,14 @@ namespace galay::utils
 
     inline std::string MurmurHash3Util::toHexString(uint64_t high, uint64_t low)
     {
-        static const char hexChars[] = "0123456789abcdef";
-        std::string result;
-        result.reserve(32);
-
-        // Convert high 64 bits
-        for (int i = 60; i >= 0; i -= 4)
+        // 高位在前，按大端字节序输出
+        std::array<uint8_t, 16> bytes;
+        for (int i = 0; i < 8; ++i)
         {
-            result.push_back(hexChars[(high >> i) & 0xF]);
+            bytes[i] = static_cast<uint8_t>(high >> (56 - i * 8));
+            bytes[8 + i] = static_cast<uint8_t>(low >> (56 - i * 8));
         }
-
-        // Convert low 64 bits
-        for (int i = 60; i >= 0; i -= 4)
-        {
-            result.push_back(hexChars[(low >> i) & 0xF]);
-        }
-
-        return result;
+        return HexCodec::encode(std::span<const uint8_t>(bytes));
     }
 
     inline std::string MurmurHash3Util::Hash128(const void* key, size_t len, uint32_t seed)
@@ -11,6 +11,9 @@
 #ifndef GALAY_UTILS_SALT_H
 #define GALAY_UTILS_SALT_H
 
+#include "galay-utils/crypto/secure_random.hpp"
+#include "galay-utils/encoding/base64.hpp"
+#include "galay-utils/encoding/hex.hpp"
 #include <string>
 #include <vector>
 #include <random>
@@ -23,7 +26,8 @@ namespace galay::utils
 {
     /**
      * @brief 随机盐值生成器
-     * @details 提供多种格式的盐值生成，包括普通随机和密码学安全随机两种模式。
+     * @details 提供多种格式的盐值生成。随机字节统一取自线程本地 ChaCha20 CSPRNG（SecureRandom），
+     *          generate* 与 generateSecure* 输出来源相同，保留两组接口以兼容现有调用。
      */
     class SaltGenerator
     {
@@ -124,66 +128,25 @@ namespace galay::utils
 
     inline std::string SaltGenerator::toHex(const uint8_t* data, size_t length)
     {
-        static const char hexChars[] = "0123456789abcdef";
-        std::string result;
-        result.reserve(length * 2);
-
-        for (size_t i = 0; i < length; ++i)
-        {
-            result.push_back(hexChars[data[i] >> 4]);
-            result.push_back(hexChars[data[i] & 0x0F]);
-        }
-
-        return result;
+        return HexCodec::encode(std::span<const uint8_t>(data, length));
     }
 
     inline std::string SaltGenerator::toBase64(const uint8_t* data, size_t length)
     {
-        static const char base64Chars[] =
-            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-        std::string result;
-        result.reserve(((length + 2) / 3) * 4);
-
-        for (size_t i = 0; i < length; i += 3)
-        {
-            uint32_t n = static_cast<uint32_t>(data[i]) << 16;
-            if (i + 1 < length) n |= static_cast<uint32_t>(data[i + 1]) << 8;
-            if (i + 2 < length) n |= static_cast<uint32_t>(data[i + 2]);
-
-            result.push_back(base64Chars[(n >> 18) & 0x3F]);
-            result.push_back(base64Chars[(n >> 12) & 0x3F]);
-            result.push_back(i + 1 < length ? base64Chars[(n >> 6) & 0x3F] : '=');
-            result.push_back(i + 2 < length ? base64Chars[n & 0x3F] : '=');
-        }
-
+        std::string result(Base64Util::Base64EncodedLength(length), '\0');
+        Base64Util::Base64EncodeInto(std::span<const uint8_t>(data, length), result);
         return result;
     }
 
     inline void SaltGenerator::getSecureRandomBytes(uint8_t* buffer, size_t length)
     {
-        std::random_device rd;
-
-        // Fill buffer with random bytes
-        for (size_t i = 0; i < length; ++i)
-        {
-            buffer[i] = static_cast<uint8_t>(rd() & 0xFF);
-        }
+        SecureRandom::fill(buffer, length);
     }
 
     inline std::vector<uint8_t> SaltGenerator::generateBytes(size_t length)
     {
-        std::vector<uint8_t> salt(length);
-        std::random_device rd;
-        std::mt19937_64 gen(rd());
-        std::uniform_int_distribution<int> dis(0, 255);
-
-        for (size_t i = 0; i < length; ++i)
-        {
-            salt[i] = static_cast<uint8_t>(dis(gen));
-        }
-
-        return salt;
+        // 盐值必须不可预测，普通接口同样取自线程本地 CSPRNG
+        return SecureRandom::bytes(length);
     }
 
     inline std::vector<uint8_t> SaltGenerator::generateSecureBytes(size_t length)
@@ -225,13 +188,9 @@ namespace galay::utils
         std::string result;
         result.reserve(length);
 
-        std::random_device rd;
-        std::mt19937_64 gen(rd());
-        std::uniform_int_distribution<size_t> dis(0, charset.length() - 1);
-
         for (size_t i = 0; i < length; ++i)
         {
-            result.push_back(charset[dis(gen)]);
+            result.push_back(charset[SecureRandom::uniform(charset.length())]);
         }
 
         return result;
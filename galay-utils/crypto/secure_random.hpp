@@ -0,0 +1,583 @@
+/**
+ * @file secure_random.hpp
+ * @brief 线程本地 ChaCha20 密码学安全随机数生成器
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 每个线程持有独立的 ChaCha20 密钥与输出缓冲，热路径无锁、无系统调用。
+ *          密钥来自操作系统熵源（Linux getrandom()、macOS arc4random_buf()，其余平台
+ *          std::random_device），并采用快速密钥擦除：每次补充缓冲时用首 32 字节替换密钥，
+ *          已输出的字节立即清零，事后泄露状态也无法回推历史输出。
+ *          fork 后子进程首次取数会重新播种；每输出 kReseedBytes 字节或经过 kReseedInterval
+ *          后混入新的系统熵。
+ */
+
+#ifndef GALAY_UTILS_SECURE_RANDOM_H
+#define GALAY_UTILS_SECURE_RANDOM_H
+
+#include "galay-utils/common/defn.hpp"
+#include "galay-utils/encoding/base64.hpp"
+#include "galay-utils/encoding/hex.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(GALAY_PLATFORM_LINUX)
+#include <cerrno>
+#include <pthread.h>
+#include <sys/random.h>
+#elif defined(GALAY_PLATFORM_MACOS)
+#include <pthread.h>
+#include <stdlib.h>
+#endif
+
+#if defined(GALAY_ARCH_X64) && (defined(GALAY_COMPILER_GCC) || defined(GALAY_COMPILER_CLANG))
+#define GALAY_UTILS_CHACHA_SSE2 1
+#include <immintrin.h>
+#elif defined(GALAY_ARCH_ARM64) && defined(__ARM_NEON)
+#define GALAY_UTILS_CHACHA_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace galay::utils
+{
+    namespace detail
+    {
+        /// "expand 32-byte k"
+        inline constexpr uint32_t chachaConstants[4] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+
+        inline constexpr uint32_t chachaRotl(uint32_t v, int n)
+        {
+            return (v << n) | (v >> (32 - n));
+        }
+
+        inline void chachaQuarterRound(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d)
+        {
+            a += b; d ^= a; d = chachaRotl(d, 16);
+            c += d; b ^= c; b = chachaRotl(b, 12);
+            a += b; d ^= a; d = chachaRotl(d, 8);
+            c += d; b ^= c; b = chachaRotl(b, 7);
+        }
+
+        /**
+         * @brief RFC 8439 ChaCha20 块函数
+         * @param key 256 位密钥（小端 32 位字）
+         * @param counter 块计数器
+         * @param nonce 96 位 nonce（小端 32 位字）
+         * @param out 64 字节密钥流
+         */
+        inline void chacha20Block(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3], uint8_t out[64])
+        {
+            uint32_t input[16] = {
+                chachaConstants[0], chachaConstants[1], chachaConstants[2], chachaConstants[3],
+                key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+                counter, nonce[0], nonce[1], nonce[2]};
+            uint32_t x[16];
+            std::memcpy(x, input, sizeof(x));
+            for (int i = 0; i < 10; ++i) {
+                chachaQuarterRound(x[0], x[4], x[8], x[12]);
+                chachaQuarterRound(x[1], x[5], x[9], x[13]);
+                chachaQuarterRound(x[2], x[6], x[10], x[14]);
+                chachaQuarterRound(x[3], x[7], x[11], x[15]);
+                chachaQuarterRound(x[0], x[5], x[10], x[15]);
+                chachaQuarterRound(x[1], x[6], x[11], x[12]);
+                chachaQuarterRound(x[2], x[7], x[8], x[13]);
+                chachaQuarterRound(x[3], x[4], x[9], x[14]);
+            }
+            for (int i = 0; i < 16; ++i) {
+                const uint32_t v = x[i] + input[i];
+                out[i * 4] = static_cast<uint8_t>(v);
+                out[i * 4 + 1] = static_cast<uint8_t>(v >> 8);
+                out[i * 4 + 2] = static_cast<uint8_t>(v >> 16);
+                out[i * 4 + 3] = static_cast<uint8_t>(v >> 24);
+            }
+        }
+
+#if defined(GALAY_UTILS_CHACHA_SSE2)
+        template<int N>
+        inline __m128i chachaRotlSse2(__m128i v)
+        {
+            return _mm_or_si128(_mm_slli_epi32(v, N), _mm_srli_epi32(v, 32 - N));
+        }
+
+        /// 4 路并行：每个向量保存 4 个块的同一状态字，计数器依次为 counter..counter+3
+        inline void chacha20Blocks4(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3], uint8_t* out)
+        {
+            __m128i input[16];
+            for (int i = 0; i < 4; ++i) {
+                input[i] = _mm_set1_epi32(static_cast<int>(chachaConstants[i]));
+            }
+            for (int i = 0; i < 8; ++i) {
+                input[4 + i] = _mm_set1_epi32(static_cast<int>(key[i]));
+            }
+            input[12] = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(counter)), _mm_setr_epi32(0, 1, 2, 3));
+            for (int i = 0; i < 3; ++i) {
+                input[13 + i] = _mm_set1_epi32(static_cast<int>(nonce[i]));
+            }
+            __m128i x[16];
+            for (int i = 0; i < 16; ++i) {
+                x[i] = input[i];
+            }
+            auto quarter = [](__m128i& a, __m128i& b, __m128i& c, __m128i& d) {
+                a = _mm_add_epi32(a, b); d = chachaRotlSse2<16>(_mm_xor_si128(d, a));
+                c = _mm_add_epi32(c, d); b = chachaRotlSse2<12>(_mm_xor_si128(b, c));
+                a = _mm_add_epi32(a, b); d = chachaRotlSse2<8>(_mm_xor_si128(d, a));
+                c = _mm_add_epi32(c, d); b = chachaRotlSse2<7>(_mm_xor_si128(b, c));
+            };
+            for (int i = 0; i < 10; ++i) {
+                quarter(x[0], x[4], x[8], x[12]);
+                quarter(x[1], x[5], x[9], x[13]);
+                quarter(x[2], x[6], x[10], x[14]);
+                quarter(x[3], x[7], x[11], x[15]);
+                quarter(x[0], x[5], x[10], x[15]);
+                quarter(x[1], x[6], x[11], x[12]);
+                quarter(x[2], x[7], x[8], x[13]);
+                quarter(x[3], x[4], x[9], x[14]);
+            }
+            // 每 4 个状态字做一次 4x4 转置，写回各块的对应 16 字节
+            for (int group = 0; group < 4; ++group) {
+                const __m128i a0 = _mm_add_epi32(x[group * 4], input[group * 4]);
+                const __m128i a1 = _mm_add_epi32(x[group * 4 + 1], input[group * 4 + 1]);
+                const __m128i a2 = _mm_add_epi32(x[group * 4 + 2], input[group * 4 + 2]);
+                const __m128i a3 = _mm_add_epi32(x[group * 4 + 3], input[group * 4 + 3]);
+                const __m128i t0 = _mm_unpacklo_epi32(a0, a1);
+                const __m128i t1 = _mm_unpacklo_epi32(a2, a3);
+                const __m128i t2 = _mm_unpackhi_epi32(a0, a1);
+                const __m128i t3 = _mm_unpackhi_epi32(a2, a3);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + group * 16), _mm_unpacklo_epi64(t0, t1));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 64 + group * 16), _mm_unpackhi_epi64(t0, t1));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 128 + group * 16), _mm_unpacklo_epi64(t2, t3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 192 + group * 16), _mm_unpackhi_epi64(t2, t3));
+            }
+        }
+        __attribute__((target("avx2")))
+        inline void chachaQuarterAvx2(__m256i& a, __m256i& b, __m256i& c, __m256i& d)
+        {
+            // 16 / 8 位循环移位正好是字节重排
+            const __m256i rot16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                                   2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+            const __m256i rot8 = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+                                                  3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+            a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16);
+            c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c);
+            b = _mm256_or_si256(_mm256_slli_epi32(b, 12), _mm256_srli_epi32(b, 20));
+            a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot8);
+            c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c);
+            b = _mm256_or_si256(_mm256_slli_epi32(b, 7), _mm256_srli_epi32(b, 25));
+        }
+
+        /// 8 路并行（AVX2，运行时检测）：低 128 位通道为块 0-3，高 128 位通道为块 4-7
+        __attribute__((target("avx2")))
+        inline void chacha20Blocks8Avx2(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3], uint8_t* out)
+        {
+            __m256i input[16];
+            for (int i = 0; i < 4; ++i) {
+                input[i] = _mm256_set1_epi32(static_cast<int>(chachaConstants[i]));
+            }
+            for (int i = 0; i < 8; ++i) {
+                input[4 + i] = _mm256_set1_epi32(static_cast<int>(key[i]));
+            }
+            input[12] = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(counter)),
+                                         _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            for (int i = 0; i < 3; ++i) {
+                input[13 + i] = _mm256_set1_epi32(static_cast<int>(nonce[i]));
+            }
+            __m256i x[16];
+            for (int i = 0; i < 16; ++i) {
+                x[i] = input[i];
+            }
+            for (int i = 0; i < 10; ++i) {
+                chachaQuarterAvx2(x[0], x[4], x[8], x[12]);
+                chachaQuarterAvx2(x[1], x[5], x[9], x[13]);
+                chachaQuarterAvx2(x[2], x[6], x[10], x[14]);
+                chachaQuarterAvx2(x[3], x[7], x[11], x[15]);
+                chachaQuarterAvx2(x[0], x[5], x[10], x[15]);
+                chachaQuarterAvx2(x[1], x[6], x[11], x[12]);
+                chachaQuarterAvx2(x[2], x[7], x[8], x[13]);
+                chachaQuarterAvx2(x[3], x[4], x[9], x[14]);
+            }
+            for (int group = 0; group < 4; ++group) {
+                const __m256i a0 = _mm256_add_epi32(x[group * 4], input[group * 4]);
+                const __m256i a1 = _mm256_add_epi32(x[group * 4 + 1], input[group * 4 + 1]);
+                const __m256i a2 = _mm256_add_epi32(x[group * 4 + 2], input[group * 4 + 2]);
+                const __m256i a3 = _mm256_add_epi32(x[group * 4 + 3], input[group * 4 + 3]);
+                const __m256i t0 = _mm256_unpacklo_epi32(a0, a1);
+                const __m256i t1 = _mm256_unpacklo_epi32(a2, a3);
+                const __m256i t2 = _mm256_unpackhi_epi32(a0, a1);
+                const __m256i t3 = _mm256_unpackhi_epi32(a2, a3);
+                const __m256i rows[4] = {_mm256_unpacklo_epi64(t0, t1), _mm256_unpackhi_epi64(t0, t1),
+                                         _mm256_unpacklo_epi64(t2, t3), _mm256_unpackhi_epi64(t2, t3)};
+                for (int block = 0; block < 4; ++block) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + block * 64 + group * 16),
+                                     _mm256_castsi256_si128(rows[block]));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + (block + 4) * 64 + group * 16),
+                                     _mm256_extracti128_si256(rows[block], 1));
+                }
+            }
+        }
+#elif defined(GALAY_UTILS_CHACHA_NEON)
+        template<int N>
+        inline uint32x4_t chachaRotlNeon(uint32x4_t v)
+        {
+            return vorrq_u32(vshlq_n_u32(v, N), vshrq_n_u32(v, 32 - N));
+        }
+
+        inline void chacha20Blocks4(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3], uint8_t* out)
+        {
+            uint32x4_t input[16];
+            for (int i = 0; i < 4; ++i) {
+                input[i] = vdupq_n_u32(chachaConstants[i]);
+            }
+            for (int i = 0; i < 8; ++i) {
+                input[4 + i] = vdupq_n_u32(key[i]);
+            }
+            const uint32_t lanes[4] = {0, 1, 2, 3};
+            input[12] = vaddq_u32(vdupq_n_u32(counter), vld1q_u32(lanes));
+            for (int i = 0; i < 3; ++i) {
+                input[13 + i] = vdupq_n_u32(nonce[i]);
+            }
+            uint32x4_t x[16];
+            for (int i = 0; i < 16; ++i) {
+                x[i] = input[i];
+            }
+            auto quarter = [](uint32x4_t& a, uint32x4_t& b, uint32x4_t& c, uint32x4_t& d) {
+                a = vaddq_u32(a, b); d = vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(veorq_u32(d, a))));
+                c = vaddq_u32(c, d); b = chachaRotlNeon<12>(veorq_u32(b, c));
+                a = vaddq_u32(a, b); d = chachaRotlNeon<8>(veorq_u32(d, a));
+                c = vaddq_u32(c, d); b = chachaRotlNeon<7>(veorq_u32(b, c));
+            };
+            for (int i = 0; i < 10; ++i) {
+                quarter(x[0], x[4], x[8], x[12]);
+                quarter(x[1], x[5], x[9], x[13]);
+                quarter(x[2], x[6], x[10], x[14]);
+                quarter(x[3], x[7], x[11], x[15]);
+                quarter(x[0], x[5], x[10], x[15]);
+                quarter(x[1], x[6], x[11], x[12]);
+                quarter(x[2], x[7], x[8], x[13]);
+                quarter(x[3], x[4], x[9], x[14]);
+            }
+            for (int group = 0; group < 4; ++group) {
+                const uint32x4x2_t t01 = vtrnq_u32(vaddq_u32(x[group * 4], input[group * 4]),
+                                                   vaddq_u32(x[group * 4 + 1], input[group * 4 + 1]));
+                const uint32x4x2_t t23 = vtrnq_u32(vaddq_u32(x[group * 4 + 2], input[group * 4 + 2]),
+                                                   vaddq_u32(x[group * 4 + 3], input[group * 4 + 3]));
+                auto* dst = reinterpret_cast<uint32_t*>(out + group * 16);
+                vst1q_u32(dst, vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0])));
+                vst1q_u32(dst + 16, vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1])));
+                vst1q_u32(dst + 32, vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])));
+                vst1q_u32(dst + 48, vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1])));
+            }
+        }
+#endif
+
+        /// 生成 blocks 个连续块的密钥流（计数器从 0 开始，nonce 为 0）
+        inline void chacha20Stream(const uint32_t key[8], uint8_t* out, size_t blocks)
+        {
+            constexpr uint32_t nonce[3] = {0, 0, 0};
+            size_t done = 0;
+#if defined(GALAY_UTILS_CHACHA_SSE2)
+            static const bool avx2 = __builtin_cpu_supports("avx2");
+            if (avx2) {
+                for (; done + 8 <= blocks; done += 8) {
+                    chacha20Blocks8Avx2(key, static_cast<uint32_t>(done), nonce, out + done * 64);
+                }
+            }
+#endif
+#if defined(GALAY_UTILS_CHACHA_SSE2) || defined(GALAY_UTILS_CHACHA_NEON)
+            for (; done + 4 <= blocks; done += 4) {
+                chacha20Blocks4(key, static_cast<uint32_t>(done), nonce, out + done * 64);
+            }
+#endif
+            // 按剩余块数计数，避免 GCC 在内联后对 done * 64 给出溢出误报
+            for (size_t rest = blocks - done; rest > 0; --rest, ++done) {
+                chacha20Block(key, static_cast<uint32_t>(done), nonce, out + done * 64);
+            }
+        }
+
+        /// 不会被编译器优化掉的清零
+        inline void secureWipe(void* data, size_t length)
+        {
+            volatile uint8_t* p = static_cast<volatile uint8_t*>(data);
+            while (length--) {
+                *p++ = 0;
+            }
+        }
+
+        /**
+         * @brief 从操作系统熵源读取随机字节
+         * @throws std::runtime_error 系统熵源不可用
+         */
+        inline void systemRandomBytes(uint8_t* out, size_t length)
+        {
+#if defined(GALAY_PLATFORM_LINUX)
+            while (length > 0) {
+                const ssize_t n = ::getrandom(out, length, 0);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::runtime_error("getrandom() failed");
+                }
+                out += n;
+                length -= static_cast<size_t>(n);
+            }
+#elif defined(GALAY_PLATFORM_MACOS)
+            ::arc4random_buf(out, length);
+#else
+            std::random_device device;
+            for (size_t i = 0; i < length; i += 4) {
+                const uint32_t v = device();
+                std::memcpy(out + i, &v, std::min<size_t>(4, length - i));
+            }
+#endif
+        }
+
+        /// fork 代数：子进程中递增，线程状态据此判断是否需要重新播种
+        inline std::atomic<uint64_t>& secureRandomForkGeneration()
+        {
+            static std::atomic<uint64_t> generation{0};
+            return generation;
+        }
+
+        inline void secureRandomRegisterAtFork()
+        {
+#if defined(GALAY_PLATFORM_LINUX) || defined(GALAY_PLATFORM_MACOS)
+            static const bool registered = [] {
+                ::pthread_atfork(nullptr, nullptr, [] {
+                    secureRandomForkGeneration().fetch_add(1, std::memory_order_relaxed);
+                });
+                return true;
+            }();
+            GALAY_UNUSED(registered);
+#endif
+        }
+
+        /// 每线程 ChaCha20 状态，缓冲区尾部 available 字节为未输出的密钥流
+        struct SecureRandomState
+        {
+            static constexpr size_t kBlocks = 16;
+            static constexpr size_t kBufferSize = kBlocks * 64;
+
+            std::array<uint32_t, 8> key{};
+            std::array<uint8_t, kBufferSize> buffer{};
+            size_t available = 0;
+            bool seeded = false;
+            uint64_t forkGeneration = 0;
+            uint64_t bytesSinceSeed = 0;
+            std::chrono::steady_clock::time_point seededAt{};
+
+            SecureRandomState() = default;
+            SecureRandomState(const SecureRandomState&) = delete;
+            SecureRandomState& operator=(const SecureRandomState&) = delete;
+
+            ~SecureRandomState()
+            {
+                secureWipe(key.data(), sizeof(key));
+                secureWipe(buffer.data(), buffer.size());
+            }
+        };
+
+        inline SecureRandomState& secureRandomState()
+        {
+            static thread_local SecureRandomState state;
+            return state;
+        }
+    } // namespace detail
+
+    /**
+     * @brief 密码学安全随机数生成器
+     * @details 全部为静态方法，状态按线程隔离，可在任意线程并发调用而无需加锁。
+     *          适用于盐值、会话令牌、API key、UUID 等需要不可预测性的场景；
+     *          需要可复现序列的模拟或测试请使用 RandomGenerator。
+     */
+    class SecureRandom
+    {
+    public:
+        /// 单线程累计输出达到该字节数后混入新的系统熵
+        static constexpr uint64_t kReseedBytes = 1ull << 20;
+        /// 距上次播种超过该时长后混入新的系统熵（在补充缓冲时检查）
+        static constexpr std::chrono::seconds kReseedInterval{300};
+
+        /**
+         * @brief 填充安全随机字节
+         * @param output 输出缓冲区
+         * @throws std::runtime_error 首次播种时系统熵源不可用
+         */
+        static void fill(std::span<uint8_t> output)
+        {
+            fill(output.data(), output.size());
+        }
+
+        /**
+         * @brief 填充安全随机字节
+         * @param buffer 输出缓冲区；为空时直接返回
+         * @param length 字节数量
+         */
+        static void fill(uint8_t* buffer, size_t length);
+
+        /**
+         * @brief 生成安全随机字节数组
+         * @param length 字节数量
+         */
+        static std::vector<uint8_t> bytes(size_t length)
+        {
+            std::vector<uint8_t> result(length);
+            fill(result);
+            return result;
+        }
+
+        /**
+         * @brief 生成 64 位安全随机整数
+         */
+        static uint64_t next64()
+        {
+            uint64_t value;
+            fill(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+            return value;
+        }
+
+        /**
+         * @brief 生成 [0, bound) 内均匀分布的安全随机整数（拒绝采样，无取模偏差）
+         * @param bound 上界（不含）
+         * @throws std::invalid_argument bound 为 0
+         */
+        static uint64_t uniform(uint64_t bound)
+        {
+            if (bound == 0) {
+                throw std::invalid_argument("SecureRandom::uniform bound must be positive");
+            }
+            // 丢弃 [0, 2^64 mod bound) 区间，使剩余取值数为 bound 的整数倍
+            const uint64_t threshold = (0 - bound) % bound;
+            for (;;) {
+                const uint64_t value = next64();
+                if (value >= threshold) {
+                    return value % bound;
+                }
+            }
+        }
+
+        /**
+         * @brief 生成 URL-safe Base64 令牌（无填充）
+         * @param length 随机字节数（默认 32，即 256 位）
+         * @return 约 4 * length / 3 个字符的令牌
+         */
+        static std::string token(size_t length = 32);
+
+        /**
+         * @brief 生成随机 UUID（版本 4）
+         * @return 36 字符小写 UUID 字符串
+         */
+        static std::string uuid();
+
+        /**
+         * @brief 立即为当前线程混入新的系统熵，并丢弃已缓冲的输出
+         */
+        static void reseed();
+
+    private:
+        static void refill(detail::SecureRandomState& state);
+        static void seed(detail::SecureRandomState& state);
+    };
+
+    inline void SecureRandom::seed(detail::SecureRandomState& state)
+    {
+        detail::secureRandomRegisterAtFork();
+        std::array<uint32_t, 8> fresh;
+        detail::systemRandomBytes(reinterpret_cast<uint8_t*>(fresh.data()), sizeof(fresh));
+        // 与旧密钥异或：新熵不足时也不会丢失已有熵
+        for (size_t i = 0; i < fresh.size(); ++i) {
+            state.key[i] ^= fresh[i];
+        }
+        detail::secureWipe(fresh.data(), sizeof(fresh));
+        detail::secureWipe(state.buffer.data(), state.buffer.size());
+        state.available = 0;
+        state.seeded = true;
+        state.forkGeneration = detail::secureRandomForkGeneration().load(std::memory_order_relaxed);
+        state.bytesSinceSeed = 0;
+        state.seededAt = std::chrono::steady_clock::now();
+    }
+
+    inline void SecureRandom::refill(detail::SecureRandomState& state)
+    {
+        if (state.bytesSinceSeed >= kReseedBytes
+            || std::chrono::steady_clock::now() - state.seededAt >= kReseedInterval) {
+            seed(state);
+        }
+        detail::chacha20Stream(state.key.data(), state.buffer.data(), detail::SecureRandomState::kBlocks);
+        // 快速密钥擦除：首 32 字节成为下一轮密钥，不作为输出
+        std::memcpy(state.key.data(), state.buffer.data(), sizeof(state.key));
+        detail::secureWipe(state.buffer.data(), sizeof(state.key));
+        state.available = state.buffer.size() - sizeof(state.key);
+    }
+
+    inline void SecureRandom::fill(uint8_t* buffer, size_t length)
+    {
+        if (buffer == nullptr || length == 0) {
+            return;
+        }
+        detail::SecureRandomState& state = detail::secureRandomState();
+        if (GALAY_UNLIKELY(!state.seeded
+                           || state.forkGeneration != detail::secureRandomForkGeneration().load(std::memory_order_relaxed))) {
+            seed(state);
+        }
+        state.bytesSinceSeed += length;
+        while (length > 0) {
+            if (state.available == 0) {
+                refill(state);
+            }
+            const size_t take = std::min(length, state.available);
+            uint8_t* source = state.buffer.data() + state.buffer.size() - state.available;
+            std::memcpy(buffer, source, take);
+            std::memset(source, 0, take);
+            buffer += take;
+            length -= take;
+            state.available -= take;
+        }
+    }
+
+    inline std::string SecureRandom::token(size_t length)
+    {
+        std::array<uint8_t, 64> stack;
+        std::vector<uint8_t> heap;
+        uint8_t* raw = stack.data();
+        if (length > stack.size()) {
+            heap.resize(length);
+            raw = heap.data();
+        }
+        fill(raw, length);
+        std::string result(Base64Util::Base64EncodedLength(length), '\0');
+        Base64Util::Base64EncodeInto(std::span<const uint8_t>(raw, length), result, true);
+        while (!result.empty() && result.back() == '=') {
+            result.pop_back();
+        }
+        detail::secureWipe(raw, length);
+        return result;
+    }
+
+    inline std::string SecureRandom::uuid()
+    {
+        std::array<uint8_t, 16> raw;
+        fill(raw);
+        raw[6] = static_cast<uint8_t>((raw[6] & 0x0F) | 0x40);
+        raw[8] = static_cast<uint8_t>((raw[8] & 0x3F) | 0x80);
+
+        std::string result(36, '\0');
+        detail::hexFormatUuid(raw.data(), result.data());
+        return result;
+    }
+
+    inline void SecureRandom::reseed()
+    {
+        seed(detail::secureRandomState());
+    }
+}
+
+#endif // GALAY_UTILS_SECURE_RANDOM_H
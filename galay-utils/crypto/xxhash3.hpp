@@ -0,0 +1,879 @@
+/**
+ * @file xxhash3.hpp
+ * @brief XXH3 64/128 位非加密哈希实现
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 提供与 xxHash v0.8 参考实现逐位一致的 XXH3_64bits / XXH3_128bits，
+ *          支持种子、一次性与流式计算。超过 240 字节的长输入在 x86-64 上运行时
+ *          检测 AVX2，在 AArch64 上使用 NEON，其他平台使用标量实现。
+ *          同时提供可作为 BloomFilter / ConsistentHash / LruCache 模板参数的 XXH3Hasher。
+ */
+
+#ifndef GALAY_UTILS_XXHASH3_H
+#define GALAY_UTILS_XXHASH3_H
+
+#include "galay-utils/common/defn.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#if defined(GALAY_ARCH_X64) && (defined(GALAY_COMPILER_GCC) || defined(GALAY_COMPILER_CLANG))
+#define GALAY_UTILS_XXH3_AVX2 1
+#include <immintrin.h>
+#elif defined(GALAY_ARCH_ARM64) && defined(__ARM_NEON)
+#define GALAY_UTILS_XXH3_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace galay::utils
+{
+    /**
+     * @brief XXH3 128 位哈希结果
+     */
+    struct XXH128Hash
+    {
+        uint64_t low;   ///< 低 64 位
+        uint64_t high;  ///< 高 64 位
+
+        friend bool operator==(const XXH128Hash&, const XXH128Hash&) = default;
+    };
+
+    /**
+     * @brief XXH3 长输入累加使用的指令集
+     */
+    enum class XXH3Backend
+    {
+        Scalar,     ///< 可移植标量实现
+        Avx2,       ///< x86-64 AVX2（运行时检测）
+        Neon        ///< AArch64 NEON
+    };
+
+    /**
+     * @brief XXH3 哈希工具类
+     * @details 结果与 xxHash 参考实现的 XXH3_64bits_withSeed / XXH3_128bits_withSeed 一致，
+     *          可跨进程、跨机器稳定使用。不是加密哈希，不能抵御刻意构造的碰撞。
+     */
+    class XXH3
+    {
+    public:
+        static constexpr size_t kSecretSize = 192;  ///< 默认密钥长度
+        static constexpr size_t kStripeSize = 64;   ///< 长输入每条带字节数
+
+        /**
+         * @brief 计算 64 位哈希
+         * @param data 输入数据指针；length 为 0 时可以为 nullptr
+         * @param length 数据长度
+         * @param seed 种子值
+         * @return 64 位哈希值
+         */
+        static uint64_t hash64(const uint8_t* data, size_t length, uint64_t seed = 0);
+
+        /**
+         * @brief 计算字符串视图的 64 位哈希
+         * @param input 输入数据
+         * @param seed 种子值
+         * @return 64 位哈希值
+         */
+        static uint64_t hash64(std::string_view input, uint64_t seed = 0);
+
+        /**
+         * @brief 计算 128 位哈希
+         * @param data 输入数据指针；length 为 0 时可以为 nullptr
+         * @param length 数据长度
+         * @param seed 种子值
+         * @return 128 位哈希值
+         */
+        static XXH128Hash hash128(const uint8_t* data, size_t length, uint64_t seed = 0);
+
+        /**
+         * @brief 计算字符串视图的 128 位哈希
+         * @param input 输入数据
+         * @param seed 种子值
+         * @return 128 位哈希值
+         */
+        static XXH128Hash hash128(std::string_view input, uint64_t seed = 0);
+
+        /**
+         * @brief 获取当前进程长输入路径使用的指令集
+         * @return 指令集类型
+         */
+        static XXH3Backend backend();
+
+        /**
+         * @brief 流式哈希状态
+         * @details 可多次 update()，digest64() / digest128() 不修改状态，可在任意时刻取中间结果。
+         *          结果与对拼接后的完整输入调用 hash64() / hash128() 相同。不分配堆内存。
+         */
+        class State
+        {
+        public:
+            /**
+             * @brief 构造并以指定种子初始化
+             * @param seed 种子值
+             */
+            explicit State(uint64_t seed = 0) { reset(seed); }
+
+            /**
+             * @brief 重置状态
+             * @param seed 种子值
+             */
+            void reset(uint64_t seed = 0);
+
+            /**
+             * @brief 追加输入数据
+             * @param data 输入数据指针；length 为 0 时可以为 nullptr
+             * @param length 数据长度
+             */
+            void update(const uint8_t* data, size_t length);
+
+            /**
+             * @brief 追加字符串视图
+             * @param input 输入数据
+             */
+            void update(std::string_view input) { update(reinterpret_cast<const uint8_t*>(input.data()), input.size()); }
+
+            /**
+             * @brief 计算当前输入的 64 位哈希
+             * @return 64 位哈希值
+             */
+            uint64_t digest64() const;
+
+            /**
+             * @brief 计算当前输入的 128 位哈希
+             * @return 128 位哈希值
+             */
+            XXH128Hash digest128() const;
+
+        private:
+            static constexpr size_t kBufferSize = 256;
+
+            void digestLong(uint64_t acc[8]) const;
+
+            alignas(64) uint64_t m_acc[8];
+            alignas(64) uint8_t m_secret[kSecretSize];
+            alignas(64) uint8_t m_buffer[kBufferSize];
+            size_t m_bufferedSize;
+            size_t m_stripesSoFar;
+            uint64_t m_totalLength;
+            uint64_t m_seed;
+        };
+
+    private:
+        static constexpr size_t kSecretConsumeRate = 8;
+        static constexpr size_t kStripesPerBlock = (kSecretSize - kStripeSize) / kSecretConsumeRate;
+        static constexpr size_t kSecretLastAccStart = 7;
+        static constexpr size_t kSecretMergeAccsStart = 11;
+        static constexpr size_t kSecretSizeMin = 136;
+        static constexpr size_t kMidSizeMax = 240;
+        static constexpr size_t kMidSizeStartOffset = 3;
+        static constexpr size_t kMidSizeLastOffset = 17;
+
+        static constexpr uint32_t kPrime32_1 = 0x9E3779B1U;
+        static constexpr uint32_t kPrime32_2 = 0x85EBCA77U;
+        static constexpr uint32_t kPrime32_3 = 0xC2B2AE3DU;
+        static constexpr uint64_t kPrime64_1 = 0x9E3779B185EBCA87ULL;
+        static constexpr uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4FULL;
+        static constexpr uint64_t kPrime64_3 = 0x165667B19E3779F9ULL;
+        static constexpr uint64_t kPrime64_4 = 0x85EBCA77C2B2AE63ULL;
+        static constexpr uint64_t kPrime64_5 = 0x27D4EB2F165667C5ULL;
+        static constexpr uint64_t kPrimeMx1 = 0x165667919E3779F9ULL;
+        static constexpr uint64_t kPrimeMx2 = 0x9FB21C651E98DF25ULL;
+
+        alignas(64) static constexpr uint8_t kSecret[kSecretSize] = {
+            0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+            0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+            0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+            0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+            0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+            0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+            0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+            0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+            0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+            0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+            0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+            0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+        };
+
+        // Primitive helpers
+        static uint32_t readLE32(const uint8_t* p);
+        static uint64_t readLE64(const uint8_t* p);
+        static void writeLE64(uint8_t* p, uint64_t value);
+        static uint32_t swap32(uint32_t x);
+        static uint64_t swap64(uint64_t x);
+        static uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+        static uint32_t rotl32(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+        static XXH128Hash mult64to128(uint64_t lhs, uint64_t rhs);
+        static uint64_t mul128Fold64(uint64_t lhs, uint64_t rhs);
+        static uint64_t xxh64Avalanche(uint64_t h);
+        static uint64_t avalanche(uint64_t h);
+        static uint64_t rrmxmx(uint64_t h, uint64_t length);
+        static uint64_t mix16B(const uint8_t* input, const uint8_t* secret, uint64_t seed);
+        static XXH128Hash mix32B(XXH128Hash acc, const uint8_t* input1, const uint8_t* input2,
+                                 const uint8_t* secret, uint64_t seed);
+
+        // Short inputs (<= 240 bytes)
+        static uint64_t hashShort64(const uint8_t* input, size_t length, uint64_t seed);
+        static XXH128Hash hashShort128(const uint8_t* input, size_t length, uint64_t seed);
+
+        // Long inputs
+        static void initCustomSecret(uint8_t secret[kSecretSize], uint64_t seed);
+        static void initAcc(uint64_t acc[8]);
+        static void accumulate(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes);
+        static void scramble(uint64_t acc[8], const uint8_t* secret);
+        static void accumulateScalar(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes);
+        static void scrambleScalar(uint64_t acc[8], const uint8_t* secret);
+#if defined(GALAY_UTILS_XXH3_AVX2)
+        static void accumulateAvx2(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes);
+        static void scrambleAvx2(uint64_t acc[8], const uint8_t* secret);
+#elif defined(GALAY_UTILS_XXH3_NEON)
+        static void accumulateNeon(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes);
+        static void scrambleNeon(uint64_t acc[8], const uint8_t* secret);
+#endif
+        static void hashLongLoop(uint64_t acc[8], const uint8_t* input, size_t length, const uint8_t* secret);
+        static void consumeStripes(uint64_t acc[8], size_t& stripesSoFar, const uint8_t* input,
+                                   size_t stripes, const uint8_t* secret);
+        static uint64_t mergeAccs(const uint64_t acc[8], const uint8_t* secret, uint64_t start);
+        static uint64_t finishLong64(const uint64_t acc[8], const uint8_t* secret, uint64_t length);
+        static XXH128Hash finishLong128(const uint64_t acc[8], const uint8_t* secret, uint64_t length);
+    };
+
+    /**
+     * @brief 基于 XXH3 的哈希函数对象
+     * @details 字符串类（可转换为 std::string_view）按字节内容哈希；整数、枚举、指针等
+     *          具有唯一对象表示的类型按对象字节哈希。结果跨进程稳定，可直接用作
+     *          `BloomFilter<T, XXH3Hasher>`、`BasicConsistentHash<XXH3Hasher>` 或
+     *          `LruCache<Key, Value, XXH3Hasher>` 的模板参数。
+     */
+    struct XXH3Hasher
+    {
+        using is_transparent = void;
+
+        uint64_t seed = 0;  ///< 种子值
+
+        /**
+         * @brief 计算值的哈希
+         * @tparam T 值类型
+         * @param value 待哈希的值
+         * @return 哈希值
+         */
+        template<typename T>
+        size_t operator()(const T& value) const noexcept
+        {
+            if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                return static_cast<size_t>(XXH3::hash64(std::string_view(value), seed));
+            } else {
+                static_assert(std::has_unique_object_representations_v<T>,
+                              "XXH3Hasher requires a string-like type or a type with unique object representations");
+                return static_cast<size_t>(XXH3::hash64(reinterpret_cast<const uint8_t*>(&value), sizeof(T), seed));
+            }
+        }
+    };
+
+    // Implementation
+
+    inline uint32_t XXH3::swap32(uint32_t x)
+    {
+        return ((x << 24) & 0xff000000U) | ((x << 8) & 0x00ff0000U) |
+               ((x >> 8) & 0x0000ff00U) | ((x >> 24) & 0x000000ffU);
+    }
+
+    inline uint64_t XXH3::swap64(uint64_t x)
+    {
+        return (static_cast<uint64_t>(swap32(static_cast<uint32_t>(x))) << 32) |
+               swap32(static_cast<uint32_t>(x >> 32));
+    }
+
+    inline uint32_t XXH3::readLE32(const uint8_t* p)
+    {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = swap32(value);
+#endif
+        return value;
+    }
+
+    inline uint64_t XXH3::readLE64(const uint8_t* p)
+    {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = swap64(value);
+#endif
+        return value;
+    }
+
+    inline void XXH3::writeLE64(uint8_t* p, uint64_t value)
+    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = swap64(value);
+#endif
+        std::memcpy(p, &value, sizeof(value));
+    }
+
+    inline XXH128Hash XXH3::mult64to128(uint64_t lhs, uint64_t rhs)
+    {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+        return {static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64)};
+#else
+        const uint64_t loLo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+        const uint64_t hiLo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+        const uint64_t loHi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+        const uint64_t hiHi = (lhs >> 32) * (rhs >> 32);
+        const uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+        const uint64_t upper = (hiLo >> 32) + (cross >> 32) + hiHi;
+        const uint64_t lower = (cross << 32) | (loLo & 0xFFFFFFFF);
+        return {lower, upper};
+#endif
+    }
+
+    inline uint64_t XXH3::mul128Fold64(uint64_t lhs, uint64_t rhs)
+    {
+        const XXH128Hash product = mult64to128(lhs, rhs);
+        return product.low ^ product.high;
+    }
+
+    inline uint64_t XXH3::xxh64Avalanche(uint64_t h)
+    {
+        h ^= h >> 33;
+        h *= kPrime64_2;
+        h ^= h >> 29;
+        h *= kPrime64_3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    inline uint64_t XXH3::avalanche(uint64_t h)
+    {
+        h ^= h >> 37;
+        h *= kPrimeMx1;
+        h ^= h >> 32;
+        return h;
+    }
+
+    inline uint64_t XXH3::rrmxmx(uint64_t h, uint64_t length)
+    {
+        h ^= rotl64(h, 49) ^ rotl64(h, 24);
+        h *= kPrimeMx2;
+        h ^= (h >> 35) + length;
+        h *= kPrimeMx2;
+        return h ^ (h >> 28);
+    }
+
+    inline uint64_t XXH3::mix16B(const uint8_t* input, const uint8_t* secret, uint64_t seed)
+    {
+        return mul128Fold64(readLE64(input) ^ (readLE64(secret) + seed),
+                            readLE64(input + 8) ^ (readLE64(secret + 8) - seed));
+    }
+
+    inline XXH128Hash XXH3::mix32B(XXH128Hash acc, const uint8_t* input1, const uint8_t* input2,
+                                   const uint8_t* secret, uint64_t seed)
+    {
+        acc.low += mix16B(input1, secret, seed);
+        acc.low ^= readLE64(input2) + readLE64(input2 + 8);
+        acc.high += mix16B(input2, secret + 16, seed);
+        acc.high ^= readLE64(input1) + readLE64(input1 + 8);
+        return acc;
+    }
+
+    inline uint64_t XXH3::hashShort64(const uint8_t* input, size_t length, uint64_t seed)
+    {
+        const uint8_t* secret = kSecret;
+        if (length > 128) {
+            uint64_t acc = length * kPrime64_1;
+            const size_t rounds = length / 16;
+            for (size_t i = 0; i < 8; ++i) {
+                acc += mix16B(input + 16 * i, secret + 16 * i, seed);
+            }
+            uint64_t accEnd = mix16B(input + length - 16, secret + kSecretSizeMin - kMidSizeLastOffset, seed);
+            acc = avalanche(acc);
+            for (size_t i = 8; i < rounds; ++i) {
+                accEnd += mix16B(input + 16 * i, secret + 16 * (i - 8) + kMidSizeStartOffset, seed);
+            }
+            return avalanche(acc + accEnd);
+        }
+        if (length > 16) {
+            uint64_t acc = length * kPrime64_1;
+            if (length > 32) {
+                if (length > 64) {
+                    if (length > 96) {
+                        acc += mix16B(input + 48, secret + 96, seed);
+                        acc += mix16B(input + length - 64, secret + 112, seed);
+                    }
+                    acc += mix16B(input + 32, secret + 64, seed);
+                    acc += mix16B(input + length - 48, secret + 80, seed);
+                }
+                acc += mix16B(input + 16, secret + 32, seed);
+                acc += mix16B(input + length - 32, secret + 48, seed);
+            }
+            acc += mix16B(input, secret, seed);
+            acc += mix16B(input + length - 16, secret + 16, seed);
+            return avalanche(acc);
+        }
+        if (length > 8) {
+            const uint64_t bitflip1 = (readLE64(secret + 24) ^ readLE64(secret + 32)) + seed;
+            const uint64_t bitflip2 = (readLE64(secret + 40) ^ readLE64(secret + 48)) - seed;
+            const uint64_t inputLo = readLE64(input) ^ bitflip1;
+            const uint64_t inputHi = readLE64(input + length - 8) ^ bitflip2;
+            const uint64_t acc = length + swap64(inputLo) + inputHi + mul128Fold64(inputLo, inputHi);
+            return avalanche(acc);
+        }
+        if (length >= 4) {
+            seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+            const uint32_t input1 = readLE32(input);
+            const uint32_t input2 = readLE32(input + length - 4);
+            const uint64_t bitflip = (readLE64(secret + 8) ^ readLE64(secret + 16)) - seed;
+            const uint64_t input64 = input2 + (static_cast<uint64_t>(input1) << 32);
+            return rrmxmx(input64 ^ bitflip, length);
+        }
+        if (length > 0) {
+            const uint32_t combined = (static_cast<uint32_t>(input[0]) << 16) |
+                                      (static_cast<uint32_t>(input[length >> 1]) << 24) |
+                                      static_cast<uint32_t>(input[length - 1]) |
+                                      (static_cast<uint32_t>(length) << 8);
+            const uint64_t bitflip = (readLE32(secret) ^ readLE32(secret + 4)) + seed;
+            return xxh64Avalanche(static_cast<uint64_t>(combined) ^ bitflip);
+        }
+        return xxh64Avalanche(seed ^ (readLE64(secret + 56) ^ readLE64(secret + 64)));
+    }
+
+    inline XXH128Hash XXH3::hashShort128(const uint8_t* input, size_t length, uint64_t seed)
+    {
+        const uint8_t* secret = kSecret;
+        if (length > 16) {
+            XXH128Hash acc{length * kPrime64_1, 0};
+            if (length > 128) {
+                for (size_t i = 32; i < 160; i += 32) {
+                    acc = mix32B(acc, input + i - 32, input + i - 16, secret + i - 32, seed);
+                }
+                acc.low = avalanche(acc.low);
+                acc.high = avalanche(acc.high);
+                for (size_t i = 160; i <= length; i += 32) {
+                    acc = mix32B(acc, input + i - 32, input + i - 16,
+                                 secret + kMidSizeStartOffset + i - 160, seed);
+                }
+                acc = mix32B(acc, input + length - 16, input + length - 32,
+                             secret + kSecretSizeMin - kMidSizeLastOffset - 16, 0 - seed);
+            } else {
+                if (length > 32) {
+                    if (length > 64) {
+                        if (length > 96) {
+                            acc = mix32B(acc, input + 48, input + length - 64, secret + 96, seed);
+                        }
+                        acc = mix32B(acc, input + 32, input + length - 48, secret + 64, seed);
+                    }
+                    acc = mix32B(acc, input + 16, input + length - 32, secret + 32, seed);
+                }
+                acc = mix32B(acc, input, input + length - 16, secret, seed);
+            }
+            XXH128Hash result;
+            result.low = avalanche(acc.low + acc.high);
+            result.high = 0 - avalanche((acc.low * kPrime64_1) + (acc.high * kPrime64_4) +
+                                        ((length - seed) * kPrime64_2));
+            return result;
+        }
+        if (length > 8) {
+            const uint64_t bitflipl = (readLE64(secret + 32) ^ readLE64(secret + 40)) - seed;
+            const uint64_t bitfliph = (readLE64(secret + 48) ^ readLE64(secret + 56)) + seed;
+            const uint64_t inputLo = readLE64(input);
+            uint64_t inputHi = readLE64(input + length - 8);
+            XXH128Hash m128 = mult64to128(inputLo ^ inputHi ^ bitflipl, kPrime64_1);
+            m128.low += static_cast<uint64_t>(length - 1) << 54;
+            inputHi ^= bitfliph;
+            m128.high += inputHi + static_cast<uint64_t>(static_cast<uint32_t>(inputHi)) * (kPrime32_2 - 1);
+            m128.low ^= swap64(m128.high);
+            XXH128Hash h128 = mult64to128(m128.low, kPrime64_2);
+            h128.high += m128.high * kPrime64_2;
+            h128.low = avalanche(h128.low);
+            h128.high = avalanche(h128.high);
+            return h128;
+        }
+        if (length >= 4) {
+            seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+            const uint32_t inputLo = readLE32(input);
+            const uint32_t inputHi = readLE32(input + length - 4);
+            const uint64_t input64 = inputLo + (static_cast<uint64_t>(inputHi) << 32);
+            const uint64_t bitflip = (readLE64(secret + 16) ^ readLE64(secret + 24)) + seed;
+            XXH128Hash m128 = mult64to128(input64 ^ bitflip, kPrime64_1 + (length << 2));
+            m128.high += m128.low << 1;
+            m128.low ^= m128.high >> 3;
+            m128.low ^= m128.low >> 35;
+            m128.low *= kPrimeMx2;
+            m128.low ^= m128.low >> 28;
+            m128.high = avalanche(m128.high);
+            return m128;
+        }
+        if (length > 0) {
+            const uint32_t combinedl = (static_cast<uint32_t>(input[0]) << 16) |
+                                       (static_cast<uint32_t>(input[length >> 1]) << 24) |
+                                       static_cast<uint32_t>(input[length - 1]) |
+                                       (static_cast<uint32_t>(length) << 8);
+            const uint32_t combinedh = rotl32(swap32(combinedl), 13);
+            const uint64_t bitflipl = (readLE32(secret) ^ readLE32(secret + 4)) + seed;
+            const uint64_t bitfliph = (readLE32(secret + 8) ^ readLE32(secret + 12)) - seed;
+            return {xxh64Avalanche(static_cast<uint64_t>(combinedl) ^ bitflipl),
+                    xxh64Avalanche(static_cast<uint64_t>(combinedh) ^ bitfliph)};
+        }
+        const uint64_t bitflipl = readLE64(secret + 64) ^ readLE64(secret + 72);
+        const uint64_t bitfliph = readLE64(secret + 80) ^ readLE64(secret + 88);
+        return {xxh64Avalanche(seed ^ bitflipl), xxh64Avalanche(seed ^ bitfliph)};
+    }
+
+    inline void XXH3::initCustomSecret(uint8_t secret[kSecretSize], uint64_t seed)
+    {
+        for (size_t i = 0; i < kSecretSize / 16; ++i) {
+            writeLE64(secret + 16 * i, readLE64(kSecret + 16 * i) + seed);
+            writeLE64(secret + 16 * i + 8, readLE64(kSecret + 16 * i + 8) - seed);
+        }
+    }
+
+    inline void XXH3::initAcc(uint64_t acc[8])
+    {
+        acc[0] = kPrime32_3;
+        acc[1] = kPrime64_1;
+        acc[2] = kPrime64_2;
+        acc[3] = kPrime64_3;
+        acc[4] = kPrime64_4;
+        acc[5] = kPrime32_2;
+        acc[6] = kPrime64_5;
+        acc[7] = kPrime32_1;
+    }
+
+    inline void XXH3::accumulateScalar(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes)
+    {
+        for (size_t n = 0; n < stripes; ++n) {
+            const uint8_t* in = input + n * kStripeSize;
+            const uint8_t* key = secret + n * kSecretConsumeRate;
+            for (size_t lane = 0; lane < 8; ++lane) {
+                const uint64_t dataVal = readLE64(in + lane * 8);
+                const uint64_t dataKey = dataVal ^ readLE64(key + lane * 8);
+                acc[lane ^ 1] += dataVal;
+                acc[lane] += (dataKey & 0xFFFFFFFF) * (dataKey >> 32);
+            }
+        }
+    }
+
+    inline void XXH3::scrambleScalar(uint64_t acc[8], const uint8_t* secret)
+    {
+        for (size_t lane = 0; lane < 8; ++lane) {
+            uint64_t value = acc[lane];
+            value ^= value >> 47;
+            value ^= readLE64(secret + lane * 8);
+            value *= kPrime32_1;
+            acc[lane] = value;
+        }
+    }
+
+#if defined(GALAY_UTILS_XXH3_AVX2)
+    __attribute__((target("avx2")))
+    inline void XXH3::accumulateAvx2(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes)
+    {
+        __m256i acc0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc));
+        __m256i acc1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4));
+        for (size_t n = 0; n < stripes; ++n) {
+            const auto* in = reinterpret_cast<const __m256i*>(input + n * kStripeSize);
+            const auto* key = reinterpret_cast<const __m256i*>(secret + n * kSecretConsumeRate);
+
+            const __m256i data0 = _mm256_loadu_si256(in);
+            const __m256i dataKey0 = _mm256_xor_si256(data0, _mm256_loadu_si256(key));
+            const __m256i product0 = _mm256_mul_epu32(dataKey0, _mm256_srli_epi64(dataKey0, 32));
+            acc0 = _mm256_add_epi64(product0,
+                _mm256_add_epi64(acc0, _mm256_shuffle_epi32(data0, _MM_SHUFFLE(1, 0, 3, 2))));
+
+            const __m256i data1 = _mm256_loadu_si256(in + 1);
+            const __m256i dataKey1 = _mm256_xor_si256(data1, _mm256_loadu_si256(key + 1));
+            const __m256i product1 = _mm256_mul_epu32(dataKey1, _mm256_srli_epi64(dataKey1, 32));
+            acc1 = _mm256_add_epi64(product1,
+                _mm256_add_epi64(acc1, _mm256_shuffle_epi32(data1, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), acc0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4), acc1);
+    }
+
+    __attribute__((target("avx2")))
+    inline void XXH3::scrambleAvx2(uint64_t acc[8], const uint8_t* secret)
+    {
+        const __m256i prime = _mm256_set1_epi32(static_cast<int>(kPrime32_1));
+        for (size_t i = 0; i < 2; ++i) {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4 * i));
+            const __m256i mixed = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+            const __m256i dataKey = _mm256_xor_si256(mixed,
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret + 32 * i)));
+            const __m256i productLo = _mm256_mul_epu32(dataKey, prime);
+            const __m256i productHi = _mm256_mul_epu32(_mm256_srli_epi64(dataKey, 32), prime);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4 * i),
+                                _mm256_add_epi64(productLo, _mm256_slli_epi64(productHi, 32)));
+        }
+    }
+#elif defined(GALAY_UTILS_XXH3_NEON)
+    inline void XXH3::accumulateNeon(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes)
+    {
+        uint64x2_t accs[4];
+        for (size_t i = 0; i < 4; ++i) {
+            accs[i] = vld1q_u64(acc + 2 * i);
+        }
+        for (size_t n = 0; n < stripes; ++n) {
+            const uint8_t* in = input + n * kStripeSize;
+            const uint8_t* key = secret + n * kSecretConsumeRate;
+            for (size_t i = 0; i < 4; ++i) {
+                const uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(in + 16 * i));
+                const uint64x2_t dataKey = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(key + 16 * i)));
+                accs[i] = vaddq_u64(accs[i], vextq_u64(data, data, 1));
+                accs[i] = vmlal_u32(accs[i], vmovn_u64(dataKey), vshrn_n_u64(dataKey, 32));
+            }
+        }
+        for (size_t i = 0; i < 4; ++i) {
+            vst1q_u64(acc + 2 * i, accs[i]);
+        }
+    }
+
+    inline void XXH3::scrambleNeon(uint64_t acc[8], const uint8_t* secret)
+    {
+        const uint32x2_t prime = vdup_n_u32(kPrime32_1);
+        for (size_t i = 0; i < 4; ++i) {
+            uint64x2_t value = vld1q_u64(acc + 2 * i);
+            value = veorq_u64(value, vshrq_n_u64(value, 47));
+            value = veorq_u64(value, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+            const uint64x2_t productHi = vshlq_n_u64(vmull_u32(vshrn_n_u64(value, 32), prime), 32);
+            vst1q_u64(acc + 2 * i, vmlal_u32(productHi, vmovn_u64(value), prime));
+        }
+    }
+#endif
+
+    inline XXH3Backend XXH3::backend()
+    {
+#if defined(GALAY_UTILS_XXH3_AVX2)
+        static const XXH3Backend selected =
+            __builtin_cpu_supports("avx2") ? XXH3Backend::Avx2 : XXH3Backend::Scalar;
+        return selected;
+#elif defined(GALAY_UTILS_XXH3_NEON)
+        return XXH3Backend::Neon;
+#else
+        return XXH3Backend::Scalar;
+#endif
+    }
+
+    inline void XXH3::accumulate(uint64_t acc[8], const uint8_t* input, const uint8_t* secret, size_t stripes)
+    {
+#if defined(GALAY_UTILS_XXH3_AVX2)
+        if (backend() == XXH3Backend::Avx2) {
+            accumulateAvx2(acc, input, secret, stripes);
+            return;
+        }
+#elif defined(GALAY_UTILS_XXH3_NEON)
+        accumulateNeon(acc, input, secret, stripes);
+        return;
+#endif
+        accumulateScalar(acc, input, secret, stripes);
+    }
+
+    inline void XXH3::scramble(uint64_t acc[8], const uint8_t* secret)
+    {
+#if defined(GALAY_UTILS_XXH3_AVX2)
+        if (backend() == XXH3Backend::Avx2) {
+            scrambleAvx2(acc, secret);
+            return;
+        }
+#elif defined(GALAY_UTILS_XXH3_NEON)
+        scrambleNeon(acc, secret);
+        return;
+#endif
+        scrambleScalar(acc, secret);
+    }
+
+    inline void XXH3::hashLongLoop(uint64_t acc[8], const uint8_t* input, size_t length, const uint8_t* secret)
+    {
+        constexpr size_t blockLength = kStripeSize * kStripesPerBlock;
+        const size_t blocks = (length - 1) / blockLength;
+        for (size_t n = 0; n < blocks; ++n) {
+            accumulate(acc, input + n * blockLength, secret, kStripesPerBlock);
+            scramble(acc, secret + kSecretSize - kStripeSize);
+        }
+
+        const size_t stripes = ((length - 1) - blockLength * blocks) / kStripeSize;
+        accumulate(acc, input + blocks * blockLength, secret, stripes);
+        accumulate(acc, input + length - kStripeSize, secret + kSecretSize - kStripeSize - kSecretLastAccStart, 1);
+    }
+
+    inline void XXH3::consumeStripes(uint64_t acc[8], size_t& stripesSoFar, const uint8_t* input,
+                                     size_t stripes, const uint8_t* secret)
+    {
+        const uint8_t* key = secret + stripesSoFar * kSecretConsumeRate;
+        if (stripes >= kStripesPerBlock - stripesSoFar) {
+            size_t stripesThisRound = kStripesPerBlock - stripesSoFar;
+            do {
+                accumulate(acc, input, key, stripesThisRound);
+                scramble(acc, secret + kSecretSize - kStripeSize);
+                input += stripesThisRound * kStripeSize;
+                stripes -= stripesThisRound;
+                stripesThisRound = kStripesPerBlock;
+                key = secret;
+            } while (stripes >= kStripesPerBlock);
+            stripesSoFar = 0;
+        }
+        if (stripes > 0) {
+            accumulate(acc, input, key, stripes);
+            stripesSoFar += stripes;
+        }
+    }
+
+    inline uint64_t XXH3::mergeAccs(const uint64_t acc[8], const uint8_t* secret, uint64_t start)
+    {
+        uint64_t result = start;
+        for (size_t i = 0; i < 4; ++i) {
+            result += mul128Fold64(acc[2 * i] ^ readLE64(secret + 16 * i),
+                                   acc[2 * i + 1] ^ readLE64(secret + 16 * i + 8));
+        }
+        return avalanche(result);
+    }
+
+    inline uint64_t XXH3::finishLong64(const uint64_t acc[8], const uint8_t* secret, uint64_t length)
+    {
+        return mergeAccs(acc, secret + kSecretMergeAccsStart, length * kPrime64_1);
+    }
+
+    inline XXH128Hash XXH3::finishLong128(const uint64_t acc[8], const uint8_t* secret, uint64_t length)
+    {
+        return {mergeAccs(acc, secret + kSecretMergeAccsStart, length * kPrime64_1),
+                mergeAccs(acc, secret + kSecretSize - 64 - kSecretMergeAccsStart, ~(length * kPrime64_2))};
+    }
+
+    inline uint64_t XXH3::hash64(const uint8_t* input, size_t length, uint64_t seed)
+    {
+        if (length <= kMidSizeMax) {
+            return hashShort64(input, length, seed);
+        }
+        alignas(64) uint8_t custom[kSecretSize];
+        const uint8_t* secret = kSecret;
+        if (seed != 0) {
+            initCustomSecret(custom, seed);
+            secret = custom;
+        }
+        alignas(64) uint64_t acc[8];
+        initAcc(acc);
+        hashLongLoop(acc, input, length, secret);
+        return finishLong64(acc, secret, length);
+    }
+
+    inline uint64_t XXH3::hash64(std::string_view input, uint64_t seed)
+    {
+        return hash64(reinterpret_cast<const uint8_t*>(input.data()), input.size(), seed);
+    }
+
+    inline XXH128Hash XXH3::hash128(const uint8_t* input, size_t length, uint64_t seed)
+    {
+        if (length <= kMidSizeMax) {
+            return hashShort128(input, length, seed);
+        }
+        alignas(64) uint8_t custom[kSecretSize];
+        const uint8_t* secret = kSecret;
+        if (seed != 0) {
+            initCustomSecret(custom, seed);
+            secret = custom;
+        }
+        alignas(64) uint64_t acc[8];
+        initAcc(acc);
+        hashLongLoop(acc, input, length, secret);
+        return finishLong128(acc, secret, length);
+    }
+
+    inline XXH128Hash XXH3::hash128(std::string_view input, uint64_t seed)
+    {
+        return hash128(reinterpret_cast<const uint8_t*>(input.data()), input.size(), seed);
+    }
+
+    inline void XXH3::State::reset(uint64_t seed)
+    {
+        initAcc(m_acc);
+        if (seed == 0) {
+            std::memcpy(m_secret, kSecret, kSecretSize);
+        } else {
+            initCustomSecret(m_secret, seed);
+        }
+        m_bufferedSize = 0;
+        m_stripesSoFar = 0;
+        m_totalLength = 0;
+        m_seed = seed;
+    }
+
+    inline void XXH3::State::update(const uint8_t* input, size_t length)
+    {
+        if (length == 0) {
+            return;
+        }
+        const uint8_t* const end = input + length;
+        m_totalLength += length;
+
+        // 缓冲区未满时只拷贝；最后一个条带总是留在缓冲区，供 digest 处理
+        if (length <= kBufferSize && m_bufferedSize + length <= kBufferSize) {
+            std::memcpy(m_buffer + m_bufferedSize, input, length);
+            m_bufferedSize += length;
+            return;
+        }
+
+        if (m_bufferedSize != 0) {
+            const size_t loadSize = kBufferSize - m_bufferedSize;
+            std::memcpy(m_buffer + m_bufferedSize, input, loadSize);
+            input += loadSize;
+            consumeStripes(m_acc, m_stripesSoFar, m_buffer, kBufferSize / kStripeSize, m_secret);
+            m_bufferedSize = 0;
+        }
+
+        // 大块输入直接从调用方内存累加，无需经过缓冲区
+        if (static_cast<size_t>(end - input) > kBufferSize) {
+            const size_t stripes = static_cast<size_t>(end - 1 - input) / kStripeSize;
+            consumeStripes(m_acc, m_stripesSoFar, input, stripes, m_secret);
+            input += stripes * kStripeSize;
+            std::memcpy(m_buffer + kBufferSize - kStripeSize, input - kStripeSize, kStripeSize);
+        }
+
+        std::memcpy(m_buffer, input, static_cast<size_t>(end - input));
+        m_bufferedSize = static_cast<size_t>(end - input);
+    }
+
+    inline void XXH3::State::digestLong(uint64_t acc[8]) const
+    {
+        uint8_t lastStripe[kStripeSize];
+        const uint8_t* lastStripePtr;
+        std::memcpy(acc, m_acc, sizeof(m_acc));
+        if (m_bufferedSize >= kStripeSize) {
+            const size_t stripes = (m_bufferedSize - 1) / kStripeSize;
+            size_t stripesSoFar = m_stripesSoFar;
+            consumeStripes(acc, stripesSoFar, m_buffer, stripes, m_secret);
+            lastStripePtr = m_buffer + m_bufferedSize - kStripeSize;
+        } else {
+            // 不足一个条带时，从缓冲区尾部（上一轮保存的数据）补齐
+            const size_t catchup = kStripeSize - m_bufferedSize;
+            std::memcpy(lastStripe, m_buffer + kBufferSize - catchup, catchup);
+            std::memcpy(lastStripe + catchup, m_buffer, m_bufferedSize);
+            lastStripePtr = lastStripe;
+        }
+        accumulate(acc, lastStripePtr, m_secret + kSecretSize - kStripeSize - kSecretLastAccStart, 1);
+    }
+
+    inline uint64_t XXH3::State::digest64() const
+    {
+        if (m_totalLength > kMidSizeMax) {
+            alignas(64) uint64_t acc[8];
+            digestLong(acc);
+            return finishLong64(acc, m_secret, m_totalLength);
+        }
+        return hashShort64(m_buffer, static_cast<size_t>(m_totalLength), m_seed);
+    }
+
+    inline XXH128Hash XXH3::State::digest128() const
+    {
+        if (m_totalLength > kMidSizeMax) {
+            alignas(64) uint64_t acc[8];
+            digestLong(acc);
+            return finishLong128(acc, m_secret, m_totalLength);
+        }
+        return hashShort128(m_buffer, static_cast<size_t>(m_totalLength), m_seed);
+    }
+} // namespace galay::utils
+
+#endif // GALAY_UTILS_XXHASH3_H
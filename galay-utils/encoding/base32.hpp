@@ -0,0 +1,218 @@
+/**
+ * @file base32.hpp
+ * @brief Base32 编解码（RFC 4648）
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 使用 RFC 4648 标准字母表 A-Z2-7，面向 TOTP 密钥与人类可读 ID。
+ *          编码可选 '=' 填充；解码接受大小写字母，填充可省略，但出现时必须补齐到 8 的倍数。
+ */
+
+#ifndef GALAY_UTILS_BASE32_H
+#define GALAY_UTILS_BASE32_H
+
+#include "galay-utils/encoding/codec.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace galay::utils
+{
+    namespace detail
+    {
+        inline constexpr char base32Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+        /// ASCII 到 5 位值，大小写均可，非法字符为 0xFF
+        inline constexpr std::array<uint8_t, 256> base32DecodeTable = [] {
+            std::array<uint8_t, 256> table{};
+            for (auto& value : table) {
+                value = 0xFF;
+            }
+            for (uint8_t i = 0; i < 32; ++i) {
+                const char c = base32Alphabet[i];
+                table[static_cast<unsigned char>(c)] = i;
+                if (c >= 'A' && c <= 'Z') {
+                    table[static_cast<unsigned char>(c - 'A' + 'a')] = i;
+                }
+            }
+            return table;
+        }();
+
+        /// 余下 n 个字符可构成的字节数；1、3、6 个字符无法对齐到字节边界
+        inline constexpr size_t base32TailBytes(size_t chars)
+        {
+            constexpr uint8_t bytes[8] = {0, 0xFF, 1, 0xFF, 2, 3, 0xFF, 4};
+            return bytes[chars];
+        }
+    }
+
+    /**
+     * @brief Base32 编解码（RFC 4648）
+     * @details *Into 接口写入调用方缓冲区、不抛异常；encode() / decode() 为返回容器的便捷包装。
+     */
+    class Base32Codec
+    {
+    public:
+        /**
+         * @brief 计算编码后的字符数
+         * @param length 原始字节数
+         * @param padding 是否补 '=' 到 8 的倍数
+         */
+        static constexpr size_t encodedLength(size_t length, bool padding = true)
+        {
+            return padding ? (length + 4) / 5 * 8 : (length * 8 + 4) / 5;
+        }
+
+        /**
+         * @brief 计算解码后的字节数（忽略末尾填充）
+         * @param input Base32 字符串
+         */
+        static constexpr size_t decodedLength(std::string_view input)
+        {
+            size_t length = input.size();
+            while (length > 0 && input[length - 1] == '=') {
+                --length;
+            }
+            const size_t tail = detail::base32TailBytes(length % 8);
+            return length / 8 * 5 + (tail == 0xFF ? 0 : tail);
+        }
+
+        /**
+         * @brief 编码到调用方缓冲区
+         * @param input 原始字节
+         * @param output 输出缓冲区，至少 encodedLength(input.size(), padding) 字节
+         * @param padding 是否补 '=' 到 8 的倍数
+         * @return 成功时 length 为写入字符数；缓冲区不足时返回 OutputTooSmall 且不写入
+         */
+        static CodecResult encodeInto(std::span<const uint8_t> input, std::span<char> output,
+                                      bool padding = true)
+        {
+            const size_t required = encodedLength(input.size(), padding);
+            if (output.size() < required) {
+                return {0, 0, CodecStatus::OutputTooSmall};
+            }
+            const uint8_t* in = input.data();
+            char* out = output.data();
+            const size_t blocks = input.size() / 5;
+            for (size_t i = 0; i < blocks; ++i, in += 5, out += 8) {
+                const uint64_t value = (static_cast<uint64_t>(in[0]) << 32)
+                                     | (static_cast<uint64_t>(in[1]) << 24)
+                                     | (static_cast<uint64_t>(in[2]) << 16)
+                                     | (static_cast<uint64_t>(in[3]) << 8)
+                                     | in[4];
+                for (int j = 0; j < 8; ++j) {
+                    out[j] = detail::base32Alphabet[(value >> (35 - j * 5)) & 0x1F];
+                }
+            }
+            const size_t rest = input.size() - blocks * 5;
+            if (rest > 0) {
+                uint64_t value = 0;
+                for (size_t j = 0; j < rest; ++j) {
+                    value |= static_cast<uint64_t>(in[j]) << (32 - j * 8);
+                }
+                const size_t chars = (rest * 8 + 4) / 5;
+                for (size_t j = 0; j < chars; ++j) {
+                    out[j] = detail::base32Alphabet[(value >> (35 - j * 5)) & 0x1F];
+                }
+                if (padding) {
+                    for (size_t j = chars; j < 8; ++j) {
+                        out[j] = '=';
+                    }
+                }
+            }
+            return {required, input.size(), CodecStatus::Ok};
+        }
+
+        /**
+         * @brief 解码到调用方缓冲区
+         * @param input Base32 字符串，大小写均可，末尾填充可省略
+         * @param output 输出缓冲区，至少 decodedLength(input) 字节
+         * @return 失败时 position 为出错字符下标，length 为出错前已写入的字节数
+         */
+        static CodecResult decodeInto(std::string_view input, std::span<uint8_t> output)
+        {
+            size_t length = input.size();
+            while (length > 0 && input[length - 1] == '=') {
+                --length;
+            }
+            const size_t pads = input.size() - length;
+            if (const size_t inner = input.substr(0, length).find('='); inner != std::string_view::npos) {
+                return {0, inner, CodecStatus::InvalidPadding};
+            }
+            if (pads > 0 && (pads > 6 || input.size() % 8 != 0)) {
+                return {0, length, CodecStatus::InvalidPadding};
+            }
+            const size_t tail = detail::base32TailBytes(length % 8);
+            if (tail == 0xFF) {
+                return {0, length - 1, CodecStatus::InvalidLength};
+            }
+            const size_t required = length / 8 * 5 + tail;
+            if (output.size() < required) {
+                return {0, 0, CodecStatus::OutputTooSmall};
+            }
+
+            uint8_t* out = output.data();
+            size_t written = 0;
+            for (size_t pos = 0; pos < length; pos += 8) {
+                const size_t chars = std::min<size_t>(8, length - pos);
+                uint64_t value = 0;
+                for (size_t j = 0; j < chars; ++j) {
+                    const uint8_t v = detail::base32DecodeTable[static_cast<unsigned char>(input[pos + j])];
+                    if (v == 0xFF) {
+                        return {written, pos + j, CodecStatus::InvalidCharacter};
+                    }
+                    value |= static_cast<uint64_t>(v) << (35 - j * 5);
+                }
+                const size_t bytes = chars == 8 ? 5 : detail::base32TailBytes(chars);
+                for (size_t j = 0; j < bytes; ++j) {
+                    out[written + j] = static_cast<uint8_t>(value >> (32 - j * 8));
+                }
+                written += bytes;
+            }
+            return {written, input.size(), CodecStatus::Ok};
+        }
+
+        /**
+         * @brief 编码为字符串
+         * @param input 原始字节
+         * @param padding 是否补 '=' 到 8 的倍数
+         */
+        static std::string encode(std::span<const uint8_t> input, bool padding = true)
+        {
+            std::string result(encodedLength(input.size(), padding), '\0');
+            encodeInto(input, result, padding);
+            return result;
+        }
+
+        /**
+         * @brief 编码字符串的原始字节
+         */
+        static std::string encode(std::string_view input, bool padding = true)
+        {
+            return encode(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(input.data()), input.size()),
+                          padding);
+        }
+
+        /**
+         * @brief 解码为字节数组
+         * @param input Base32 字符串
+         * @return 解码后的字节
+         * @throws std::runtime_error 输入包含非法字符、填充或长度
+         */
+        static std::vector<uint8_t> decode(std::string_view input)
+        {
+            std::vector<uint8_t> result(decodedLength(input));
+            if (!decodeInto(input, result)) {
+                throw std::runtime_error("Input is not valid base32-encoded data.");
+            }
+            return result;
+        }
+    };
+}
+
+#endif // GALAY_UTILS_BASE32_H
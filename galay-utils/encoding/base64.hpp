@@ -6,18 +6,22 @@
  *
  * @details 提供 Base64 编码和解码功能，支持标准 Base64 和 URL 安全 Base64 变体，
  *          以及 PEM 和 MIME 格式的编码。支持 C++17 的 string_view 接口。
+ *          块编解码在 x86-64 上运行时分派 AVX2 / SSSE3，在 AArch64 上使用 NEON；
+ *          提供写入调用方缓冲区的 span 接口，以及面向分块 MIME 正文的流式编解码器。
  */
 
 #ifndef GALAY_UTILS_BASE64_H
 #define GALAY_UTILS_BASE64_H
 
+#include "galay-utils/common/defn.hpp"
+#include "galay-utils/encoding/codec.hpp"
 #include <string>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
 #include <stdexcept>
-
-#if __cplusplus >= 201703L
 #include <string_view>
-#endif
 
 namespace galay::utils
 {
@@ -53,10 +57,346 @@ namespace galay::utils
         0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
     };
 
+    /// Base64 结果状态，与其他编解码共用 CodecStatus
+    using Base64Status = CodecStatus;
+    /// Base64 span 接口与流式编解码器的返回值
+    using Base64Result = CodecResult;
+    /// Base64 块编解码使用的指令集
+    using Base64Backend = CodecBackend;
+
+    namespace detail
+    {
+        inline constexpr bool base64IsSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        // 兼容部分 URL-safe 变体使用 '.' 作为填充
+        inline constexpr bool base64IsPad(char c)
+        {
+            return c == '=' || c == '.';
+        }
+
+        inline Base64Backend base64SelectBackend()
+        {
+            return codecSelectBackend();
+        }
+
+        /// 编码 triples 组 3 字节输入，写出 triples * 4 个字符
+        inline void base64EncodeScalar(const uint8_t* in, size_t triples, char* out, bool url)
+        {
+            const char* alphabet = base64_chars[url ? 1 : 0];
+            for (size_t i = 0; i < triples; ++i) {
+                const uint32_t value = (static_cast<uint32_t>(in[0]) << 16)
+                                     | (static_cast<uint32_t>(in[1]) << 8)
+                                     | in[2];
+                out[0] = alphabet[value >> 18];
+                out[1] = alphabet[(value >> 12) & 0x3F];
+                out[2] = alphabet[(value >> 6) & 0x3F];
+                out[3] = alphabet[value & 0x3F];
+                in += 3;
+                out += 4;
+            }
+        }
+
+        /// 编码 1 或 2 字节的末尾输入，写出 4 个字符（含 '=' 填充）
+        inline void base64EncodeTail(const uint8_t* in, size_t length, char* out, bool url)
+        {
+            const char* alphabet = base64_chars[url ? 1 : 0];
+            const uint32_t value = (static_cast<uint32_t>(in[0]) << 16)
+                                 | (length > 1 ? static_cast<uint32_t>(in[1]) << 8 : 0);
+            out[0] = alphabet[value >> 18];
+            out[1] = alphabet[(value >> 12) & 0x3F];
+            out[2] = length > 1 ? alphabet[(value >> 6) & 0x3F] : '=';
+            out[3] = '=';
+        }
+
+        /// 解码 quads 组 4 字符输入，遇到含非字母表字符的分组时停止，返回成功解码的分组数
+        inline size_t base64DecodeScalar(const char* in, size_t quads, uint8_t* out)
+        {
+            for (size_t i = 0; i < quads; ++i) {
+                const uint32_t a = decode_table[static_cast<uint8_t>(in[0])];
+                const uint32_t b = decode_table[static_cast<uint8_t>(in[1])];
+                const uint32_t c = decode_table[static_cast<uint8_t>(in[2])];
+                const uint32_t d = decode_table[static_cast<uint8_t>(in[3])];
+                if ((a | b | c | d) & 0x80) {
+                    return i;
+                }
+                const uint32_t value = (a << 18) | (b << 12) | (c << 6) | d;
+                out[0] = static_cast<uint8_t>(value >> 16);
+                out[1] = static_cast<uint8_t>(value >> 8);
+                out[2] = static_cast<uint8_t>(value);
+                in += 4;
+                out += 3;
+            }
+            return quads;
+        }
+
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+        // 编码：Muła 重排 + mulhi/mullo 拆出 6 位索引，再按区间偏移表 pshufb 转为 ASCII。
+        // 解码：半字节查表校验并求偏移，maddubs/madd 合并为 24 位后重排。
+        // 解码同时接受标准与 URL-safe 字母表，与 decode_table 一致。
+
+        __attribute__((target("ssse3")))
+        inline size_t base64EncodeSsse3(const uint8_t* in, size_t triples, char* out, bool url)
+        {
+            const __m128i shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+            const __m128i lut = _mm_setr_epi8(
+                'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '0' - 52, '0' - 52, url ? '-' - 62 : '+' - 62, url ? '_' - 63 : '/' - 63, 'A', 0, 0);
+            size_t done = 0;
+            // 每轮加载 16 字节、消费 12 字节
+            while (triples - done >= 6) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done * 3));
+                v = _mm_shuffle_epi8(v, shuffle);
+                const __m128i hi = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+                                                   _mm_set1_epi32(0x04000040));
+                const __m128i lo = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+                                                   _mm_set1_epi32(0x01000010));
+                const __m128i indices = _mm_or_si128(hi, lo);
+                __m128i offset = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+                offset = _mm_or_si128(offset, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices),
+                                                            _mm_set1_epi8(13)));
+                const __m128i chars = _mm_add_epi8(_mm_shuffle_epi8(lut, offset), indices);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done * 4), chars);
+                done += 4;
+            }
+            return done;
+        }
+
+        __attribute__((target("avx2")))
+        inline size_t base64EncodeAvx2(const uint8_t* in, size_t triples, char* out, bool url)
+        {
+            const __m256i shuffle = _mm256_setr_epi8(
+                1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+            const char plus = url ? '-' - 62 : '+' - 62;
+            const char slash = url ? '_' - 63 : '/' - 63;
+            const __m256i lut = _mm256_setr_epi8(
+                'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '0' - 52, '0' - 52, plus, slash, 'A', 0, 0,
+                'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '0' - 52, '0' - 52, plus, slash, 'A', 0, 0);
+            size_t done = 0;
+            // 每轮从 src 与 src + 12 各加载 16 字节、消费 24 字节
+            while (triples - done >= 10) {
+                const uint8_t* src = in + done * 3;
+                __m256i v = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 12)), 1);
+                v = _mm256_shuffle_epi8(v, shuffle);
+                const __m256i hi = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)),
+                                                      _mm256_set1_epi32(0x04000040));
+                const __m256i lo = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)),
+                                                      _mm256_set1_epi32(0x01000010));
+                const __m256i indices = _mm256_or_si256(hi, lo);
+                __m256i offset = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+                offset = _mm256_or_si256(offset, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices),
+                                                                  _mm256_set1_epi8(13)));
+                const __m256i chars = _mm256_add_epi8(_mm256_shuffle_epi8(lut, offset), indices);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done * 4), chars);
+                done += 8;
+            }
+            return done;
+        }
+
+        // 解码校验：按高 / 低半字节查表，两表按位与非零即为非法字符。
+        // 高半字节分类 bit0=0x2?、bit1=0x3?、bit2=0x4?/0x6?、bit3=0x5?、bit4=0x7?、bit5=其余；
+        // 低半字节表记录该低半字节在哪些分类中非法。
+        // 偏移按高半字节查表；'/'、'-'、'_' 与 '+' 或字母同组，用比较结果（-1）把索引挪到
+        // 空闲槽位：'/' -> 1，'-' -> 0，'_' -> 8，避免额外常量占用寄存器。
+#define GALAY_UTILS_BASE64_DECODE_LUT_LO \
+    0x25, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x23, 0x3A, 0x3B, 0x3A, 0x3B, 0x32
+#define GALAY_UTILS_BASE64_DECODE_LUT_HI \
+    0x20, 0x20, 0x01, 0x02, 0x04, 0x08, 0x04, 0x10, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20
+#define GALAY_UTILS_BASE64_DECODE_LUT_ROLL \
+    17, 16, 19, 4, -65, -65, -71, -71, -32, 0, 0, 0, 0, 0, 0, 0
+
+        __attribute__((target("ssse3")))
+        inline size_t base64DecodeSsse3(const char* in, size_t quads, uint8_t* out)
+        {
+            const __m128i lutLo = _mm_setr_epi8(GALAY_UTILS_BASE64_DECODE_LUT_LO);
+            const __m128i lutHi = _mm_setr_epi8(GALAY_UTILS_BASE64_DECODE_LUT_HI);
+            const __m128i lutRoll = _mm_setr_epi8(GALAY_UTILS_BASE64_DECODE_LUT_ROLL);
+            const __m128i nibble = _mm_set1_epi8(0x0F);
+            const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+            size_t done = 0;
+            while (quads - done >= 4) {
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done * 4));
+                const __m128i hi = _mm_and_si128(_mm_srli_epi32(c, 4), nibble);
+                const __m128i lo = _mm_and_si128(c, nibble);
+                const __m128i bad = _mm_and_si128(_mm_shuffle_epi8(lutLo, lo), _mm_shuffle_epi8(lutHi, hi));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(bad, _mm_setzero_si128())) != 0xFFFF) {
+                    break;
+                }
+                const __m128i isMinus = _mm_cmpeq_epi8(c, _mm_set1_epi8('-'));
+                const __m128i isUnderscore = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+                __m128i index = _mm_add_epi8(hi, _mm_cmpeq_epi8(c, _mm_set1_epi8('/')));
+                index = _mm_add_epi8(index, _mm_add_epi8(isMinus, isMinus));
+                index = _mm_sub_epi8(index, _mm_add_epi8(isUnderscore, _mm_add_epi8(isUnderscore, isUnderscore)));
+                const __m128i values = _mm_add_epi8(c, _mm_shuffle_epi8(lutRoll, index));
+                const __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+                const __m128i packed = _mm_shuffle_epi8(_mm_madd_epi16(merged, _mm_set1_epi32(0x00011000)), pack);
+                uint8_t* dst = out + done * 3;
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), packed);
+                const uint32_t tail = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(packed, 8)));
+                std::memcpy(dst + 8, &tail, sizeof(tail));
+                done += 4;
+            }
+            return done;
+        }
+
+        __attribute__((target("avx2")))
+        inline size_t base64DecodeAvx2(const char* in, size_t quads, uint8_t* out)
+        {
+            const __m256i lutLo = _mm256_setr_epi8(GALAY_UTILS_BASE64_DECODE_LUT_LO, GALAY_UTILS_BASE64_DECODE_LUT_LO);
+            const __m256i lutHi = _mm256_setr_epi8(GALAY_UTILS_BASE64_DECODE_LUT_HI, GALAY_UTILS_BASE64_DECODE_LUT_HI);
+            const __m256i lutRoll = _mm256_setr_epi8(GALAY_UTILS_BASE64_DECODE_LUT_ROLL,
+                                                     GALAY_UTILS_BASE64_DECODE_LUT_ROLL);
+            const __m256i nibble = _mm256_set1_epi8(0x0F);
+            const __m256i pack = _mm256_setr_epi8(
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+            const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+            const __m256i minus = _mm256_set1_epi8('-');
+            const __m256i slash = _mm256_set1_epi8('/');
+            const __m256i underscore = _mm256_set1_epi8('_');
+            const __m256i mergePairs = _mm256_set1_epi32(0x01400140);
+            const __m256i mergeQuads = _mm256_set1_epi32(0x00011000);
+            size_t done = 0;
+            while (quads - done >= 8) {
+                const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done * 4));
+                const __m256i hi = _mm256_and_si256(_mm256_srli_epi32(c, 4), nibble);
+                const __m256i lo = _mm256_and_si256(c, nibble);
+                if (!_mm256_testz_si256(_mm256_shuffle_epi8(lutLo, lo), _mm256_shuffle_epi8(lutHi, hi))) {
+                    break;
+                }
+                const __m256i isMinus = _mm256_cmpeq_epi8(c, minus);
+                const __m256i isUnderscore = _mm256_cmpeq_epi8(c, underscore);
+                __m256i index = _mm256_add_epi8(hi, _mm256_cmpeq_epi8(c, slash));
+                index = _mm256_add_epi8(index, _mm256_add_epi8(isMinus, isMinus));
+                index = _mm256_sub_epi8(index, _mm256_add_epi8(isUnderscore, _mm256_add_epi8(isUnderscore, isUnderscore)));
+                const __m256i values = _mm256_add_epi8(c, _mm256_shuffle_epi8(lutRoll, index));
+                const __m256i merged = _mm256_maddubs_epi16(values, mergePairs);
+                __m256i packed = _mm256_shuffle_epi8(_mm256_madd_epi16(merged, mergeQuads), pack);
+                packed = _mm256_permutevar8x32_epi32(packed, compact);
+                uint8_t* dst = out + done * 3;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(packed));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16), _mm256_extracti128_si256(packed, 1));
+                done += 8;
+            }
+            return done;
+        }
+
+#undef GALAY_UTILS_BASE64_DECODE_LUT_LO
+#undef GALAY_UTILS_BASE64_DECODE_LUT_HI
+#undef GALAY_UTILS_BASE64_DECODE_LUT_ROLL
+#elif defined(GALAY_UTILS_CODEC_NEON)
+        inline size_t base64EncodeNeon(const uint8_t* in, size_t triples, char* out, bool url)
+        {
+            const auto* alphabet = reinterpret_cast<const uint8_t*>(base64_chars[url ? 1 : 0]);
+            uint8x16x4_t table;
+            table.val[0] = vld1q_u8(alphabet);
+            table.val[1] = vld1q_u8(alphabet + 16);
+            table.val[2] = vld1q_u8(alphabet + 32);
+            table.val[3] = vld1q_u8(alphabet + 48);
+            const uint8x16_t mask = vdupq_n_u8(0x3F);
+            size_t done = 0;
+            while (triples - done >= 16) {
+                const uint8x16x3_t bytes = vld3q_u8(in + done * 3);
+                uint8x16x4_t chars;
+                chars.val[0] = vqtbl4q_u8(table, vshrq_n_u8(bytes.val[0], 2));
+                chars.val[1] = vqtbl4q_u8(table, vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[0], 4),
+                                                                   vshrq_n_u8(bytes.val[1], 4)), mask));
+                chars.val[2] = vqtbl4q_u8(table, vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[1], 2),
+                                                                   vshrq_n_u8(bytes.val[2], 6)), mask));
+                chars.val[3] = vqtbl4q_u8(table, vandq_u8(bytes.val[2], mask));
+                vst4q_u8(reinterpret_cast<uint8_t*>(out + done * 4), chars);
+                done += 16;
+            }
+            return done;
+        }
+
+        inline uint8x16_t base64TranslateNeon(uint8x16_t c, uint8x16_t& invalid)
+        {
+            const uint8x16_t upper = vandq_u8(vcgeq_u8(c, vdupq_n_u8('A')), vcleq_u8(c, vdupq_n_u8('Z')));
+            const uint8x16_t lower = vandq_u8(vcgeq_u8(c, vdupq_n_u8('a')), vcleq_u8(c, vdupq_n_u8('z')));
+            const uint8x16_t digit = vandq_u8(vcgeq_u8(c, vdupq_n_u8('0')), vcleq_u8(c, vdupq_n_u8('9')));
+            uint8x16_t shift = vandq_u8(upper, vdupq_n_u8(static_cast<uint8_t>(-65)));
+            shift = vorrq_u8(shift, vandq_u8(lower, vdupq_n_u8(static_cast<uint8_t>(-71))));
+            shift = vorrq_u8(shift, vandq_u8(digit, vdupq_n_u8(4)));
+            shift = vorrq_u8(shift, vandq_u8(vceqq_u8(c, vdupq_n_u8('+')), vdupq_n_u8(19)));
+            shift = vorrq_u8(shift, vandq_u8(vceqq_u8(c, vdupq_n_u8('-')), vdupq_n_u8(17)));
+            shift = vorrq_u8(shift, vandq_u8(vceqq_u8(c, vdupq_n_u8('/')), vdupq_n_u8(16)));
+            shift = vorrq_u8(shift, vandq_u8(vceqq_u8(c, vdupq_n_u8('_')), vdupq_n_u8(static_cast<uint8_t>(-32))));
+            invalid = vorrq_u8(invalid, vceqq_u8(shift, vdupq_n_u8(0)));
+            return vaddq_u8(c, shift);
+        }
+
+        inline size_t base64DecodeNeon(const char* in, size_t quads, uint8_t* out)
+        {
+            size_t done = 0;
+            while (quads - done >= 16) {
+                const uint8x16x4_t chars = vld4q_u8(reinterpret_cast<const uint8_t*>(in + done * 4));
+                uint8x16_t invalid = vdupq_n_u8(0);
+                const uint8x16_t a = base64TranslateNeon(chars.val[0], invalid);
+                const uint8x16_t b = base64TranslateNeon(chars.val[1], invalid);
+                const uint8x16_t c = base64TranslateNeon(chars.val[2], invalid);
+                const uint8x16_t d = base64TranslateNeon(chars.val[3], invalid);
+                if (vmaxvq_u8(invalid) != 0) {
+                    break;
+                }
+                uint8x16x3_t bytes;
+                bytes.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+                bytes.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+                bytes.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+                vst3q_u8(out + done * 3, bytes);
+                done += 16;
+            }
+            return done;
+        }
+#endif
+
+        /// 编码 triples 组完整输入（不含填充），按后端分派
+        inline void base64EncodeBlocks(const uint8_t* in, size_t triples, char* out, bool url)
+        {
+            size_t done = 0;
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+            const Base64Backend backend = base64SelectBackend();
+            if (backend == Base64Backend::Avx2) {
+                done = base64EncodeAvx2(in, triples, out, url);
+            } else if (backend == Base64Backend::Ssse3) {
+                done = base64EncodeSsse3(in, triples, out, url);
+            }
+#elif defined(GALAY_UTILS_CODEC_NEON)
+            done = base64EncodeNeon(in, triples, out, url);
+#endif
+            base64EncodeScalar(in + done * 3, triples - done, out + done * 4, url);
+        }
+
+        /// 解码 quads 组完整输入，返回遇到首个非法分组前成功解码的分组数
+        inline size_t base64DecodeBlocks(const char* in, size_t quads, uint8_t* out)
+        {
+            size_t done = 0;
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+            const Base64Backend backend = base64SelectBackend();
+            if (backend == Base64Backend::Avx2) {
+                done = base64DecodeAvx2(in, quads, out);
+            } else if (backend == Base64Backend::Ssse3) {
+                done = base64DecodeSsse3(in, quads, out);
+            }
+#elif defined(GALAY_UTILS_CODEC_NEON)
+            done = base64DecodeNeon(in, quads, out);
+#endif
+            return done + base64DecodeScalar(in + done * 4, quads - done, out + done * 3);
+        }
+    } // namespace detail
+
     /**
      * @brief Base64 编解码工具类
      * @details 提供 Base64 编码和解码的静态方法，支持标准 Base64、URL 安全变体、
      *          PEM（64 字符换行）和 MIME（76 字符换行）格式。
+     *          *Into 接口写入调用方缓冲区、不抛异常，通过 Base64Result 返回长度与校验状态。
      */
     class Base64Util
     {
@@ -86,7 +426,7 @@ namespace galay::utils
         /**
          * @brief 对 Base64 字符串进行解码
          * @param s 待解码的 Base64 字符串
-         * @param remove_linebreaks 是否在解码前移除换行符
+         * @param remove_linebreaks 是否在解码时跳过换行等空白字符
          * @return 解码后的字符串
          */
         static std::string Base64Decode(std::string const &s, bool remove_linebreaks = false);
@@ -126,156 +466,66 @@ namespace galay::utils
         /**
          * @brief 对 string_view 进行 Base64 解码（C++17）
          * @param s 待解码的 Base64 字符串视图
-         * @param remove_linebreaks 是否在解码前移除换行符
+         * @param remove_linebreaks 是否在解码时跳过换行等空白字符
          * @return 解码后的字符串
          */
         static std::string Base64DecodeView(std::string_view s, bool remove_linebreaks = false);
 #endif
-    private:
-        template <typename String>
-        static std::string Decode(String const &encoded_string, bool remove_linebreaks)
-        {
-            //
-            // Decode(…) is templated so that it can be used with String = const std::string&
-            // or std::string_view (requires at least C++17)
-            //
-
-            if (encoded_string.empty())
-                return std::string();
-
-            if (remove_linebreaks)
-            {
-
-                std::string copy(encoded_string);
-
-                copy.erase(std::remove(copy.begin(), copy.end(), '\n'), copy.end());
-
-                return Base64Decode(copy, false);
-            }
-
-            size_t length_of_string = encoded_string.length();
-            size_t pos = 0;
-
-            //
-            // The approximate length (bytes) of the decoded string might be one or
-            // two bytes smaller, depending on the amount of trailing equal signs
-            // in the encoded string. This approximation is needed to reserve
-            // enough space in the string to be returned.
-            //
-            size_t approx_length_of_decoded_string = length_of_string / 4 * 3;
-            std::string ret;
-            ret.reserve(approx_length_of_decoded_string);
-
-            while (pos < length_of_string)
-            {
-                //
-                // Iterate over encoded input string in chunks. The size of all
-                // chunks except the last one is 4 bytes.
-                //
-                // The last chunk might be padded with equal signs or dots
-                // in order to make it 4 bytes in size as well, but this
-                // is not required as per RFC 2045.
-                //
-                // All chunks except the last one produce three output bytes.
-                //
-                // The last chunk produces at least one and up to three bytes.
-                //
-
-                size_t pos_of_char_1 = pos_of_char(encoded_string.at(pos + 1));
-
-                //
-                // Emit the first output byte that is produced in each chunk:
-                //
-                ret.push_back(static_cast<std::string::value_type>(((pos_of_char(encoded_string.at(pos + 0))) << 2) + ((pos_of_char_1 & 0x30) >> 4)));
-
-                if ((pos + 2 < length_of_string) && // Check for data that is not padded with equal signs (which is allowed by RFC 2045)
-                    encoded_string.at(pos + 2) != '=' &&
-                    encoded_string.at(pos + 2) != '.' // accept URL-safe base 64 strings, too, so check for '.' also.
-                )
-                {
-                    //
-                    // Emit a chunk's second byte (which might not be produced in the last chunk).
-                    //
-                    unsigned int pos_of_char_2 = pos_of_char(encoded_string.at(pos + 2));
-                    ret.push_back(static_cast<std::string::value_type>(((pos_of_char_1 & 0x0f) << 4) + ((pos_of_char_2 & 0x3c) >> 2)));
-
-                    if ((pos + 3 < length_of_string) &&
-                        encoded_string.at(pos + 3) != '=' &&
-                        encoded_string.at(pos + 3) != '.')
-                    {
-                        //
-                        // Emit a chunk's third byte (which might not be produced in the last chunk).
-                        //
-                        ret.push_back(static_cast<std::string::value_type>(((pos_of_char_2 & 0x03) << 6) + pos_of_char(encoded_string.at(pos + 3))));
-                    }
-                }
-
-                pos += 4;
-            }
 
-            return ret;
-        }
+        /**
+         * @brief 计算编码输出长度（含填充）
+         * @param len 原始字节长度
+         * @return 编码后的字符数
+         */
+        static constexpr size_t Base64EncodedLength(size_t len) { return (len + 2) / 3 * 4; }
 
-        static inline unsigned int pos_of_char(const unsigned char chr)
-        {
-            unsigned char value = decode_table[chr];
-            if (value == 0xFF) {
-                throw std::runtime_error("Input is not valid base64-encoded data.");
-            }
-            return value;
-        }
+        /**
+         * @brief 计算合法输入的解码输出长度
+         * @param s Base64 字符串（不含空白）
+         * @return 解码后的字节数；输入不合法时为上界
+         */
+        static size_t Base64DecodedLength(std::string_view s);
 
-        static std::string insert_linebreaks(std::string str, size_t distance)
-        {
-            if (str.empty() || distance == 0)
-            {
-                return str;
-            }
+        /**
+         * @brief 编码到调用方缓冲区
+         * @param input 待编码字节
+         * @param output 输出缓冲区，至少 Base64EncodedLength(input.size()) 字节
+         * @param url 是否使用 URL 安全字符集
+         * @return 写入长度与状态；缓冲区不足时返回 OutputTooSmall 且不写入
+         */
+        static Base64Result Base64EncodeInto(std::span<const uint8_t> input, std::span<char> output, bool url = false);
 
-            // Calculate the number of line breaks needed
-            size_t num_breaks = (str.length() - 1) / distance;
-            if (num_breaks == 0)
-            {
-                return str;
-            }
+        /**
+         * @brief 解码到调用方缓冲区
+         * @details 同时接受标准与 URL 安全字符集；末尾填充可省略或不完整，但不允许出现在中间。
+         *          不跳过空白，含换行的输入请使用 Base64Decoder。
+         * @param input Base64 字符串
+         * @param output 输出缓冲区，至少 Base64DecodedLength(input) 字节
+         * @return 写入长度与状态；失败时 position 为首个非法字符的下标
+         */
+        static Base64Result Base64DecodeInto(std::string_view input, std::span<uint8_t> output);
 
-            // Pre-allocate the result string with exact size
-            std::string result;
-            result.reserve(str.length() + num_breaks);
-
-            // Copy chunks with line breaks
-            size_t pos = 0;
-            while (pos < str.length())
-            {
-                size_t chunk_size = std::min(distance, str.length() - pos);
-                result.append(str, pos, chunk_size);
-                pos += chunk_size;
-
-                if (pos < str.length())
-                {
-                    result.push_back('\n');
-                }
-            }
+        /**
+         * @brief 获取当前使用的块编解码指令集
+         * @return Base64Backend 枚举值
+         */
+        static Base64Backend backend() { return detail::base64SelectBackend(); }
 
-            return result;
-        }
+    private:
+        static std::string Decode(std::string_view encoded_string, bool remove_linebreaks);
 
-        template <typename String, unsigned int line_length>
-        static std::string encode_with_line_breaks(String s)
-        {
-            return insert_linebreaks(Encode(s, false), line_length);
-        }
+        static std::string encode_with_line_breaks(std::string_view s, size_t line_length);
 
         template <typename String>
         static std::string encode_pem(String s)
         {
-            return encode_with_line_breaks<String, 64>(s);
+            return encode_with_line_breaks(std::string_view(s.data(), s.size()), 64);
         }
 
         template <typename String>
         static std::string encode_mime(String s)
         {
-            return encode_with_line_breaks<String, 76>(s);
+            return encode_with_line_breaks(std::string_view(s.data(), s.size()), 76);
         }
 
         template <typename String>
@@ -285,52 +535,139 @@ namespace galay::utils
         }
     };
 
-    // Implementation of Base64Encode functions
-    inline std::string Base64Util::Base64Encode(unsigned char const *bytes_to_encode, size_t in_len, bool url)
+    /**
+     * @brief 流式 Base64 编码器
+     * @details 适合分块生成的 MIME 正文：跨 update() 保留不足 3 字节的尾部，
+     *          可按固定列宽插入 '\n'，输出与 Base64EncodeMime / Base64EncodePem 一致。
+     */
+    class Base64Encoder
     {
-        std::string ret;
-        int i = 0;
-        unsigned char char_array_3[3];
-        unsigned char char_array_4[4];
+    public:
+        /**
+         * @brief 构造编码器
+         * @param url 是否使用 URL 安全字符集
+         * @param lineLength 每行字符数，0 表示不换行；必须是 4 的倍数，否则抛 std::invalid_argument
+         */
+        explicit Base64Encoder(bool url = false, size_t lineLength = 0)
+            : m_url(url)
+            , m_lineLength(lineLength)
+        {
+            if (lineLength % 4 != 0) {
+                throw std::invalid_argument("Base64Encoder line length must be a multiple of 4");
+            }
+        }
 
-        const char *base64_chars_selected = base64_chars[url ? 1 : 0];
+        /**
+         * @brief 计算追加 inputLength 字节并 finish() 所需的最大输出长度
+         * @param inputLength 本次输入长度
+         * @return 输出字符数上界
+         */
+        size_t maxOutputLength(size_t inputLength) const
+        {
+            const size_t chars = Base64Util::Base64EncodedLength(m_carryLength + inputLength);
+            return chars + (m_lineLength ? (m_column + chars) / m_lineLength : 0);
+        }
 
-        // Pre-calculate and reserve exact size needed
-        size_t encoded_size = ((in_len + 2) / 3) * 4;
-        ret.reserve(encoded_size);
+        /**
+         * @brief 追加输入
+         * @param input 待编码字节
+         * @param output 输出缓冲区，至少 maxOutputLength(input.size()) 字节
+         * @return 写入长度与状态；缓冲区不足时返回 OutputTooSmall 且不消费输入
+         */
+        Base64Result update(std::span<const uint8_t> input, std::span<char> output);
 
-        while (in_len--)
+        /**
+         * @brief 追加字符串视图
+         * @param input 待编码数据
+         * @param output 输出缓冲区
+         * @return 写入长度与状态
+         */
+        Base64Result update(std::string_view input, std::span<char> output)
         {
-            char_array_3[i++] = *(bytes_to_encode++);
-            if (i == 3)
-            {
-                char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-                char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-                char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-                char_array_4[3] = char_array_3[2] & 0x3f;
-
-                for (i = 0; i < 4; i++)
-                    ret += base64_chars_selected[char_array_4[i]];
-                i = 0;
-            }
+            return update(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(input.data()), input.size()),
+                          output);
         }
 
-        if (i)
+        /**
+         * @brief 输出剩余字节及填充，并重置编码器
+         * @param output 输出缓冲区，至少 5 字节
+         * @return 写入长度与状态
+         */
+        Base64Result finish(std::span<char> output);
+
+        /// 丢弃缓存的尾部并回到初始状态
+        void reset()
         {
-            for (int j = i; j < 3; j++)
-                char_array_3[j] = '\0';
+            m_carryLength = 0;
+            m_column = 0;
+        }
+
+    private:
+        size_t writeTriples(const uint8_t* input, size_t triples, char* output);
+
+        bool m_url;
+        size_t m_lineLength;
+        size_t m_column = 0;
+        size_t m_carryLength = 0;
+        uint8_t m_carry[3] = {};
+    };
 
-            char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-            char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-            char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
+    /**
+     * @brief 流式 Base64 解码器
+     * @details 单趟跳过空格、制表符与 CR/LF，跨 update() 保留不足 4 字符的分组；
+     *          连续的完整分组走 SIMD 块解码。出错后状态保持，直到 reset()。
+     */
+    class Base64Decoder
+    {
+    public:
+        /**
+         * @brief 计算 update() 所需的输出长度上界
+         * @param inputLength 本次输入长度
+         * @return 输出字节数上界
+         */
+        static constexpr size_t maxOutputLength(size_t inputLength) { return (inputLength + 3) / 4 * 3; }
+
+        /**
+         * @brief 追加输入
+         * @param input Base64 文本片段，可包含空白
+         * @param output 输出缓冲区，至少 maxOutputLength(缓存分组长度 + input.size()) 字节；
+         *        缓存分组不超过 3 个字符，按 maxOutputLength(input.size() + 3) 分配总是足够
+         * @return 写入长度与状态；失败时 position 为出错字符在本片段中的下标
+         */
+        Base64Result update(std::string_view input, std::span<uint8_t> output);
 
-            for (int j = 0; j < i + 1; j++)
-                ret += base64_chars_selected[char_array_4[j]];
+        /**
+         * @brief 结束输入，输出未填充的末尾分组，并在成功时重置解码器
+         * @param output 输出缓冲区，至少 2 字节
+         * @return 写入长度与状态
+         */
+        Base64Result finish(std::span<uint8_t> output);
 
-            while (i++ < 3)
-                ret += '=';
+        /// 清除缓存分组与错误状态
+        void reset()
+        {
+            m_carryLength = 0;
+            m_padRemaining = 0;
+            m_closed = false;
+            m_status = Base64Status::Ok;
         }
 
+    private:
+        size_t flushPartial(uint8_t* output) const;
+        Base64Result fail(Base64Status status, size_t position, size_t length);
+
+        uint8_t m_carry[4] = {};
+        size_t m_carryLength = 0;
+        size_t m_padRemaining = 0;
+        bool m_closed = false;
+        Base64Status m_status = Base64Status::Ok;
+    };
+
+    // Implementation of Base64Encode functions
+    inline std::string Base64Util::Base64Encode(unsigned char const *bytes_to_encode, size_t in_len, bool url)
+    {
+        std::string ret(Base64EncodedLength(in_len), '\0');
+        Base64EncodeInto(std::span<const uint8_t>(bytes_to_encode, in_len), ret, url);
         return ret;
     }
 
@@ -377,7 +714,310 @@ namespace galay::utils
     }
 #endif
 
+    inline std::string Base64Util::Decode(std::string_view encoded_string, bool remove_linebreaks)
+    {
+        std::string ret;
+        auto bytes = [&ret]() {
+            return std::span<uint8_t>(reinterpret_cast<uint8_t*>(ret.data()), ret.size());
+        };
+
+        Base64Result result;
+        if (remove_linebreaks) {
+            ret.resize(Base64Decoder::maxOutputLength(encoded_string.size()));
+            Base64Decoder decoder;
+            result = decoder.update(encoded_string, bytes());
+            if (result) {
+                const Base64Result tail = decoder.finish(bytes().subspan(result.length));
+                result.length += tail.length;
+                result.status = tail.status;
+            }
+        } else {
+            ret.resize(Base64DecodedLength(encoded_string));
+            result = Base64DecodeInto(encoded_string, bytes());
+        }
+
+        if (!result) {
+            throw std::runtime_error("Input is not valid base64-encoded data.");
+        }
+        ret.resize(result.length);
+        return ret;
+    }
+
+    inline std::string Base64Util::encode_with_line_breaks(std::string_view s, size_t line_length)
+    {
+        Base64Encoder encoder(false, line_length);
+        std::string ret(encoder.maxOutputLength(s.size()), '\0');
+        const Base64Result body = encoder.update(s, ret);
+        const Base64Result tail = encoder.finish(std::span<char>(ret).subspan(body.length));
+        ret.resize(body.length + tail.length);
+        return ret;
+    }
+
+    inline size_t Base64Util::Base64DecodedLength(std::string_view s)
+    {
+        size_t length = s.size();
+        for (size_t pad = 0; pad < 2 && length > 0 && detail::base64IsPad(s[length - 1]); ++pad) {
+            --length;
+        }
+        const size_t rest = length % 4;
+        return length / 4 * 3 + (rest > 1 ? rest - 1 : 0);
+    }
+
+    inline Base64Result Base64Util::Base64EncodeInto(std::span<const uint8_t> input, std::span<char> output, bool url)
+    {
+        const size_t required = Base64EncodedLength(input.size());
+        if (output.size() < required) {
+            return {0, 0, Base64Status::OutputTooSmall};
+        }
+
+        const size_t triples = input.size() / 3;
+        detail::base64EncodeBlocks(input.data(), triples, output.data(), url);
+        if (const size_t rest = input.size() - triples * 3; rest != 0) {
+            detail::base64EncodeTail(input.data() + triples * 3, rest, output.data() + triples * 4, url);
+        }
+        return {required, input.size(), Base64Status::Ok};
+    }
+
+    inline Base64Result Base64Util::Base64DecodeInto(std::string_view input, std::span<uint8_t> output)
+    {
+        size_t length = input.size();
+        size_t padding = 0;
+        while (padding < 2 && length > 0 && detail::base64IsPad(input[length - 1])) {
+            --length;
+            ++padding;
+        }
+
+        const size_t rest = length % 4;
+        if (rest == 1) {
+            return {0, length - 1, Base64Status::InvalidLength};
+        }
+        if (padding != 0 && (rest == 0 || rest + padding > 4)) {
+            return {0, length, Base64Status::InvalidPadding};
+        }
+
+        const size_t required = length / 4 * 3 + (rest > 1 ? rest - 1 : 0);
+        if (output.size() < required) {
+            return {0, 0, Base64Status::OutputTooSmall};
+        }
+
+        const char* in = input.data();
+        uint8_t* out = output.data();
+        const size_t quads = length / 4;
+        const size_t done = detail::base64DecodeBlocks(in, quads, out);
+
+        auto invalidAt = [&](size_t begin, size_t count) -> Base64Result {
+            for (size_t i = begin; i < begin + count; ++i) {
+                if (decode_table[static_cast<uint8_t>(in[i])] == 0xFF) {
+                    return {done * 3, i, detail::base64IsPad(in[i]) ? Base64Status::InvalidPadding
+                                                                    : Base64Status::InvalidCharacter};
+                }
+            }
+            return {};
+        };
+
+        if (done < quads) {
+            return invalidAt(done * 4, 4);
+        }
+        if (rest != 0) {
+            if (Base64Result error = invalidAt(quads * 4, rest); error.status != Base64Status::Ok) {
+                return error;
+            }
+            const char* tail = in + quads * 4;
+            const uint32_t a = decode_table[static_cast<uint8_t>(tail[0])];
+            const uint32_t b = decode_table[static_cast<uint8_t>(tail[1])];
+            uint8_t* dst = out + quads * 3;
+            dst[0] = static_cast<uint8_t>((a << 2) | (b >> 4));
+            if (rest == 3) {
+                const uint32_t c = decode_table[static_cast<uint8_t>(tail[2])];
+                dst[1] = static_cast<uint8_t>((b << 4) | (c >> 2));
+            }
+        }
+        return {required, input.size(), Base64Status::Ok};
+    }
+
+    inline size_t Base64Encoder::writeTriples(const uint8_t* input, size_t triples, char* output)
+    {
+        if (m_lineLength == 0) {
+            detail::base64EncodeBlocks(input, triples, output, m_url);
+            return triples * 4;
+        }
+
+        // 换行在写下一行首字符前才插入，因此输出末尾不会多出换行
+        size_t written = 0;
+        while (triples > 0) {
+            if (m_column == m_lineLength) {
+                output[written++] = '\n';
+                m_column = 0;
+            }
+            const size_t count = std::min(triples, (m_lineLength - m_column) / 4);
+            detail::base64EncodeBlocks(input, count, output + written, m_url);
+            input += count * 3;
+            triples -= count;
+            written += count * 4;
+            m_column += count * 4;
+        }
+        return written;
+    }
+
+    inline Base64Result Base64Encoder::update(std::span<const uint8_t> input, std::span<char> output)
+    {
+        if (output.size() < maxOutputLength(input.size())) {
+            return {0, 0, Base64Status::OutputTooSmall};
+        }
+
+        const uint8_t* in = input.data();
+        size_t remaining = input.size();
+        size_t written = 0;
+
+        if (m_carryLength != 0) {
+            while (m_carryLength < 3 && remaining > 0) {
+                m_carry[m_carryLength++] = *in++;
+                --remaining;
+            }
+            if (m_carryLength < 3) {
+                return {0, input.size(), Base64Status::Ok};
+            }
+            written += writeTriples(m_carry, 1, output.data());
+            m_carryLength = 0;
+        }
+
+        const size_t triples = remaining / 3;
+        written += writeTriples(in, triples, output.data() + written);
+        in += triples * 3;
+        remaining -= triples * 3;
+
+        std::memcpy(m_carry, in, remaining);
+        m_carryLength = remaining;
+        return {written, input.size(), Base64Status::Ok};
+    }
+
+    inline Base64Result Base64Encoder::finish(std::span<char> output)
+    {
+        if (m_carryLength == 0) {
+            reset();
+            return {};
+        }
+
+        const bool breakLine = m_lineLength != 0 && m_column == m_lineLength;
+        if (output.size() < 4 + (breakLine ? 1 : 0)) {
+            return {0, 0, Base64Status::OutputTooSmall};
+        }
+
+        size_t written = 0;
+        if (breakLine) {
+            output[written++] = '\n';
+        }
+        detail::base64EncodeTail(m_carry, m_carryLength, output.data() + written, m_url);
+        written += 4;
+        reset();
+        return {written, 0, Base64Status::Ok};
+    }
+
+    inline size_t Base64Decoder::flushPartial(uint8_t* output) const
+    {
+        output[0] = static_cast<uint8_t>((m_carry[0] << 2) | (m_carry[1] >> 4));
+        if (m_carryLength == 3) {
+            output[1] = static_cast<uint8_t>((m_carry[1] << 4) | (m_carry[2] >> 2));
+            return 2;
+        }
+        return 1;
+    }
+
+    inline Base64Result Base64Decoder::fail(Base64Status status, size_t position, size_t length)
+    {
+        m_status = status;
+        return {length, position, status};
+    }
+
+    inline Base64Result Base64Decoder::update(std::string_view input, std::span<uint8_t> output)
+    {
+        if (m_status != Base64Status::Ok) {
+            return {0, 0, m_status};
+        }
+        // 上界须覆盖填充分组 flushPartial() 写出的末尾 1~2 字节
+        if (output.size() < maxOutputLength(m_carryLength + input.size())) {
+            return {0, 0, Base64Status::OutputTooSmall};
+        }
+
+        const char* in = input.data();
+        const size_t size = input.size();
+        uint8_t* out = output.data();
+        size_t pos = 0;
+        size_t written = 0;
+
+        while (pos < size) {
+            // 分组对齐时整段交给块解码，遇到空白、填充或非法字符再逐字符处理
+            if (m_carryLength == 0 && !m_closed && size - pos >= 4) {
+                const size_t done = detail::base64DecodeBlocks(in + pos, (size - pos) / 4, out + written);
+                pos += done * 4;
+                written += done * 3;
+                if (pos == size) {
+                    break;
+                }
+            }
+
+            const char c = in[pos];
+            if (detail::base64IsSpace(c)) {
+                ++pos;
+                continue;
+            }
+            if (m_closed) {
+                if (detail::base64IsPad(c) && m_padRemaining > 0) {
+                    --m_padRemaining;
+                    ++pos;
+                    continue;
+                }
+                return fail(Base64Status::InvalidPadding, pos, written);
+            }
+            if (detail::base64IsPad(c)) {
+                if (m_carryLength < 2) {
+                    return fail(Base64Status::InvalidPadding, pos, written);
+                }
+                written += flushPartial(out + written);
+                m_padRemaining = 3 - m_carryLength;
+                m_carryLength = 0;
+                m_closed = true;
+                ++pos;
+                continue;
+            }
+
+            const uint8_t value = decode_table[static_cast<uint8_t>(c)];
+            if (value == 0xFF) {
+                return fail(Base64Status::InvalidCharacter, pos, written);
+            }
+            m_carry[m_carryLength++] = value;
+            ++pos;
+            if (m_carryLength == 4) {
+                out[written++] = static_cast<uint8_t>((m_carry[0] << 2) | (m_carry[1] >> 4));
+                out[written++] = static_cast<uint8_t>((m_carry[1] << 4) | (m_carry[2] >> 2));
+                out[written++] = static_cast<uint8_t>((m_carry[2] << 6) | m_carry[3]);
+                m_carryLength = 0;
+            }
+        }
+        return {written, size, Base64Status::Ok};
+    }
+
+    inline Base64Result Base64Decoder::finish(std::span<uint8_t> output)
+    {
+        if (m_status != Base64Status::Ok) {
+            return {0, 0, m_status};
+        }
+        if (m_carryLength == 1) {
+            return fail(Base64Status::InvalidLength, 0, 0);
+        }
+
+        size_t written = 0;
+        if (m_carryLength > 1) {
+            if (output.size() < m_carryLength - 1) {
+                return {0, 0, Base64Status::OutputTooSmall};
+            }
+            written = flushPartial(output.data());
+        }
+        reset();
+        return {written, 0, Base64Status::Ok};
+    }
+
 }
 
 
-#endif /* BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A */
\ No newline at end of file
+#endif /* BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A */
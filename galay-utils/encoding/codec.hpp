@@ -0,0 +1,83 @@
+/**
+ * @file codec.hpp
+ * @brief 编解码公共类型
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details Base64、十六进制、Base32 与 Z85 的 span 接口共用的结果状态、返回值和指令集选择。
+ *          x86-64 上运行时检测 AVX2 / SSSE3，AArch64 上固定使用 NEON。
+ */
+
+#ifndef GALAY_UTILS_CODEC_H
+#define GALAY_UTILS_CODEC_H
+
+#include "galay-utils/common/defn.hpp"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(GALAY_ARCH_X64) && (defined(GALAY_COMPILER_GCC) || defined(GALAY_COMPILER_CLANG))
+#define GALAY_UTILS_CODEC_X86_SIMD 1
+#include <immintrin.h>
+#elif defined(GALAY_ARCH_ARM64) && defined(__ARM_NEON)
+#define GALAY_UTILS_CODEC_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace galay::utils
+{
+    /**
+     * @brief span 编解码接口与流式编解码器的结果状态
+     */
+    enum class CodecStatus
+    {
+        Ok,                 ///< 成功
+        OutputTooSmall,     ///< 输出缓冲区不足，未写入任何数据
+        InvalidCharacter,   ///< 输入包含字母表外的字符
+        InvalidPadding,     ///< 填充字符位置或数量不合法
+        InvalidLength       ///< 输入长度无法构成完整字节或完整分组
+    };
+
+    /**
+     * @brief span 编解码接口与流式编解码器的返回值
+     */
+    struct CodecResult
+    {
+        size_t length = 0;      ///< 写入输出缓冲区的字节数
+        size_t position = 0;    ///< 成功时为已消费的输入长度；失败时为出错字符在输入中的下标
+        CodecStatus status = CodecStatus::Ok; ///< 结果状态
+
+        /// 是否成功
+        explicit operator bool() const { return status == CodecStatus::Ok; }
+    };
+
+    /**
+     * @brief 块编解码使用的指令集
+     */
+    enum class CodecBackend
+    {
+        Scalar,     ///< 可移植标量实现
+        Ssse3,      ///< x86-64 SSSE3（运行时检测）
+        Avx2,       ///< x86-64 AVX2（运行时检测）
+        Neon        ///< AArch64 NEON
+    };
+
+    namespace detail
+    {
+        inline CodecBackend codecSelectBackend()
+        {
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+            static const CodecBackend selected =
+                __builtin_cpu_supports("avx2") ? CodecBackend::Avx2
+                : __builtin_cpu_supports("ssse3") ? CodecBackend::Ssse3
+                : CodecBackend::Scalar;
+            return selected;
+#elif defined(GALAY_UTILS_CODEC_NEON)
+            return CodecBackend::Neon;
+#else
+            return CodecBackend::Scalar;
+#endif
+        }
+    }
+}
+
+#endif // GALAY_UTILS_CODEC_H
@@ -0,0 +1,402 @@
+/**
+ * @file hex.hpp
+ * @brief 十六进制编解码
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 摘要、盐值与 trace ID 的十六进制输出统一经过此处。
+ *          块编解码在 x86-64 上运行时分派 AVX2 / SSSE3，在 AArch64 上使用 NEON；
+ *          span 接口写入调用方缓冲区、不抛异常，解码同时接受大小写字母。
+ */
+
+#ifndef GALAY_UTILS_HEX_H
+#define GALAY_UTILS_HEX_H
+
+#include "galay-utils/encoding/codec.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace galay::utils
+{
+    namespace detail
+    {
+        inline constexpr char hexDigitsLower[] = "0123456789abcdef";
+        inline constexpr char hexDigitsUpper[] = "0123456789ABCDEF";
+
+        /// 字节到两个字符的查找表，标量路径每字节一次 2 字节拷贝
+        inline constexpr auto hexPairTable(const char* digits)
+        {
+            std::array<char, 512> table{};
+            for (size_t i = 0; i < 256; ++i) {
+                table[i * 2] = digits[i >> 4];
+                table[i * 2 + 1] = digits[i & 0x0F];
+            }
+            return table;
+        }
+
+        inline constexpr std::array<char, 512> hexPairsLower = hexPairTable(hexDigitsLower);
+        inline constexpr std::array<char, 512> hexPairsUpper = hexPairTable(hexDigitsUpper);
+
+        /// ASCII 到半字节值，非法字符为 0xFF
+        inline constexpr std::array<uint8_t, 256> hexDecodeTable = [] {
+            std::array<uint8_t, 256> table{};
+            for (auto& value : table) {
+                value = 0xFF;
+            }
+            for (uint8_t i = 0; i < 10; ++i) {
+                table['0' + i] = i;
+            }
+            for (uint8_t i = 0; i < 6; ++i) {
+                table['a' + i] = static_cast<uint8_t>(10 + i);
+                table['A' + i] = static_cast<uint8_t>(10 + i);
+            }
+            return table;
+        }();
+
+        inline void hexEncodeScalar(const uint8_t* in, size_t length, char* out, bool uppercase)
+        {
+            const char* pairs = uppercase ? hexPairsUpper.data() : hexPairsLower.data();
+            for (size_t i = 0; i < length; ++i) {
+                std::memcpy(out + i * 2, pairs + in[i] * 2, 2);
+            }
+        }
+
+        /// 解码 length 个字节（2 * length 个字符），返回遇到首个非法字符对前成功解码的字节数
+        inline size_t hexDecodeScalar(const char* in, size_t length, uint8_t* out)
+        {
+            for (size_t i = 0; i < length; ++i) {
+                const uint8_t hi = hexDecodeTable[static_cast<unsigned char>(in[i * 2])];
+                const uint8_t lo = hexDecodeTable[static_cast<unsigned char>(in[i * 2 + 1])];
+                if ((hi | lo) == 0xFF) {
+                    return i;
+                }
+                out[i] = static_cast<uint8_t>((hi << 4) | lo);
+            }
+            return length;
+        }
+
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+        __attribute__((target("ssse3")))
+        inline size_t hexEncodeSsse3(const uint8_t* in, size_t length, char* out, bool uppercase)
+        {
+            const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                uppercase ? hexDigitsUpper : hexDigitsLower));
+            const __m128i mask = _mm_set1_epi8(0x0F);
+            size_t done = 0;
+            while (length - done >= 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+                const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+                const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, mask));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done * 2), _mm_unpacklo_epi8(hi, lo));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+                done += 16;
+            }
+            return done;
+        }
+
+        __attribute__((target("avx2")))
+        inline size_t hexEncodeAvx2(const uint8_t* in, size_t length, char* out, bool uppercase)
+        {
+            const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(uppercase ? hexDigitsUpper : hexDigitsLower)));
+            const __m256i mask = _mm256_set1_epi8(0x0F);
+            size_t done = 0;
+            while (length - done >= 32) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done));
+                const __m256i hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+                const __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, mask));
+                // unpack 按 128 位通道交错，再用 permute 把两个通道拼回顺序
+                const __m256i first = _mm256_unpacklo_epi8(hi, lo);
+                const __m256i second = _mm256_unpackhi_epi8(hi, lo);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done * 2),
+                                    _mm256_permute2x128_si256(first, second, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done * 2 + 32),
+                                    _mm256_permute2x128_si256(first, second, 0x31));
+                done += 32;
+            }
+            return done;
+        }
+
+        /// 字符转半字节：'0'-'9' 与 'a'-'f'/'A'-'F'，非法字符在 valid 中置 0
+        __attribute__((target("ssse3")))
+        inline __m128i hexNibblesSsse3(__m128i c, __m128i& valid)
+        {
+            const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+            const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+            const __m128i alpha = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+            const __m128i isAlpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+            valid = _mm_or_si128(isDigit, isAlpha);
+            return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                                _mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+        }
+
+        __attribute__((target("ssse3")))
+        inline size_t hexDecodeSsse3(const char* in, size_t length, uint8_t* out)
+        {
+            // 相邻两个半字节按 (hi * 16 + lo) 合并为 16 位，再饱和打包回字节
+            const __m128i weights = _mm_set1_epi16(0x0110);
+            size_t done = 0;
+            while (length - done >= 16) {
+                __m128i valid0, valid1;
+                const __m128i v0 = hexNibblesSsse3(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done * 2)), valid0);
+                const __m128i v1 = hexNibblesSsse3(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done * 2 + 16)), valid1);
+                if (_mm_movemask_epi8(_mm_and_si128(valid0, valid1)) != 0xFFFF) {
+                    break;
+                }
+                const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(v0, weights),
+                                                       _mm_maddubs_epi16(v1, weights));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done), bytes);
+                done += 16;
+            }
+            return done;
+        }
+
+        __attribute__((target("avx2")))
+        inline __m256i hexNibblesAvx2(__m256i c, __m256i& valid)
+        {
+            const __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+            const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+            const __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)),
+                                                  _mm256_set1_epi8('a'));
+            const __m256i isAlpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+            valid = _mm256_or_si256(isDigit, isAlpha);
+            return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+                                   _mm256_and_si256(isAlpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+        }
+
+        __attribute__((target("avx2")))
+        inline size_t hexDecodeAvx2(const char* in, size_t length, uint8_t* out)
+        {
+            const __m256i weights = _mm256_set1_epi16(0x0110);
+            size_t done = 0;
+            while (length - done >= 32) {
+                __m256i valid0, valid1;
+                const __m256i v0 = hexNibblesAvx2(
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done * 2)), valid0);
+                const __m256i v1 = hexNibblesAvx2(
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done * 2 + 32)), valid1);
+                if (_mm256_movemask_epi8(_mm256_and_si256(valid0, valid1)) != -1) {
+                    break;
+                }
+                // packus 按 128 位通道交错，0xD8 把 64 位块恢复为 0,1,2,3 顺序
+                const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(v0, weights),
+                                                           _mm256_maddubs_epi16(v1, weights));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + done),
+                                    _mm256_permute4x64_epi64(packed, 0xD8));
+                done += 32;
+            }
+            return done;
+        }
+#elif defined(GALAY_UTILS_CODEC_NEON)
+        inline size_t hexEncodeNeon(const uint8_t* in, size_t length, char* out, bool uppercase)
+        {
+            const uint8x16_t digits = vld1q_u8(reinterpret_cast<const uint8_t*>(
+                uppercase ? hexDigitsUpper : hexDigitsLower));
+            const uint8x16_t mask = vdupq_n_u8(0x0F);
+            size_t done = 0;
+            while (length - done >= 16) {
+                const uint8x16_t v = vld1q_u8(in + done);
+                uint8x16x2_t chars;
+                chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(v, 4));
+                chars.val[1] = vqtbl1q_u8(digits, vandq_u8(v, mask));
+                vst2q_u8(reinterpret_cast<uint8_t*>(out + done * 2), chars);
+                done += 16;
+            }
+            return done;
+        }
+
+        inline uint8x16_t hexNibblesNeon(uint8x16_t c, uint8x16_t& valid)
+        {
+            const uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+            const uint8x16_t isDigit = vcleq_u8(digit, vdupq_n_u8(9));
+            const uint8x16_t alpha = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+            const uint8x16_t isAlpha = vcleq_u8(alpha, vdupq_n_u8(5));
+            valid = vorrq_u8(isDigit, isAlpha);
+            return vbslq_u8(isDigit, digit, vaddq_u8(alpha, vdupq_n_u8(10)));
+        }
+
+        inline size_t hexDecodeNeon(const char* in, size_t length, uint8_t* out)
+        {
+            size_t done = 0;
+            while (length - done >= 16) {
+                // vld2q 按奇偶拆分，val[0] 为高半字节字符，val[1] 为低半字节字符
+                const uint8x16x2_t chars = vld2q_u8(reinterpret_cast<const uint8_t*>(in + done * 2));
+                uint8x16_t validHi, validLo;
+                const uint8x16_t hi = hexNibblesNeon(chars.val[0], validHi);
+                const uint8x16_t lo = hexNibblesNeon(chars.val[1], validLo);
+                if (vminvq_u8(vandq_u8(validHi, validLo)) != 0xFF) {
+                    break;
+                }
+                vst1q_u8(out + done, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+                done += 16;
+            }
+            return done;
+        }
+#endif
+
+        inline void hexEncodeBlocks(const uint8_t* in, size_t length, char* out, bool uppercase)
+        {
+            size_t done = 0;
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+            const CodecBackend backend = codecSelectBackend();
+            if (backend == CodecBackend::Avx2) {
+                done = hexEncodeAvx2(in, length, out, uppercase);
+                done += hexEncodeSsse3(in + done, length - done, out + done * 2, uppercase);
+            } else if (backend == CodecBackend::Ssse3) {
+                done = hexEncodeSsse3(in, length, out, uppercase);
+            }
+#elif defined(GALAY_UTILS_CODEC_NEON)
+            done = hexEncodeNeon(in, length, out, uppercase);
+#endif
+            hexEncodeScalar(in + done, length - done, out + done * 2, uppercase);
+        }
+
+        /// 16 字节按 8-4-4-4-12 分组写出 36 字符小写 UUID 文本
+        inline void hexFormatUuid(const uint8_t* bytes, char* out)
+        {
+            hexEncodeScalar(bytes, 4, out, false);
+            out[8] = '-';
+            hexEncodeScalar(bytes + 4, 2, out + 9, false);
+            out[13] = '-';
+            hexEncodeScalar(bytes + 6, 2, out + 14, false);
+            out[18] = '-';
+            hexEncodeScalar(bytes + 8, 2, out + 19, false);
+            out[23] = '-';
+            hexEncodeScalar(bytes + 10, 6, out + 24, false);
+        }
+
+        /// 解码 length 个字节，返回遇到首个非法字符对前成功解码的字节数
+        inline size_t hexDecodeBlocks(const char* in, size_t length, uint8_t* out)
+        {
+            size_t done = 0;
+#if defined(GALAY_UTILS_CODEC_X86_SIMD)
+            const CodecBackend backend = codecSelectBackend();
+            if (backend == CodecBackend::Avx2) {
+                done = hexDecodeAvx2(in, length, out);
+                done += hexDecodeSsse3(in + done * 2, length - done, out + done);
+            } else if (backend == CodecBackend::Ssse3) {
+                done = hexDecodeSsse3(in, length, out);
+            }
+#elif defined(GALAY_UTILS_CODEC_NEON)
+            done = hexDecodeNeon(in, length, out);
+#endif
+            return done + hexDecodeScalar(in + done * 2, length - done, out + done);
+        }
+    } // namespace detail
+
+    /**
+     * @brief 十六进制编解码
+     * @details *Into 接口写入调用方缓冲区、不抛异常；encode() / decode() 为返回容器的便捷包装。
+     */
+    class HexCodec
+    {
+    public:
+        /**
+         * @brief 计算编码后的字符数
+         * @param length 原始字节数
+         * @return 2 * length
+         */
+        static constexpr size_t encodedLength(size_t length) { return length * 2; }
+
+        /**
+         * @brief 计算解码后的字节数
+         * @param length 十六进制字符数
+         * @return length / 2
+         */
+        static constexpr size_t decodedLength(size_t length) { return length / 2; }
+
+        /**
+         * @brief 编码到调用方缓冲区
+         * @param input 原始字节
+         * @param output 输出缓冲区，至少 encodedLength(input.size()) 字节；不追加 '\0'
+         * @param uppercase 是否输出大写字母
+         * @return 成功时 length 为写入字符数；缓冲区不足时返回 OutputTooSmall 且不写入
+         */
+        static CodecResult encodeInto(std::span<const uint8_t> input, std::span<char> output,
+                                      bool uppercase = false)
+        {
+            const size_t required = encodedLength(input.size());
+            if (output.size() < required) {
+                return {0, 0, CodecStatus::OutputTooSmall};
+            }
+            detail::hexEncodeBlocks(input.data(), input.size(), output.data(), uppercase);
+            return {required, input.size(), CodecStatus::Ok};
+        }
+
+        /**
+         * @brief 解码到调用方缓冲区，接受大小写字母
+         * @param input 十六进制字符串，长度必须为偶数
+         * @param output 输出缓冲区，至少 decodedLength(input.size()) 字节
+         * @return 失败时 position 为出错字符下标，length 为出错前已写入的字节数
+         */
+        static CodecResult decodeInto(std::string_view input, std::span<uint8_t> output)
+        {
+            if (input.size() % 2 != 0) {
+                return {0, input.size() - 1, CodecStatus::InvalidLength};
+            }
+            const size_t required = decodedLength(input.size());
+            if (output.size() < required) {
+                return {0, 0, CodecStatus::OutputTooSmall};
+            }
+            const size_t done = detail::hexDecodeBlocks(input.data(), required, output.data());
+            if (done != required) {
+                const bool hiValid = detail::hexDecodeTable[static_cast<unsigned char>(input[done * 2])] != 0xFF;
+                return {done, done * 2 + (hiValid ? 1 : 0), CodecStatus::InvalidCharacter};
+            }
+            return {required, input.size(), CodecStatus::Ok};
+        }
+
+        /**
+         * @brief 编码为字符串
+         * @param input 原始字节
+         * @param uppercase 是否输出大写字母
+         * @return 十六进制字符串
+         */
+        static std::string encode(std::span<const uint8_t> input, bool uppercase = false)
+        {
+            std::string result(encodedLength(input.size()), '\0');
+            detail::hexEncodeBlocks(input.data(), input.size(), result.data(), uppercase);
+            return result;
+        }
+
+        /**
+         * @brief 编码字符串的原始字节
+         */
+        static std::string encode(std::string_view input, bool uppercase = false)
+        {
+            return encode(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(input.data()), input.size()),
+                          uppercase);
+        }
+
+        /**
+         * @brief 解码为字节数组
+         * @param input 十六进制字符串
+         * @return 解码后的字节
+         * @throws std::runtime_error 长度为奇数或包含非十六进制字符
+         */
+        static std::vector<uint8_t> decode(std::string_view input)
+        {
+            std::vector<uint8_t> result(decodedLength(input.size()));
+            if (!decodeInto(input, result)) {
+                throw std::runtime_error("Input is not valid hex-encoded data.");
+            }
+            return result;
+        }
+
+        /**
+         * @brief 获取当前块编解码使用的指令集
+         * @return CodecBackend 枚举值
+         */
+        static CodecBackend backend() { return detail::codecSelectBackend(); }
+    };
+}
+
+#endif // GALAY_UTILS_HEX_H
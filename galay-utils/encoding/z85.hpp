@@ -0,0 +1,170 @@
+/**
+ * @file z85.hpp
+ * @brief Z85 编解码（ZeroMQ RFC 32 的 Base85 变体）
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 每 4 字节按大端解释为 32 位整数，输出 5 个字符，膨胀率 25%（Base64 为 33%）。
+ *          字母表不含引号和反斜杠，可直接嵌入源码、JSON 与命令行。
+ *          输入长度必须是 4 的倍数（编码）或 5 的倍数（解码）。
+ */
+
+#ifndef GALAY_UTILS_Z85_H
+#define GALAY_UTILS_Z85_H
+
+#include "galay-utils/encoding/codec.hpp"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace galay::utils
+{
+    namespace detail
+    {
+        inline constexpr char z85Alphabet[] =
+            "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+
+        /// ASCII 到 0-84 的值，非法字符为 0xFF
+        inline constexpr std::array<uint8_t, 256> z85DecodeTable = [] {
+            std::array<uint8_t, 256> table{};
+            for (auto& value : table) {
+                value = 0xFF;
+            }
+            for (uint8_t i = 0; i < 85; ++i) {
+                table[static_cast<unsigned char>(z85Alphabet[i])] = i;
+            }
+            return table;
+        }();
+    }
+
+    /**
+     * @brief Z85 编解码
+     * @details *Into 接口写入调用方缓冲区、不抛异常；encode() / decode() 为返回容器的便捷包装。
+     */
+    class Z85Codec
+    {
+    public:
+        /**
+         * @brief 计算编码后的字符数
+         * @param length 原始字节数，须为 4 的倍数
+         */
+        static constexpr size_t encodedLength(size_t length) { return length / 4 * 5; }
+
+        /**
+         * @brief 计算解码后的字节数
+         * @param length Z85 字符数，须为 5 的倍数
+         */
+        static constexpr size_t decodedLength(size_t length) { return length / 5 * 4; }
+
+        /**
+         * @brief 编码到调用方缓冲区
+         * @param input 原始字节，长度须为 4 的倍数
+         * @param output 输出缓冲区，至少 encodedLength(input.size()) 字节
+         * @return 长度不是 4 的倍数时返回 InvalidLength；缓冲区不足时返回 OutputTooSmall
+         */
+        static CodecResult encodeInto(std::span<const uint8_t> input, std::span<char> output)
+        {
+            if (input.size() % 4 != 0) {
+                return {0, input.size() - input.size() % 4, CodecStatus::InvalidLength};
+            }
+            const size_t required = encodedLength(input.size());
+            if (output.size() < required) {
+                return {0, 0, CodecStatus::OutputTooSmall};
+            }
+            const uint8_t* in = input.data();
+            char* out = output.data();
+            for (size_t i = 0; i < input.size(); i += 4, out += 5) {
+                uint32_t value = (static_cast<uint32_t>(in[i]) << 24)
+                               | (static_cast<uint32_t>(in[i + 1]) << 16)
+                               | (static_cast<uint32_t>(in[i + 2]) << 8)
+                               | in[i + 3];
+                for (int j = 4; j >= 0; --j) {
+                    out[j] = detail::z85Alphabet[value % 85];
+                    value /= 85;
+                }
+            }
+            return {required, input.size(), CodecStatus::Ok};
+        }
+
+        /**
+         * @brief 解码到调用方缓冲区
+         * @param input Z85 字符串，长度须为 5 的倍数
+         * @param output 输出缓冲区，至少 decodedLength(input.size()) 字节
+         * @return 失败时 position 为出错字符下标（数值溢出时为该分组首字符），length 为出错前已写入的字节数
+         */
+        static CodecResult decodeInto(std::string_view input, std::span<uint8_t> output)
+        {
+            if (input.size() % 5 != 0) {
+                return {0, input.size() - input.size() % 5, CodecStatus::InvalidLength};
+            }
+            const size_t required = decodedLength(input.size());
+            if (output.size() < required) {
+                return {0, 0, CodecStatus::OutputTooSmall};
+            }
+            uint8_t* out = output.data();
+            for (size_t pos = 0; pos < input.size(); pos += 5, out += 4) {
+                uint64_t value = 0;
+                for (size_t j = 0; j < 5; ++j) {
+                    const uint8_t v = detail::z85DecodeTable[static_cast<unsigned char>(input[pos + j])];
+                    if (v == 0xFF) {
+                        return {pos / 5 * 4, pos + j, CodecStatus::InvalidCharacter};
+                    }
+                    value = value * 85 + v;
+                }
+                // 5 个字符最大可表示 85^5 - 1 > 2^32 - 1
+                if (value > 0xFFFFFFFFu) {
+                    return {pos / 5 * 4, pos, CodecStatus::InvalidCharacter};
+                }
+                out[0] = static_cast<uint8_t>(value >> 24);
+                out[1] = static_cast<uint8_t>(value >> 16);
+                out[2] = static_cast<uint8_t>(value >> 8);
+                out[3] = static_cast<uint8_t>(value);
+            }
+            return {required, input.size(), CodecStatus::Ok};
+        }
+
+        /**
+         * @brief 编码为字符串
+         * @param input 原始字节，长度须为 4 的倍数
+         * @throws std::invalid_argument 长度不是 4 的倍数
+         */
+        static std::string encode(std::span<const uint8_t> input)
+        {
+            if (input.size() % 4 != 0) {
+                throw std::invalid_argument("Z85 input length must be a multiple of 4");
+            }
+            std::string result(encodedLength(input.size()), '\0');
+            encodeInto(input, result);
+            return result;
+        }
+
+        /**
+         * @brief 编码字符串的原始字节
+         */
+        static std::string encode(std::string_view input)
+        {
+            return encode(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(input.data()), input.size()));
+        }
+
+        /**
+         * @brief 解码为字节数组
+         * @param input Z85 字符串
+         * @return 解码后的字节
+         * @throws std::runtime_error 长度不是 5 的倍数、包含非法字符或分组数值溢出
+         */
+        static std::vector<uint8_t> decode(std::string_view input)
+        {
+            std::vector<uint8_t> result(decodedLength(input.size()));
+            if (!decodeInto(input, result)) {
+                throw std::runtime_error("Input is not valid Z85-encoded data.");
+            }
+            return result;
+        }
+    };
+}
+
+#endif // GALAY_UTILS_Z85_H
@@ -15,17 +15,32 @@
 /// 类型名称工具
 #include "galay-utils/core/type_name.hpp"
 
+/// ASCII 分类、大小写与 UTF-8 校验
+#include "galay-utils/core/ascii.hpp"
+
 /// 字符串工具
 #include "galay-utils/core/string.hpp"
 
 /// 随机数生成
 #include "galay-utils/core/random.hpp"
 
+/// 按时间排序的唯一 ID
+#include "galay-utils/core/id.hpp"
+
+/// 并发字符串驻留池
+#include "galay-utils/core/interner.hpp"
+
 /// 系统工具
 #include "galay-utils/process/system.hpp"
 
 /// 时间工具
 #include "galay-utils/core/time.hpp"
+/// 热路径时钟源（TSC / 粗粒度 / 缓存时钟）
+#include "galay-utils/core/clock.hpp"
+/// 对数线性直方图与作用域计时
+#include "galay-utils/core/histogram.hpp"
+/// 指标注册表与 Prometheus / JSON 导出
+#include "galay-utils/core/metrics.hpp"
 
 /// 堆栈跟踪
 #include "galay-utils/process/backtrace.hpp"
@@ -50,6 +65,8 @@
 
 /// 线程池
 #include "galay-utils/tool/thread.hpp"
+/// 分层时间轮定时器
+#include "galay-utils/tool/timer.hpp"
 
 /// 熔断器
 #include "galay-utils/tool/circuit_breaker.hpp"
@@ -81,12 +98,24 @@
 /// 负载均衡
 #include "galay-utils/tool/balancer.hpp"
 
+/// 编解码公共结果类型
+#include "galay-utils/encoding/codec.hpp"
 /// Base64 编解码
 #include "galay-utils/encoding/base64.hpp"
+/// 十六进制编解码
+#include "galay-utils/encoding/hex.hpp"
+/// Base32 编解码（RFC 4648）
+#include "galay-utils/encoding/base32.hpp"
+/// Z85 编解码
+#include "galay-utils/encoding/z85.hpp"
 /// MD5 哈希
 #include "galay-utils/crypto/md5.hpp"
 /// MurmurHash3 哈希
 #include "galay-utils/crypto/murmur_hash3.hpp"
+/// XXH3 哈希
+#include "galay-utils/crypto/xxhash3.hpp"
+/// 密码学安全随机数
+#include "galay-utils/crypto/secure_random.hpp"
 /// 盐值生成
 #include "galay-utils/crypto/salt.hpp"
 /// HMAC-SHA256
@@ -8,10 +8,16 @@ export {
 #include "galay-utils/common/defn.hpp"
 #include "galay-utils/core/type_name.hpp"
 
+#include "galay-utils/core/ascii.hpp"
 #include "galay-utils/core/string.hpp"
 #include "galay-utils/core/random.hpp"
+#include "galay-utils/core/id.hpp"
+#include "galay-utils/core/interner.hpp"
 #include "galay-utils/process/system.hpp"
 #include "galay-utils/core/time.hpp"
+#include "galay-utils/core/clock.hpp"
+#include "galay-utils/core/histogram.hpp"
+#include "galay-utils/core/metrics.hpp"
 #include "galay-utils/process/backtrace.hpp"
 #include "galay-utils/process/signal.hpp"
 #include "galay-utils/tool/pool.hpp"
@@ -20,6 +26,7 @@ export {
 #include "galay-utils/cache/byte_queue_view.hpp"
 #include "galay-utils/cache/ring_buffer.hpp"
 #include "galay-utils/tool/thread.hpp"
+#include "galay-utils/tool/timer.hpp"
 #include "galay-utils/tool/circuit_breaker.hpp"
 #include "galay-utils/algorithm/consistent_hash.hpp"
 #include "galay-utils/algorithm/bloom_filter.hpp"
@@ -31,9 +38,15 @@ export {
 #include "galay-utils/process/process.hpp"
 #include "galay-utils/tool/balancer.hpp"
 
+#include "galay-utils/encoding/codec.hpp"
 #include "galay-utils/encoding/base64.hpp"
+#include "galay-utils/encoding/hex.hpp"
+#include "galay-utils/encoding/base32.hpp"
+#include "galay-utils/encoding/z85.hpp"
 #include "galay-utils/crypto/md5.hpp"
 #include "galay-utils/crypto/murmur_hash3.hpp"
+#include "galay-utils/crypto/xxhash3.hpp"
+#include "galay-utils/crypto/secure_random.hpp"
 #include "galay-utils/crypto/salt.hpp"
 #include "galay-utils/crypto/hmac.hpp"
 }
@@ -13,6 +13,9 @@
 #if __has_include(<algorithm>)
 #include <algorithm>
 #endif
+#if __has_include(<arm_neon.h>) && (defined(__ARM_NEON) || defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h>
+#endif
 #if __has_include(<arpa/inet.h>)
 #include <arpa/inet.h>
 #endif
@@ -22,12 +25,30 @@
 #if __has_include(<atomic>)
 #include <atomic>
 #endif
+#if __has_include(<bit>)
+#include <bit>
+#endif
 #if __has_include(<cctype>)
 #include <cctype>
 #endif
+#if __has_include(<cerrno>)
+#include <cerrno>
+#endif
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
 #if __has_include(<chrono>)
 #include <chrono>
 #endif
+#if __has_include(<climits>)
+#include <climits>
+#endif
+#if __has_include(<cmath>)
+#include <cmath>
+#endif
+#if __has_include(<compare>)
+#include <compare>
+#endif
 #if __has_include(<condition_variable>)
 #include <condition_variable>
 #endif
@@ -37,12 +58,18 @@
 #if __has_include(<csignal>)
 #include <csignal>
 #endif
+#if __has_include(<cpuid.h>) && (defined(__x86_64__) || defined(_M_X64))
+#include <cpuid.h>
+#endif
 #if __has_include(<cstddef>)
 #include <cstddef>
 #endif
 #if __has_include(<cstdint>)
 #include <cstdint>
 #endif
+#if __has_include(<cstdio>)
+#include <cstdio>
+#endif
 #if __has_include(<cstdlib>)
 #include <cstdlib>
 #endif
@@ -55,6 +82,9 @@
 #if __has_include(<cxxabi.h>)
 #include <cxxabi.h>
 #endif
+#if __has_include(<deque>)
+#include <deque>
+#endif
 #if __has_include(<direct.h>)
 #include <direct.h>
 #endif
@@ -73,6 +103,9 @@
 #if __has_include(<fcntl.h>)
 #include <fcntl.h>
 #endif
+#if __has_include(<format>)
+#include <format>
+#endif
 #if __has_include(<fstream>)
 #include <fstream>
 #endif
@@ -82,12 +115,27 @@
 #if __has_include(<future>)
 #include <future>
 #endif
+#if __has_include(<immintrin.h>) && (defined(__x86_64__) || defined(_M_X64))
+#include <immintrin.h>
+#endif
+#if __has_include(<initializer_list>)
+#include <initializer_list>
+#endif
+#if __has_include(<intrin.h>) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
 #if __has_include(<iomanip>)
 #include <iomanip>
 #endif
 #if __has_include(<iostream>)
 #include <iostream>
 #endif
+#if __has_include(<iterator>)
+#include <iterator>
+#endif
+#if __has_include(<limits>)
+#include <limits>
+#endif
 #if __has_include(<mach-o/dyld.h>)
 #include <mach-o/dyld.h>
 #endif
@@ -103,15 +151,24 @@
 #if __has_include(<netdb.h>)
 #include <netdb.h>
 #endif
+#if __has_include(<new>)
+#include <new>
+#endif
 #if __has_include(<optional>)
 #include <optional>
 #endif
+#if __has_include(<pthread.h>)
+#include <pthread.h>
+#endif
 #if __has_include(<queue>)
 #include <queue>
 #endif
 #if __has_include(<random>)
 #include <random>
 #endif
+#if __has_include(<sched.h>)
+#include <sched.h>
+#endif
 #if __has_include(<set>)
 #include <set>
 #endif
@@ -121,6 +178,9 @@
 #if __has_include(<signal.h>)
 #include <signal.h>
 #endif
+#if __has_include(<span>)
+#include <span>
+#endif
 #if __has_include(<sstream>)
 #include <sstream>
 #endif
@@ -136,6 +196,9 @@
 #if __has_include(<sys/mman.h>)
 #include <sys/mman.h>
 #endif
+#if __has_include(<sys/random.h>)
+#include <sys/random.h>
+#endif
 #if __has_include(<sys/stat.h>)
 #include <sys/stat.h>
 #endif
@@ -145,6 +208,9 @@
 #if __has_include(<sys/wait.h>)
 #include <sys/wait.h>
 #endif
+#if __has_include(<system_error>)
+#include <system_error>
+#endif
 #if __has_include(<thread>)
 #include <thread>
 #endif
@@ -172,6 +238,9 @@
 #if __has_include(<vector>)
 #include <vector>
 #endif
+#if __has_include(<version>)
+#include <version>
+#endif
 #if __has_include(<windows.h>)
 #include <windows.h>
 #endif
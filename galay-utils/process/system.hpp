@@ -5,7 +5,10 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <algorithm>
+#include <cerrno>
 #include <fstream>
+#include <iterator>
 #include <thread>
 
 #if defined(GALAY_PLATFORM_MACOS) || defined(GALAY_PLATFORM_LINUX) || defined(__APPLE__) || defined(__linux__)
@@ -159,6 +162,58 @@ public:
 #endif
     }
 
+    /**
+     * @brief 以 read() 循环读入整个文件，直到读到 EOF
+     * @details 不依赖 st_size，管道、/proc 文件与进程替换（<(...)）等大小为 0 的非常规文件也能读全；
+     *          常规文件按 st_size 预留容量。读取期间文件被截断时只会少读，不会像 mmap 那样触发 SIGBUS。
+     */
+    static std::optional<std::string> readFileStream(const std::string& path) {
+#if defined(_WIN32)
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return std::nullopt;
+        }
+        std::string content(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>{});
+        if (file.bad()) {
+            return std::nullopt;
+        }
+        return content;
+#else
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return std::nullopt;
+        }
+
+        // 常规文件多留 1 字节，读满 st_size 后的那次 read() 直接读到 EOF，不必再扩容
+        std::string content;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            content.resize(static_cast<size_t>(st.st_size) + 1);
+        }
+
+        size_t used = 0;
+        while (true) {
+            if (used == content.size()) {
+                content.resize(std::max<size_t>(content.size() * 2, 4096));
+            }
+            const ssize_t n = ::read(fd, content.data() + used, content.size() - used);
+            if (n > 0) {
+                used += static_cast<size_t>(n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            close(fd);
+            if (n < 0) {
+                return std::nullopt;
+            }
+            content.resize(used);
+            return content;
+        }
+#endif
+    }
+
     static bool fileExists(const std::string& path) {
 #if defined(_WIN32)
         DWORD attrs = GetFileAttributesA(path.c_str());
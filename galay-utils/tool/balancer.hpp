@@ -4,8 +4,10 @@
  * @author galay-utils
  * @version 1.0.0
  *
- * @details 提供四种负载均衡策略：轮询、加权轮询、随机、加权随机。
+ * @details 提供四种负载无关策略：轮询、加权轮询、随机、加权随机；
+ *          以及两种负载感知策略：P2C（Power of Two Choices）和最少在途请求。
  *          轮询和随机版本是线程安全的，加权轮询为非线程安全。
+ *          负载感知策略的 select() 线程安全，返回 RAII 选择句柄记录完成与延迟。
  */
 
 #ifndef GALAY_LOADBALANCER_HPP
@@ -13,10 +15,12 @@
 
 #include "galay-utils/common/defn.hpp"
 #include <atomic>
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <random>
 #include <optional>
+#include <utility>
 
 namespace galay::utils
 {
@@ -236,6 +240,285 @@ private:
     std::mt19937 m_rng;
 };
 
+namespace detail {
+
+/**
+ * @brief 负载感知均衡器的单节点统计（缓存行对齐，避免伪共享）
+ * @details 在途请求数与延迟 EWMA 均为原子变量，select() 与完成回调可并发访问。
+ */
+struct alignas(64) BalancerNodeStats {
+    std::atomic<uint32_t> inflight{0}; ///< 在途请求数
+    std::atomic<uint64_t> ewmaLatencyNs{0}; ///< 延迟指数加权移动平均（纳秒），0 表示尚无样本
+    std::atomic<uint64_t> completed{0}; ///< 已完成请求数
+
+    /**
+     * @brief 记录一次延迟样本
+     * @details 首个样本直接作为初值，之后按 alpha = 1/8 衰减：ewma += (sample - ewma) / 8。
+     * @param latencyNs 延迟（纳秒）
+     */
+    void recordLatency(uint64_t latencyNs) noexcept {
+        uint64_t current = ewmaLatencyNs.load(std::memory_order_relaxed);
+        uint64_t next;
+        do {
+            if (current == 0) {
+                next = latencyNs == 0 ? 1 : latencyNs;
+            } else {
+                const int64_t delta = static_cast<int64_t>(latencyNs) - static_cast<int64_t>(current);
+                next = static_cast<uint64_t>(static_cast<int64_t>(current) + delta / 8);
+                if (next == 0) {
+                    next = 1;
+                }
+            }
+        } while (!ewmaLatencyNs.compare_exchange_weak(current, next,
+                    std::memory_order_relaxed, std::memory_order_relaxed));
+    }
+};
+
+/**
+ * @brief 负载感知均衡器节点：节点值与其统计
+ */
+template<typename Type>
+struct BalancerLoadNode {
+    Type node; ///< 节点值
+    BalancerNodeStats stats; ///< 节点统计
+
+    explicit BalancerLoadNode(Type n)
+        : node(std::move(n)) {}
+};
+
+/**
+ * @brief 无锁伪随机源（splitmix64），多线程共享时通过原子递增推进状态
+ */
+class BalancerRandom {
+public:
+    BalancerRandom();
+
+    /**
+     * @brief 生成 [0, bound) 范围内的随机下标
+     * @param bound 上界（必须大于 0）
+     * @return 随机下标
+     */
+    size_t next(size_t bound) noexcept;
+
+private:
+    std::atomic<uint64_t> m_state;
+};
+
+} // namespace detail
+
+/**
+ * @brief 负载感知均衡器返回的 RAII 选择句柄
+ * @details 持有被选节点并计入其在途请求数；析构或调用 complete() 时减少在途数，
+ *          并把自选中起的耗时记录进节点延迟 EWMA。句柄仅可移动，不得晚于所属均衡器析构。
+ * @tparam Type 节点类型
+ * @tparam ClockType 时间源类型，需提供 now() 和 time_point
+ */
+template<typename Type, typename ClockType = std::chrono::steady_clock>
+class LoadBalancerSelection
+{
+public:
+    using value_type = Type; ///< 节点值类型
+    using Clock = ClockType; ///< 时间源类型
+    using TimePoint = typename Clock::time_point; ///< 时间点类型
+
+    LoadBalancerSelection() = default;
+
+    /**
+     * @brief 构造选择句柄（由均衡器调用）
+     * @param node 被选节点
+     * @param start 选中时刻
+     */
+    LoadBalancerSelection(detail::BalancerLoadNode<Type>* node, TimePoint start) noexcept
+        : m_node(node), m_start(start) {}
+
+    LoadBalancerSelection(const LoadBalancerSelection&) = delete;
+    LoadBalancerSelection& operator=(const LoadBalancerSelection&) = delete;
+
+    LoadBalancerSelection(LoadBalancerSelection&& other) noexcept
+        : m_node(std::exchange(other.m_node, nullptr)), m_start(other.m_start) {}
+
+    LoadBalancerSelection& operator=(LoadBalancerSelection&& other) noexcept {
+        if (this != &other) {
+            complete();
+            m_node = std::exchange(other.m_node, nullptr);
+            m_start = other.m_start;
+        }
+        return *this;
+    }
+
+    ~LoadBalancerSelection() { complete(); }
+
+    bool has_value() const noexcept { return m_node != nullptr; } ///< 是否持有节点
+    explicit operator bool() const noexcept { return has_value(); } ///< 是否持有节点
+
+    const Type& value() const { return m_node->node; } ///< 获取节点值，调用前需确认 has_value()
+    const Type& operator*() const { return m_node->node; } ///< 获取节点值
+    const Type* operator->() const { return &m_node->node; } ///< 访问节点成员
+
+    /**
+     * @brief 记录完成，延迟取自选中起到当前时刻的耗时
+     */
+    void complete();
+
+    /**
+     * @brief 记录完成并使用调用方测得的延迟
+     * @param latency 请求延迟
+     */
+    void complete(std::chrono::nanoseconds latency);
+
+    /**
+     * @brief 释放在途计数但不记录延迟样本（例如请求未真正发出）
+     */
+    void release() noexcept;
+
+private:
+    detail::BalancerLoadNode<Type>* m_node = nullptr;
+    TimePoint m_start{};
+};
+
+/**
+ * @brief P2C 负载评估方式
+ */
+enum class P2CMetric {
+    Outstanding, ///< 比较在途请求数，相同时比较延迟 EWMA
+    LatencyEwma, ///< 比较 EWMA 延迟 × (在途请求数 + 1)，无样本的节点优先被探测
+};
+
+/**
+ * @brief P2C（Power of Two Choices）负载均衡器（select 线程安全）
+ * @details 每次随机取两个不同节点，选择负载更低者。节点统计使用缓存行对齐的原子变量，
+ *          select() 无锁；append() 不与 select() 同步，运行期追加需外部同步。
+ * @tparam Type 节点类型
+ * @tparam ClockType 时间源类型，默认 std::chrono::steady_clock
+ */
+template<typename Type, typename ClockType = std::chrono::steady_clock>
+class P2CLoadBalancer
+{
+public:
+    using value_type = Type; ///< 节点值类型
+    using Selection = LoadBalancerSelection<Type, ClockType>; ///< 选择句柄类型
+    using uptr = std::unique_ptr<P2CLoadBalancer>; ///< 独占指针类型
+    using ptr = std::shared_ptr<P2CLoadBalancer>; ///< 共享指针类型
+
+    /**
+     * @brief 构造 P2C 负载均衡器
+     * @param nodes 节点列表
+     * @param metric 负载评估方式
+     */
+    explicit P2CLoadBalancer(const std::vector<Type>& nodes, P2CMetric metric = P2CMetric::Outstanding);
+
+    /**
+     * @brief 移动构造 P2C 负载均衡器
+     * @param nodes 节点列表（右值）
+     * @param metric 负载评估方式
+     */
+    explicit P2CLoadBalancer(std::vector<Type>&& nodes, P2CMetric metric = P2CMetric::Outstanding);
+
+    /**
+     * @brief 选择负载较低的节点
+     * @return 选择句柄，无节点时 has_value() 为 false
+     */
+    Selection select();
+
+    /**
+     * @brief 获取节点数量
+     * @return 节点数量
+     */
+    size_t size() const;
+
+    /**
+     * @brief 追加节点
+     * @param node 新节点
+     */
+    void append(Type node);
+
+    /**
+     * @brief 获取指定节点的在途请求数
+     * @param index 节点下标
+     * @return 在途请求数
+     */
+    uint32_t inflight(size_t index) const;
+
+    /**
+     * @brief 获取指定节点的延迟 EWMA
+     * @param index 节点下标
+     * @return 延迟 EWMA，无样本时为 0
+     */
+    std::chrono::nanoseconds latencyEwma(size_t index) const;
+
+private:
+    uint64_t cost(const detail::BalancerNodeStats& stats) const noexcept;
+
+    std::vector<std::unique_ptr<detail::BalancerLoadNode<Type>>> m_nodes;
+    P2CMetric m_metric;
+    detail::BalancerRandom m_random;
+};
+
+/**
+ * @brief 最少在途请求负载均衡器（select 线程安全）
+ * @details 遍历全部节点选择在途请求数最少者；起始位置轮转，使并列节点均匀分摊。
+ *          适合节点数较少、需要严格按负载分配的场景；节点较多时推荐 P2CLoadBalancer。
+ * @tparam Type 节点类型
+ * @tparam ClockType 时间源类型，默认 std::chrono::steady_clock
+ */
+template<typename Type, typename ClockType = std::chrono::steady_clock>
+class LeastOutstandingLoadBalancer
+{
+public:
+    using value_type = Type; ///< 节点值类型
+    using Selection = LoadBalancerSelection<Type, ClockType>; ///< 选择句柄类型
+    using uptr = std::unique_ptr<LeastOutstandingLoadBalancer>; ///< 独占指针类型
+    using ptr = std::shared_ptr<LeastOutstandingLoadBalancer>; ///< 共享指针类型
+
+    /**
+     * @brief 构造最少在途请求负载均衡器
+     * @param nodes 节点列表
+     */
+    explicit LeastOutstandingLoadBalancer(const std::vector<Type>& nodes);
+
+    /**
+     * @brief 移动构造最少在途请求负载均衡器
+     * @param nodes 节点列表（右值）
+     */
+    explicit LeastOutstandingLoadBalancer(std::vector<Type>&& nodes);
+
+    /**
+     * @brief 选择在途请求最少的节点
+     * @return 选择句柄，无节点时 has_value() 为 false
+     */
+    Selection select();
+
+    /**
+     * @brief 获取节点数量
+     * @return 节点数量
+     */
+    size_t size() const;
+
+    /**
+     * @brief 追加节点
+     * @param node 新节点
+     */
+    void append(Type node);
+
+    /**
+     * @brief 获取指定节点的在途请求数
+     * @param index 节点下标
+     * @return 在途请求数
+     */
+    uint32_t inflight(size_t index) const;
+
+    /**
+     * @brief 获取指定节点的延迟 EWMA
+     * @param index 节点下标
+     * @return 延迟 EWMA，无样本时为 0
+     */
+    std::chrono::nanoseconds latencyEwma(size_t index) const;
+
+private:
+    std::vector<std::unique_ptr<detail::BalancerLoadNode<Type>>> m_nodes;
+    std::atomic_uint32_t m_index{0};
+};
+
 } // namespace galay::utils
 
 #include "balancer.inl"
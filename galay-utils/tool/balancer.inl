@@ -201,6 +201,222 @@ inline void WeightedRandomLoadBalancer<Type>::append(Type node, uint32_t weight)
     m_total_weight += weight;
 }
 
+namespace detail {
+
+inline BalancerRandom::BalancerRandom()
+{
+    std::random_device rd;
+    m_state.store((static_cast<uint64_t>(rd()) << 32) ^ rd(), std::memory_order_relaxed);
+}
+
+inline size_t BalancerRandom::next(size_t bound) noexcept
+{
+    uint64_t z = m_state.fetch_add(0x9e3779b97f4a7c15ULL, std::memory_order_relaxed)
+        + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    return static_cast<size_t>(z % bound);
+}
+
+} // namespace detail
+
+template<typename Type, typename ClockType>
+inline void LoadBalancerSelection<Type, ClockType>::complete()
+{
+    if (!m_node) {
+        return;
+    }
+    const auto elapsed = ClockType::now() - m_start;
+    complete(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+}
+
+template<typename Type, typename ClockType>
+inline void LoadBalancerSelection<Type, ClockType>::complete(std::chrono::nanoseconds latency)
+{
+    if (!m_node) {
+        return;
+    }
+    const int64_t latencyNs = latency.count();
+    m_node->stats.recordLatency(latencyNs > 0 ? static_cast<uint64_t>(latencyNs) : 0);
+    m_node->stats.completed.fetch_add(1, std::memory_order_relaxed);
+    release();
+}
+
+template<typename Type, typename ClockType>
+inline void LoadBalancerSelection<Type, ClockType>::release() noexcept
+{
+    if (!m_node) {
+        return;
+    }
+    m_node->stats.inflight.fetch_sub(1, std::memory_order_relaxed);
+    m_node = nullptr;
+}
+
+template<typename Type, typename ClockType>
+inline P2CLoadBalancer<Type, ClockType>::P2CLoadBalancer(const std::vector<Type>& nodes, P2CMetric metric)
+    : m_metric(metric)
+{
+    m_nodes.reserve(nodes.size());
+    for (const auto& node : nodes) {
+        m_nodes.emplace_back(std::make_unique<detail::BalancerLoadNode<Type>>(node));
+    }
+}
+
+template<typename Type, typename ClockType>
+inline P2CLoadBalancer<Type, ClockType>::P2CLoadBalancer(std::vector<Type>&& nodes, P2CMetric metric)
+    : m_metric(metric)
+{
+    m_nodes.reserve(nodes.size());
+    for (auto& node : nodes) {
+        m_nodes.emplace_back(std::make_unique<detail::BalancerLoadNode<Type>>(std::move(node)));
+    }
+}
+
+template<typename Type, typename ClockType>
+inline uint64_t P2CLoadBalancer<Type, ClockType>::cost(const detail::BalancerNodeStats& stats) const noexcept
+{
+    const uint64_t inflight = stats.inflight.load(std::memory_order_relaxed);
+    if (m_metric == P2CMetric::Outstanding) {
+        return inflight;
+    }
+    const uint64_t ewma = stats.ewmaLatencyNs.load(std::memory_order_relaxed);
+    if (ewma == 0) {
+        return inflight; // 无样本节点按在途数估价，便于尽快获得延迟样本
+    }
+    return ewma * (inflight + 1);
+}
+
+template<typename Type, typename ClockType>
+inline typename P2CLoadBalancer<Type, ClockType>::Selection P2CLoadBalancer<Type, ClockType>::select()
+{
+    const size_t count = m_nodes.size();
+    if (count == 0) {
+        return Selection{};
+    }
+
+    detail::BalancerLoadNode<Type>* chosen = m_nodes[0].get();
+    if (count > 1) {
+        const size_t first = m_random.next(count);
+        size_t second = m_random.next(count - 1);
+        if (second >= first) {
+            ++second;
+        }
+
+        auto* a = m_nodes[first].get();
+        auto* b = m_nodes[second].get();
+        const uint64_t costA = cost(a->stats);
+        const uint64_t costB = cost(b->stats);
+        if (costA != costB) {
+            chosen = costA < costB ? a : b;
+        } else {
+            const uint64_t latencyA = a->stats.ewmaLatencyNs.load(std::memory_order_relaxed);
+            const uint64_t latencyB = b->stats.ewmaLatencyNs.load(std::memory_order_relaxed);
+            chosen = latencyB < latencyA ? b : a;
+        }
+    }
+
+    chosen->stats.inflight.fetch_add(1, std::memory_order_relaxed);
+    return Selection(chosen, ClockType::now());
+}
+
+template<typename Type, typename ClockType>
+inline size_t P2CLoadBalancer<Type, ClockType>::size() const
+{
+    return m_nodes.size();
+}
+
+template<typename Type, typename ClockType>
+inline void P2CLoadBalancer<Type, ClockType>::append(Type node)
+{
+    m_nodes.emplace_back(std::make_unique<detail::BalancerLoadNode<Type>>(std::move(node)));
+}
+
+template<typename Type, typename ClockType>
+inline uint32_t P2CLoadBalancer<Type, ClockType>::inflight(size_t index) const
+{
+    return m_nodes.at(index)->stats.inflight.load(std::memory_order_relaxed);
+}
+
+template<typename Type, typename ClockType>
+inline std::chrono::nanoseconds P2CLoadBalancer<Type, ClockType>::latencyEwma(size_t index) const
+{
+    const uint64_t ewma = m_nodes.at(index)->stats.ewmaLatencyNs.load(std::memory_order_relaxed);
+    return std::chrono::nanoseconds(static_cast<int64_t>(ewma));
+}
+
+template<typename Type, typename ClockType>
+inline LeastOutstandingLoadBalancer<Type, ClockType>::LeastOutstandingLoadBalancer(const std::vector<Type>& nodes)
+{
+    m_nodes.reserve(nodes.size());
+    for (const auto& node : nodes) {
+        m_nodes.emplace_back(std::make_unique<detail::BalancerLoadNode<Type>>(node));
+    }
+}
+
+template<typename Type, typename ClockType>
+inline LeastOutstandingLoadBalancer<Type, ClockType>::LeastOutstandingLoadBalancer(std::vector<Type>&& nodes)
+{
+    m_nodes.reserve(nodes.size());
+    for (auto& node : nodes) {
+        m_nodes.emplace_back(std::make_unique<detail::BalancerLoadNode<Type>>(std::move(node)));
+    }
+}
+
+template<typename Type, typename ClockType>
+inline typename LeastOutstandingLoadBalancer<Type, ClockType>::Selection LeastOutstandingLoadBalancer<Type, ClockType>::select()
+{
+    const size_t count = m_nodes.size();
+    if (count == 0) {
+        return Selection{};
+    }
+
+    // 起始位置轮转，在途数相同时依次分摊到不同节点
+    const size_t start = m_index.fetch_add(1, std::memory_order_relaxed) % count;
+    detail::BalancerLoadNode<Type>* chosen = nullptr;
+    uint32_t best = std::numeric_limits<uint32_t>::max();
+
+    for (size_t i = 0; i < count; ++i) {
+        auto* candidate = m_nodes[(start + i) % count].get();
+        const uint32_t inflight = candidate->stats.inflight.load(std::memory_order_relaxed);
+        if (!chosen || inflight < best) {
+            chosen = candidate;
+            best = inflight;
+            if (best == 0) {
+                break;
+            }
+        }
+    }
+
+    chosen->stats.inflight.fetch_add(1, std::memory_order_relaxed);
+    return Selection(chosen, ClockType::now());
+}
+
+template<typename Type, typename ClockType>
+inline size_t LeastOutstandingLoadBalancer<Type, ClockType>::size() const
+{
+    return m_nodes.size();
+}
+
+template<typename Type, typename ClockType>
+inline void LeastOutstandingLoadBalancer<Type, ClockType>::append(Type node)
+{
+    m_nodes.emplace_back(std::make_unique<detail::BalancerLoadNode<Type>>(std::move(node)));
+}
+
+template<typename Type, typename ClockType>
+inline uint32_t LeastOutstandingLoadBalancer<Type, ClockType>::inflight(size_t index) const
+{
+    return m_nodes.at(index)->stats.inflight.load(std::memory_order_relaxed);
+}
+
+template<typename Type, typename ClockType>
+inline std::chrono::nanoseconds LeastOutstandingLoadBalancer<Type, ClockType>::latencyEwma(size_t index) const
+{
+    const uint64_t ewma = m_nodes.at(index)->stats.ewmaLatencyNs.load(std::memory_order_relaxed);
+    return std::chrono::nanoseconds(static_cast<int64_t>(ewma));
+}
+
 } // namespace galay::utils
 
 #endif // GALAY_LOADBALANCER_INL
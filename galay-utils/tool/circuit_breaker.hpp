@@ -116,42 +116,10 @@ public:
      * @return 允许请求返回 true，熔断中返回 false
      */
     bool allowRequest() {
-        auto currentState = static_cast<CircuitState>(m_state.load(std::memory_order_acquire));
-
-        switch (currentState) {
-            case CircuitState::Closed:
-                return true;
-
-            case CircuitState::Open: {
-                auto now = nowNs();
-                auto lastFailure = m_lastFailureTimeNs.load(std::memory_order_acquire);
-                auto timeoutNs = m_resetTimeoutNs;
-
-                if (now >= lastFailure && now - lastFailure >= timeoutNs) {
-                    // 尝试转换到 HalfOpen
-                    int expected = static_cast<int>(CircuitState::Open);
-                    if (m_state.compare_exchange_strong(expected,
-                            static_cast<int>(CircuitState::HalfOpen),
-                            std::memory_order_acq_rel)) {
-                        m_successCount.store(0, std::memory_order_release);
-                        m_failureCount.store(0, std::memory_order_release);
-                        m_halfOpenInFlight.store(0, std::memory_order_release);
-                    }
-
-                    auto observedState = static_cast<CircuitState>(
-                        m_state.load(std::memory_order_acquire));
-                    if (observedState == CircuitState::HalfOpen) {
-                        return tryAcquireHalfOpenProbe();
-                    }
-                    return observedState == CircuitState::Closed;
-                }
-                return false;
-            }
-
-            case CircuitState::HalfOpen:
-                return tryAcquireHalfOpenProbe();
+        if (GALAY_LIKELY(tryAllowRequest())) {
+            return true;
         }
-
+        m_rejectedCount.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
 
@@ -322,6 +290,14 @@ public:
         return m_successCount.load(std::memory_order_acquire);
     }
 
+    /**
+     * @brief 获取 allowRequest() 拒绝的累计次数（含 execute() 中的拒绝），reset() 不清零
+     * @return 被拒绝次数
+     */
+    uint64_t rejectedCount() const {
+        return m_rejectedCount.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief 重置熔断器为关闭状态
      */
@@ -382,6 +358,46 @@ private:
             Clock::now().time_since_epoch()).count();
     }
 
+    bool tryAllowRequest() {
+        auto currentState = static_cast<CircuitState>(m_state.load(std::memory_order_acquire));
+
+        switch (currentState) {
+            case CircuitState::Closed:
+                return true;
+
+            case CircuitState::Open: {
+                auto now = nowNs();
+                auto lastFailure = m_lastFailureTimeNs.load(std::memory_order_acquire);
+                auto timeoutNs = m_resetTimeoutNs;
+
+                if (now >= lastFailure && now - lastFailure >= timeoutNs) {
+                    // 尝试转换到 HalfOpen
+                    int expected = static_cast<int>(CircuitState::Open);
+                    if (m_state.compare_exchange_strong(expected,
+                            static_cast<int>(CircuitState::HalfOpen),
+                            std::memory_order_acq_rel)) {
+                        m_successCount.store(0, std::memory_order_release);
+                        m_failureCount.store(0, std::memory_order_release);
+                        m_halfOpenInFlight.store(0, std::memory_order_release);
+                    }
+
+                    auto observedState = static_cast<CircuitState>(
+                        m_state.load(std::memory_order_acquire));
+                    if (observedState == CircuitState::HalfOpen) {
+                        return tryAcquireHalfOpenProbe();
+                    }
+                    return observedState == CircuitState::Closed;
+                }
+                return false;
+            }
+
+            case CircuitState::HalfOpen:
+                return tryAcquireHalfOpenProbe();
+        }
+
+        return false;
+    }
+
     bool tryAcquireHalfOpenProbe() {
         auto current = m_halfOpenInFlight.load(std::memory_order_relaxed);
         while (current < m_config.halfOpenMaxRequests) {
@@ -414,6 +430,7 @@ private:
     std::atomic<size_t> m_successCount;
     std::atomic<size_t> m_halfOpenInFlight;
     std::atomic<int64_t> m_lastFailureTimeNs;
+    alignas(64) std::atomic<uint64_t> m_rejectedCount{0};
 };
 
 using CircuitBreaker = BasicCircuitBreaker<>;
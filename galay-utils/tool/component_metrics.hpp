@@ -0,0 +1,257 @@
+/**
+ * @file component_metrics.hpp
+ * @brief 把库内组件的运行状态注册到 MetricsRegistry
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 每个 registerMetrics() 重载注册一个采集回调，在 MetricsRegistry::snapshot() 时读取组件已有的
+ *          计数与状态，组件的热路径不增加任何开销。所有序列带有 name 标签区分实例。
+ *          返回的 MetricsRegistration 析构时注销回调；组件必须比注册句柄存活更久。
+ */
+
+#ifndef GALAY_UTILS_COMPONENT_METRICS_HPP
+#define GALAY_UTILS_COMPONENT_METRICS_HPP
+
+#include "galay-utils/algorithm/consistent_hash.hpp"
+#include "galay-utils/cache/lru_cache.hpp"
+#include "galay-utils/core/metrics.hpp"
+#include "galay-utils/tool/balancer.hpp"
+#include "galay-utils/tool/circuit_breaker.hpp"
+#include "galay-utils/tool/pool.hpp"
+#include "galay-utils/tool/rate_limiter.hpp"
+#include "galay-utils/tool/thread.hpp"
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace galay::utils {
+
+namespace detail {
+
+inline MetricLabels componentLabels(const std::string& name) {
+    return MetricLabels{{"name", name}};
+}
+
+inline MetricLabels componentLabels(const std::string& name, std::string_view key, std::string value) {
+    return MetricLabels{{"name", name}, {std::string(key), std::move(value)}};
+}
+
+template<typename Cache>
+void collectLruCache(MetricsWriter& out, const std::string& name, const Cache& cache) {
+    out.gauge("lru_cache_size", "Entries currently held by the LRU cache", static_cast<double>(cache.size()),
+              componentLabels(name));
+    out.gauge("lru_cache_capacity", "Configured LRU cache capacity", static_cast<double>(cache.capacity()),
+              componentLabels(name));
+    if constexpr (Cache::statsEnabled()) {
+        const auto stats = cache.stats();
+        out.counter("lru_cache_hits_total", "LRU cache lookups that found an entry",
+                    static_cast<double>(stats.hits), componentLabels(name));
+        out.counter("lru_cache_misses_total", "LRU cache lookups that found no entry",
+                    static_cast<double>(stats.misses), componentLabels(name));
+        out.counter("lru_cache_inserts_total", "Entries inserted into the LRU cache",
+                    static_cast<double>(stats.inserts), componentLabels(name));
+        out.counter("lru_cache_updates_total", "Existing LRU cache entries overwritten",
+                    static_cast<double>(stats.updates), componentLabels(name));
+        const char* help = "Entries removed from the LRU cache by reason";
+        out.counter("lru_cache_evictions_total", help, static_cast<double>(stats.capacityEvictions),
+                    componentLabels(name, "reason", "capacity"));
+        out.counter("lru_cache_evictions_total", help, static_cast<double>(stats.expiredEvictions),
+                    componentLabels(name, "reason", "expired"));
+        out.counter("lru_cache_evictions_total", help, static_cast<double>(stats.removes),
+                    componentLabels(name, "reason", "removed"));
+        out.counter("lru_cache_evictions_total", help, static_cast<double>(stats.clears),
+                    componentLabels(name, "reason", "cleared"));
+    }
+}
+
+template<typename Balancer>
+void collectBalancer(MetricsWriter& out, const std::string& name, const Balancer& balancer) {
+    const size_t nodes = balancer.size();
+    out.gauge("load_balancer_nodes", "Nodes known to the load balancer", static_cast<double>(nodes),
+              componentLabels(name));
+    for (size_t i = 0; i < nodes; ++i) {
+        out.gauge("load_balancer_inflight", "Outstanding requests per node",
+                  static_cast<double>(balancer.inflight(i)), componentLabels(name, "node", std::to_string(i)));
+        out.gauge("load_balancer_latency_ewma_seconds", "Per-node latency EWMA, 0 before the first sample",
+                  std::chrono::duration<double>(balancer.latencyEwma(i)).count(),
+                  componentLabels(name, "node", std::to_string(i)));
+    }
+}
+
+template<typename Limiter>
+void collectRejections(MetricsWriter& out, const std::string& name, std::string_view kind, const Limiter& limiter) {
+    out.counter("rate_limiter_rejected_total", "tryAcquire() calls rejected by the limiter",
+                static_cast<double>(limiter.rejectedCount()), componentLabels(name, "kind", std::string(kind)));
+}
+
+} // namespace detail
+
+/**
+ * @brief 注册 LruCache 的容量与命中 / 淘汰统计
+ * @details 命中、未命中与按原因区分的淘汰计数仅在 EnableStats=true 时导出。
+ * @warning LruCache 非线程安全，本重载在导出线程直接读取缓存；缓存被其他线程修改时应使用带锁的重载。
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Clock, bool EnableStats>
+[[nodiscard]] MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                  const LruCache<Key, Value, Hash, KeyEqual, Clock, EnableStats>& cache) {
+    return registry.addCollector([name = std::move(name), &cache](MetricsWriter& out) {
+        detail::collectLruCache(out, name, cache);
+    });
+}
+
+/**
+ * @brief 注册 LruCache，导出时持有调用方保护该缓存的锁
+ */
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Clock, bool EnableStats,
+         typename Mutex>
+[[nodiscard]] MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                  const LruCache<Key, Value, Hash, KeyEqual, Clock, EnableStats>& cache,
+                                                  Mutex& mutex) {
+    return registry.addCollector([name = std::move(name), &cache, &mutex](MetricsWriter& out) {
+        std::lock_guard<Mutex> lock(mutex);
+        detail::collectLruCache(out, name, cache);
+    });
+}
+
+/// 注册 ObjectPool 的空闲对象数与累计创建数
+template<typename T>
+[[nodiscard]] MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                  const ObjectPool<T>& pool) {
+    return registry.addCollector([name = std::move(name), &pool](MetricsWriter& out) {
+        out.gauge("object_pool_idle", "Idle objects held by the pool", static_cast<double>(pool.size()),
+                  detail::componentLabels(name));
+        out.counter("object_pool_created_total", "Objects created by the pool",
+                    static_cast<double>(pool.totalCreated()), detail::componentLabels(name));
+    });
+}
+
+/// 注册 BlockingObjectPool 的空闲对象数
+template<typename T>
+[[nodiscard]] MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                  const BlockingObjectPool<T>& pool) {
+    return registry.addCollector([name = std::move(name), &pool](MetricsWriter& out) {
+        out.gauge("object_pool_idle", "Idle objects held by the pool", static_cast<double>(pool.available()),
+                  detail::componentLabels(name));
+    });
+}
+
+/// 注册 ThreadPool 的线程数与排队任务数
+[[nodiscard]] inline MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                         const ThreadPool& pool) {
+    return registry.addCollector([name = std::move(name), &pool](MetricsWriter& out) {
+        out.gauge("thread_pool_threads", "Worker threads in the pool", static_cast<double>(pool.threadCount()),
+                  detail::componentLabels(name));
+        out.gauge("thread_pool_pending_tasks", "Tasks queued but not yet started",
+                  static_cast<double>(pool.pendingTasks()), detail::componentLabels(name));
+    });
+}
+
+/**
+ * @brief 注册熔断器状态、当前连续失败数与累计拒绝数
+ * @details circuit_breaker_state 取值 0 = Closed，1 = Open，2 = HalfOpen。
+ */
+template<typename Clock>
+[[nodiscard]] MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                  const BasicCircuitBreaker<Clock>& breaker) {
+    return registry.addCollector([name = std::move(name), &breaker](MetricsWriter& out) {
+        out.gauge("circuit_breaker_state", "0 = closed, 1 = open, 2 = half-open",
+                  static_cast<double>(static_cast<int>(breaker.state())), detail::componentLabels(name));
+        out.gauge("circuit_breaker_consecutive_failures", "Failures counted toward the open threshold",
+                  static_cast<double>(breaker.failureCount()), detail::componentLabels(name));
+        out.counter("circuit_breaker_rejected_total", "Requests rejected while open or half-open",
+                    static_cast<double>(breaker.rejectedCount()), detail::componentLabels(name));
+    });
+}
+
+/// 注册计数信号量的可用许可数与累计拒绝数
+[[nodiscard]] inline MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                         const CountingSemaphore& semaphore) {
+    return registry.addCollector([name = std::move(name), &semaphore](MetricsWriter& out) {
+        out.gauge("semaphore_available", "Permits currently available", static_cast<double>(semaphore.available()),
+                  detail::componentLabels(name));
+        detail::collectRejections(out, name, "semaphore", semaphore);
+    });
+}
+
+/// 注册令牌桶的可用令牌数与累计拒绝数
+template<typename Clock>
+[[nodiscard]] MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                  const BasicTokenBucketLimiter<Clock>& limiter) {
+    return registry.addCollector([name = std::move(name), &limiter](MetricsWriter& out) {
+        out.gauge("rate_limiter_available_tokens", "Tokens left in the bucket (refilled lazily on acquire)",
+                  limiter.availableTokens(), detail::componentLabels(name));
+        detail::collectRejections(out, name, "token_bucket", limiter);
+    });
+}
+
+/// 注册滑动窗口限流器的累计拒绝数
+template<typename Clock>
+[[nodiscard]] MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                  const BasicSlidingWindowLimiter<Clock>& limiter) {
+    return registry.addCollector([name = std::move(name), &limiter](MetricsWriter& out) {
+        detail::collectRejections(out, name, "sliding_window", limiter);
+    });
+}
+
+/// 注册漏桶的当前水量与累计拒绝数
+template<typename Clock>
+[[nodiscard]] MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                  const BasicLeakyBucketLimiter<Clock>& limiter) {
+    return registry.addCollector([name = std::move(name), &limiter](MetricsWriter& out) {
+        out.gauge("rate_limiter_water_level", "Water currently in the bucket (leaked lazily on acquire)",
+                  limiter.currentWater(), detail::componentLabels(name));
+        detail::collectRejections(out, name, "leaky_bucket", limiter);
+    });
+}
+
+/**
+ * @brief 注册 P2C 均衡器的逐节点在途请求数与延迟 EWMA
+ * @warning 与 append() 之间没有同步，运行期追加节点时需与导出互斥
+ */
+template<typename Type, typename Clock>
+[[nodiscard]] MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                  const P2CLoadBalancer<Type, Clock>& balancer) {
+    return registry.addCollector([name = std::move(name), &balancer](MetricsWriter& out) {
+        detail::collectBalancer(out, name, balancer);
+    });
+}
+
+/// 注册最少在途请求均衡器，导出内容与限制同 P2CLoadBalancer
+template<typename Type, typename Clock>
+[[nodiscard]] MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                  const LeastOutstandingLoadBalancer<Type, Clock>& balancer) {
+    return registry.addCollector([name = std::move(name), &balancer](MetricsWriter& out) {
+        detail::collectBalancer(out, name, balancer);
+    });
+}
+
+/**
+ * @brief 注册一致性哈希环的节点数与逐节点 NodeStatus
+ * @details 逐节点序列以 node 标签区分（取 NodeConfig::id），在环的共享锁内读取；
+ *          consistent_hash_node_healthy 取值 1 = 健康，0 = 不健康。
+ */
+template<typename Hasher>
+[[nodiscard]] MetricsRegistration registerMetrics(MetricsRegistry& registry, std::string name,
+                                                  const BasicConsistentHash<Hasher>& ring) {
+    return registry.addCollector([name = std::move(name), &ring](MetricsWriter& out) {
+        out.gauge("consistent_hash_nodes", "Physical nodes on the ring", static_cast<double>(ring.nodeCount()),
+                  detail::componentLabels(name));
+        out.gauge("consistent_hash_virtual_nodes", "Virtual nodes on the ring",
+                  static_cast<double>(ring.virtualNodeCount()), detail::componentLabels(name));
+        ring.forEachNodeStatus([&](const NodeConfig& config, const NodeStatus& status) {
+            out.gauge("consistent_hash_node_healthy", "1 = healthy, 0 = unhealthy",
+                      status.healthy.load(std::memory_order_relaxed) ? 1.0 : 0.0,
+                      detail::componentLabels(name, "node", config.id));
+            out.counter("consistent_hash_node_requests_total", "Requests recorded per node",
+                        static_cast<double>(status.requestCount.load(std::memory_order_relaxed)),
+                        detail::componentLabels(name, "node", config.id));
+            out.counter("consistent_hash_node_failures_total", "Failures recorded per node",
+                        static_cast<double>(status.failureCount.load(std::memory_order_relaxed)),
+                        detail::componentLabels(name, "node", config.id));
+        });
+    });
+}
+
+} // namespace galay::utils
+
+#endif // GALAY_UTILS_COMPONENT_METRICS_HPP
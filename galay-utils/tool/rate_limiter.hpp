@@ -6,6 +6,8 @@
  *
  * @details 提供四种限流器实现：计数信号量、令牌桶、滑动窗口和漏桶。
  *          所有限流器均为无锁非阻塞 API，失败时 tryAcquire() 返回 false。
+ *          依赖时间的限流器以 Basic* 模板接受 Clock 参数（如 core/clock.hpp 中的 TscClock / CoarseClock），
+ *          无前缀名称是默认 steady_clock 的别名。
  */
 
 #ifndef GALAY_UTILS_RATE_LIMITER_HPP
@@ -64,11 +66,23 @@ inline int64_t saturatingAddUnits(int64_t lhs, int64_t rhs) noexcept {
     return lhs + rhs;
 }
 
-inline int64_t nonNegativeSteadyTicks(std::chrono::milliseconds duration) noexcept {
+template<typename Clock>
+inline int64_t nonNegativeClockTicks(std::chrono::milliseconds duration) noexcept {
     if (duration <= std::chrono::milliseconds::zero()) {
         return 0;
     }
-    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration).count();
+    return static_cast<int64_t>(
+        std::chrono::duration_cast<typename Clock::duration>(duration).count());
+}
+
+template<typename Clock>
+inline int64_t clockTicks() noexcept {
+    return static_cast<int64_t>(Clock::now().time_since_epoch().count());
+}
+
+template<typename Clock>
+inline double clockTicksToSeconds(int64_t ticks) noexcept {
+    return std::chrono::duration<double>(typename Clock::duration(ticks)).count();
 }
 
 } // namespace detail
@@ -100,6 +114,7 @@ public:
                 return true;
             }
         }
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
 
@@ -119,17 +134,31 @@ public:
         return m_count.load(std::memory_order_acquire);
     }
 
+    /**
+     * @brief 获取 tryAcquire() 失败的累计次数
+     * @return 被拒绝次数
+     */
+    uint64_t rejectedCount() const {
+        return m_rejected.load(std::memory_order_relaxed);
+    }
+
 private:
     std::atomic<size_t> m_count;
+    // 只在失败路径写入，单独占用缓存行以免干扰成功路径的 CAS
+    alignas(64) std::atomic<uint64_t> m_rejected{0};
 };
 
 /**
  * @brief 非阻塞令牌桶限流器
+ * @tparam ClockType 时间源类型，需要提供 now() 和 duration；默认使用 std::chrono::steady_clock
  * @details 按令牌/秒速率填充令牌，直到容量上限。线程安全，不阻塞调用者。
  */
-class TokenBucketLimiter {
+template<typename ClockType = std::chrono::steady_clock>
+class BasicTokenBucketLimiter {
 public:
-    TokenBucketLimiter(double rate, size_t capacity)
+    using Clock = ClockType;
+
+    BasicTokenBucketLimiter(double rate, size_t capacity)
         : m_rate_units(detail::toRateLimiterUnits(rate))
         , m_capacity_units(detail::toRateLimiterUnits(capacity))
         , m_tokens(detail::toRateLimiterUnits(capacity))
@@ -156,6 +185,7 @@ public:
                 return true;
             }
         }
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
 
@@ -211,9 +241,17 @@ public:
         return detail::fromRateLimiterUnits(m_capacity_units.load(std::memory_order_acquire));
     }
 
+    /**
+     * @brief 获取 tryAcquire() 失败的累计次数
+     * @return 被拒绝次数
+     */
+    uint64_t rejectedCount() const {
+        return m_rejected.load(std::memory_order_relaxed);
+    }
+
 private:
     static int64_t nowTicks() {
-        return static_cast<int64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        return detail::clockTicks<Clock>();
     }
 
     void refill() {
@@ -230,8 +268,7 @@ private:
                 continue;
             }
 
-            double elapsed_seconds = std::chrono::duration<double>(
-                std::chrono::steady_clock::duration(now - last_time)).count();
+            double elapsed_seconds = detail::clockTicksToSeconds<Clock>(now - last_time);
             double units_to_add = elapsed_seconds * static_cast<double>(rate_units);
             int64_t tokens_to_add =
                 units_to_add >= static_cast<double>(std::numeric_limits<int64_t>::max())
@@ -260,19 +297,26 @@ private:
     std::atomic<int64_t> m_capacity_units;
     std::atomic<int64_t> m_tokens;
     std::atomic<int64_t> m_last_refill_time;
+    alignas(64) std::atomic<uint64_t> m_rejected{0};
 };
 
+using TokenBucketLimiter = BasicTokenBucketLimiter<>;
+
 /**
  * @brief 无锁滑动窗口限流器
+ * @tparam ClockType 时间源类型，需要提供 now() 和 duration；默认使用 std::chrono::steady_clock
  * @details 每次成功获取记录时间戳，超过窗口内最大请求数时返回 false。
  *          使用固定槽位和原子 CAS 记录请求，不阻塞调用线程。
  */
-class SlidingWindowLimiter {
+template<typename ClockType = std::chrono::steady_clock>
+class BasicSlidingWindowLimiter {
 public:
-    SlidingWindowLimiter(size_t maxRequests, std::chrono::milliseconds windowSize)
+    using Clock = ClockType;
+
+    BasicSlidingWindowLimiter(size_t maxRequests, std::chrono::milliseconds windowSize)
         : m_max_requests(maxRequests)
         , m_window_size(windowSize)
-        , m_window_ticks(detail::nonNegativeSteadyTicks(windowSize))
+        , m_window_ticks(detail::nonNegativeClockTicks<Clock>(windowSize))
         , m_requests(maxRequests) {
         for (auto& request : m_requests) {
             request.store(std::numeric_limits<int64_t>::min(), std::memory_order_relaxed);
@@ -285,6 +329,7 @@ public:
      */
     bool tryAcquire() {
         if (m_max_requests == 0) {
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
             return false;
         }
 
@@ -302,6 +347,7 @@ public:
                 }
             }
         }
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
 
@@ -317,9 +363,17 @@ public:
      */
     std::chrono::milliseconds windowSize() const { return m_window_size; }
 
+    /**
+     * @brief 获取 tryAcquire() 失败的累计次数
+     * @return 被拒绝次数
+     */
+    uint64_t rejectedCount() const {
+        return m_rejected.load(std::memory_order_relaxed);
+    }
+
 private:
     static int64_t nowTicks() {
-        return static_cast<int64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        return detail::clockTicks<Clock>();
     }
 
     size_t m_max_requests;
@@ -327,15 +381,22 @@ private:
     int64_t m_window_ticks;
     std::vector<std::atomic<int64_t>> m_requests;
     std::atomic<size_t> m_probe_cursor{0};
+    alignas(64) std::atomic<uint64_t> m_rejected{0};
 };
 
+using SlidingWindowLimiter = BasicSlidingWindowLimiter<>;
+
 /**
  * @brief 非阻塞漏桶限流器
+ * @tparam ClockType 时间源类型，需要提供 now() 和 duration；默认使用 std::chrono::steady_clock
  * @details 桶按配置速率漏水，仅在不超过容量时接受新水。线程安全，不阻塞。
  */
-class LeakyBucketLimiter {
+template<typename ClockType = std::chrono::steady_clock>
+class BasicLeakyBucketLimiter {
 public:
-    LeakyBucketLimiter(double rate, size_t capacity)
+    using Clock = ClockType;
+
+    BasicLeakyBucketLimiter(double rate, size_t capacity)
         : m_rate_units(detail::toRateLimiterUnits(rate))
         , m_capacity_units(detail::toRateLimiterUnits(capacity))
         , m_water(0)
@@ -363,6 +424,7 @@ public:
                 return true;
             }
         }
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
 
@@ -392,9 +454,17 @@ public:
         return detail::fromRateLimiterUnits(m_capacity_units.load(std::memory_order_acquire));
     }
 
+    /**
+     * @brief 获取 tryAcquire() 失败的累计次数
+     * @return 被拒绝次数
+     */
+    uint64_t rejectedCount() const {
+        return m_rejected.load(std::memory_order_relaxed);
+    }
+
 private:
     static int64_t nowTicks() {
-        return static_cast<int64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        return detail::clockTicks<Clock>();
     }
 
     void leak() {
@@ -411,8 +481,7 @@ private:
                 continue;
             }
 
-            double elapsed_seconds = std::chrono::duration<double>(
-                std::chrono::steady_clock::duration(now - last_time)).count();
+            double elapsed_seconds = detail::clockTicksToSeconds<Clock>(now - last_time);
             double units_to_leak = elapsed_seconds * static_cast<double>(rate_units);
             int64_t leaked =
                 units_to_leak >= static_cast<double>(std::numeric_limits<int64_t>::max())
@@ -439,8 +508,11 @@ private:
     std::atomic<int64_t> m_capacity_units;
     std::atomic<int64_t> m_water;
     std::atomic<int64_t> m_last_leak_time;
+    alignas(64) std::atomic<uint64_t> m_rejected{0};
 };
 
+using LeakyBucketLimiter = BasicLeakyBucketLimiter<>;
+
 } // namespace galay::utils
 
 #endif // GALAY_UTILS_RATE_LIMITER_HPP
@@ -0,0 +1,772 @@
+/**
+ * @file timer.hpp
+ * @brief 分层时间轮定时器
+ * @author galay-utils
+ * @version 1.0.0
+ *
+ * @details 提供 O(1) 调度 / 取消的分层时间轮：
+ *          - BasicTimerWheel<Clock>：单线程时间轮，由事件循环调用 advance() 驱动，定时器为侵入式 TimerNode；
+ *          - BasicTimerService<Clock>：内置驱动线程的线程安全定时服务，按 TimerId 取消，
+ *            到期回调可在驱动线程执行，或批量投递到 ThreadPool。
+ *          时间轮共 5 层：第 0 层 256 个槽，第 1-4 层各 64 个槽，覆盖 2^32 个 tick（1ms tick 约 49.7 天），
+ *          更远的定时器先挂在最高层，降级时重新计算位置。定时器不会早于截止时间触发，最多晚一个 tick。
+ */
+
+#ifndef GALAY_UTILS_TIMER_HPP
+#define GALAY_UTILS_TIMER_HPP
+
+#include "galay-utils/tool/thread.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace galay::utils {
+
+class TimerNode;
+
+namespace detail {
+
+/// 侵入式双向循环链表节点；槽位头节点与 TimerNode 共用
+struct TimerLink {
+    TimerLink* prev = this;
+    TimerLink* next = this;
+
+    bool linked() const noexcept { return next != this; }
+
+    void unlink() noexcept {
+        prev->next = next;
+        next->prev = prev;
+        prev = this;
+        next = this;
+    }
+
+    void pushBack(TimerLink& link) noexcept {
+        link.prev = prev;
+        link.next = this;
+        prev->next = &link;
+        prev = &link;
+    }
+
+    /// 把 other 的全部节点移到本链表尾部，other 变为空
+    void spliceFrom(TimerLink& other) noexcept {
+        if (!other.linked()) {
+            return;
+        }
+        TimerLink* first = other.next;
+        TimerLink* last = other.prev;
+        first->prev = prev;
+        last->next = this;
+        prev->next = first;
+        prev = last;
+        other.prev = &other;
+        other.next = &other;
+    }
+};
+
+/**
+ * @brief 以 tick 为单位的分层时间轮
+ * @details 不关心时钟，只维护“当前 tick”；BasicTimerWheel 在其上做时间换算。
+ */
+class TimerWheelBase {
+public:
+    static constexpr unsigned kRootBits = 8;
+    static constexpr unsigned kLevelBits = 6;
+    static constexpr unsigned kLevels = 5;
+    static constexpr size_t kRootSlots = size_t{1} << kRootBits;
+    static constexpr size_t kLevelSlots = size_t{1} << kLevelBits;
+    static constexpr uint64_t kMaxDelta = (uint64_t{1} << (kRootBits + (kLevels - 1) * kLevelBits)) - 1;
+
+    TimerWheelBase() = default;
+    TimerWheelBase(const TimerWheelBase&) = delete;
+    TimerWheelBase& operator=(const TimerWheelBase&) = delete;
+
+    ~TimerWheelBase();
+
+    /**
+     * @brief 下一个待处理的 tick，小于它的 tick 均已处理
+     */
+    uint64_t currentTick() const noexcept { return m_currentTick; }
+
+    /**
+     * @brief 已调度且尚未触发或取消的定时器数量
+     */
+    size_t size() const noexcept { return m_size; }
+
+    bool empty() const noexcept { return m_size == 0; }
+
+    /**
+     * @brief 在指定 tick 调度定时器；节点已在本时间轮中时先取消再重新调度
+     * @details 早于 currentTick() 的 tick 按 currentTick() 处理
+     * @throws std::invalid_argument 节点已挂在其他时间轮上
+     */
+    void scheduleTick(TimerNode& node, uint64_t expireTick);
+
+    /**
+     * @brief 取消定时器
+     * @return 节点仍处于调度状态并被移除时返回 true
+     */
+    bool cancel(TimerNode& node) noexcept;
+
+    /**
+     * @brief 处理所有 tick <= target 的到期定时器，按 tick 顺序批量触发回调
+     * @return 本次触发的定时器数量
+     * @details 连续的空槽直接跳过；回调中可以调度或取消本时间轮上的任意定时器。
+     */
+    size_t advanceTo(uint64_t target);
+
+    /**
+     * @brief 距下一次需要处理的 tick 的 tick 数（相对 currentTick()）
+     * @details 返回值是可以安全休眠的上界：第 0 层有定时器时精确，否则为下一次降级的边界；
+     *          没有定时器时返回 std::nullopt
+     */
+    std::optional<uint64_t> ticksUntilNextEvent() const noexcept;
+
+private:
+    static constexpr uint16_t kNoSlot = UINT16_MAX;
+    static constexpr size_t kSlotCount = kRootSlots + (kLevels - 1) * kLevelSlots;
+
+    void place(TimerNode& node) noexcept;
+    void detach(TimerNode& node) noexcept;
+    void cascade(uint64_t tick) noexcept;
+    size_t expireSlot(size_t index);
+
+    void markSlot(size_t slot) noexcept {
+        m_occupied[slot >> 6] |= uint64_t{1} << (slot & 63);
+    }
+
+    void clearSlotIfEmpty(size_t slot) noexcept {
+        if (!m_slots[slot].linked()) {
+            m_occupied[slot >> 6] &= ~(uint64_t{1} << (slot & 63));
+        }
+    }
+
+    bool slotOccupied(size_t slot) const noexcept {
+        return (m_occupied[slot >> 6] >> (slot & 63)) & 1;
+    }
+
+    /// 第 level 层（1-4）的槽占用位图
+    uint64_t levelBits(unsigned level) const noexcept {
+        return m_occupied[(kRootSlots >> 6) + (level - 1)];
+    }
+
+    /// 下一个需要处理的 tick：第 0 层非空槽或某一层非空槽的降级时刻
+    uint64_t nextEventTick() const noexcept;
+
+    /// 第 0 层从 index 起（含）第一个非空槽，没有时返回 kRootSlots
+    size_t nextRootSlot(size_t index) const noexcept {
+        size_t word = index >> 6;
+        uint64_t bits = m_occupied[word] & (~uint64_t{0} << (index & 63));
+        while (true) {
+            if (bits != 0) {
+                return (word << 6) + static_cast<size_t>(std::countr_zero(bits));
+            }
+            if (++word == kRootSlots / 64) {
+                return kRootSlots;
+            }
+            bits = m_occupied[word];
+        }
+    }
+
+    std::array<TimerLink, kSlotCount> m_slots{};
+    std::array<uint64_t, kSlotCount / 64> m_occupied{};
+    uint64_t m_currentTick = 0;
+    size_t m_size = 0;
+};
+
+} // namespace detail
+
+/**
+ * @brief 侵入式定时器节点
+ * @details 嵌入到业务对象中（或作为基类）使用，调度与取消不分配内存。回调签名为 void(TimerNode&)，
+ *          可通过 static_cast 取回外层对象。节点析构时自动从时间轮取消；不可复制或移动。
+ *          同一时刻只能挂在一个时间轮上，且只能在驱动该时间轮的线程上操作。
+ */
+class TimerNode : private detail::TimerLink {
+public:
+    using Callback = void (*)(TimerNode&);
+
+    explicit TimerNode(Callback callback = nullptr) noexcept
+        : m_callback(callback) {}
+
+    TimerNode(const TimerNode&) = delete;
+    TimerNode& operator=(const TimerNode&) = delete;
+
+    ~TimerNode() {
+        cancel();
+    }
+
+    /**
+     * @brief 设置到期回调；回调可以为空（仅作为超时标记）
+     */
+    void setCallback(Callback callback) noexcept { m_callback = callback; }
+
+    /**
+     * @brief 是否处于调度状态（已调度且尚未触发或取消）
+     */
+    bool armed() const noexcept { return m_wheel != nullptr; }
+
+    /**
+     * @brief 到期 tick；仅在 armed() 时有意义
+     */
+    uint64_t expireTick() const noexcept { return m_expireTick; }
+
+    /**
+     * @brief 取消调度
+     * @return 节点处于调度状态并被移除时返回 true
+     */
+    bool cancel() noexcept {
+        return m_wheel != nullptr && m_wheel->cancel(*this);
+    }
+
+private:
+    friend class detail::TimerWheelBase;
+
+    static TimerNode& fromLink(detail::TimerLink& link) noexcept {
+        return static_cast<TimerNode&>(link);
+    }
+
+    Callback m_callback;
+    detail::TimerWheelBase* m_wheel = nullptr;
+    uint64_t m_expireTick = 0;
+    uint16_t m_slot = UINT16_MAX;
+};
+
+/**
+ * @brief 持有 std::function 回调的定时器节点
+ * @details 不需要自定义外层对象时使用；回调在时间轮 advance() 的调用线程执行。
+ */
+class Timer : public TimerNode {
+public:
+    explicit Timer(std::function<void()> callback = {})
+        : TimerNode(&Timer::invoke)
+        , m_function(std::move(callback)) {}
+
+    void setFunction(std::function<void()> callback) { m_function = std::move(callback); }
+
+private:
+    static void invoke(TimerNode& node) {
+        Timer& timer = static_cast<Timer&>(node);
+        if (timer.m_function) {
+            timer.m_function();
+        }
+    }
+
+    std::function<void()> m_function;
+};
+
+namespace detail {
+
+inline TimerWheelBase::~TimerWheelBase() {
+    for (TimerLink& head : m_slots) {
+        while (head.linked()) {
+            TimerNode& node = TimerNode::fromLink(*head.next);
+            static_cast<TimerLink&>(node).unlink();
+            node.m_wheel = nullptr;
+            node.m_slot = kNoSlot;
+        }
+    }
+}
+
+inline void TimerWheelBase::scheduleTick(TimerNode& node, uint64_t expireTick) {
+    if (node.m_wheel != nullptr && node.m_wheel != this) {
+        throw std::invalid_argument("TimerNode is scheduled on another timer wheel");
+    }
+    if (node.m_wheel == this) {
+        detach(node);
+    } else {
+        node.m_wheel = this;
+        ++m_size;
+    }
+    node.m_expireTick = std::max(expireTick, m_currentTick);
+    place(node);
+}
+
+inline bool TimerWheelBase::cancel(TimerNode& node) noexcept {
+    if (node.m_wheel != this) {
+        return false;
+    }
+    detach(node);
+    node.m_wheel = nullptr;
+    --m_size;
+    return true;
+}
+
+inline void TimerWheelBase::place(TimerNode& node) noexcept {
+    const uint64_t expire = node.m_expireTick;
+    uint64_t delta = expire - m_currentTick;
+    size_t slot;
+    if (delta < kRootSlots) {
+        slot = static_cast<size_t>(expire & (kRootSlots - 1));
+    } else {
+        // 超出覆盖范围的定时器按最远位置放入最高层，降级时按真实到期 tick 重新放置
+        const uint64_t position = delta > kMaxDelta ? m_currentTick + kMaxDelta : expire;
+        delta = position - m_currentTick;
+        unsigned level = 1;
+        unsigned shift = kRootBits;
+        while (level < kLevels - 1 && delta >= (uint64_t{1} << (shift + kLevelBits))) {
+            ++level;
+            shift += kLevelBits;
+        }
+        slot = kRootSlots + (level - 1) * kLevelSlots
+            + static_cast<size_t>((position >> shift) & (kLevelSlots - 1));
+    }
+    node.m_slot = static_cast<uint16_t>(slot);
+    m_slots[slot].pushBack(node);
+    markSlot(slot);
+}
+
+inline void TimerWheelBase::detach(TimerNode& node) noexcept {
+    static_cast<TimerLink&>(node).unlink();
+    if (node.m_slot != kNoSlot) {
+        clearSlotIfEmpty(node.m_slot);
+        node.m_slot = kNoSlot;
+    }
+}
+
+inline void TimerWheelBase::cascade(uint64_t tick) noexcept {
+    unsigned shift = kRootBits;
+    for (unsigned level = 1; level < kLevels; ++level, shift += kLevelBits) {
+        const size_t index = static_cast<size_t>((tick >> shift) & (kLevelSlots - 1));
+        const size_t slot = kRootSlots + (level - 1) * kLevelSlots + index;
+        if (slotOccupied(slot)) {
+            TimerLink pending;
+            pending.spliceFrom(m_slots[slot]);
+            clearSlotIfEmpty(slot);
+            while (pending.linked()) {
+                TimerNode& node = TimerNode::fromLink(*pending.next);
+                static_cast<TimerLink&>(node).unlink();
+                place(node);
+            }
+        }
+        // 本层索引回到 0 时上一层才需要降级
+        if (index != 0) {
+            break;
+        }
+    }
+}
+
+inline size_t TimerWheelBase::expireSlot(size_t index) {
+    TimerLink expiring;
+    expiring.spliceFrom(m_slots[index]);
+    clearSlotIfEmpty(index);
+    // 先推进当前 tick，回调中重新调度的定时器不会落入正在处理的批次
+    ++m_currentTick;
+
+    size_t fired = 0;
+    while (expiring.linked()) {
+        TimerNode& node = TimerNode::fromLink(*expiring.next);
+        static_cast<TimerLink&>(node).unlink();
+        node.m_slot = kNoSlot;
+        node.m_wheel = nullptr;
+        --m_size;
+        ++fired;
+        if (node.m_callback != nullptr) {
+            node.m_callback(node);
+        }
+    }
+    return fired;
+}
+
+inline size_t TimerWheelBase::advanceTo(uint64_t target) {
+    size_t fired = 0;
+    while (m_currentTick <= target) {
+        if (m_size == 0) {
+            m_currentTick = target + 1;
+            break;
+        }
+        const size_t index = static_cast<size_t>(m_currentTick & (kRootSlots - 1));
+        if (index == 0) {
+            cascade(m_currentTick);
+        }
+        if (slotOccupied(index)) {
+            fired += expireSlot(index);
+        } else {
+            ++m_currentTick;
+        }
+
+        if (m_currentTick <= target) {
+            m_currentTick = std::min(nextEventTick(), target + 1);
+        }
+    }
+    return fired;
+}
+
+inline uint64_t TimerWheelBase::nextEventTick() const noexcept {
+    // 第 0 层当前窗口内的非空槽；窗口内没有时至少要停在下一个降级边界
+    const size_t index = static_cast<size_t>(m_currentTick & (kRootSlots - 1));
+    if (index == 0) {
+        return m_currentTick;
+    }
+    const size_t found = nextRootSlot(index);
+    if (found != kRootSlots) {
+        return m_currentTick + (found - index);
+    }
+    const uint64_t boundary = m_currentTick + (kRootSlots - index);
+    for (size_t word = 0; word < kRootSlots / 64; ++word) {
+        if (m_occupied[word] != 0) {
+            return boundary;
+        }
+    }
+    // 第 0 层为空：直接跳到各层下一个非空槽的降级时刻
+    uint64_t next = UINT64_MAX;
+    unsigned shift = kRootBits;
+    for (unsigned level = 1; level < kLevels; ++level, shift += kLevelBits) {
+        const uint64_t bits = levelBits(level);
+        if (bits == 0) {
+            continue;
+        }
+        const uint64_t block = (boundary + (uint64_t{1} << shift) - 1) >> shift;
+        const unsigned position = static_cast<unsigned>(block & (kLevelSlots - 1));
+        const uint64_t rotated = std::rotr(bits, static_cast<int>(position));
+        const uint64_t candidate = (block + static_cast<uint64_t>(std::countr_zero(rotated))) << shift;
+        next = std::min(next, candidate);
+    }
+    return std::max(next, boundary);
+}
+
+inline std::optional<uint64_t> TimerWheelBase::ticksUntilNextEvent() const noexcept {
+    if (m_size == 0) {
+        return std::nullopt;
+    }
+    const size_t index = static_cast<size_t>(m_currentTick & (kRootSlots - 1));
+    return static_cast<uint64_t>(nextRootSlot(index) - index);
+}
+
+} // namespace detail
+
+/**
+ * @brief 事件循环驱动的分层时间轮
+ * @tparam ClockType 时间源类型，需要提供 now()、time_point 和 duration；默认使用 std::chrono::steady_clock
+ * @details 构造时记录起点，之后按 tickDuration 把时间换算为 tick。调度、取消均为 O(1) 且不分配内存，
+ *          advance() 批量触发到期定时器并跳过空槽。非线程安全，所有操作应在同一个事件循环线程上进行；
+ *          事件循环可用 timeUntilNextEvent() 计算 epoll / poll 的等待时间。
+ */
+template<typename ClockType = std::chrono::steady_clock>
+class BasicTimerWheel : public detail::TimerWheelBase {
+public:
+    using Clock = ClockType;
+    using time_point = typename Clock::time_point;
+    using duration = typename Clock::duration;
+
+    /**
+     * @param tickDuration tick 粒度，不大于 0 时按 1ms 处理
+     * @param origin 时间轮起点，tick 0 对应的时间
+     */
+    explicit BasicTimerWheel(std::chrono::nanoseconds tickDuration = std::chrono::milliseconds(1),
+                             time_point origin = Clock::now())
+        : m_tick(tickDuration > std::chrono::nanoseconds::zero()
+                     ? std::chrono::duration_cast<duration>(tickDuration)
+                     : std::chrono::duration_cast<duration>(std::chrono::milliseconds(1)))
+        , m_origin(origin) {
+        if (m_tick <= duration::zero()) {
+            m_tick = duration(1);
+        }
+    }
+
+    duration tickDuration() const noexcept { return m_tick; }
+    time_point origin() const noexcept { return m_origin; }
+
+    /**
+     * @brief 在指定时间点触发
+     */
+    void scheduleAt(TimerNode& node, time_point deadline) {
+        scheduleTick(node, tickAtOrAfter(deadline));
+    }
+
+    /**
+     * @brief 在 Clock::now() + delay 后触发
+     */
+    template<typename Rep, typename Period>
+    void schedule(TimerNode& node, std::chrono::duration<Rep, Period> delay) {
+        scheduleAt(node, Clock::now() + std::chrono::duration_cast<duration>(delay));
+    }
+
+    /**
+     * @brief 处理截至 now 的全部到期定时器
+     * @return 本次触发的定时器数量
+     */
+    size_t advance(time_point now = Clock::now()) {
+        if (now < m_origin) {
+            return 0;
+        }
+        return advanceTo(static_cast<uint64_t>((now - m_origin) / m_tick));
+    }
+
+    /**
+     * @brief 距下一次需要调用 advance() 的时长，没有定时器时返回 std::nullopt
+     */
+    std::optional<duration> timeUntilNextEvent(time_point now = Clock::now()) const {
+        const std::optional<uint64_t> ticks = ticksUntilNextEvent();
+        if (!ticks) {
+            return std::nullopt;
+        }
+        const time_point wake = m_origin + m_tick * static_cast<typename duration::rep>(currentTick() + *ticks);
+        return wake > now ? wake - now : duration::zero();
+    }
+
+    /**
+     * @brief 截止时间对应的 tick（向上取整，保证不会提前触发）
+     */
+    uint64_t tickAtOrAfter(time_point deadline) const noexcept {
+        if (deadline <= m_origin) {
+            return 0;
+        }
+        const auto elapsed = deadline - m_origin;
+        const auto ticks = elapsed / m_tick;
+        return static_cast<uint64_t>(ticks) + (elapsed % m_tick != duration::zero() ? 1 : 0);
+    }
+
+private:
+    duration m_tick;
+    time_point m_origin;
+};
+
+using TimerWheel = BasicTimerWheel<>;
+
+/**
+ * @brief TimerService 定时器句柄
+ * @details 由槽位索引与代数组成，定时器触发或取消后句柄自动失效，重复取消是安全的空操作。
+ */
+struct TimerId {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+
+    bool valid() const noexcept { return generation != 0; }
+    friend bool operator==(const TimerId&, const TimerId&) = default;
+};
+
+/**
+ * @brief 线程驱动的定时服务
+ * @tparam ClockType 时间源类型，默认使用 std::chrono::steady_clock
+ * @details 内部持有一个 BasicTimerWheel 与一个驱动线程。schedule() / cancel() 线程安全，持锁时间为 O(1)；
+ *          驱动线程在下一个到期 tick 前休眠，到期后在锁外批量执行回调。构造时传入 ThreadPool 时，
+ *          回调通过 ThreadPool::execute() 投递；否则在驱动线程上执行，回调应短小且不得抛出异常。
+ *          回调内可以调用 stop()，但不能析构服务本身。
+ *          定时器节点在服务内部按块复用，除 std::function 自身外调度不分配内存。
+ */
+template<typename ClockType = std::chrono::steady_clock>
+class BasicTimerService {
+public:
+    using Clock = ClockType;
+    using time_point = typename Clock::time_point;
+    using duration = typename Clock::duration;
+    using Callback = std::function<void()>;
+
+    /**
+     * @param tickDuration tick 粒度，不大于 0 时按 1ms 处理
+     * @param executor 回调投递的线程池，为空时在驱动线程执行；线程池须比服务活得久
+     */
+    explicit BasicTimerService(std::chrono::nanoseconds tickDuration = std::chrono::milliseconds(1),
+                               ThreadPool* executor = nullptr)
+        : m_wheel(tickDuration)
+        , m_executor(executor)
+        , m_worker([this]() { run(); }) {}
+
+    BasicTimerService(const BasicTimerService&) = delete;
+    BasicTimerService& operator=(const BasicTimerService&) = delete;
+
+    ~BasicTimerService() {
+        stop();
+    }
+
+    /**
+     * @brief 在 delay 后执行回调
+     * @throws std::runtime_error 服务已停止
+     */
+    template<typename Rep, typename Period>
+    TimerId schedule(std::chrono::duration<Rep, Period> delay, Callback callback) {
+        return scheduleAt(Clock::now() + std::chrono::duration_cast<duration>(delay), std::move(callback));
+    }
+
+    /**
+     * @brief 在指定时间点执行回调
+     * @throws std::runtime_error 服务已停止
+     */
+    TimerId scheduleAt(time_point deadline, Callback callback) {
+        const uint64_t tick = m_wheel.tickAtOrAfter(deadline);
+        bool wake = false;
+        TimerId id;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopping) {
+                throw std::runtime_error("TimerService is stopped");
+            }
+            Entry& entry = acquireEntry();
+            entry.callback = std::move(callback);
+            m_wheel.scheduleTick(entry, tick);
+            id = TimerId{entry.index, entry.generation};
+            // 只有比驱动线程计划唤醒时间更早的定时器才需要唤醒它
+            if (entry.expireTick() < m_wakeTick) {
+                m_wakeTick = entry.expireTick();
+                wake = true;
+            }
+        }
+        if (wake) {
+            m_wakeup.notify_one();
+        }
+        return id;
+    }
+
+    /**
+     * @brief 取消定时器
+     * @return 定时器尚未触发并被取消时返回 true
+     */
+    bool cancel(TimerId id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!id.valid() || id.index >= m_entries.size()) {
+            return false;
+        }
+        Entry& entry = m_entries[id.index];
+        if (entry.generation != id.generation || !m_wheel.cancel(entry)) {
+            return false;
+        }
+        releaseEntry(entry);
+        return true;
+    }
+
+    /**
+     * @brief 尚未触发的定时器数量
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_wheel.size();
+    }
+
+    /**
+     * @brief 停止驱动线程并丢弃所有未触发的定时器（幂等）
+     * @details 在驱动线程上（即回调内）调用时只设置停止标志，当前批次剩余回调执行完后线程退出，
+     *          由之后在其他线程上的 stop() 或析构回收线程。
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeup.notify_one();
+        if (m_worker.joinable() && m_worker.get_id() != std::this_thread::get_id()) {
+            m_worker.join();
+        }
+    }
+
+private:
+    struct Entry : TimerNode {
+        explicit Entry(BasicTimerService* owner, uint32_t slot)
+            : TimerNode(&Entry::expire)
+            , service(owner)
+            , index(slot) {}
+
+        static void expire(TimerNode& node) {
+            Entry& entry = static_cast<Entry&>(node);
+            entry.service->m_batch.push_back(std::move(entry.callback));
+            entry.service->releaseEntry(entry);
+        }
+
+        BasicTimerService* service;
+        typename BasicTimerService::Callback callback;
+        uint32_t index;
+        uint32_t generation = 1;
+        uint32_t nextFree = UINT32_MAX;
+    };
+
+    Entry& acquireEntry() {
+        if (m_freeHead != UINT32_MAX) {
+            Entry& entry = m_entries[m_freeHead];
+            m_freeHead = entry.nextFree;
+            return entry;
+        }
+        if (m_entries.size() >= UINT32_MAX) {
+            throw std::length_error("TimerService has too many timers");
+        }
+        return m_entries.emplace_back(this, static_cast<uint32_t>(m_entries.size()));
+    }
+
+    void releaseEntry(Entry& entry) noexcept {
+        entry.callback = nullptr;
+        // 代数跳过 0，保证失效句柄不会与新定时器冲突
+        if (++entry.generation == 0) {
+            entry.generation = 1;
+        }
+        entry.nextFree = m_freeHead;
+        m_freeHead = entry.index;
+    }
+
+    void run() {
+        std::vector<Callback> ready;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stopping) {
+            const time_point now = Clock::now();
+            m_wheel.advance(now);
+            if (!m_batch.empty()) {
+                ready.swap(m_batch);
+                lock.unlock();
+                dispatch(ready);
+                ready.clear();
+                lock.lock();
+                continue;
+            }
+
+            const std::optional<uint64_t> ticks = m_wheel.ticksUntilNextEvent();
+            if (!ticks) {
+                m_wakeTick = UINT64_MAX;
+                m_wakeup.wait(lock, [this]() { return m_stopping || m_wakeTick != UINT64_MAX; });
+                continue;
+            }
+            m_wakeTick = m_wheel.currentTick() + *ticks;
+            const time_point wakeAt = m_wheel.origin()
+                + m_wheel.tickDuration() * static_cast<typename duration::rep>(m_wakeTick);
+            const uint64_t planned = m_wakeTick;
+            const auto timeout = wakeAt > now ? wakeAt - now : duration::zero();
+            m_wakeup.wait_for(lock, timeout, [this, planned]() {
+                return m_stopping || m_wakeTick < planned;
+            });
+        }
+        // 停止时丢弃未触发的定时器并回收节点
+        for (Entry& entry : m_entries) {
+            if (m_wheel.cancel(entry)) {
+                releaseEntry(entry);
+            }
+        }
+    }
+
+    void dispatch(std::vector<Callback>& ready) {
+        for (Callback& callback : ready) {
+            if (!callback) {
+                continue;
+            }
+            if (m_executor != nullptr) {
+                m_executor->execute(std::move(callback));
+            } else {
+                callback();
+            }
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    BasicTimerWheel<Clock> m_wheel;
+    std::deque<Entry> m_entries;
+    std::vector<Callback> m_batch;
+    uint32_t m_freeHead = UINT32_MAX;
+    uint64_t m_wakeTick = UINT64_MAX;
+    bool m_stopping = false;
+    ThreadPool* m_executor;
+    std::thread m_worker;
+};
+
+using TimerService = BasicTimerService<>;
+
+} // namespace galay::utils
+
+#endif // GALAY_UTILS_TIMER_HPP
@@ -159,9 +159,205 @@ void testBase64() {
     std::cout << "  string_view tests passed!" << std::endl;
 #endif
 
+    // Test span interfaces with RFC 4648 vectors
+    const std::pair<std::string_view, std::string_view> rfcVectors[] = {
+        {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"},
+        {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"}};
+    for (const auto& [plain, encoded] : rfcVectors) {
+        char encodeBuffer[16];
+        auto encodeResult = Base64Util::Base64EncodeInto(
+            std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(plain.data()), plain.size()), encodeBuffer);
+        assert(encodeResult && std::string_view(encodeBuffer, encodeResult.length) == encoded);
+
+        uint8_t decodeBuffer[16];
+        auto decodeResult = Base64Util::Base64DecodeInto(encoded, decodeBuffer);
+        assert(decodeResult && decodeResult.length == plain.size());
+        assert(std::string_view(reinterpret_cast<char*>(decodeBuffer), decodeResult.length) == plain);
+        assert(Base64Util::Base64DecodedLength(encoded) == plain.size());
+    }
+
+    // Lengths crossing every SIMD block size, both alphabets
+    std::mt19937 base64Rng(57);
+    for (size_t len = 0; len < 300; ++len) {
+        std::vector<uint8_t> bytes(len);
+        for (auto& b : bytes) b = static_cast<uint8_t>(base64Rng());
+        for (bool url : {false, true}) {
+            std::string text(Base64Util::Base64EncodedLength(len), '\0');
+            assert(Base64Util::Base64EncodeInto(bytes, text, url).length == text.size());
+            std::vector<uint8_t> back(len);
+            auto result = Base64Util::Base64DecodeInto(text, back);
+            assert(result && result.length == len && back == bytes);
+        }
+    }
+
+    // Validation status
+    uint8_t scratch[64];
+    char tooSmall[3];
+    assert(Base64Util::Base64EncodeInto(std::span<const uint8_t>(scratch, 3), tooSmall).status ==
+           Base64Status::OutputTooSmall);
+    assert(Base64Util::Base64DecodeInto("Zm9vYmFy", std::span<uint8_t>(scratch, 5)).status ==
+           Base64Status::OutputTooSmall);
+    auto badChar = Base64Util::Base64DecodeInto("QUJDREVGR0hJSktMTU5PUFFSU1RVVldY@Vo=", scratch);
+    assert(badChar.status == Base64Status::InvalidCharacter && badChar.position == 32);
+    assert(Base64Util::Base64DecodeInto("Zg==Zg==", scratch).status == Base64Status::InvalidPadding);
+    assert(Base64Util::Base64DecodeInto("Zm9vY", scratch).status == Base64Status::InvalidLength);
+    assert(Base64Util::Base64DecodeInto("Zm9v=", scratch).status == Base64Status::InvalidPadding);
+    assert(Base64Util::Base64DecodeInto("Zm8", scratch).length == 2);
+
+    // Streaming encoder matches MIME output for arbitrary chunking
+    std::string mimeBody(1000, '\0');
+    for (auto& c : mimeBody) c = static_cast<char>(base64Rng());
+    Base64Encoder mimeEncoder(false, 76);
+    std::string streamed;
+    for (size_t pos = 0; pos < mimeBody.size();) {
+        const size_t chunk = std::min<size_t>(mimeBody.size() - pos, base64Rng() % 50 + 1);
+        std::string buffer(mimeEncoder.maxOutputLength(chunk), '\0');
+        auto result = mimeEncoder.update(std::string_view(mimeBody).substr(pos, chunk), buffer);
+        assert(result);
+        streamed.append(buffer, 0, result.length);
+        pos += chunk;
+    }
+    char finishBuffer[5];
+    streamed.append(finishBuffer, mimeEncoder.finish(finishBuffer).length);
+    assert(streamed == Base64Util::Base64EncodeMime(mimeBody));
+
+    // Streaming decoder skips CR/LF and spaces across chunk boundaries
+    std::string crlfText;
+    for (char c : streamed) {
+        if (c == '\n') crlfText += "\r\n";
+        else crlfText += c;
+    }
+    Base64Decoder mimeDecoder;
+    std::string decodedBody(Base64Decoder::maxOutputLength(crlfText.size()), '\0');
+    auto decodedSpan = std::span<uint8_t>(reinterpret_cast<uint8_t*>(decodedBody.data()), decodedBody.size());
+    size_t decodedLength = 0;
+    for (size_t pos = 0; pos < crlfText.size(); pos += 7) {
+        auto result = mimeDecoder.update(std::string_view(crlfText).substr(pos, 7), decodedSpan.subspan(decodedLength));
+        assert(result);
+        decodedLength += result.length;
+    }
+    decodedLength += mimeDecoder.finish(decodedSpan.subspan(decodedLength)).length;
+    assert(std::string_view(decodedBody).substr(0, decodedLength) == mimeBody);
+
+    Base64Decoder strictDecoder;
+    assert(strictDecoder.update("Zm8= Zg", scratch).status == Base64Status::InvalidPadding);
+    assert(strictDecoder.update("Zm9v", scratch).status == Base64Status::InvalidPadding);
+    strictDecoder.reset();
+    assert(strictDecoder.update("Zm9vY", scratch) && strictDecoder.finish(scratch).status == Base64Status::InvalidLength);
+
+    // Padded final quantum: the size check covers the bytes flushed at '='
+    Base64Decoder paddedDecoder;
+    std::vector<uint8_t> exact(Base64Decoder::maxOutputLength(7));
+    auto padded = paddedDecoder.update("AAAAAA=", exact);
+    assert(padded && padded.length == 4);
+    paddedDecoder.reset();
+    std::vector<uint8_t> shortBuffer(3);
+    assert(paddedDecoder.update("AAAAAA=", shortBuffer).status == Base64Status::OutputTooSmall);
+    assert(paddedDecoder.update("AAAAAA=", exact) && paddedDecoder.finish(scratch));
+
+    std::cout << "  span/streaming tests passed (backend=" << static_cast<int>(Base64Util::backend()) << ")" << std::endl;
+
     std::cout << "Base64 tests passed!" << std::endl;
 }
 
+// ==================== Hex / Base32 / Z85 Tests ====================
+
+void testHexBase32Z85() {
+    std::cout << "=== Testing Hex / Base32 / Z85 ===" << std::endl;
+
+    // Hex: SIMD blocks and scalar tail agree with a byte-by-byte reference at every length
+    std::mt19937 codecRng(58);
+    const char* digits = "0123456789abcdef";
+    for (size_t length = 0; length <= 200; ++length) {
+        std::vector<uint8_t> bytes(length);
+        for (auto& b : bytes) b = static_cast<uint8_t>(codecRng());
+        std::string expected;
+        for (uint8_t b : bytes) {
+            expected += digits[b >> 4];
+            expected += digits[b & 0x0F];
+        }
+        const std::string encoded = HexCodec::encode(bytes);
+        assert(encoded == expected);
+        std::string upper = expected;
+        std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+        assert(HexCodec::encode(bytes, true) == upper);
+        assert(HexCodec::decode(upper) == bytes);
+
+        std::vector<uint8_t> out(length);
+        auto result = HexCodec::decodeInto(encoded, out);
+        assert(result && result.length == length && out == bytes);
+
+        // Corrupting any single character is reported at its exact position
+        if (length > 0) {
+            std::string corrupt = encoded;
+            const size_t at = codecRng() % corrupt.size();
+            corrupt[at] = "g/:@G`\x80 "[codecRng() % 8];
+            auto bad = HexCodec::decodeInto(corrupt, out);
+            assert(bad.status == CodecStatus::InvalidCharacter && bad.position == at && bad.length == at / 2);
+        }
+    }
+    char small[3];
+    const uint8_t two[] = {0xAB, 0xCD};
+    assert(HexCodec::encodeInto(two, small).status == CodecStatus::OutputTooSmall);
+    uint8_t one[1];
+    assert(HexCodec::decodeInto("abc", one).status == CodecStatus::InvalidLength);
+    assert(HexCodec::decodeInto("abcd", one).status == CodecStatus::OutputTooSmall);
+    bool threw = false;
+    try { HexCodec::decode("0x"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+
+    // Base32: RFC 4648 section 10 test vectors
+    const std::pair<const char*, const char*> base32Vectors[] = {
+        {"", ""}, {"f", "MY======"}, {"fo", "MZXQ===="}, {"foo", "MZXW6==="},
+        {"foob", "MZXW6YQ="}, {"fooba", "MZXW6YTB"}, {"foobar", "MZXW6YTBOI======"}};
+    for (const auto& [plain, encoded] : base32Vectors) {
+        assert(Base32Codec::encode(std::string_view(plain)) == encoded);
+        std::string unpadded = encoded;
+        unpadded.erase(unpadded.find_last_not_of('=') + 1);
+        assert(Base32Codec::encode(std::string_view(plain), false) == unpadded);
+        const auto decoded = Base32Codec::decode(encoded);
+        assert(std::string(decoded.begin(), decoded.end()) == plain);
+        const auto decodedUnpadded = Base32Codec::decode(unpadded);
+        assert(std::string(decodedUnpadded.begin(), decodedUnpadded.end()) == plain);
+    }
+    // TOTP secrets are often lowercase and unpadded
+    const auto totp = Base32Codec::decode("jbswy3dpehpk3pxp");
+    assert(std::string(totp.begin(), totp.end()) == "Hello!\xDE\xAD\xBE\xEF");
+    uint8_t base32Out[16];
+    assert(Base32Codec::decodeInto("MZXW6===", base32Out).length == 3);
+    assert(Base32Codec::decodeInto("MZXW6==", base32Out).status == CodecStatus::InvalidPadding);
+    assert(Base32Codec::decodeInto("MZXW6Y", base32Out).status == CodecStatus::InvalidLength);
+    auto base32Bad = Base32Codec::decodeInto("MZXW1YTB", base32Out);
+    assert(base32Bad.status == CodecStatus::InvalidCharacter && base32Bad.position == 4);
+    assert(Base32Codec::decodeInto("MY==MY==", base32Out).status == CodecStatus::InvalidPadding);
+
+    // Z85: ZeroMQ RFC 32 reference vector
+    const uint8_t z85Plain[] = {0x86, 0x4F, 0xD2, 0x6F, 0xB5, 0x59, 0xF7, 0x5B};
+    assert(Z85Codec::encode(z85Plain) == "HelloWorld");
+    const auto z85Decoded = Z85Codec::decode("HelloWorld");
+    assert(std::equal(z85Decoded.begin(), z85Decoded.end(), std::begin(z85Plain), std::end(z85Plain)));
+    for (size_t length = 0; length <= 64; length += 4) {
+        std::vector<uint8_t> bytes(length);
+        for (auto& b : bytes) b = static_cast<uint8_t>(codecRng());
+        assert(Z85Codec::decode(Z85Codec::encode(bytes)) == bytes);
+    }
+    const uint8_t allOnes[] = {0xFF, 0xFF, 0xFF, 0xFF};
+    assert(Z85Codec::encode(allOnes) == "%nSc0");
+    uint8_t z85Out[8];
+    assert(Z85Codec::decodeInto("%nSc1", z85Out).status == CodecStatus::InvalidCharacter);
+    assert(Z85Codec::decodeInto("Hello", z85Out).length == 4);
+    assert(Z85Codec::decodeInto("Hell", z85Out).status == CodecStatus::InvalidLength);
+    auto z85Bad = Z85Codec::decodeInto("Hello\"orld", z85Out);
+    assert(z85Bad.status == CodecStatus::InvalidCharacter && z85Bad.position == 5 && z85Bad.length == 4);
+    char z85Small[4];
+    assert(Z85Codec::encodeInto(allOnes, z85Small).status == CodecStatus::OutputTooSmall);
+    threw = false;
+    try { Z85Codec::encode(std::string_view("abc")); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    std::cout << "Hex / Base32 / Z85 tests passed (backend=" << static_cast<int>(HexCodec::backend()) << ")" << std::endl;
+}
+
 // ==================== MD5 Tests ====================
 
 void testMD5() {
@@ -268,6 +464,53 @@ void testMD5() {
     std::cout << "  string_view tests passed!" << std::endl;
 #endif
 
+    // Streaming: 任意分块与一次性结果一致
+    {
+        std::string payload;
+        for (int i = 0; i < 1000; ++i) {
+            payload.push_back(static_cast<char>('a' + i % 26));
+        }
+        const auto expected = MD5Util::MD5Raw(payload);
+        for (size_t chunk : {1u, 7u, 55u, 56u, 63u, 64u, 65u, 200u}) {
+            MD5Util::Context ctx;
+            MD5Util::init(ctx);
+            for (size_t offset = 0; offset < payload.size(); offset += chunk) {
+                const size_t len = std::min(chunk, payload.size() - offset);
+                MD5Util::update(ctx, reinterpret_cast<const uint8_t*>(payload.data()) + offset, len);
+            }
+            assert(MD5Util::finalize(ctx) == expected);
+        }
+    }
+
+    // Batch: 各种长度（跨越 55/56/64 补位边界）与逐条结果一致
+    {
+        std::vector<std::string> storage;
+        for (size_t len : {0u, 1u, 3u, 55u, 56u, 57u, 63u, 64u, 65u, 119u, 120u, 128u, 300u, 1000u,
+                           5u, 17u, 2048u, 60u, 61u, 62u, 9u}) {
+            std::string s;
+            for (size_t i = 0; i < len; ++i) {
+                s.push_back(static_cast<char>((i * 131 + len) & 0xFF));
+            }
+            storage.push_back(std::move(s));
+        }
+        std::vector<std::string_view> inputs(storage.begin(), storage.end());
+        std::vector<std::array<uint8_t, 16>> outputs(inputs.size());
+        MD5Util::MD5RawBatch(inputs, outputs);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            assert(outputs[i] == MD5Util::MD5RawView(inputs[i]));
+        }
+        assert(MD5Util::batchLanes() == 1 || MD5Util::batchLanes() == 4 || MD5Util::batchLanes() == 8);
+
+        bool threw = false;
+        try {
+            MD5Util::MD5RawBatch(inputs, std::span<std::array<uint8_t, 16>>(outputs.data(), 1));
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+        std::cout << "  Batch lanes: " << MD5Util::batchLanes() << std::endl;
+    }
+
     // Test known MD5 collisions awareness (informational)
     // Note: MD5 is cryptographically broken, but still useful for checksums
     std::cout << "  Note: MD5 is not cryptographically secure" << std::endl;
@@ -442,6 +685,59 @@ void testMurmurHash3() {
     std::cout << "MurmurHash3 tests passed!" << std::endl;
 }
 
+// ==================== XXH3 Tests ====================
+
+void testXXH3() {
+    std::cout << "=== Testing XXH3 ===" << std::endl;
+
+    // 参考实现 xxHash v0.8 的向量
+    assert(XXH3::hash64("") == 0x2d06800538d394c2ULL);
+    assert(XXH3::hash64("hello world") == 0xd447b1ea40e6988bULL);
+    assert(XXH3::hash64("hello world", 42) == 0x972a5725e93d338eULL);
+    assert((XXH3::hash128("hello world") == XXH128Hash{0xa99b8775cc15b6c7ULL, 0xdf8d09e93f874900ULL}));
+
+    std::string big;
+    for (int i = 0; i < 1000; ++i) {
+        big.push_back(static_cast<char>('a' + i % 26));
+    }
+    assert(XXH3::hash64(big) == 0xe153425558d7da5dULL);
+    assert(XXH3::hash64(big, 0x9E3779B97F4A7C15ULL) == 0x2a8d17c28b05e4ffULL);
+    assert((XXH3::hash128(big, 7) == XXH128Hash{0x99bba0e7e158ec56ULL, 0x4e8d2f969825469fULL}));
+
+    // 流式：各长度区间（含 240/256 边界与多块）任意分块与一次性结果一致
+    std::string payload;
+    for (int i = 0; i < 5000; ++i) {
+        payload.push_back(static_cast<char>((i * 131 + 7) & 0xFF));
+    }
+    for (size_t length : {0u, 3u, 8u, 16u, 17u, 128u, 129u, 240u, 241u, 256u, 257u, 1024u, 1025u, 5000u}) {
+        const std::string_view input(payload.data(), length);
+        for (size_t chunk : {1u, 13u, 64u, 255u, 1000u}) {
+            XXH3::State state(99);
+            for (size_t offset = 0; offset < length; offset += chunk) {
+                state.update(input.substr(offset, chunk));
+            }
+            assert(state.digest64() == XXH3::hash64(input, 99));
+            assert(state.digest128() == XXH3::hash128(input, 99));
+        }
+    }
+    XXH3::State reused;
+    reused.update("discarded");
+    reused.reset();
+    reused.update("hello world");
+    assert(reused.digest64() == 0xd447b1ea40e6988bULL);
+
+    // Hasher：字符串按内容，整数按对象字节
+    XXH3Hasher hasher;
+    assert(hasher(std::string("hello world")) == static_cast<size_t>(0xd447b1ea40e6988bULL));
+    assert(hasher(std::string_view("hello world")) == hasher("hello world"));
+    const uint64_t key = 12345;
+    assert(hasher(key) == static_cast<size_t>(XXH3::hash64(reinterpret_cast<const uint8_t*>(&key), sizeof(key))));
+    assert(XXH3Hasher{1}("a") != XXH3Hasher{2}("a"));
+
+    std::cout << "  Backend: " << static_cast<int>(XXH3::backend()) << std::endl;
+    std::cout << "XXH3 tests passed!" << std::endl;
+}
+
 // ==================== Salt Generator Tests ====================
 
 void testSaltGenerator() {
@@ -594,15 +890,306 @@ void testSaltGenerator() {
     std::cout << "Salt Generator tests passed!" << std::endl;
 }
 
+// ==================== SecureRandom Tests ====================
+
+void testSecureRandom() {
+    std::cout << "=== Testing SecureRandom ===" << std::endl;
+
+    // RFC 8439 section 2.3.2 block function test vector
+    uint32_t key[8];
+    for (uint32_t i = 0; i < 8; ++i) {
+        key[i] = (4 * i) | ((4 * i + 1) << 8) | ((4 * i + 2) << 16) | ((4 * i + 3) << 24);
+    }
+    const uint32_t nonce[3] = {0x09000000, 0x4a000000, 0x00000000};
+    uint8_t block[64];
+    detail::chacha20Block(key, 1, nonce, block);
+    assert(HexCodec::encode(std::span<const uint8_t>(block, 64)) ==
+           "10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+           "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e");
+
+    // 8-way / 4-way SIMD paths and the scalar tail match the block function
+    std::vector<uint8_t> streamed(23 * 64), reference(23 * 64);
+    detail::chacha20Stream(key, streamed.data(), 23);
+    const uint32_t zeroNonce[3] = {0, 0, 0};
+    for (uint32_t i = 0; i < 23; ++i) {
+        detail::chacha20Block(key, i, zeroNonce, reference.data() + i * 64);
+    }
+    assert(streamed == reference);
+
+    // Output spans buffer refills and never repeats
+    std::vector<uint8_t> large = SecureRandom::bytes(5000);
+    std::vector<uint8_t> large2 = SecureRandom::bytes(5000);
+    assert(large != large2);
+    size_t ones = 0;
+    for (uint8_t b : large) ones += static_cast<size_t>(__builtin_popcount(b));
+    assert(ones > 5000 * 4 - 600 && ones < 5000 * 4 + 600);
+    SecureRandom::fill(nullptr, 10);
+
+    for (uint64_t bound : {uint64_t{1}, uint64_t{7}, uint64_t{1000}, (uint64_t{1} << 63) + 1}) {
+        for (int i = 0; i < 100; ++i) {
+            assert(SecureRandom::uniform(bound) < bound);
+        }
+    }
+    bool threw = false;
+    try { SecureRandom::uniform(0); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    const std::string token = SecureRandom::token();
+    assert(token.size() == 43);
+    assert(token.find_first_of("+/=") == std::string::npos);
+    assert(SecureRandom::token(100).size() == 134);
+    assert(token != SecureRandom::token());
+
+    const std::string uuid = SecureRandom::uuid();
+    assert(uuid.size() == 36 && uuid[8] == '-' && uuid[13] == '-' && uuid[18] == '-' && uuid[23] == '-');
+    assert(uuid[14] == '4');
+    assert(uuid[19] == '8' || uuid[19] == '9' || uuid[19] == 'a' || uuid[19] == 'b');
+
+    // Threads draw from independent states
+    std::string fromThread;
+    std::thread worker([&] { fromThread = SecureRandom::token(); });
+    worker.join();
+    assert(fromThread.size() == 43 && fromThread != SecureRandom::token());
+
+    SecureRandom::reseed();
+    assert(SecureRandom::bytes(32).size() == 32);
+
+#if defined(GALAY_PLATFORM_LINUX) || defined(GALAY_PLATFORM_MACOS)
+    // Parent and child must not replay the same buffered stream after fork
+    (void)SecureRandom::next64();
+    int fds[2];
+    assert(::pipe(fds) == 0);
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        const uint64_t childValue = SecureRandom::next64();
+        const bool ok = ::write(fds[1], &childValue, sizeof(childValue)) == sizeof(childValue);
+        ::_exit(ok ? 0 : 1);
+    }
+    assert(pid > 0);
+    const uint64_t parentValue = SecureRandom::next64();
+    uint64_t childValue = 0;
+    assert(::read(fds[0], &childValue, sizeof(childValue)) == sizeof(childValue));
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    ::close(fds[0]);
+    ::close(fds[1]);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(childValue != parentValue);
+#endif
+
+    std::cout << "SecureRandom tests passed!" << std::endl;
+}
+
+// ==================== SHA256 / HMAC Tests ====================
+
+void testSHA256() {
+    std::cout << "=== Testing SHA256 ===" << std::endl;
+
+    auto hexOf = [](const std::array<uint8_t, 32>& digest) {
+        static const char hexChars[] = "0123456789abcdef";
+        std::string out;
+        for (uint8_t byte : digest) {
+            out.push_back(hexChars[byte >> 4]);
+            out.push_back(hexChars[byte & 0x0F]);
+        }
+        return out;
+    };
+
+    // NIST FIPS 180-2 向量
+    assert(SHA256::hashHex("") == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    assert(SHA256::hashHex("abc") == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    assert(SHA256::hashHex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+           "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    const std::string million(1000000, 'a');
+    assert(SHA256::hashHex(million) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+    // 各后端与补位边界（55/56/63/64/65 字节）结果一致
+    std::string data;
+    for (int i = 0; i < 300; ++i) {
+        data.push_back(static_cast<char>(i * 31 + 7));
+    }
+    const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+    for (size_t len : {0u, 1u, 55u, 56u, 63u, 64u, 65u, 119u, 128u, 300u}) {
+        SHA256::Context scalar;
+        SHA256::init(scalar, SHA256Backend::Scalar);
+        assert(scalar.backend == SHA256Backend::Scalar);
+        SHA256::update(scalar, bytes, len);
+        const auto expected = SHA256::finalize(scalar);
+
+        for (auto backend : {SHA256Backend::ShaNi, SHA256Backend::ArmSha2}) {
+            SHA256::Context ctx;
+            SHA256::init(ctx, backend);
+            assert(ctx.backend == (SHA256::isBackendSupported(backend) ? backend : SHA256Backend::Scalar));
+            SHA256::update(ctx, bytes, len);
+            assert(SHA256::finalize(ctx) == expected);
+        }
+        assert(SHA256::hash(bytes, len) == expected);
+    }
+    std::cout << "  Best backend: " << static_cast<int>(SHA256::bestBackend()) << std::endl;
+
+    // 流式分片输入与一次性结果一致
+    for (size_t chunk : {1u, 3u, 63u, 64u, 65u, 200u}) {
+        SHA256::Context ctx;
+        SHA256::init(ctx);
+        for (size_t offset = 0; offset < million.size(); offset += chunk) {
+            const size_t len = std::min(chunk, million.size() - offset);
+            SHA256::update(ctx, reinterpret_cast<const uint8_t*>(million.data()) + offset, len);
+        }
+        assert(hexOf(SHA256::finalize(ctx)) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+    }
+
+    // 上下文可拷贝以复用公共前缀
+    SHA256::Context prefix;
+    SHA256::init(prefix);
+    SHA256::update(prefix, reinterpret_cast<const uint8_t*>("ab"), 2);
+    SHA256::Context forked = prefix;
+    SHA256::update(forked, reinterpret_cast<const uint8_t*>("c"), 1);
+    assert(hexOf(SHA256::finalize(forked)) == SHA256::hashHex("abc"));
+
+    // RFC 4231 HMAC-SHA256 test case 2 / 6（长密钥）
+    assert(HMAC::hmacSha256Hex("Jefe", "what do ya want for nothing?") ==
+           "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+    assert(HMAC::hmacSha256Hex(std::string(131, '\xaa'),
+                               "Test Using Larger Than Block-Size Key - Hash Key First") ==
+           "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+
+    std::cout << "SHA256 tests passed!" << std::endl;
+}
+
+void testHmacBatch() {
+    std::cout << "=== Testing HmacKey / batch SHA256 ===" << std::endl;
+
+    // 预计算密钥与一次性接口结果一致（含空密钥、块长密钥与长密钥）
+    const std::string message = "what do ya want for nothing?";
+    for (const std::string& key : {std::string(), std::string("Jefe"), std::string(64, 'k'), std::string(131, '\xaa')}) {
+        HmacKey hmacKey(key);
+        assert(hmacKey.sign(message) == HMAC::hmacSha256(key, message));
+    }
+
+    // 批量哈希覆盖 0～300 字节的混合长度及不足 8 路的尾部
+    std::vector<std::string> storage;
+    for (size_t i = 0; i < 37; ++i) {
+        std::string item;
+        for (size_t j = 0; j < (i * 53) % 301; ++j) {
+            item.push_back(static_cast<char>(i * 7 + j));
+        }
+        storage.push_back(std::move(item));
+    }
+    std::vector<std::string_view> views(storage.begin(), storage.end());
+    std::vector<std::array<uint8_t, 32>> digests(views.size());
+    SHA256::Context iv;
+    SHA256::init(iv);
+    for (auto mode : {SHA256BatchMode::Auto, SHA256BatchMode::MultiBuffer, SHA256BatchMode::SingleBuffer}) {
+        SHA256::hashBatch(iv, views, digests, mode);
+        for (size_t i = 0; i < views.size(); ++i) {
+            assert(digests[i] == SHA256::hash(reinterpret_cast<const uint8_t*>(views[i].data()), views[i].size()));
+        }
+    }
+
+    // 非分组对齐前缀回退为逐条计算
+    SHA256::Context unaligned;
+    SHA256::init(unaligned);
+    SHA256::update(unaligned, reinterpret_cast<const uint8_t*>("xyz"), 3);
+    SHA256::hashBatch(unaligned, views, digests, SHA256BatchMode::MultiBuffer);
+    for (size_t i = 0; i < views.size(); ++i) {
+        assert(digests[i] == SHA256::hash(reinterpret_cast<const uint8_t*>(("xyz" + storage[i]).data()), storage[i].size() + 3));
+    }
+    SHA256::hashBatch(views, digests);
+    std::cout << "  Batch accelerated: " << (SHA256::isBatchAccelerated() ? "yes" : "no") << std::endl;
+
+    // 批量签名与校验，篡改的标签被拒绝
+    HmacKey webhookKey("webhook-secret");
+    std::vector<std::array<uint8_t, 32>> tags(views.size());
+    webhookKey.signBatch(views, tags);
+    for (size_t i = 0; i < views.size(); ++i) {
+        assert(tags[i] == HMAC::hmacSha256("webhook-secret", storage[i]));
+    }
+    tags[3][0] ^= 0x01;
+    tags[20][31] ^= 0x80;
+    std::unique_ptr<bool[]> results(new bool[views.size()]);
+    const size_t matched = webhookKey.verifyBatch(views, tags, std::span<bool>(results.get(), views.size()));
+    assert(matched == views.size() - 2);
+    assert(!results[3] && !results[20] && results[0] && results[36]);
+
+    bool threw = false;
+    try {
+        SHA256::hashBatch(views, std::span(digests.data(), 1));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "HmacKey / batch SHA256 tests passed!" << std::endl;
+}
+
+void testHmacSpanVerify() {
+    std::cout << "=== Testing HMAC span / verify ===" << std::endl;
+
+    const std::string key = "Jefe";
+    const std::string message = "what do ya want for nothing?";
+    const auto expected = HMAC::hmacSha256(key, message);
+
+    std::array<uint8_t, 32> out{};
+    HMAC::hmacSha256Into(key, message, out);
+    assert(out == expected);
+    HMAC::hmacSha256Into(std::as_bytes(std::span(key)), std::as_bytes(std::span(message)), out);
+    assert(out == expected);
+
+    assert(HMAC::verify(key, message, expected));
+    auto tampered = expected;
+    tampered[31] ^= 0x01;
+    assert(!HMAC::verify(key, message, tampered));
+    assert(!HMAC::verify(key, message, std::span<const uint8_t>(expected.data(), 16)));
+
+    assert(HMAC::constantTimeEqual(expected, expected));
+    assert(!HMAC::constantTimeEqual(expected, tampered));
+    assert(!HMAC::constantTimeEqual(std::span<const uint8_t>(expected.data(), 31), expected));
+
+    // RingBuffer 环绕数据分段校验，无需线性化
+    RingBuffer ring(40);
+    assert(ring.write(std::string(30, 'x')) == 30);
+    ring.consume(29);
+    assert(ring.write(message) == message.size());
+    ring.consume(1);
+    std::array<std::span<const std::byte>, 2> segments;
+    const size_t segmentCount = ring.readSpans(segments);
+    assert(segmentCount == 2);
+    const std::span<const std::span<const std::byte>> parts(segments.data(), segmentCount);
+    HMAC::hmacSha256Into(std::as_bytes(std::span(key)), parts, out);
+    assert(out == expected);
+    assert(HMAC::verify(std::as_bytes(std::span(key)), parts, expected));
+    assert(!HMAC::verify(std::as_bytes(std::span(key)), parts, tampered));
+
+    // ByteQueueView 连续视图
+    ByteQueueView queue;
+    queue.append("prefix:");
+    queue.append(message);
+    queue.consume(7);
+    HmacKey hmacKey(key);
+    assert(hmacKey.verify(queue.view(0, queue.size()), expected));
+    assert(hmacKey.verify(parts, expected));
+    hmacKey.signInto(std::as_bytes(std::span(message)), out);
+    assert(out == expected);
+
+    std::cout << "HMAC span / verify tests passed!" << std::endl;
+}
+
 // ==================== LoadBalancer Tests ====================
 
 int main() {
     std::cout << "\n=== algorithm_test ===" << std::endl;
     try {
         testBase64();
+        testHexBase32Z85();
         testMD5();
         testMurmurHash3();
+        testXXH3();
         testSaltGenerator();
+        testSecureRandom();
+        testSHA256();
+        testHmacBatch();
+        testHmacSpanVerify();
         return 0;
     } catch (const std::exception& e) {
         std::cerr << "Test failed with exception: " << e.what() << std::endl;
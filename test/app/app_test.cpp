@@ -23,6 +23,9 @@ debug = true
     assert(config.getValueAs<int>("database.port", 0) == 5432);
     assert(config.getValue("database.name").value() == "test_db");
     assert(config.getValueAs<int>("server.port", 0) == 8080);
+    assert(config.getValueAs<bool>("server.debug", false));
+    assert(config.getValueAs<uint16_t>("database.port", 0) == 5432);
+    assert(config.getValueAs<int>("database.host", -1) == -1);
 
     auto dbKeys = config.getKeysInSection("database");
     assert(dbKeys.size() == 3);
@@ -66,6 +69,8 @@ tags = ["primary", "readonly"]
     assert(toml.getValue("enabled").value() == "true");
     assert(toml.getValueAs<int>("database.port", 0) == 5432);
     assert(toml.getValue("database.ratio").value() == "0.75");
+    assert(toml.getValueAs<double>("database.ratio", 0.0) == 0.75);
+    assert(toml.getValueAs<bool>("enabled", false));
 
     auto ports = toml.getArray("ports");
     assert(ports.size() == 3 && ports[0] == "8000" && ports[2] == "8002");
@@ -167,7 +172,6 @@ ports = [8080, 8081]
     assert(!invalidToml.parseString("invalid line"));
     assert(!invalidToml.lastError().empty());
     assert(!invalidToml.parseString("bad = [1, 2"));
-    assert(!invalidToml.parseString("[[products]]\nname = \"x\""));
     assert(!invalidToml.parseString("[]\nname = \"x\""));
     assert(!invalidToml.parseString("name = \"unterminated"));
     assert(!invalidToml.parseString("path = 'unterminated"));
@@ -179,20 +183,12 @@ ports = [8080, 8081]
     assert(!invalidToml.parseString("[database.]\nhost = \"localhost\""));
     assert(!invalidToml.parseString("ports = [1,,2]"));
     assert(!invalidToml.parseString("names = [\"a]"));
-    assert(!invalidToml.parseString("nested = [[1], [2]]"));
-    assert(!invalidToml.parseString("inline = { name = \"galay\" }"));
-    assert(!invalidToml.parseString("date = 2026-04-29T10:00:00Z"));
     assert(!invalidToml.parseString("enabled = True"));
     assert(!invalidToml.parseString("text = \"bad \\q escape\""));
     assert(!invalidToml.parseString("text = \"bad \\u12 escape\""));
     assert(!invalidToml.parseString("number = 01"));
     assert(!invalidToml.parseString("number = 1."));
     assert(!invalidToml.parseString("number = .1"));
-    assert(!invalidToml.parseString("number = 1_000"));
-    assert(!invalidToml.parseString("number = 1e10"));
-    assert(!invalidToml.parseString("number = nan"));
-    assert(!invalidToml.parseString("number = inf"));
-    assert(!invalidToml.parseString("mixed = [1, \"a\"]"));
     assert(!invalidToml.parseString("trailing = [1, ,]"));
     assert(!invalidToml.parseString("database = \"x\"\n[database]\nhost = \"localhost\""));
     assert(!invalidToml.parseString("[database]\nhost = \"localhost\"\n[database.host]\nport = 1"));
@@ -200,7 +196,12 @@ ports = [8080, 8081]
     assert(!invalidToml.parseString("a.b = 2\na = 1"));
     assert(!invalidToml.parseString("[db]\nhost = \"a\"\n[db]\nport = 1"));
     assert(!invalidToml.parseString("key = # missing"));
-    assert(!invalidToml.parseString("\"quoted key\" = 1"));
+    assert(!invalidToml.parseString("number = 1__000"));
+    assert(!invalidToml.parseString("number = 0x_ff"));
+    assert(!invalidToml.parseString("date = 2026-02-30"));
+    assert(!invalidToml.parseString("inline = { name = \"galay\", }"));
+    assert(!invalidToml.parseString("[[products]]\n[products]"));
+
     assert(!invalidToml.parseString("中文 = 1"));
     assert(!invalidToml.parseString("name = \"a\" \"b\""));
     assert(!invalidToml.parseString("name = 'a' 'b'"));
@@ -210,10 +211,47 @@ ports = [8080, 8081]
     assert(!invalidToml.parseString("ports = [\n    8000\n[database]\nhost = \"localhost\"\n"));
     assert(!invalidToml.parseString("ports = [\n    8000\nname = \"x\"\n]"));
     assert(!invalidToml.parseString("names = [\n    \"a]\n]"));
-    assert(!invalidToml.parseString("nested = [\n    [1]\n]"));
     assert(!invalidToml.parseString("tags = [\n    \"a\"\n    \"b\"\n]"));
     assert(!invalidToml.parseString("tags = [\n    'a'\n    'b'\n]"));
 
+    // TOML 1.0 特性按拍平规则暴露给 ParserBase 接口
+    TomlParser tomlFull;
+    std::string tomlFullContent = R"(
+limit = 1_000
+big = 1e10
+mask = 0xff
+mixed = [1, "a"]
+when = 2026-04-29T10:00:00Z
+inline = { name = "galay", port.value = 80 }
+nested = [[1, 2], [3]]
+"quoted key" = 1
+
+[[products]]
+name = "hammer"
+sku = 738594937
+
+[[products]]
+name = "nail"
+)";
+    assert(tomlFull.parseString(tomlFullContent));
+    assert(tomlFull.getValueAs<int>("limit", 0) == 1000);
+    assert(tomlFull.getValueAs<double>("big", 0.0) == 1e10);
+    assert(tomlFull.getValue("mask").value() == "255");
+    assert(tomlFull.getArray("mixed").size() == 2);
+    assert(tomlFull.getValue("when").value() == "2026-04-29T10:00:00Z");
+    assert(tomlFull.getValue("inline.name").value() == "galay");
+    assert(tomlFull.getValueAs<int>("inline.port.value", 0) == 80);
+    assert(tomlFull.getArray("nested.0").size() == 2 && tomlFull.getArray("nested.1")[0] == "3");
+    assert(tomlFull.getValue("quoted key").value() == "1");
+    assert(tomlFull.getValue("products.0.name").value() == "hammer");
+    assert(tomlFull.getValue("products.1.name").value() == "nail");
+    assert(!tomlFull.hasKey("products.1.sku"));
+    assert(tomlFull.document().at("products.0.sku").valueOr<int64_t>(0) == 738594937);
+    TomlParser tomlCopy = tomlFull;
+    assert(tomlFull.parseString("other = 1"));
+    assert(tomlCopy.getValue("products.1.name").value() == "nail");
+    assert(tomlCopy.document()["products"].size() == 2);
+
     TomlParser tomlCrlf;
     assert(tomlCrlf.parseString("name = \"galay\"\r\n[server]\r\nport = 8080\r\n"));
     assert(tomlCrlf.getValue("server.port").value() == "8080");
@@ -221,6 +259,620 @@ ports = [8080, 8081]
     std::cout << "Parser tests passed!" << std::endl;
 }
 
+void testParserViews() {
+    std::cout << "=== Testing Parser Views ===" << std::endl;
+
+    ConfigParser config;
+    std::string content = "[server]\r\nhost = \"a\\tb\"\r\nname = 'plain'\r\nport = 8080";
+    assert(config.parseString(content));
+    content.assign(content.size(), 'x');
+    assert(config.getValueView("server.host").value() == "a\tb");
+    assert(config.getValueView("server.name").value() == "plain");
+    assert(config.getValueView("server.port").value() == "8080");
+    assert(!config.getValueView("server.missing"));
+    assert(!config.parseString("[server]\nport 8080"));
+    assert(config.lastError() == "Invalid line 2: port 8080");
+
+    // 副本与原解析器共享已解析文本，原解析器重新解析后副本仍然有效
+    ConfigParser fresh;
+    assert(fresh.parseString("[a]\nk = v"));
+    ConfigParser snapshot = fresh;
+    assert(fresh.parseString("k = w"));
+    assert(snapshot.getValue("a.k").value() == "v");
+    assert(fresh.getValue("k").value() == "w" && !fresh.hasKey("a.k"));
+
+    EnvParser env;
+    assert(env.parseString("export A=\"x\\ny\"\nB='raw'\nnot a pair\n"));
+    assert(env.getValueView("A").value() == "x\ny");
+    assert(env.getValueView("B").value() == "raw");
+    assert(env.getKeys().size() == 2);
+
+    TomlParser toml;
+    assert(toml.parseString("[a]\nb.c = 1\nd = \"e\\\"f\"\n[g]\nh = 'i'"));
+    assert(toml.getValueView("a.b.c").value() == "1");
+    assert(toml.getValueView("a.d").value() == "e\"f");
+    assert(toml.getValueView("g.h").value() == "i");
+    assert(!toml.parseString("[a]\nb.c = 1\nb = 2"));
+    assert(!toml.parseString("[a]\nb = 1\n[a.b]\nc = 2"));
+    assert(toml.parseString("[a]\nb = 1\n[a.c]\nd = 2"));
+
+    const std::string path = "/tmp/galay_parser_view_test.conf";
+    assert(System::writeFile(path, "[db]\nhost = localhost\n"));
+    ConfigParser fromFile;
+    assert(fromFile.parseFile(path));
+    assert(fromFile.getValue("db.host").value() == "localhost");
+    std::remove(path.c_str());
+    assert(!fromFile.parseFile(path));
+    assert(fromFile.lastError() == "Failed to open file: " + path);
+
+    // st_size 为 0 的管道也要读到 EOF，而不是当成空文件
+    const std::string fifo = "/tmp/galay_parser_view_test.fifo";
+    std::remove(fifo.c_str());
+    assert(::mkfifo(fifo.c_str(), 0600) == 0);
+    std::thread writer([&fifo] {
+        std::string text = "[db]\nhost = piped\n";
+        for (int i = 0; i < 1000; ++i) {
+            text += "key" + std::to_string(i) + " = " + std::to_string(i) + "\n";
+        }
+        assert(System::writeFile(fifo, text));
+    });
+    ConfigParser fromFifo;
+    const bool fifoParsed = fromFifo.parseFile(fifo);
+    writer.join();
+    std::remove(fifo.c_str());
+    assert(fifoParsed);
+    assert(fromFifo.getValue("db.host").value() == "piped");
+    assert(fromFifo.getValue("db.key999").value() == "999");
+
+    // 移走后复用源 arena 不会写入目标持有的块
+    parser_detail::StringArena source;
+    const std::string_view kept = source.store("kept");
+    parser_detail::StringArena target(std::move(source));
+    assert(source.bytes() == 0 && target.bytes() > 0);
+    assert(source.store("over") == "over" && kept == "kept");
+    parser_detail::StringArena assigned;
+    assigned = std::move(target);
+    assert(target.store("more") == "more" && kept == "kept");
+
+    std::cout << "Parser view tests passed!" << std::endl;
+}
+
+void testTomlDocument() {
+    std::cout << "=== Testing TomlDocument ===" << std::endl;
+
+    TomlDocument doc;
+    std::string content = R"TOML(
+# 服务配置
+title = "TOML \"Example\" \u00e9"
+"quoted key" = 'C:\Users\galay'
+site."google.com" = true
+3.14159 = "pi"
+
+[owner]
+name = "Tom"
+dob = 1979-05-27T07:32:00-08:00
+local = 1979-05-27 07:32:00.999999
+day = 1979-05-27
+lunch = 12:30:00
+
+[numbers]
+int = +99
+neg = -17
+under = 5_349_221
+hex = 0xDEAD_beef
+oct = 0o755
+bin = 0b1101
+float = -3.14_15e+2
+exp = 5e-22
+pinf = +inf
+ninf = -inf
+notnum = nan
+
+[strings]
+multi = """
+Roses are red
+Violets are blue"""
+folded = """\
+    The quick brown \
+    fox."""
+quotes = """Here are two quotation marks: "". Simple enough.""""
+raw = '''
+The first newline is
+trimmed in raw strings.
+'''
+lit = '''I [dw]on't need \d{2} apples'''
+
+[servers.alpha]
+ip = "10.0.0.1"
+ports = [ 8000, 8001, ]
+
+[servers.beta]
+ip = "10.0.0.2"
+point = { x = 1, y = 2, z.w = 3 }
+
+[[upstream]]
+host = "a.internal"
+port = 8080
+  [upstream.health]
+  path = "/ping"
+  [[upstream.backup]]
+  host = "a2.internal"
+
+[[upstream]]
+host = "b.internal"
+
+[fruit]
+apple.color = "red"
+apple.taste.sweet = true
+[fruit.apple.texture]
+smooth = true
+)TOML";
+    assert(doc.parseString(content));
+    assert(doc.root().isTable());
+
+    assert(doc["title"].asString().value() == "TOML \"Example\" \xC3\xA9");
+    assert(doc["quoted key"].valueOr<std::string>("") == R"(C:\Users\galay)");
+    assert(doc.at({"site", "google.com"}).asBool().value());
+    assert(doc.at({"3", "14159"}).text() == "pi");
+
+    auto owner = doc["owner"];
+    assert(owner.type() == TomlType::Table && owner.size() == 5);
+    auto dob = owner["dob"].asDateTime().value();
+    assert(owner["dob"].type() == TomlType::OffsetDateTime);
+    assert(dob.year == 1979 && dob.month == 5 && dob.day == 27 && dob.hour == 7 && dob.offsetMinutes == -480);
+    assert(owner["local"].type() == TomlType::LocalDateTime);
+    assert(owner["local"].asDateTime()->nanosecond == 999'999'000);
+    assert(owner["day"].type() == TomlType::LocalDate && owner["day"].text() == "1979-05-27");
+    assert(owner["lunch"].type() == TomlType::LocalTime && owner["lunch"].asDateTime()->minute == 30);
+
+    auto numbers = doc["numbers"];
+    assert(numbers["int"].asInteger().value() == 99 && numbers["int"].text() == "99");
+    assert(numbers["neg"].valueOr<int>(0) == -17);
+    assert(numbers["under"].asInteger().value() == 5349221 && numbers["under"].text() == "5349221");
+    assert(numbers["hex"].asInteger().value() == 0xDEADBEEF);
+    assert(numbers["oct"].asInteger().value() == 0755 && numbers["bin"].asInteger().value() == 13);
+    assert(numbers["float"].asFloat().value() == -314.15 && numbers["float"].text() == "-3.1415e2");
+    assert(numbers["exp"].isFloat() && numbers["exp"].asFloat().value() == 5e-22);
+    assert(std::isinf(numbers["pinf"].asFloat().value()) && numbers["pinf"].text() == "inf");
+    assert(numbers["ninf"].asFloat().value() < 0);
+    assert(std::isnan(numbers["notnum"].asFloat().value()));
+    assert(numbers["int"].as<double>().value() == 99.0);
+    assert(!numbers["int"].as<bool>() && !numbers["hex"].as<int16_t>() && !numbers["float"].as<int>());
+
+    auto strings = doc["strings"];
+    assert(strings["multi"].text() == "Roses are red\nViolets are blue");
+    assert(strings["folded"].text() == "The quick brown fox.");
+    assert(strings["quotes"].text() == "Here are two quotation marks: \"\". Simple enough.\"");
+    assert(strings["raw"].text() == "The first newline is\ntrimmed in raw strings.\n");
+    assert(strings["lit"].text() == R"(I [dw]on't need \d{2} apples)");
+
+    auto alpha = doc.at("servers.alpha");
+    assert(alpha["ip"].text() == "10.0.0.1");
+    assert(alpha["ports"].isArray() && alpha["ports"].size() == 2 && alpha["ports"][1].valueOr<int>(0) == 8001);
+    assert(doc.at("servers.beta.point.z.w").valueOr<int>(0) == 3);
+    assert(doc.at("servers.beta.point").size() == 3);
+
+    auto upstream = doc["upstream"];
+    assert(upstream.isArray() && upstream.size() == 2);
+    std::vector<std::string_view> hosts;
+    for (TomlView server : upstream) {
+        hosts.push_back(server["host"].valueOr<std::string_view>(""));
+    }
+    assert(hosts.size() == 2 && hosts[0] == "a.internal" && hosts[1] == "b.internal");
+    assert(doc.at("upstream.0.health.path").text() == "/ping");
+    assert(doc.at("upstream.0.backup.0.host").text() == "a2.internal");
+    assert(!doc.at("upstream.1.port") && !doc.at("upstream.2") && !doc.at("upstream.x"));
+
+    assert(doc.at("fruit.apple.taste.sweet").asBool().value());
+    assert(doc.at("fruit.apple.texture.smooth").asBool().value());
+
+    // 表成员按定义顺序遍历，键名可预先驻留
+    std::vector<std::string_view> ownerKeys;
+    for (TomlView member : owner) {
+        ownerKeys.push_back(member.key());
+    }
+    assert(ownerKeys.size() == 5 && ownerKeys[0] == "name" && ownerKeys[4] == "lunch");
+    const InternedString hostKey = doc.findKey("host");
+    assert(hostKey && upstream[1][hostKey].text() == "b.internal");
+    assert(!doc.findKey("missing") && !doc["missing"] && !doc["missing"]["deeper"]);
+    assert(!doc["title"]["x"] && doc["title"].size() == 0);
+
+    TomlDocument shared = doc;
+    assert(doc.parseString("a = 1"));
+    assert(shared.at("upstream.0.port").valueOr<int>(0) == 8080);
+    assert(doc.nodeCount() == 2);
+
+    // 合法的边界情况
+    const char* valid[] = {
+        "a = \"\"\n",
+        "a = ''\n",
+        "\xEF\xBB\xBF" "a = 1",
+        "a = 1\r\nb = 2\r\n",
+        "\"\" = 1",
+        "a = [\n  1, # one\n  [2, 'x'], {b = 1},\n]",
+        "a = {}",
+        "[a.b.c]\n[a]\nx = 1",
+        "[a]\nb.c = 1\n[a.b.d]\ne = 2",
+        "[ a . \"b\" ]\nc = 1",
+        "a = 0\nb = -0\nc = +0.0\nd = 0e0\ne = 1E2",
+        "t = 1979-05-27t07:32:00z",
+        "t = 2000-02-29",
+        "m = \"\"\"a\\\r\n   b\"\"\"",
+        "i = 9223372036854775807\nj = -9223372036854775808",
+    };
+    for (const char* text : valid) {
+        TomlDocument ok;
+        if (!ok.parseString(text)) {
+            std::cerr << "rejected valid TOML: " << text << " (" << ok.lastError() << ")" << std::endl;
+            assert(false);
+        }
+    }
+
+    const char* invalid[] = {
+        "a = 1\na = 2",
+        "[a]\n[a]",
+        "a = 1\n[a]",
+        "[a]\nb = 1\n[a.b]",
+        "[a]\nb.c = 1\n[a.b]",
+        "[a.b.c]\nz = 9\n[a]\nb.c.t = 1",
+        "a = {b = 1}\na.c = 2",
+        "a = {b = 1}\n[a]",
+        "a = {b = 1,\nc = 2}",
+        "a = [1]\n[[a]]",
+        "[[a]]\n[a]",
+        "a = 1 b = 2",
+        "a = 01",
+        "a = 1.",
+        "a = .1",
+        "a = 1e",
+        "a = _1",
+        "a = 1_",
+        "a = +0x1",
+        "a = 0b2",
+        "a = 9223372036854775808",
+        "a = infinity",
+        "a = tru",
+        "a = \"\\x41\"",
+        "a = \"\\uD800\"",
+        "a = \"tab\x01\"",
+        "a = '''x''''''",
+        "a = \"\"\"x",
+        "a = 1979-13-01",
+        "a = 1979-05-27T25:00:00",
+        "a = 07:32",
+        "a = 1979-05-27T07:32:00+8:00",
+        "a\r= 1",
+        "# bad \x7F comment",
+        "a = \"\xC3\x28\"",
+        "[a]]",
+        "[[a]",
+        "a.b = 1\na.b.c = 2",
+        "a = \"\"\"x\\\rb\"\"\"",
+        "a = \"\"\"x\\ \rb\"\"\"",
+    };
+    for (const char* text : invalid) {
+        TomlDocument bad;
+        if (bad.parseString(text)) {
+            std::cerr << "accepted invalid TOML: " << text << std::endl;
+            assert(false);
+        }
+        assert(!bad.lastError().empty() && !bad.root());
+    }
+
+    // 行尾反斜杠后的 CRLF 与 LF 一样被折叠
+    TomlDocument folded;
+    assert(folded.parseString("a = \"\"\"x\\\r\n  b\"\"\""));
+    assert(folded["a"].asString() == "xb");
+
+    TomlDocument located;
+    assert(!located.parseString("a = 1\n\nb = [1,\n 2\nc = 3"));
+    assert(located.lastError().find("line 5") != std::string::npos);
+
+    std::string deep(200, '[');
+    TomlDocument nested;
+    assert(!nested.parseString("a = " + deep));
+
+    // 点分键与表头的每一段都计入嵌套深度，超长点分键在解析阶段就被拒绝
+    auto dotted = [](size_t segments) {
+        std::string key = "k";
+        for (size_t i = 1; i < segments; ++i) {
+            key += ".k";
+        }
+        return key;
+    };
+    assert(!nested.parseString(dotted(200000) + " = 1"));
+    assert(nested.lastError().find("too many segments") != std::string::npos);
+    TomlParser flatDeep;
+    assert(flatDeep.parseString(dotted(128) + " = 1"));
+    assert(flatDeep.getValueView(dotted(128)).value() == "1");
+    assert(!flatDeep.parseString(dotted(129) + " = 1"));
+    assert(!nested.parseString("[" + dotted(100) + "]\n" + dotted(29) + " = 1"));
+    assert(nested.parseString("[" + dotted(100) + "]\n" + dotted(28) + " = 1"));
+    // 数组表的元素比数组本身深一层
+    assert(!nested.parseString("[[" + dotted(100) + "]]\n[" + dotted(100) + "." + dotted(28) + "]"));
+    assert(nested.parseString("[[" + dotted(100) + "]]\n[" + dotted(100) + "." + dotted(27) + "]"));
+    std::string inlineDeep = "v = 1";
+    for (int i = 0; i < 100; ++i) {
+        inlineDeep = "a.b = {" + inlineDeep + "}";
+    }
+    assert(!nested.parseString(inlineDeep));
+
+    assert(!TomlDocument().parseFile("/tmp/galay_missing_document.toml"));
+
+    std::cout << "TomlDocument tests passed!" << std::endl;
+}
+
+void testTypedConfig() {
+    std::cout << "=== Testing TypedConfig ===" << std::endl;
+
+    ConfigParser parser;
+    assert(parser.parseString(R"(
+[server]
+port = 8080
+debug = true
+ratio = 0.25
+hosts = a.internal, b.internal
+name = "gateway"
+big = 18446744073709551615
+negative = -1
+)"));
+
+    TypedConfig config(parser);
+    assert(config.size() == 7);
+    assert(config.contains("server.port") && !config.contains("server.missing"));
+
+    auto port = config.key<int>("server.port", 80);
+    auto port16 = config.key<uint16_t>("server.port");
+    auto debug = config.key<bool>("server.debug");
+    auto ratio = config.key<double>("server.ratio");
+    auto hosts = config.key<std::vector<std::string>>("server.hosts");
+    auto name = config.key<std::string>("server.name");
+    auto big = config.key<uint64_t>("server.big");
+    assert(port.bound() && config.get(port) == 8080);
+    assert(config.get(port16) == 8080);
+    assert(config.get(debug));
+    assert(config.get(ratio) == 0.25);
+    assert(config.get(config.key<double>("server.port")) == 8080.0);
+    assert(config.get(hosts).size() == 2 && config.get(hosts)[1] == "b.internal");
+    assert(config.get(name) == "gateway");
+    auto single = config.get(config.key<std::vector<std::string>>("server.name"));
+    assert(single.size() == 1 && single[0] == "gateway");
+    auto none = config.key<std::vector<std::string>>("server.none", {"x", "y"});
+    assert(config.get(none).size() == 2 && config.get(none)[0] == "x");
+    assert(config.get(big) == std::numeric_limits<uint64_t>::max());
+
+    // 缺失的键不绑定；类型不符或越界的键照常绑定，读取返回默认值
+    auto missing = config.key<int>("server.missing", 7);
+    assert(!missing.bound() && config.get(missing) == 7);
+    auto mismatched = config.key<int>("server.name", -1);
+    assert(mismatched.bound() && config.get(mismatched) == -1);
+    assert(!config.get(config.key<bool>("server.port")));
+    assert(config.get(config.key<int64_t>("server.big", 5)) == 5);
+    assert(config.get(config.key<uint32_t>("server.negative", 6)) == 6);
+    assert(config.get(config.key<int16_t>("server.big", 3)) == 3);
+    assert(config.get(config.key<std::string>("server.missing", std::string("none"))) == "none");
+
+    TomlParser toml;
+    assert(toml.parseString("tags = [\"a\", \"b,c\"]\n[limits]\nqps = 500"));
+    TypedConfig tomlConfig(toml);
+    auto tags = tomlConfig.key<std::vector<std::string>>("tags");
+    assert(tomlConfig.get(tags).size() == 2 && tomlConfig.get(tags)[1] == "b,c");
+    assert(tomlConfig.get(tomlConfig.key<int>("limits.qps")) == 500);
+
+    std::cout << "TypedConfig tests passed!" << std::endl;
+}
+
+namespace {
+
+template<typename Predicate>
+bool waitUntil(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(3000)) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+// 先写临时文件再改名，模拟原子发布配置
+void publishConfig(const std::string& path, const std::string& content) {
+    const std::string temp = path + ".tmp";
+    assert(System::writeFile(temp, content));
+    assert(std::rename(temp.c_str(), path.c_str()) == 0);
+}
+
+void checkConfigWatcher(bool useInotify) {
+    const std::string path = std::string("/tmp/galay_config_watcher_") + (useInotify ? "inotify" : "poll") + ".conf";
+    publishConfig(path, "[server]\nport = 8080\ndebug = true\nname = edge\n");
+
+    ConfigWatcherOptions options;
+    options.pollInterval = std::chrono::milliseconds(20);
+    options.settleDelay = std::chrono::milliseconds(5);
+    options.useInotify = useInotify;
+    ConfigWatcher watcher(path, options);
+    assert(watcher.start());
+    assert(!watcher.start());
+    assert(watcher.version() == 1);
+    assert(!useInotify || watcher.usingInotify());
+    assert(useInotify || !watcher.usingInotify());
+
+    auto port = watcher.key<int>("server.port", 80);
+    auto debug = watcher.key<bool>("server.debug");
+    auto workers = watcher.key<int>("server.workers", 1);
+    auto reader = watcher.reader();
+    assert(reader.get(port) == 8080 && reader.get(debug) && reader.get(workers) == 1);
+    const auto first = watcher.snapshot();
+
+    std::mutex mutex;
+    std::vector<ConfigChange> seen;
+    uint64_t seenVersion = 0;
+    const uint64_t callbackId = watcher.onChange([&](const ConfigSnapshot& snapshot, std::span<const ConfigChange> changes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        seen.assign(changes.begin(), changes.end());
+        seenVersion = snapshot.version;
+    });
+
+    publishConfig(path, "[server]\nport = 9090\nname = edge\nworkers = 4\n");
+    // version() 在回调执行前就已更新，这里等回调本身观察到新版本
+    assert(waitUntil([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return seenVersion == 2;
+    }));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        assert(watcher.version() == 2 && seen.size() == 3);
+        for (const auto& change : seen) {
+            if (change.key == "server.port") {
+                assert(change.kind == ConfigChangeKind::Modified && change.oldValue == "8080" && change.newValue == "9090");
+            } else if (change.key == "server.debug") {
+                assert(change.kind == ConfigChangeKind::Removed && change.oldValue == "true");
+            } else {
+                assert(change.key == "server.workers" && change.kind == ConfigChangeKind::Added && change.newValue == "4");
+            }
+        }
+    }
+    // 旧句柄跨版本有效，已删除的键回落到默认值，创建时尚不存在的键读到新值；旧快照仍可读取
+    assert(reader.get(port) == 9090 && !reader.get(debug) && reader.get(workers) == 4);
+    assert(reader.current().values.get(watcher.key<int>("server.workers")) == 4);
+    assert(first->values.get(port) == 8080);
+
+    // 解析失败保留旧快照
+    publishConfig(path, "[server]\nport 1\n");
+    assert(waitUntil([&]() { return watcher.failureCount() == 1; }));
+    assert(watcher.version() == 2 && !watcher.lastError().empty());
+
+    // 内容不变只更新文件状态，不发布新版本
+    assert(watcher.removeCallback(callbackId));
+    assert(!watcher.removeCallback(callbackId));
+    publishConfig(path, "[server]\nport = 9090\nname = edge\nworkers = 4\n");
+    assert(waitUntil([&]() { return watcher.lastError().empty(); }));
+    assert(watcher.version() == 2);
+
+    publishConfig(path, "[server]\nport = 7070\nname = edge\nworkers = 4\n");
+    assert(waitUntil([&]() { return watcher.version() == 3; }));
+    assert(reader.get(port) == 7070);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        assert(seenVersion == 2);
+    }
+
+    watcher.stop();
+    watcher.stop();
+    assert(watcher.snapshot()->version == 3);
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+void testConfigWatcher() {
+    std::cout << "=== Testing ConfigWatcher ===" << std::endl;
+
+    checkConfigWatcher(true);
+    checkConfigWatcher(false);
+
+    ConfigWatcher missing("/tmp/galay_config_watcher_missing.conf");
+    assert(!missing.start());
+    assert(missing.version() == 0 && missing.snapshot() == nullptr && !missing.lastError().empty());
+    auto reader = missing.reader();
+    assert(reader.get(missing.key<int>("a", 3)) == 3);
+    assert(reader.current().values.size() == 0);
+
+    // 首次加载前创建的句柄、以及取值修正前创建的句柄，在之后的版本中都能读到新值
+    {
+        const std::string path = "/tmp/galay_config_watcher_rebind.conf";
+        ConfigWatcher watcher(path);
+        auto early = watcher.key<int>("a", -1);
+        assert(early.bound() && watcher.key<int>("a").slot() == early.slot());
+        publishConfig(path, "a = 1\nb = x\n");
+        assert(watcher.reload());
+        auto fixed = watcher.key<int>("b", -1);
+        auto flag = watcher.key<bool>("c", false);
+        auto reader = watcher.reader();
+        assert(reader.get(early) == 1 && reader.get(fixed) == -1 && !reader.get(flag));
+        publishConfig(path, "a = 1\nb = 2\nc = true\n");
+        assert(watcher.reload() && watcher.version() == 2);
+        assert(reader.get(fixed) == 2 && reader.get(flag));
+        assert(watcher.snapshot()->values.slotCount() == 3);
+        std::remove(path.c_str());
+    }
+
+    // 轮询模式下原地分段写入：写入方仍在修改期间不重新加载，不会解析到半份文件
+    {
+        const std::string path = "/tmp/galay_config_watcher_settle.conf";
+        publishConfig(path, "[server]\nport = 1\n");
+        ConfigWatcherOptions options;
+        options.pollInterval = std::chrono::milliseconds(5);
+        options.settleDelay = std::chrono::milliseconds(300);
+        options.useInotify = false;
+        ConfigWatcher watcher(path, options);
+        assert(watcher.start());
+        assert(System::writeFile(path, "[server]\nport "));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(System::writeFile(path, "= 2\n", true));
+        assert(waitUntil([&]() { return watcher.version() == 2; }));
+        assert(watcher.failureCount() == 0);
+        assert(watcher.snapshot()->values.get(watcher.key<int>("server.port")) == 2);
+        watcher.stop();
+        std::remove(path.c_str());
+    }
+
+    // 回调抛出的异常被捕获记录，不影响其余回调，快照照常发布
+    {
+        const std::string path = "/tmp/galay_config_watcher_throw.conf";
+        publishConfig(path, "a = 1\n");
+        ConfigWatcher watcher(path);
+        assert(watcher.reload() && watcher.version() == 1);
+        int notified = 0;
+        watcher.onChange([](const ConfigSnapshot&, std::span<const ConfigChange>) {
+            throw std::runtime_error("boom");
+        });
+        watcher.onChange([](const ConfigSnapshot&, std::span<const ConfigChange>) { throw 42; });
+        watcher.onChange([&notified](const ConfigSnapshot&, std::span<const ConfigChange>) { ++notified; });
+        publishConfig(path, "a = 2\n");
+        assert(watcher.reload());
+        assert(watcher.version() == 2 && notified == 1);
+        assert(watcher.callbackFailureCount() == 2 && watcher.failureCount() == 0);
+        assert(watcher.lastError() == "Config change callback threw a non-standard exception");
+        publishConfig(path, "a = 3\n");
+        assert(watcher.reload() && notified == 2 && watcher.callbackFailureCount() == 4);
+        assert(watcher.lastError().find("non-standard") != std::string::npos);
+        std::remove(path.c_str());
+    }
+
+    ConfigWatcher unsupported("/tmp/galay_config_watcher.yaml");
+    assert(!unsupported.start());
+    assert(unsupported.lastError().find("Unsupported") != std::string::npos);
+
+    TomlParser before;
+    assert(before.parseString("a = 1\nb = [\"x\", \"y,z\"]\nc = true"));
+    TomlParser after;
+    assert(after.parseString("a = 2\nb = [\"x\", \"y,z\"]\nd = 'new'"));
+    TypedConfig oldValues(before);
+    TypedConfig newValues(after, oldValues);
+    assert(newValues.size() == 3 && newValues.slotCount() == 4);
+    assert(!newValues.contains("c") && !newValues.text("c"));
+    assert(newValues.text("d").value() == "new");
+    auto items = oldValues.key<std::vector<std::string>>("b");
+    assert(newValues.get(items).size() == 2 && newValues.get(items)[1] == "y,z");
+    assert(TypedConfig::diff(oldValues, newValues).size() == 3);
+    assert(TypedConfig::diff(newValues, TypedConfig(after)).empty());
+    assert(TypedConfig::diff(TypedConfig(after), oldValues).size() == 3);
+
+    // 空槽多于有效键时压缩布局，旧代数的句柄改按键名查找
+    TomlParser churn;
+    assert(churn.parseString("d = 5"));
+    TypedConfig compacted(churn, newValues);
+    assert(newValues.generation() == oldValues.generation());
+    assert(compacted.slotCount() == 1 && compacted.generation() == newValues.generation() + 1);
+    assert(compacted.get(newValues.key<int>("d", -1)) == 5 && compacted.get(newValues.key<int>("a", 9)) == 9);
+    assert(compacted.get(oldValues.key<int>("d", -1)) == 5);
+    assert(TypedConfig::diff(newValues, compacted).size() == 3);
+
+    std::cout << "ConfigWatcher tests passed!" << std::endl;
+}
+
 // ==================== App (Args) Tests ====================
 
 void testApp() {
@@ -261,6 +913,10 @@ int main() {
     std::cout << "\n=== app_test ===" << std::endl;
     try {
         testParser();
+        testParserViews();
+        testTomlDocument();
+        testTypedConfig();
+        testConfigWatcher();
         testApp();
         return 0;
     } catch (const std::exception& e) {
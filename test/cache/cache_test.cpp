@@ -1,6 +1,7 @@
 #include "../test_common.hpp"
 
 #include <filesystem>
+#include <mutex>
 
 void testCacheHeadersMovedToCache() {
     const auto sourceRoot = std::filesystem::path(GALAY_UTILS_SOURCE_DIR);
@@ -96,6 +97,16 @@ void testLruCache() {
         assert(cache.get(3) != nullptr && *cache.get(3) == "ddd");
     }
 
+    {
+        LruCache<std::string, int, XXH3Hasher> cache(2);
+        cache.put("alpha", 1);
+        cache.put("beta", 2);
+        assert(cache.get("alpha") != nullptr && *cache.get("alpha") == 1);
+        cache.put("gamma", 3);
+        assert(cache.get("beta") == nullptr);
+        assert(cache.get("gamma") != nullptr && *cache.get("gamma") == 3);
+    }
+
     {
         using Cache = LruCache<std::string, int, std::hash<std::string>,
                                std::equal_to<std::string>, ManualClock>;
@@ -422,6 +433,38 @@ void testLruCache() {
         assert(cache.get("alpha") == nullptr);
     }
 
+    {
+        // HTTP 头部风格：大小写不敏感的键
+        LruCache<std::string, int, AsciiCaseInsensitiveHash, AsciiCaseInsensitiveEqual> cache(2);
+        assert(cache.put(std::string("Content-Type"), 1));
+        assert(cache.get("content-type") != nullptr && *cache.get("CONTENT-TYPE") == 1);
+        assert(cache.put(std::string("CONTENT-type"), 2));
+        assert(cache.size() == 1 && *cache.get("Content-Type") == 2);
+    }
+
+    {
+        // 导出容量与淘汰统计；带锁重载在导出时持有调用方的锁
+        using Cache = LruCache<int, int, std::hash<int>, std::equal_to<int>, std::chrono::steady_clock, true>;
+        Cache cache(1);
+        std::mutex mutex;
+        LruCache<int, int> plain(4);
+        MetricsRegistry registry;
+        auto statsRegistration = registerMetrics(registry, "sessions", cache, mutex);
+        auto plainRegistration = registerMetrics(registry, "plain", plain);
+
+        cache.put(1, 1);
+        cache.put(2, 2);
+        assert(cache.get(1) == nullptr);
+        plain.put(1, 1);
+
+        const auto snapshot = registry.snapshot();
+        assert(snapshot.value("lru_cache_size", {{"name", "sessions"}}) == 1.0);
+        assert(snapshot.value("lru_cache_capacity", {{"name", "plain"}}) == 4.0);
+        assert(snapshot.value("lru_cache_misses_total", {{"name", "sessions"}}) == 1.0);
+        assert(snapshot.value("lru_cache_evictions_total", {{"name", "sessions"}, {"reason", "capacity"}}) == 1.0);
+        assert(!snapshot.value("lru_cache_misses_total", {{"name", "plain"}}).has_value());
+    }
+
     std::cout << "LruCache tests passed!" << std::endl;
 }
 
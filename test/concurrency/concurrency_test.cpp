@@ -218,6 +218,207 @@ void stressTestThreadPool() {
     std::cout << "ThreadPool stress test passed!" << std::endl;
 }
 
+void testTimerWheel() {
+    std::cout << "=== Testing TimerWheel ===" << std::endl;
+    using namespace std::chrono;
+
+    ManualClock::reset();
+    BasicTimerWheel<ManualClock> wheel(1ms, ManualClock::now());
+    std::vector<int> order;
+
+    struct Request : TimerNode {
+        Request(int requestId, std::vector<int>& sink)
+            : TimerNode(&Request::onTimeout), id(requestId), order(&sink) {}
+
+        static void onTimeout(TimerNode& node) {
+            Request& request = static_cast<Request&>(node);
+            request.order->push_back(request.id);
+        }
+
+        int id;
+        std::vector<int>* order;
+    };
+
+    Request first(1, order);
+    Request second(2, order);
+    Request third(3, order);
+    Request far(4, order);
+    wheel.schedule(first, 10ms);
+    wheel.schedule(second, 5ms);
+    wheel.schedule(third, 300ms);
+    wheel.schedule(far, hours(24 * 60));
+    assert(wheel.size() == 4);
+    assert(first.armed() && first.expireTick() == 10);
+    assert(wheel.timeUntilNextEvent(ManualClock::now()) == ManualClock::duration(5));
+
+    ManualClock::advance(4ms);
+    assert(wheel.advance(ManualClock::now()) == 0);
+    ManualClock::advance(1ms);
+    assert(wheel.advance(ManualClock::now()) == 1);
+    assert(order == std::vector<int>{2});
+    assert(!second.armed());
+
+    // 取消与重新调度都是 O(1)，重复取消是空操作
+    assert(first.cancel());
+    assert(!first.cancel());
+    wheel.schedule(first, 1ms);
+    wheel.schedule(third, 2ms);
+    assert(wheel.size() == 3);
+    ManualClock::advance(2ms);
+    assert(wheel.advance(ManualClock::now()) == 2);
+    assert((order == std::vector<int>{2, 1, 3}));
+
+    // 超出 2^32 tick 覆盖范围的定时器在降级时重新放置，仍准时触发
+    ManualClock::advance(hours(24 * 60) - 8ms);
+    assert(wheel.advance(ManualClock::now()) == 0);
+    ManualClock::advance(1ms);
+    assert(wheel.advance(ManualClock::now()) == 1);
+    assert(order.back() == 4);
+    assert(wheel.empty());
+    assert(!wheel.timeUntilNextEvent(ManualClock::now()).has_value());
+
+    // 回调中重新调度自身：周期定时器
+    int ticks = 0;
+    Timer periodic;
+    periodic.setFunction([&]() {
+        if (++ticks < 3) {
+            wheel.schedule(periodic, 10ms);
+        }
+    });
+    wheel.schedule(periodic, 10ms);
+    ManualClock::advance(100ms);
+    assert(wheel.advance(ManualClock::now()) == 1);
+    for (int i = 0; i < 3; ++i) {
+        ManualClock::advance(10ms);
+        wheel.advance(ManualClock::now());
+    }
+    assert(ticks == 3);
+    assert(wheel.empty());
+
+    // 析构的节点自动取消
+    {
+        Request scoped(5, order);
+        wheel.schedule(scoped, 1ms);
+        assert(wheel.size() == 1);
+    }
+    assert(wheel.empty());
+
+    // 大量定时器：只在到期 tick 触发，不提前
+    std::vector<std::unique_ptr<Timer>> timers;
+    uint64_t fired = 0;
+    bool early = false;
+    for (int i = 0; i < 5000; ++i) {
+        const auto deadline = ManualClock::now() + ManualClock::duration((i * 7919) % 100000);
+        auto timer = std::make_unique<Timer>();
+        timer->setFunction([&fired, &early, deadline]() {
+            ++fired;
+            early = early || ManualClock::now() < deadline;
+        });
+        wheel.scheduleAt(*timer, deadline);
+        timers.push_back(std::move(timer));
+    }
+    for (size_t i = 0; i < timers.size(); i += 5) {
+        timers[i]->cancel();
+    }
+    for (int step = 0; step < 1000; ++step) {
+        ManualClock::advance(ManualClock::duration(101));
+        wheel.advance(ManualClock::now());
+    }
+    assert(fired == 4000);
+    assert(!early);
+    assert(wheel.empty());
+
+    std::cout << "TimerWheel tests passed!" << std::endl;
+}
+
+void testTimerService() {
+    std::cout << "=== Testing TimerService ===" << std::endl;
+    using namespace std::chrono;
+
+    std::atomic<int> fired{0};
+    std::atomic<bool> early{false};
+    {
+        TimerService service(1ms);
+        std::vector<TimerId> ids;
+        for (int i = 0; i < 200; ++i) {
+            const auto deadline = steady_clock::now() + milliseconds(1 + i % 20);
+            ids.push_back(service.scheduleAt(deadline, [&fired, &early, deadline]() {
+                early = early || steady_clock::now() < deadline;
+                ++fired;
+            }));
+        }
+        int cancelled = 0;
+        for (size_t i = 0; i < ids.size(); i += 4) {
+            cancelled += service.cancel(ids[i]) ? 1 : 0;
+        }
+        assert(cancelled == 50);
+        assert(!service.cancel(ids[0]));
+        assert(!service.cancel(TimerId{}));
+
+        const auto waitUntil = steady_clock::now() + 2s;
+        while (fired.load() < 150 && steady_clock::now() < waitUntil) {
+            std::this_thread::sleep_for(1ms);
+        }
+        assert(fired.load() == 150);
+        assert(!early.load());
+        assert(service.size() == 0);
+        assert(!service.cancel(ids[1]));
+
+        // 未触发的定时器在析构时丢弃
+        service.schedule(hours(1), [&fired]() { ++fired; });
+        assert(service.size() == 1);
+    }
+    assert(fired.load() == 150);
+
+    // 回调投递到线程池执行
+    ThreadPool pool(2);
+    std::atomic<int> dispatched{0};
+    {
+        TimerService service(1ms, &pool);
+        for (int i = 0; i < 100; ++i) {
+            service.schedule(1ms, [&dispatched]() { ++dispatched; });
+        }
+        const auto waitUntil = steady_clock::now() + 2s;
+        while (dispatched.load() < 100 && steady_clock::now() < waitUntil) {
+            std::this_thread::sleep_for(1ms);
+        }
+        service.stop();
+        bool threw = false;
+        try {
+            service.schedule(1ms, []() {});
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    pool.waitAll();
+    assert(dispatched.load() == 100);
+
+    // 在驱动线程的回调内停止服务
+    {
+        TimerService service(1ms);
+        std::atomic<bool> stopped{false};
+        service.schedule(1ms, [&service, &stopped]() {
+            service.stop();
+            stopped = true;
+        });
+        const auto waitUntil = steady_clock::now() + 2s;
+        while (!stopped.load() && steady_clock::now() < waitUntil) {
+            std::this_thread::sleep_for(1ms);
+        }
+        assert(stopped.load());
+        bool threw = false;
+        try {
+            service.schedule(1ms, []() {});
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    std::cout << "TimerService tests passed!" << std::endl;
+}
+
 // ==================== Main ====================
 
 int main() {
@@ -227,6 +428,8 @@ int main() {
         testPool();
         testThreadPoolUsesConcurrentQueueWithoutMutex();
         testThread();
+        testTimerWheel();
+        testTimerService();
         stressTestPool();
         stressTestThreadPool();
         return 0;
@@ -1,5 +1,7 @@
 #include "../test_common.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
 void testString() {
@@ -131,6 +133,258 @@ void testString() {
     assert(StringUtils::parse<double>("nan", -1.0) != -1.0);
     assert(StringUtils::parse<double>("1.5x", -1.0) == -1.0);
 
+    // from_chars parsing: trimmed full match, optional '+', SWAR 8-digit groups
+    assert(StringUtils::tryParse<int>(" +42 ") == 42);
+    assert(StringUtils::tryParse<int>("+-1") == std::nullopt);
+    assert(StringUtils::tryParse<int>("+") == std::nullopt);
+    assert(StringUtils::tryParse<unsigned>("-1") == std::nullopt);
+    assert(StringUtils::tryParse<uint64_t>("12345678901234567890") == 12345678901234567890ull);
+    assert(StringUtils::tryParse<uint64_t>("18446744073709551615") == std::numeric_limits<uint64_t>::max());
+    assert(StringUtils::tryParse<uint64_t>("18446744073709551616") == std::nullopt);
+    assert(StringUtils::tryParse<int64_t>("-9223372036854775808") == std::numeric_limits<int64_t>::min());
+    assert(StringUtils::tryParse<int64_t>("9223372036854775808") == std::nullopt);
+    assert(StringUtils::tryParse<int32_t>("2147483647") == 2147483647);
+    assert(StringUtils::tryParse<int32_t>("2147483648") == std::nullopt);
+    assert(StringUtils::tryParse<int16_t>("-32768") == -32768);
+    assert(StringUtils::tryParse<int>("00000000000000000000042") == 42);
+    assert(StringUtils::tryParse<int>("1234567a") == std::nullopt);
+    assert(StringUtils::tryParse<uint32_t>("87654321") == 87654321u);
+    assert(StringUtils::tryParse<uint64_t>("1234567887654321") == 1234567887654321ull);
+    assert(StringUtils::tryParse<double>("1e300") == 1e300);
+    assert(StringUtils::tryParse<double>("1e400") == std::nullopt);
+    assert(StringUtils::tryParse<double>("-inf") == -std::numeric_limits<double>::infinity());
+    assert(StringUtils::tryParse<float>("+0.5") == 0.5f);
+    assert(StringUtils::tryParse<bool>("true") == true);
+    assert(StringUtils::tryParse<bool>(" 0 ") == false);
+    assert(StringUtils::tryParse<bool>("yes") == std::nullopt);
+    for (uint64_t value : {0ull, 7ull, 99999999ull, 100000000ull, 123456789012ull}) {
+        assert(StringUtils::tryParse<uint64_t>(std::to_string(value)) == value);
+    }
+    // Non-numeric types keep the stream path
+    assert(StringUtils::parse<char>("x") == 'x');
+    assert(StringUtils::parse<std::string>(" word ") == "word");
+
+    // to_chars formatting
+    assert(StringUtils::toString(42) == "42");
+    assert(StringUtils::toString(-7LL) == "-7");
+    assert(StringUtils::toString(3.14159265) == "3.14159");
+    assert(StringUtils::toString(1e20) == "1e+20");
+    assert(StringUtils::toString(true) == "1");
+    assert(StringUtils::toString('c') == "c");
+    assert(StringUtils::toString(std::string("s")) == "s");
+    std::array<char, 32> numberBuffer{};
+    size_t written = StringUtils::toChars(numberBuffer, 3.14159265);
+    assert(std::string_view(numberBuffer.data(), written) == "3.14159265");
+    written = StringUtils::toChars(numberBuffer, std::numeric_limits<int64_t>::min());
+    assert(std::string_view(numberBuffer.data(), written) == "-9223372036854775808");
+    assert(StringUtils::toChars(std::span<char>(numberBuffer.data(), 2), 12345) == 0);
+
+    // printf-style formatting into caller buffers
+    std::array<char, 16> formatBuffer{};
+    assert(StringUtils::formatInto(formatBuffer, "%s=%d", "port", 8080) == 9);
+    assert(std::string_view(formatBuffer.data()) == "port=8080");
+    assert(StringUtils::formatInto(std::span<char>(formatBuffer.data(), 4), "%d", 123456) == 6);
+    assert(std::string_view(formatBuffer.data()) == "123");
+    assert(StringUtils::formatInto(formatBuffer, "100%") == 4);
+    assert(StringUtils::formatInto(formatBuffer, nullptr) == 0);
+    const std::string longFormatted = StringUtils::format("%s", std::string(300, 'z').c_str());
+    assert(longFormatted.size() == 300 && longFormatted.back() == 'z');
+
+    // Lazy split views share split()'s field rules
+    static_assert(std::ranges::forward_range<SplitView<SplitByChar>>);
+    auto collectView = [](const auto& view) {
+        std::vector<std::string_view> fields;
+        for (std::string_view field : view) {
+            fields.push_back(field);
+        }
+        return fields;
+    };
+    for (std::string_view input : {"", ",", "a", "a,,b", ",a,", "one,two,three"}) {
+        const auto expected = StringUtils::split(input, ',');
+        const auto viewed = collectView(StringUtils::splitView(input, ','));
+        assert(viewed.size() == expected.size());
+        for (size_t i = 0; i < viewed.size(); ++i) {
+            assert(viewed[i] == expected[i]);
+        }
+    }
+    auto multi = collectView(StringUtils::splitView("a::b::::c", "::"));
+    assert(multi.size() == 4 && multi[0] == "a" && multi[2].empty() && multi[3] == "c");
+    auto noDelimiter = collectView(StringUtils::splitView("abc", std::string_view{}));
+    assert(noDelimiter.size() == 1 && noDelimiter[0] == "abc");
+
+    // Any-of: SIMD path (<= 4 chars) across 16-byte blocks and bitmap path (> 4 chars)
+    const std::string longLine = std::string(20, 'x') + ";" + std::string(15, 'y') + "\t" + std::string(3, 'z') + " w";
+    auto anyOf = collectView(StringUtils::splitViewAnyOf(longLine, ";\t "));
+    assert(anyOf.size() == 4 && anyOf[0].size() == 20 && anyOf[1].size() == 15 && anyOf[2] == "zzz" && anyOf[3] == "w");
+    auto anyOfMany = collectView(StringUtils::splitViewAnyOf(longLine, ";\t |#!"));
+    assert(anyOfMany == anyOf);
+    assert(collectView(StringUtils::splitViewAnyOf("a,b", "")).size() == 1);
+    std::string highBytes = "a\xff" "b\x80" "c";
+    auto binary = collectView(StringUtils::splitViewAnyOf(highBytes, "\xff\x80"));
+    assert(binary.size() == 3 && binary[2] == "c");
+
+    // Quote-aware view matches splitRespectQuotes
+    const std::string quotedLine = "id,\"name, with comma\",\"x\"\"y\"," + std::string(30, 'q') + ",\"open";
+    const auto quotedExpected = StringUtils::splitRespectQuotes(quotedLine, ',');
+    const auto quotedViewed = collectView(StringUtils::splitViewRespectQuotes(quotedLine, ','));
+    assert(quotedViewed.size() == quotedExpected.size() && quotedViewed.size() == 5);
+    for (size_t i = 0; i < quotedViewed.size(); ++i) {
+        assert(quotedViewed[i] == quotedExpected[i]);
+    }
+    assert(quotedViewed[1] == "\"name, with comma\"");
+
+    // Fixed-capacity splitInto keeps the remainder in the last slot
+    std::array<std::string_view, 3> slots{};
+    assert(StringUtils::splitInto("a,b,c", ',', slots) == 3);
+    assert(slots[0] == "a" && slots[1] == "b" && slots[2] == "c");
+    assert(StringUtils::splitInto("k=v=w=x", '=', std::span(slots).first(2)) == 2);
+    assert(slots[0] == "k" && slots[1] == "v=w=x");
+    assert(StringUtils::splitInto("", ',', slots) == 0);
+    assert(StringUtils::splitInto("a,b", ',', std::span<std::string_view>{}) == 0);
+    assert(StringUtils::splitInto("a<>b<>", "<>", slots) == 3 && slots[2].empty());
+    assert(StringUtils::splitInto("a b\tc", SplitByAnyOf(" \t"), slots) == 3 && slots[2] == "c");
+
+    // ASCII kernels: lengths straddle the 16/32-byte SIMD blocks and the scalar tail
+    for (size_t length : {size_t{0}, size_t{1}, size_t{15}, size_t{16}, size_t{31}, size_t{32}, size_t{33}, size_t{77}}) {
+        std::string mixed;
+        for (size_t i = 0; i < length; ++i) {
+            mixed.push_back(static_cast<char>("@AZ[`az{0\xC3\x84"[i % 11]));
+        }
+        std::string expectedLower = mixed;
+        std::string expectedUpper = mixed;
+        for (size_t i = 0; i < length; ++i) {
+            const char c = mixed[i];
+            if (c >= 'A' && c <= 'Z') expectedLower[i] = static_cast<char>(c + 32);
+            if (c >= 'a' && c <= 'z') expectedUpper[i] = static_cast<char>(c - 32);
+        }
+        assert(StringUtils::toLower(mixed) == expectedLower);
+        assert(StringUtils::toUpper(mixed) == expectedUpper);
+
+        std::string inPlace = mixed;
+        StringUtils::toLowerInPlace(inPlace);
+        assert(inPlace == expectedLower);
+        StringUtils::toUpperInPlace(inPlace);
+        assert(inPlace == StringUtils::toUpper(expectedLower));
+
+        std::vector<char> out(length + 1, '#');
+        assert(StringUtils::toUpperInto(mixed, out) == length);
+        assert(std::string_view(out.data(), length) == expectedUpper && out[length] == '#');
+        assert(StringUtils::equalsIgnoreCase(expectedLower, expectedUpper));
+
+        const std::string digits(length, '7');
+        assert(StringUtils::isDigits(digits) == (length > 0));
+        assert(StringUtils::isHexDigits(digits + "aF") && !StringUtils::isHexDigits(digits + "g"));
+        assert(StringUtils::isBlank(std::string(length, ' ') + "\t\r\n\v\f"));
+        assert(!StringUtils::isBlank(std::string(length, ' ') + "x"));
+        assert(StringUtils::isInteger("-" + digits + "1") && !StringUtils::isInteger(digits + "/"));
+        assert(StringUtils::isAscii(digits) && !StringUtils::isAscii(digits + "\xFF"));
+    }
+    char tooSmall[2];
+    assert(StringUtils::toLowerInto("abc", tooSmall) == 0);
+    assert(!StringUtils::equalsIgnoreCase("abc", "abcd"));
+    assert(!StringUtils::equalsIgnoreCase("[", "{"));
+    assert(StringUtils::toLower("\xC3\x84" "BC") == "\xC3\x84" "bc");
+
+    // Trim views alias the input
+    const std::string padded = " \t value \r\n";
+    assert(StringUtils::trimView(padded) == "value" && StringUtils::trimView(padded).data() == padded.data() + 3);
+    assert(StringUtils::trimLeftView(padded) == "value \r\n");
+    assert(StringUtils::trimRightView(padded) == " \t value");
+    assert(StringUtils::trimView(" \t\n").empty());
+    assert(StringUtils::trimRight(padded) == " \t value");
+
+    // UTF-8 validation (Unicode Table 3-7)
+    assert(StringUtils::isValidUtf8(""));
+    assert(StringUtils::isValidUtf8("plain ascii text that is longer than sixteen bytes"));
+    assert(StringUtils::isValidUtf8("\xC3\xA9t\xC3\xA9 \xE4\xB8\xAD\xE6\x96\x87 \xF0\x9F\x98\x80 \xEF\xBF\xBF \xF4\x8F\xBF\xBF"));
+    assert(!StringUtils::isValidUtf8("\xC0\xAF"));           // overlong '/'
+    assert(!StringUtils::isValidUtf8("\xE0\x80\xAF"));       // overlong 3-byte
+    assert(!StringUtils::isValidUtf8("\xED\xA0\x80"));       // surrogate U+D800
+    assert(!StringUtils::isValidUtf8("\xF4\x90\x80\x80"));   // > U+10FFFF
+    assert(!StringUtils::isValidUtf8("\xF5\x80\x80\x80"));
+    assert(!StringUtils::isValidUtf8("abc\xE4\xB8"));         // truncated
+    assert(!StringUtils::isValidUtf8("\x80"));                 // stray continuation
+    assert(!StringUtils::isValidUtf8("\xC3\x28"));
+    assert(!StringUtils::isValidUtf8(std::string(40, 'a') + "\xFF" + std::string(40, 'b')));
+
+    // Case-insensitive functors for header-style keys
+    const AsciiCaseInsensitiveHash ciHash;
+    assert(ciHash("Content-Type") == ciHash("content-type"));
+    assert(ciHash("X-Request-Identifier") == ciHash("x-request-IDENTIFIER"));
+    assert(ciHash("Accept") != ciHash("Accept-Encoding"));
+    assert(AsciiCaseInsensitiveLess{}("accept", "Content-Type"));
+    assert(!AsciiCaseInsensitiveLess{}("ACCEPT", "accept"));
+    std::unordered_map<std::string, int, AsciiCaseInsensitiveHash, AsciiCaseInsensitiveEqual> headers;
+    headers["Content-Length"] = 42;
+    assert(headers.count("CONTENT-LENGTH") == 1 && headers.find(std::string_view("content-length"))->second == 42);
+
+    // SIMD substring search agrees with std::string_view::find across block boundaries
+    {
+        std::string haystack;
+        for (int i = 0; i < 300; ++i) {
+            haystack.push_back(static_cast<char>('a' + (i * 7 + i / 13) % 5));
+        }
+        for (std::string_view needle : {"a", "ab", "abc", "cab", "eeee", "bdace", "zz", "ecbdaebd"}) {
+            for (size_t pos = 0; pos <= haystack.size() + 1; pos += 7) {
+                assert(StringUtils::find(haystack, needle, pos) == std::string_view(haystack).find(needle, pos));
+            }
+            size_t expected = 0;
+            for (size_t p = std::string_view(haystack).find(needle); p != std::string_view::npos;
+                 p = std::string_view(haystack).find(needle, p + needle.size())) {
+                ++expected;
+            }
+            assert(StringUtils::count(haystack, needle) == expected);
+        }
+        const std::string tailMatch = std::string(100, 'x') + "needle";
+        assert(StringUtils::find(tailMatch, "needle") == 100 && StringUtils::contains(tailMatch, "xneedle"));
+        assert(!StringUtils::contains(tailMatch, "needles") && StringUtils::find(tailMatch, "", 3) == 3);
+        assert(StringUtils::count("aaaa", "aa") == 2);
+        assert(StringUtils::replace("aaaa", "aa", "b") == "bb");
+        assert(StringUtils::replace("a.b.c", ".", "::") == "a::b::c");
+        assert(StringUtils::replace("{x}{x}", "{x}", "") == "");
+    }
+
+    // MultiReplacer: one pass, leftmost-longest, replacements are not rescanned
+    {
+        const MultiReplacer replacer{{"{{name}}", "Ada"}, {"{{n}}", "{{name}}"}, {"{{name}}!", "Ada!!"}, {"&", "&amp;"}};
+        assert(replacer.patternCount() == 4);
+        assert(replacer.apply("Hi {{name}}, {{n}} & {{name}}!") == "Hi Ada, {{name}} &amp; Ada!!");
+        assert(replacer.outputSize("Hi {{name}}") == 6);
+        assert(replacer.apply("").empty() && replacer.apply("plain") == "plain");
+        assert(replacer.apply("{{nam") == "{{nam");
+
+        std::array<char, 8> small{};
+        assert(replacer.applyInto("&&", small) == 10);
+        std::array<char, 16> large{};
+        assert(replacer.applyInto("a&b", large) == 7 && std::string_view(large.data(), 7) == "a&amp;b");
+
+        std::string reused = "previous contents";
+        replacer.applyTo("x&", reused);
+        assert(reused == "x&amp;");
+
+        // More than four distinct first bytes falls back to the byte table
+        const std::vector<std::pair<std::string, std::string>> escapes = {
+            {"<", "&lt;"}, {">", "&gt;"}, {"&", "&amp;"}, {"\"", "&quot;"}, {"'", "&#39;"}};
+        const MultiReplacer html(escapes);
+        assert(html.apply("<a href=\"x\">Tom & 'Jerry'</a>")
+               == "&lt;a href=&quot;x&quot;&gt;Tom &amp; &#39;Jerry&#39;&lt;/a&gt;");
+
+        bool threw = false;
+        try {
+            MultiReplacer invalid{{"", "x"}};
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+        threw = false;
+        try {
+            MultiReplacer duplicated{{"a", "x"}, {"a", "y"}};
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
     std::cout << "String tests passed!" << std::endl;
 }
 
@@ -221,9 +475,300 @@ void testRandom() {
     assert(localA.randomString(12, "ab").size() == 12);
     localA.randomBytes(nullptr, 4);
 
+    // Engine reference vectors
+    Xoshiro256StarStar xoshiro(std::array<uint64_t, 4>{1, 2, 3, 4});
+    assert(xoshiro() == 11520u);
+    assert(xoshiro() == 0u);
+    assert(xoshiro() == 1509978240u);
+    assert(xoshiro() == 1215971899390074240u);
+    WyRand wyrand(0);
+    assert(wyrand() == 0x111cb3a78f59a58eull);
+    assert(wyrand() == 0xceabd938ff4e856dull);
+    assert(wyrand() == 0x61fb51318f47d2a4ull);
+
+    // Jump produces a disjoint stream
+    Xoshiro256StarStar jumped(42);
+    Xoshiro256StarStar plain(42);
+    jumped.jump();
+    assert(jumped() != plain());
+
+    // Bulk fill takes 8 bytes per draw, little-endian, tail from one extra draw
+    RandomGenerator fillA(7);
+    RandomGenerator fillB(7);
+    std::array<uint8_t, 19> filled{};
+    fillA.fill(filled);
+    for (size_t offset = 0; offset < filled.size(); offset += 8) {
+        const uint64_t word = fillB.next();
+        const size_t count = std::min<size_t>(8, filled.size() - offset);
+        assert(std::memcmp(filled.data() + offset, &word, count) == 0);
+    }
+
+    // Lemire bounded integers stay in range and reach both ends
+    WyRandGenerator wy(99);
+    bool sawLow = false;
+    bool sawHigh = false;
+    for (int i = 0; i < 2000; ++i) {
+        const uint64_t value = wy.uniform(7);
+        assert(value < 7);
+        sawLow = sawLow || value == 0;
+        sawHigh = sawHigh || value == 6;
+    }
+    assert(sawLow && sawHigh);
+    assert(wy.uniform(0) == 0);
+    assert(wy.uniform(1) == 0);
+    for (int i = 0; i < 100; ++i) {
+        const int value = wy.randomInt(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+        (void)value;
+        const int small = wy.randomInt(-3, 3);
+        assert(small >= -3 && small <= 3);
+        const float f = wy.randomFloat(-1.0f, 1.0f);
+        assert(f >= -1.0f && f < 1.0f);
+    }
+    const std::string oddHex = wy.randomHex(7, true);
+    assert(oddHex.size() == 7);
+    for (char c : oddHex) {
+        assert(std::isdigit(static_cast<unsigned char>(c)) || (c >= 'A' && c <= 'F'));
+    }
+
+    // Thread-local instances are distinct and seeding does not leak across threads
+    Randomizer* mainInstance = &Randomizer::instance();
+    Randomizer* workerInstance = nullptr;
+    rng.seed(2024);
+    const uint64_t expectedAfterSeed = RandomGenerator(2024).next();
+    std::thread worker([&workerInstance] {
+        workerInstance = &Randomizer::instance();
+        workerInstance->seed(1);
+        (void)workerInstance->next();
+    });
+    worker.join();
+    assert(workerInstance != mainInstance);
+    assert(rng.next() == expectedAfterSeed);
+    rng.reseed();
+
     std::cout << "Random tests passed!" << std::endl;
 }
 
+// ==================== ID Tests ====================
+
+void testIds() {
+    std::cout << "=== Testing IDs ===" << std::endl;
+
+    // UUIDv7 layout and monotonic ordering within one millisecond
+    const uint64_t ms = 1700000000123ull;
+    Uuid previous = IdGenerator::uuidV7(ms);
+    assert(previous.version() == 7);
+    assert((previous.bytes[8] & 0xC0) == 0x80);
+    assert(previous.timestampMs() == ms);
+    for (int i = 0; i < 10000; ++i) {
+        const Uuid next = IdGenerator::uuidV7(ms);
+        assert(next > previous);
+        assert(next.timestampMs() == ms);
+        previous = next;
+    }
+    // Clock rollback keeps the last timestamp
+    const Uuid rolledBack = IdGenerator::uuidV7(ms - 5);
+    assert(rolledBack > previous && rolledBack.timestampMs() == ms);
+    const Uuid later = IdGenerator::uuidV7(ms + 1);
+    assert(later > rolledBack && later.timestampMs() == ms + 1);
+
+    // Text round trip into a caller buffer
+    std::array<char, Uuid::kStringLength> uuidText{};
+    later.formatTo(uuidText);
+    const std::string uuidString(uuidText.data(), uuidText.size());
+    assert(uuidString == later.toString());
+    assert(uuidString[14] == '7');
+    auto parsedUuid = Uuid::parse(uuidString);
+    assert(parsedUuid && *parsedUuid == later);
+    assert(Uuid::parse("018bcfe5-6800-7000-8000-00000000000G") == std::nullopt);
+    assert(Uuid::parse("018bcfe568007000800000000000000000") == std::nullopt);
+    assert(Uuid::parse("018BCFE5-6800-7ABC-8000-000000000001")->bytes[7] == 0xBC);
+    const std::string v7 = IdGenerator::uuidV7().toString();
+    assert(Uuid::parse(v7)->version() == 7);
+
+    // ULID reference value and Crockford aliases
+    auto reference = Ulid::parse("01ARZ3NDEKTSV4RRFFQ69G5FAV");
+    assert(reference && reference->timestampMs() == 1469922850259ull);
+    assert(reference->toString() == "01ARZ3NDEKTSV4RRFFQ69G5FAV");
+    assert(Ulid::parse("01arz3ndektsv4rrffq69g5fav") == reference);
+    assert(Ulid::parse("0IARZ3NDEKTSV4RRFFQ69G5FAV") == Ulid::parse("01ARZ3NDEKTSV4RRFFQ69G5FAV"));
+    assert(Ulid::parse("81ARZ3NDEKTSV4RRFFQ69G5FAV") == std::nullopt);
+    assert(Ulid::parse("01ARZ3NDEKTSV4RRFFQ69G5FAU") == std::nullopt);
+    assert(Ulid::parse("01ARZ3NDEK") == std::nullopt);
+    assert(Ulid::parse("7ZZZZZZZZZZZZZZZZZZZZZZZZZ")->bytes[15] == 0xFF);
+
+    // ULID monotonic mode: same millisecond increments the random part by one
+    Ulid first = IdGenerator::ulid(ms);
+    Ulid second = IdGenerator::ulid(ms);
+    assert(second > first && second.timestampMs() == ms);
+    assert(first.toString() < second.toString());
+    const Ulid fresh = IdGenerator::ulid();
+    assert(Ulid::parse(fresh.toString()) == fresh);
+
+#if defined(GALAY_PLATFORM_LINUX) || defined(GALAY_PLATFORM_MACOS)
+    // A forked child must not continue the parent's monotonic counter
+    (void)IdGenerator::ulid(ms);
+    int fds[2];
+    assert(::pipe(fds) == 0);
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        const Ulid childUlid = IdGenerator::ulid(ms);
+        const bool ok = ::write(fds[1], childUlid.bytes.data(), 16) == 16;
+        ::_exit(ok ? 0 : 1);
+    }
+    assert(pid > 0);
+    const Ulid parentUlid = IdGenerator::ulid(ms);
+    Ulid childUlid;
+    assert(::read(fds[0], childUlid.bytes.data(), 16) == 16);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    ::close(fds[0]);
+    ::close(fds[1]);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(childUlid != parentUlid);
+#endif
+
+    // Per-thread state: each thread stays monotonic on its own
+    std::atomic<bool> threadsOk{true};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&threadsOk, ms] {
+            Uuid last = IdGenerator::uuidV7(ms);
+            for (int i = 0; i < 1000; ++i) {
+                const Uuid next = IdGenerator::uuidV7(ms);
+                if (!(next > last)) {
+                    threadsOk = false;
+                }
+                last = next;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    assert(threadsOk);
+
+    // Snowflake: layout, sequence carry and rollback
+    SnowflakeGenerator snowflake(513, SnowflakeGenerator::kDefaultEpochMs);
+    const uint64_t snowMs = SnowflakeGenerator::kDefaultEpochMs + 1000;
+    uint64_t lastId = snowflake.next(snowMs);
+    assert(SnowflakeGenerator::timestampMs(lastId) == snowMs);
+    assert(SnowflakeGenerator::workerIdOf(lastId) == 513);
+    assert(SnowflakeGenerator::sequenceOf(lastId) == 0);
+    for (int i = 0; i < 5000; ++i) {
+        const uint64_t id = snowflake.next(snowMs);
+        assert(id > lastId);
+        lastId = id;
+    }
+    // 4096 IDs per millisecond; the rest borrowed the next millisecond
+    assert(SnowflakeGenerator::timestampMs(lastId) == snowMs + 1);
+    assert(snowflake.next(snowMs - 100) > lastId);
+    assert((snowflake.next() >> 63) == 0);
+    bool threw = false;
+    try {
+        SnowflakeGenerator invalid(1024);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Shared across threads without locks
+    std::vector<uint64_t> ids(4 * 2000);
+    std::vector<std::thread> snowThreads;
+    for (int t = 0; t < 4; ++t) {
+        snowThreads.emplace_back([&snowflake, &ids, t] {
+            for (int i = 0; i < 2000; ++i) {
+                ids[static_cast<size_t>(t) * 2000 + i] = snowflake.next();
+            }
+        });
+    }
+    for (auto& thread : snowThreads) {
+        thread.join();
+    }
+    std::sort(ids.begin(), ids.end());
+    assert(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+
+    std::cout << "ID tests passed!" << std::endl;
+}
+
+// ==================== Interner Tests ====================
+
+void testInterner() {
+    std::cout << "=== Testing StringInterner ===" << std::endl;
+
+    static_assert(sizeof(Symbol) == 4);
+    static_assert(sizeof(InternedString) == sizeof(void*));
+
+    // Small arena blocks and initial table force several blocks and table growth
+    StringInterner interner(4, 256);
+    const InternedString alpha = interner.intern("alpha");
+    assert(alpha.valid() && alpha.view() == "alpha" && std::strcmp(alpha.c_str(), "alpha") == 0);
+    assert(alpha.symbol() == Symbol(1) && alpha.hash() == StringInterner::hashOf("alpha"));
+
+    const std::string alphaCopy = "alpha";
+    assert(interner.intern(alphaCopy) == alpha);
+    assert(interner.intern(alphaCopy).c_str() == alpha.c_str());
+    assert(interner.internSymbol("beta") == Symbol(2));
+    assert(interner.find("beta").symbol() == Symbol(2));
+    assert(!interner.find("gamma").valid() && interner.size() == 2);
+
+    const InternedString empty = interner.intern("");
+    assert(empty.valid() && empty.empty() && interner.find("") == empty);
+
+    std::vector<Symbol> symbols;
+    for (int i = 0; i < 5000; ++i) {
+        symbols.push_back(interner.internSymbol("route/" + std::to_string(i)));
+    }
+    const std::string longKey(1000, 'k');
+    const InternedString longHandle = interner.intern(longKey, StringInterner::hashOf(longKey));
+    assert(interner.size() == 5004 && longHandle.view() == longKey);
+    assert(interner.resolve(longHandle.symbol()) == longHandle);
+    assert(interner.view(alpha.symbol()) == "alpha" && interner.resolve(alpha.symbol()) == alpha);
+    for (int i = 0; i < 5000; ++i) {
+        assert(interner.view(symbols[i]) == "route/" + std::to_string(i));
+    }
+    assert(!interner.resolve(Symbol()).valid() && interner.view(Symbol(999999)).empty());
+    assert(interner.arenaBytes() > 5000 * sizeof(std::uint64_t));
+
+    // Functors key containers on symbols / handles
+    std::unordered_map<Symbol, int, SymbolHash> bySymbol;
+    bySymbol[alpha.symbol()] = 1;
+    assert(bySymbol.at(interner.internSymbol("alpha")) == 1);
+    std::unordered_map<InternedString, int, InternedStringHash, InternedStringEqual> byHandle;
+    byHandle[interner.intern("beta")] = 2;
+    assert(byHandle.at(interner.find("beta")) == 2);
+
+    // Concurrent interning of overlapping key sets yields one symbol per string
+    StringInterner shared(8, 512);
+    constexpr int kThreads = 4;
+    constexpr int kKeys = 4000;
+    std::vector<std::vector<Symbol>> results(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < kKeys; ++i) {
+                const int key = (t % 2 == 0) ? i : kKeys - 1 - i;
+                const Symbol symbol = shared.internSymbol("node-" + std::to_string(key));
+                assert(shared.view(symbol) == "node-" + std::to_string(key));
+                results[t].push_back(symbol);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    assert(shared.size() == kKeys);
+    for (int t = 1; t < kThreads; ++t) {
+        for (int i = 0; i < kKeys; ++i) {
+            const int key = (t % 2 == 0) ? i : kKeys - 1 - i;
+            assert(results[t][i] == results[0][key]);
+        }
+    }
+
+    assert(&StringInterner::global() == &StringInterner::global());
+
+    std::cout << "StringInterner tests passed!" << std::endl;
+}
+
 // ==================== System Tests ====================
 
 void testTimeUtilities() {
@@ -251,6 +796,79 @@ void testTimeUtilities() {
     assert(Time::currentLocalTime(nullptr).empty());
     std::cout << "  Current time: " << local << std::endl;
 
+    // Cached formatter: RFC 1123 / ISO-8601 / RFC 3339 into caller buffers
+    {
+        using namespace std::chrono;
+        TimeFormatter formatter;
+        std::array<char, 40> buffer{};
+        auto text = [&](size_t size) { return std::string(buffer.data(), size); };
+
+        assert(gmt.size() == TimeFormatter::kRfc1123Size && gmt.ends_with(" GMT"));
+        assert(text(formatter.formatRfc1123(buffer, sys_seconds(seconds(784111777)))) == "Sun, 06 Nov 1994 08:49:37 GMT");
+        assert(text(formatter.formatRfc1123(buffer, sys_seconds(seconds(784111778)))) == "Sun, 06 Nov 1994 08:49:38 GMT");
+        assert(text(formatter.formatRfc1123(buffer, sys_seconds(seconds(0)))) == "Thu, 01 Jan 1970 00:00:00 GMT");
+        assert(formatter.formatRfc1123(std::span<char>(buffer.data(), 28), sys_seconds(seconds(0))) == 0);
+
+        const system_clock::time_point sample{microseconds(784111777123456)};
+        assert(text(formatter.formatIso8601(buffer, sample)) == "1994-11-06T08:49:37.123Z");
+        assert(text(formatter.formatIso8601(buffer, sample, TimePrecision::Microseconds)) == "1994-11-06T08:49:37.123456Z");
+        assert(text(formatter.formatIso8601(buffer, sample, TimePrecision::Seconds)) == "1994-11-06T08:49:37Z");
+        assert(text(formatter.formatRfc3339(buffer, sample, hours(8))) == "1994-11-06T16:49:37.123+08:00");
+        assert(text(formatter.formatRfc3339(buffer, sample, -minutes(330), TimePrecision::Seconds)) == "1994-11-06T03:19:37-05:30");
+        assert(text(formatter.formatRfc3339(buffer, sample)) == "1994-11-06T08:49:37.123Z");
+        assert(text(formatter.formatIso8601(buffer, system_clock::time_point(microseconds(-1)), TimePrecision::Microseconds))
+               == "1969-12-31T23:59:59.999999Z");
+        assert(formatter.formatRfc3339(buffer, sample, hours(24)) == 0);
+        assert(formatter.formatIso8601(std::span<char>(buffer.data(), 23), sample) == 0);
+
+        // Second-by-second walk across minute, day, month and leap-year boundaries matches gmtime
+        for (int64_t second = 951868790; second < 951868790 + 200000; second += 37) {
+            std::array<char, 40> expected{};
+            const std::time_t timestamp = static_cast<std::time_t>(second);
+            std::tm tm{};
+            gmtime_r(&timestamp, &tm);
+            std::strftime(expected.data(), expected.size(), "%Y-%m-%dT%H:%M:%SZ", &tm);
+            assert(text(formatter.formatIso8601(buffer, system_clock::time_point(seconds(second)), TimePrecision::Seconds))
+                   == expected.data());
+            std::strftime(expected.data(), expected.size(), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+            assert(text(formatter.formatRfc1123(buffer, sys_seconds(seconds(second)))) == expected.data());
+        }
+
+        // Parsers
+        assert(TimeFormatter::parseRfc1123("Sun, 06 Nov 1994 08:49:37 GMT") == sys_seconds(seconds(784111777)));
+        assert(!TimeFormatter::parseRfc1123("Sun, 06 Nov 1994 08:49:37 UTC"));
+        assert(!TimeFormatter::parseRfc1123("Xyz, 06 Nov 1994 08:49:37 GMT"));
+        assert(!TimeFormatter::parseRfc1123("Sun, 31 Nov 1994 08:49:37 GMT"));
+        assert(!TimeFormatter::parseRfc1123("Sun, 06 Nov 1994 24:00:00 GMT"));
+        assert(!TimeFormatter::parseRfc1123("Sunday, 06-Nov-94 08:49:37 GMT"));
+
+        const auto expectedSample = TimeFormatter::Microseconds(microseconds(784111777123456));
+        assert(TimeFormatter::parseRfc3339("1994-11-06T08:49:37.123456Z") == expectedSample);
+        assert(TimeFormatter::parseRfc3339("1994-11-06t16:49:37.123456789+08:00") == expectedSample);
+        assert(TimeFormatter::parseRfc3339("1994-11-06 03:19:37.123456-05:30") == expectedSample);
+        assert(!TimeFormatter::parseRfc3339("1994-11-06T08:49:37"));
+        assert(!TimeFormatter::parseRfc3339("1994-11-06T08:49Z"));
+        assert(!TimeFormatter::parseRfc3339("1994-11-06T08:49:37+0800"));
+        assert(!TimeFormatter::parseRfc3339("1994-11-06T08:49:60Z"));
+        assert(!TimeFormatter::parseRfc3339("1994-02-29T00:00:00Z"));
+        assert(TimeFormatter::parseRfc3339("2000-02-29T00:00:00Z").has_value());
+        assert(!TimeFormatter::parseRfc3339("1994-11-06T08:49:37.Z"));
+        assert(!TimeFormatter::parseRfc3339("1994-11-06T08:49:37Zjunk"));
+
+        assert(TimeFormatter::parseIso8601("1994-11-06T08:49:37,123456") == expectedSample);
+        assert(TimeFormatter::parseIso8601("1994-11-06T16:49:37.123456+0800") == expectedSample);
+        assert(TimeFormatter::parseIso8601("1994-11-06T10:49:37.123456+02") == expectedSample);
+        assert(TimeFormatter::parseIso8601("1970-01-01") == TimeFormatter::Microseconds(microseconds(0)));
+        assert(TimeFormatter::parseIso8601("1970-01-01T00:01") == TimeFormatter::Microseconds(minutes(1)));
+        assert(!TimeFormatter::parseIso8601("1970-01-01 00:00:00Z"));
+        assert(!TimeFormatter::parseIso8601("1970-13-01"));
+
+        // Round trip through the formatter
+        const auto now = system_clock::now();
+        const size_t size = TimeFormatter::local().formatRfc3339(buffer, now, minutes(-90), TimePrecision::Microseconds);
+        assert(TimeFormatter::parseRfc3339(text(size)) == floor<microseconds>(now));
+    }
+
     ManualClock::reset();
     StopWatch<ManualClock> watch;
     ManualClock::advance(ManualClock::duration{25});
@@ -326,6 +944,341 @@ void testTimeUtilities() {
     std::cout << "Time utility tests passed!" << std::endl;
 }
 
+void testClockSources() {
+    std::cout << "=== Testing Clock Sources ===" << std::endl;
+    using namespace std::chrono;
+
+    static_assert(TscClock::is_steady && CoarseClock::is_steady && CachedClock::is_steady);
+    static_assert(std::is_same_v<TscClock::duration, nanoseconds>);
+
+    TscClock::calibrate();
+    if (TscClock::hardware()) {
+        assert(TscClock::ticksPerSecond() > 1e6);
+    }
+    // 两组 now() 之间可能被抢占，按相对误差比较并重试几次，避免在繁忙主机上偶发失败
+    bool calibrated = false;
+    for (int attempt = 0; attempt < 5 && !calibrated; ++attempt) {
+        const auto tscStart = TscClock::now();
+        const auto steadyStart = steady_clock::now();
+        std::this_thread::sleep_for(20ms);
+        const auto tscElapsed = TscClock::now() - tscStart;
+        const auto steadyElapsed = steady_clock::now() - steadyStart;
+        assert(tscElapsed >= 19ms);
+        const auto drift = duration_cast<nanoseconds>(tscElapsed - steadyElapsed).count();
+        const auto bound = duration_cast<nanoseconds>(steadyElapsed).count() / 20;
+        calibrated = drift <= bound && drift >= -bound;
+    }
+    assert(calibrated);
+    // 纪元与 steady_clock 对齐
+    const auto epochGap = TscClock::now().time_since_epoch().count()
+        - duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    assert(epochGap < 1'000'000'000 && epochGap > -1'000'000'000);
+
+    auto previous = TscClock::now();
+    for (int i = 0; i < 1000; ++i) {
+        const auto current = TscClock::now();
+        assert(current >= previous);
+        previous = current;
+    }
+
+    assert(CoarseClock::resolution() > CoarseClock::duration::zero());
+    const auto coarseStart = CoarseClock::now();
+    std::this_thread::sleep_for(20ms);
+    assert(CoarseClock::now() - coarseStart >= 20ms - CoarseClock::resolution());
+
+    CachedClock::start();
+    CachedClock::setInterval(500us);
+    assert(CachedClock::interval() == 500us);
+    const auto cachedStart = CachedClock::now();
+    std::this_thread::sleep_for(20ms);
+    assert(CachedClock::now() > cachedStart);
+    CachedClock::refresh();
+    const auto refreshed = CachedClock::now();
+    assert(refreshed.time_since_epoch() <= duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()));
+    CachedClock::setInterval(0us);
+    assert(CachedClock::interval() == CachedClock::kDefaultInterval);
+
+    StopWatch<TscClock> watch;
+    Deadline<CoarseClock> deadline = Deadline<CoarseClock>::fromNow(1h);
+    assert(!deadline.expired());
+    assert(watch.elapsed() >= TscClock::duration::zero());
+
+    std::cout << "Clock source tests passed!" << std::endl;
+}
+
+void testHistogram() {
+    std::cout << "=== Testing Histogram ===" << std::endl;
+    using namespace std::chrono;
+
+    Histogram empty;
+    const auto emptySummary = empty.summary();
+    assert(emptySummary.count == 0 && emptySummary.min == 0 && emptySummary.max == 0);
+    assert(emptySummary.p99 == 0 && emptySummary.mean == 0.0);
+
+    // 小于 2^precisionBits 的值精确记录
+    Histogram exact(1'000'000, 7);
+    for (uint64_t value = 1; value <= 100; ++value) {
+        exact.record(value);
+    }
+    auto snapshot = exact.snapshot();
+    assert(snapshot.count() == 100);
+    assert(snapshot.sum() == 5050);
+    assert(snapshot.min() == 1 && snapshot.max() == 100);
+    assert(snapshot.mean() == 50.5);
+    assert(snapshot.percentile(50) == 50);
+    assert(snapshot.percentile(99) == 99);
+    assert(snapshot.percentile(100) == 100);
+    assert(snapshot.percentile(0) == 1);
+    assert(snapshot.countAt(42) == 1);
+
+    // 相对误差不超过 2^-precisionBits，且桶上界不小于原值
+    Histogram wide;
+    RandomGenerator rng(42);
+    std::vector<uint64_t> samples;
+    for (int i = 0; i < 100000; ++i) {
+        const uint64_t value = static_cast<uint64_t>(rng.randomInt(1, 1'000'000'000));
+        samples.push_back(value);
+        wide.record(value);
+    }
+    std::sort(samples.begin(), samples.end());
+    const auto wideSnapshot = wide.snapshot();
+    for (double p : {50.0, 90.0, 99.0, 99.9}) {
+        const uint64_t expected = samples[static_cast<size_t>(std::ceil(p / 100.0 * samples.size())) - 1];
+        const uint64_t actual = wideSnapshot.percentile(p);
+        assert(actual >= expected);
+        assert(static_cast<double>(actual - expected) <= static_cast<double>(expected) / 128.0);
+    }
+    assert(wideSnapshot.max() == samples.back());
+    assert(wideSnapshot.min() == samples.front());
+    const auto summary = wideSnapshot.summary();
+    assert(summary.p50 <= summary.p90 && summary.p90 <= summary.p99 && summary.p99 <= summary.p999);
+    assert(summary.p999 <= summary.max);
+
+    // 超出上限的值计入最后一个桶，max 仍为精确值
+    Histogram bounded(1000, 4);
+    bounded.record(5000);
+    bounded.record(10);
+    assert(bounded.snapshot().max() == 5000);
+    assert(bounded.snapshot().percentile(100) == 5000);
+    assert(bounded.snapshot().countAt(1000) == 1);
+
+    // 多线程记录：每个线程一个分片，合并后计数与总和精确
+    Histogram concurrent;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&concurrent, t]() {
+            for (uint64_t i = 0; i < 100000; ++i) {
+                concurrent.record(i % 1000 + static_cast<uint64_t>(t));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto merged = concurrent.snapshot();
+    assert(merged.count() == 400000);
+    assert(merged.sum() == 4 * 100 * 499500ull + 100000ull * (0 + 1 + 2 + 3));
+    assert(merged.min() == 0 && merged.max() == 1002);
+    assert(concurrent.shardCount() == 4);
+
+    merged.merge(concurrent.snapshot());
+    assert(merged.count() == 800000);
+    bool mismatch = false;
+    try {
+        merged.merge(exact.snapshot());
+    } catch (const std::invalid_argument&) {
+        mismatch = true;
+    }
+    assert(mismatch);
+
+    concurrent.reset();
+    assert(concurrent.snapshot().count() == 0);
+    concurrent.record(milliseconds(3));
+    concurrent.record(-milliseconds(1));
+    assert(concurrent.snapshot().max() == 3'000'000);
+    assert(concurrent.snapshot().min() == 0);
+
+    // 同一线程记录多个直方图
+    std::vector<std::unique_ptr<Histogram>> many;
+    for (int i = 0; i < 40; ++i) {
+        many.push_back(std::make_unique<Histogram>());
+        many.back()->record(static_cast<uint64_t>(i));
+    }
+    for (int i = 0; i < 40; ++i) {
+        many[i]->record(static_cast<uint64_t>(i));
+        assert(many[i]->snapshot().count() == 2);
+        assert(many[i]->shardCount() == 1);
+    }
+
+    // ScopedTimer 析构时记录，stop() 立即记录，cancel() 不记录
+    ManualClock::reset();
+    Histogram latency;
+    {
+        ScopedTimer<ManualClock> timer(latency);
+        ManualClock::advance(ManualClock::duration(5));
+    }
+    {
+        ScopedTimer<ManualClock> timer(latency);
+        ManualClock::advance(ManualClock::duration(2));
+        assert(timer.stop() == ManualClock::duration(2));
+        assert(timer.stop() == ManualClock::duration::zero());
+        ManualClock::advance(ManualClock::duration(100));
+    }
+    {
+        ScopedTimer<ManualClock> timer(latency);
+        timer.cancel();
+    }
+    const auto latencySnapshot = latency.snapshot();
+    assert(latencySnapshot.count() == 2);
+    assert(latencySnapshot.max() == 5'000'000);
+    assert(latencySnapshot.min() == 2'000'000);
+
+    std::cout << "Histogram tests passed!" << std::endl;
+}
+
+void testMetrics() {
+    std::cout << "=== Testing Metrics ===" << std::endl;
+
+    // 分片计数器：多线程累加后汇总精确
+    Counter counter;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&counter]() {
+            for (int i = 0; i < 100000; ++i) {
+                counter.inc();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    counter.inc(5);
+    assert(counter.value() == 400005);
+    counter.reset();
+    assert(counter.value() == 0);
+
+    Gauge gauge;
+    gauge.set(10);
+    gauge.inc();
+    gauge.sub(4);
+    assert(gauge.value() == 7);
+
+    // 按 名称 + 标签 获取或创建，标签顺序无关
+    MetricsRegistry registry("app_");
+    Counter& requests = registry.counter("requests_total", "Handled requests", {{"route", "/a"}, {"code", "200"}});
+    assert(&requests == &registry.counter("requests_total", "", {{"code", "200"}, {"route", "/a"}}));
+    Counter& errors = registry.counter("requests_total", "", {{"route", "/a"}, {"code", "500"}});
+    assert(&requests != &errors);
+    requests.inc(3);
+    errors.inc();
+    registry.gauge("queue_depth", "Queued items").set(-2);
+    Histogram& latency = registry.histogram("latency_ns", "Request latency");
+    for (uint64_t value = 1; value <= 100; ++value) {
+        latency.record(value);
+    }
+
+    auto expectThrow = [](auto&& fn) {
+        bool thrown = false;
+        try {
+            fn();
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    };
+    expectThrow([&]() { registry.gauge("requests_total"); });
+    expectThrow([&]() { registry.counter("bad-name"); });
+    expectThrow([&]() { registry.counter("ok_total", "", {{"__reserved", "x"}}); });
+    expectThrow([&]() { registry.counter("ok_total", "", {{"a", "1"}, {"a", "2"}}); });
+
+    // 采集回调在导出时调用，注销后不再出现
+    int collected = 0;
+    {
+        MetricsRegistration registration = registry.addCollector([&collected](MetricsWriter& out) {
+            ++collected;
+            out.gauge("component_size", "Size with \"quotes\"\nand newline", 42, {{"name", "a\"b\\c"}});
+        });
+        assert(registration.active());
+        assert(registry.collectorCount() == 1);
+
+        const auto snapshot = registry.snapshot();
+        assert(collected == 1);
+        assert(snapshot.value("app_requests_total", {{"route", "/a"}, {"code", "200"}}) == 3.0);
+        assert(snapshot.value("app_requests_total", {{"code", "500"}, {"route", "/a"}}) == 1.0);
+        assert(!snapshot.value("app_requests_total", {{"code", "404"}, {"route", "/a"}}).has_value());
+        assert(snapshot.value("app_queue_depth") == -2.0);
+        assert(snapshot.value("app_component_size", {{"name", "a\"b\\c"}}) == 42.0);
+        const MetricSample* summary = snapshot.sample("app_latency_ns");
+        assert(summary != nullptr && summary->summary.count == 100 && summary->sum == 5050);
+        assert(summary->summary.p50 == 50 && summary->summary.max == 100);
+
+        const std::string text = snapshot.toPrometheus();
+        assert(text.find("# HELP app_requests_total Handled requests\n") != std::string::npos);
+        assert(text.find("# TYPE app_requests_total counter\n") != std::string::npos);
+        assert(text.find("app_requests_total{code=\"200\",route=\"/a\"} 3\n") != std::string::npos);
+        assert(text.find("app_queue_depth -2\n") != std::string::npos);
+        assert(text.find("# TYPE app_latency_ns summary\n") != std::string::npos);
+        assert(text.find("app_latency_ns{quantile=\"0.99\"} 99\n") != std::string::npos);
+        assert(text.find("app_latency_ns_sum 5050\n") != std::string::npos);
+        assert(text.find("app_latency_ns_count 100\n") != std::string::npos);
+        assert(text.find("# HELP app_component_size Size with \"quotes\"\\nand newline\n") != std::string::npos);
+        assert(text.find("app_component_size{name=\"a\\\"b\\\\c\"} 42\n") != std::string::npos);
+        // 按名称排序输出
+        assert(text.find("app_component_size") < text.find("app_latency_ns"));
+
+        const std::string json = snapshot.toJson();
+        assert(json.starts_with("{\"metrics\":[{\"name\":\"app_component_size\",\"type\":\"gauge\""));
+        assert(json.find("\"labels\":{\"name\":\"a\\\"b\\\\c\"},\"value\":42") != std::string::npos);
+        assert(json.find("\"labels\":{\"code\":\"200\",\"route\":\"/a\"},\"value\":3") != std::string::npos);
+        assert(json.find("\"count\":100,\"sum\":5050,\"min\":1,\"max\":100,\"mean\":50.5,\"p50\":50") != std::string::npos);
+        assert(json.ends_with("]}"));
+    }
+    assert(registry.collectorCount() == 0);
+    assert(registry.snapshot().find("app_component_size") == nullptr);
+    assert(collected == 1);
+
+    // 采集回调中写入非法名称时抛出
+    {
+        auto registration = registry.addCollector([](MetricsWriter& out) { out.counter("bad name", "", 1); });
+        expectThrow([&]() { (void)registry.snapshot(); });
+    }
+
+    // 并发在同一指标族下创建不同标签的序列，已取得的引用在扩容后仍有效
+    {
+        MetricsRegistry concurrent;
+        constexpr int kThreads = 4;
+        constexpr int kLabels = 200;
+        std::vector<std::thread> workers;
+        for (int t = 0; t < kThreads; ++t) {
+            workers.emplace_back([&concurrent]() {
+                for (int i = 0; i < kLabels; ++i) {
+                    concurrent.counter("shared_total", "", {{"id", std::to_string(i)}}).inc();
+                    concurrent.gauge("shared_gauge", "", {{"id", std::to_string(i)}}).inc();
+                    concurrent.histogram("shared_ns", "", {{"id", std::to_string(i)}}).record(1);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        const auto snapshot = concurrent.snapshot();
+        for (int i = 0; i < kLabels; ++i) {
+            const MetricLabels labels{{"id", std::to_string(i)}};
+            assert(snapshot.value("shared_total", labels) == kThreads);
+            assert(snapshot.value("shared_gauge", labels) == kThreads);
+            assert(snapshot.sample("shared_ns", labels)->summary.count == kThreads);
+        }
+    }
+
+    MetricsRegistry empty;
+    assert(empty.snapshot().empty());
+    assert(empty.toJson() == "{\"metrics\":[]}");
+    assert(empty.toPrometheus().empty());
+    assert(&MetricsRegistry::global() == &MetricsRegistry::global());
+
+    std::cout << "Metrics tests passed!" << std::endl;
+}
+
 // ==================== ByteQueueView Tests ====================
 
 void testTypeName() {
@@ -357,7 +1310,12 @@ int main() {
     try {
         testString();
         testRandom();
+        testIds();
+        testInterner();
         testTimeUtilities();
+        testClockSources();
+        testHistogram();
+        testMetrics();
         testTypeName();
         return 0;
     } catch (const std::exception& e) {
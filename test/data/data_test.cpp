@@ -167,6 +167,20 @@ void testBloomFilter() {
     assert(!filter.possiblyContains("alpha"));
     assert(!filter.possiblyContains("beta"));
 
+    // 稳定哈希策略：XXH3Hasher 结果跨进程一致，可持久化
+    auto stableFilter = BloomFilter<std::string, XXH3Hasher>::fromExpectedItems(1000, 0.01);
+    for (int i = 0; i < 1000; ++i) {
+        stableFilter.add("object-" + std::to_string(i));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        assert(stableFilter.possiblyContains("object-" + std::to_string(i)));
+    }
+    int stableFalsePositives = 0;
+    for (int i = 1000; i < 11000; ++i) {
+        stableFalsePositives += stableFilter.possiblyContains("object-" + std::to_string(i)) ? 1 : 0;
+    }
+    assert(stableFalsePositives < 500);
+
     BloomFilter<uint64_t> hashFilter(256);
     hashFilter.addHash(0x123456789abcdef0ULL);
     assert(hashFilter.possiblyContainsHash(0x123456789abcdef0ULL));
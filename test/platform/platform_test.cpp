@@ -15,6 +15,12 @@ void testSystem() {
     assert(content.has_value());
     assert(*content == "Hello, World!");
 
+    assert(System::readFileStream(testFile) == content);
+#if defined(__linux__)
+    assert(System::readFileStream("/proc/self/status").value_or("").find("Pid:") != std::string::npos);
+#endif
+    assert(!System::readFileStream("/tmp/non_existent_file.txt").has_value());
+
     assert(System::fileSize(testFile) == 13);
     assert(System::remove(testFile));
     assert(!System::fileExists(testFile));
@@ -135,6 +135,54 @@ void testRateLimiter() {
     std::cout << "RateLimiter tests passed!" << std::endl;
 }
 
+void testRateLimiterManualClock() {
+    std::cout << "=== Testing RateLimiter manual clock ===" << std::endl;
+
+    ManualClock::reset();
+    BasicTokenBucketLimiter<ManualClock> tokenBucket(10, 5);
+    assert(tokenBucket.tryAcquire(5));
+    assert(!tokenBucket.tryAcquire(1));
+    ManualClock::advance(std::chrono::milliseconds(99));
+    assert(!tokenBucket.tryAcquire(1));
+    ManualClock::advance(std::chrono::milliseconds(1));
+    assert(tokenBucket.tryAcquire(1));
+    assert(!tokenBucket.tryAcquire(1));
+    ManualClock::advance(std::chrono::seconds(10));
+    assert(tokenBucket.tryAcquire(5));
+    assert(!tokenBucket.tryAcquire(1));
+
+    ManualClock::reset();
+    BasicSlidingWindowLimiter<ManualClock> slidingWindow(2, std::chrono::milliseconds(100));
+    assert(slidingWindow.tryAcquire());
+    ManualClock::advance(std::chrono::milliseconds(50));
+    assert(slidingWindow.tryAcquire());
+    assert(!slidingWindow.tryAcquire());
+    ManualClock::advance(std::chrono::milliseconds(51));
+    assert(slidingWindow.tryAcquire());
+    assert(!slidingWindow.tryAcquire());
+
+    ManualClock::reset();
+    BasicLeakyBucketLimiter<ManualClock> leakyBucket(10, 2);
+    assert(leakyBucket.tryAcquire(2));
+    assert(!leakyBucket.tryAcquire(1));
+    ManualClock::advance(std::chrono::milliseconds(100));
+    assert(leakyBucket.tryAcquire(1));
+    assert(leakyBucket.currentWater() == 2.0);
+
+    // 热路径时钟可直接作为 Clock 模板参数
+    BasicTokenBucketLimiter<TscClock> tscBucket(1000, 2);
+    assert(tscBucket.tryAcquire(2));
+    assert(!tscBucket.tryAcquire(1));
+    BasicSlidingWindowLimiter<CoarseClock> coarseWindow(1, std::chrono::hours(1));
+    assert(coarseWindow.tryAcquire());
+    assert(!coarseWindow.tryAcquire());
+    BasicLeakyBucketLimiter<CachedClock> cachedBucket(0, 1);
+    assert(cachedBucket.tryAcquire(1));
+    assert(!cachedBucket.tryAcquire(1));
+
+    std::cout << "RateLimiter manual clock tests passed!" << std::endl;
+}
+
 // ==================== CircuitBreaker Tests ====================
 
 void testCircuitBreaker() {
@@ -302,6 +350,31 @@ void testCircuitBreakerManualClockTimeout() {
     std::cout << "CircuitBreaker manual clock timeout tests passed!" << std::endl;
 }
 
+void testCircuitBreakerHotPathClocks() {
+    std::cout << "=== Testing CircuitBreaker hot-path clocks ===" << std::endl;
+
+    CircuitBreakerConfig config;
+    config.failureThreshold = 1;
+    config.resetTimeout = std::chrono::seconds(0);
+
+    BasicCircuitBreaker<TscClock> tscBreaker(config);
+    tscBreaker.onFailure();
+    assert(tscBreaker.state() == CircuitState::Open);
+    assert(tscBreaker.allowRequest());
+    assert(tscBreaker.state() == CircuitState::HalfOpen);
+
+    config.resetTimeout = std::chrono::seconds(60);
+    BasicCircuitBreaker<CoarseClock> coarseBreaker(config);
+    coarseBreaker.onFailure();
+    assert(!coarseBreaker.allowRequest());
+
+    BasicCircuitBreaker<CachedClock> cachedBreaker(config);
+    cachedBreaker.onFailure();
+    assert(!cachedBreaker.allowRequest());
+
+    std::cout << "CircuitBreaker hot-path clock tests passed!" << std::endl;
+}
+
 void testCircuitBreakerHalfOpenProbeLimit() {
     std::cout << "=== Testing CircuitBreaker half-open probe limit ===" << std::endl;
 
@@ -610,17 +683,103 @@ void stressTestRateLimiter() {
     std::cout << "RateLimiter stress test passed!" << std::endl;
 }
 
+void testResilienceMetrics() {
+    std::cout << "=== Testing resilience metrics ===" << std::endl;
+    ManualClock::reset();
+
+    CountingSemaphore semaphore(1);
+    assert(semaphore.tryAcquire());
+    assert(!semaphore.tryAcquire());
+    assert(semaphore.rejectedCount() == 1);
+
+    BasicTokenBucketLimiter<ManualClock> tokenBucket(1, 2);
+    assert(tokenBucket.tryAcquire(2));
+    assert(!tokenBucket.tryAcquire());
+    assert(!tokenBucket.tryAcquire());
+    assert(tokenBucket.rejectedCount() == 2);
+
+    BasicSlidingWindowLimiter<ManualClock> slidingWindow(1, std::chrono::milliseconds(100));
+    assert(slidingWindow.tryAcquire());
+    assert(!slidingWindow.tryAcquire());
+    assert(slidingWindow.rejectedCount() == 1);
+
+    BasicLeakyBucketLimiter<ManualClock> leakyBucket(1, 1);
+    assert(leakyBucket.tryAcquire());
+    assert(!leakyBucket.tryAcquire());
+    assert(leakyBucket.rejectedCount() == 1);
+
+    CircuitBreakerConfig config;
+    config.failureThreshold = 1;
+    BasicCircuitBreaker<ManualClock> breaker(config);
+    assert(breaker.allowRequest());
+    breaker.onFailure();
+    assert(!breaker.allowRequest());
+    auto result = breaker.execute([]() -> std::expected<int, CircuitBreakerError> { return 1; });
+    assert(!result.has_value());
+    assert(breaker.rejectedCount() == 2);
+    breaker.reset();
+    assert(breaker.rejectedCount() == 2);
+    breaker.forceOpen();
+
+    MetricsRegistry registry("svc_");
+    std::vector<MetricsRegistration> registrations;
+    registrations.push_back(registerMetrics(registry, "permits", semaphore));
+    registrations.push_back(registerMetrics(registry, "api", tokenBucket));
+    registrations.push_back(registerMetrics(registry, "login", slidingWindow));
+    registrations.push_back(registerMetrics(registry, "upload", leakyBucket));
+    registrations.push_back(registerMetrics(registry, "backend", breaker));
+
+    ConsistentHash ring(10);
+    ring.addNode({"a", "10.0.0.1:80", 1});
+    ring.addNode({"b", "10.0.0.2:80", 2});
+    ring.recordRequest("a");
+    ring.recordRequest("a");
+    ring.recordRequest("b");
+    ring.markUnhealthy("b");
+    ring.recordRequest("missing");
+    registrations.push_back(registerMetrics(registry, "shards", ring));
+
+    const auto snapshot = registry.snapshot();
+    assert(snapshot.value("svc_rate_limiter_rejected_total", {{"name", "permits"}, {"kind", "semaphore"}}) == 1.0);
+    assert(snapshot.value("svc_rate_limiter_rejected_total", {{"name", "api"}, {"kind", "token_bucket"}}) == 2.0);
+    assert(snapshot.value("svc_rate_limiter_rejected_total", {{"name", "login"}, {"kind", "sliding_window"}}) == 1.0);
+    assert(snapshot.value("svc_rate_limiter_rejected_total", {{"name", "upload"}, {"kind", "leaky_bucket"}}) == 1.0);
+    assert(snapshot.value("svc_semaphore_available", {{"name", "permits"}}) == 0.0);
+    assert(snapshot.value("svc_rate_limiter_available_tokens", {{"name", "api"}}) == 0.0);
+    assert(snapshot.value("svc_rate_limiter_water_level", {{"name", "upload"}}) == 1.0);
+    assert(snapshot.value("svc_circuit_breaker_state", {{"name", "backend"}}) == 1.0);
+    assert(snapshot.value("svc_circuit_breaker_rejected_total", {{"name", "backend"}}) == 2.0);
+    assert(snapshot.find("svc_rate_limiter_rejected_total")->samples.size() == 4);
+    assert(snapshot.value("svc_consistent_hash_nodes", {{"name", "shards"}}) == 2.0);
+    assert(snapshot.value("svc_consistent_hash_virtual_nodes", {{"name", "shards"}}) == 30.0);
+    assert(snapshot.value("svc_consistent_hash_node_healthy", {{"name", "shards"}, {"node", "a"}}) == 1.0);
+    assert(snapshot.value("svc_consistent_hash_node_healthy", {{"name", "shards"}, {"node", "b"}}) == 0.0);
+    assert(snapshot.value("svc_consistent_hash_node_requests_total", {{"name", "shards"}, {"node", "a"}}) == 2.0);
+    assert(snapshot.value("svc_consistent_hash_node_requests_total", {{"name", "shards"}, {"node", "b"}}) == 1.0);
+    assert(snapshot.value("svc_consistent_hash_node_failures_total", {{"name", "shards"}, {"node", "b"}}) == 1.0);
+    assert(snapshot.toPrometheus().find(
+        "svc_circuit_breaker_rejected_total{name=\"backend\"} 2\n") != std::string::npos);
+
+    registrations.clear();
+    assert(registry.snapshot().empty());
+
+    std::cout << "Resilience metrics tests passed!" << std::endl;
+}
+
 int main() {
     std::cout << "\n=== resilience_test ===" << std::endl;
     try {
         testRateLimiterUsesLockFreeNonBlockingState();
         testRateLimiter();
+        testRateLimiterManualClock();
         testCircuitBreaker();
         testCircuitBreakerExpectedExecution();
         testCircuitBreakerExpectedFallback();
         testCircuitBreakerManualClockTimeout();
+        testCircuitBreakerHotPathClocks();
         testCircuitBreakerHalfOpenProbeLimit();
         testCircuitBreakerForceOpenUsesCurrentTime();
+        testResilienceMetrics();
         stressTestCircuitBreaker();
         stressTestRateLimiterCorrectness();
         stressTestRateLimiter();
@@ -30,6 +30,23 @@ void testConsistentHash() {
     hash.removeNode("node1");
     assert(hash.nodeCount() == 2);
 
+    // 模板注入哈希函数（64 位结果折叠为环坐标）
+    BasicConsistentHash<XXH3Hasher> xxhRing(50);
+    xxhRing.addNode({"a", "10.0.0.1:80", 1});
+    xxhRing.addNode({"b", "10.0.0.2:80", 1});
+    assert(xxhRing.virtualNodeCount() == 100);
+    auto owner = xxhRing.getNode("session-42");
+    assert(owner.has_value());
+    assert(xxhRing.getNode("session-42")->id == owner->id);
+    xxhRing.removeNode(owner->id);
+    assert(xxhRing.virtualNodeCount() == 50);
+    assert(xxhRing.getNode("session-42")->id != owner->id);
+
+    // std::function 版本显式传空时仍回退到 MurmurHash3
+    ConsistentHash nullHash(10, nullptr);
+    nullHash.addNode({"x", "", 1});
+    assert(nullHash.getNode("k").has_value());
+
     std::cout << "ConsistentHash tests passed!" << std::endl;
 }
 
@@ -111,6 +128,119 @@ void testLoadBalancer() {
     std::cout << "LoadBalancer tests passed!" << std::endl;
 }
 
+void testLoadAwareBalancer() {
+    std::cout << "=== Testing load-aware LoadBalancer ===" << std::endl;
+
+    ManualClock::reset();
+    std::vector<std::string> nodes = {"node1", "node2", "node3"};
+
+    // Least outstanding: 并列时轮转，持有句柄会抬高在途数
+    LeastOutstandingLoadBalancer<std::string, ManualClock> least(nodes);
+    assert(least.size() == 3);
+    {
+        auto a = least.select();
+        auto b = least.select();
+        auto c = least.select();
+        assert(a && b && c);
+        assert(*a != *b && *b != *c && *a != *c);
+        assert(least.inflight(0) == 1 && least.inflight(1) == 1 && least.inflight(2) == 1);
+
+        a.release();
+        assert(!a.has_value());
+        auto d = least.select();
+        assert(d.has_value());
+        assert(least.inflight(0) + least.inflight(1) + least.inflight(2) == 3);
+    }
+    assert(least.inflight(0) == 0 && least.inflight(1) == 0 && least.inflight(2) == 0);
+
+    {
+        auto busy = least.select();
+        const std::string busyNode = busy.value();
+        for (int i = 0; i < 20; ++i) {
+            auto other = least.select();
+            assert(other.has_value());
+            assert(*other != busyNode);
+        }
+    }
+
+    // 句柄析构记录延迟 EWMA；移动后只记录一次
+    LeastOutstandingLoadBalancer<std::string, ManualClock> timed(std::vector<std::string>{"only"});
+    {
+        auto selection = timed.select();
+        ManualClock::advance(std::chrono::milliseconds(8));
+        auto moved = std::move(selection);
+        assert(!selection.has_value());
+        assert(moved.has_value());
+    }
+    assert(timed.inflight(0) == 0);
+    assert(timed.latencyEwma(0) == std::chrono::milliseconds(8));
+    {
+        auto selection = timed.select();
+        selection.complete(std::chrono::milliseconds(16));
+        assert(!selection.has_value());
+    }
+    assert(timed.latencyEwma(0) == std::chrono::milliseconds(9)); // 8 + (16 - 8) / 8
+
+    // P2C：两节点时必然比较两者，在途数更少者胜出
+    P2CLoadBalancer<std::string, ManualClock> p2c(std::vector<std::string>{"slow", "fast"});
+    {
+        auto held = p2c.select();
+        const std::string heldNode = held.value();
+        for (int i = 0; i < 20; ++i) {
+            auto other = p2c.select();
+            assert(other.has_value());
+            assert(*other != heldNode);
+        }
+    }
+
+    // P2C 延迟模式：延迟高的节点被避开
+    P2CLoadBalancer<std::string, ManualClock> latency(
+        std::vector<std::string>{"slow", "fast"}, P2CMetric::LatencyEwma);
+    // 无样本节点优先被探测，两次选择后两个节点都有延迟样本
+    for (int i = 0; i < 2; ++i) {
+        auto selection = latency.select();
+        selection.complete(*selection == "slow" ? std::chrono::milliseconds(100)
+                                                : std::chrono::milliseconds(1));
+    }
+    assert(latency.latencyEwma(0) == std::chrono::milliseconds(100));
+    assert(latency.latencyEwma(1) == std::chrono::milliseconds(1));
+    for (int i = 0; i < 20; ++i) {
+        auto selection = latency.select();
+        assert(*selection == "fast");
+    }
+
+    // 多线程并发选择后在途数归零
+    P2CLoadBalancer<int> shared(std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8});
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&shared] {
+            for (int i = 0; i < 10000; ++i) {
+                auto selection = shared.select();
+                assert(selection.has_value());
+                assert(*selection >= 1 && *selection <= 8);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (size_t i = 0; i < shared.size(); ++i) {
+        assert(shared.inflight(i) == 0);
+    }
+
+    // Edge cases
+    P2CLoadBalancer<std::string> emptyP2C(std::vector<std::string>{});
+    assert(!emptyP2C.select().has_value());
+    LeastOutstandingLoadBalancer<std::string> emptyLeast(std::vector<std::string>{});
+    assert(!emptyLeast.select().has_value());
+    P2CLoadBalancer<std::string> single(std::vector<std::string>{"only"});
+    assert(*single.select() == "only");
+    single.append("second");
+    assert(single.size() == 2);
+
+    std::cout << "Load-aware LoadBalancer tests passed!" << std::endl;
+}
+
 // ==================== LruCache Tests ====================
 
 int main() {
@@ -118,6 +248,7 @@ int main() {
     try {
         testConsistentHash();
         testLoadBalancer();
+        testLoadAwareBalancer();
         return 0;
     } catch (const std::exception& e) {
         std::cerr << "Test failed with exception: " << e.what() << std::endl;
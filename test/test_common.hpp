@@ -20,6 +20,8 @@
 
 #include "galay-utils/galay_utils.hpp"
 #include <galay-utils/tool/rate_limiter.hpp>
+#include <galay-utils/tool/component_metrics.hpp>
+#include <galay-utils/config/config_watcher.hpp>
 
 using namespace galay::utils;
 